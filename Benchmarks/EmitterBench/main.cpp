@@ -0,0 +1,128 @@
+//
+//  main.cpp
+//  EmitterBench
+//
+//  Created by agent on 19/10/2026.
+//
+//  Compares the cost of emitting an event through RD::Emitter (Synchronized policy) and through RD::Signal,
+//  for several numbers of listeners, and the throughput of Emitter when several threads emit at once.
+//
+
+#include <RD/Emitter.h>
+#include <RD/Signal.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    //! @brief Listener interface, like ModuleListener.
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+        virtual void onEvent(int value) { }
+    };
+
+    //! @brief Concrete listener. Final, so Signal stubs call onEvent directly.
+    class Counter final : public Listener
+    {
+    public:
+        long long sum = 0;
+        void onEvent(int value) override { sum += value; }
+    };
+
+    //! @brief Emitter exposing emit for the benchmark.
+    class Source : public RD::Emitter < Listener, RD::EmittingPolicy::Synchronized >
+    {
+    public:
+        void fire(int value) { emit < Listener >(&Listener::onEvent, int(value)); }
+    };
+
+    //! @brief Prevents the compiler from removing the benchmarked loop.
+    volatile long long sink = 0;
+
+    /*! @brief Runs func iterations times and returns nanoseconds per iteration. */
+    template < typename Func >
+    double Measure(std::size_t iterations, Func&& func)
+    {
+        auto begin = RD::Clock::now();
+
+        for (std::size_t i = 0; i < iterations; ++i)
+            func(static_cast < int >(i));
+
+        auto end = RD::Clock::now();
+        return std::chrono::duration < double, std::nano >(end - begin).count() / iterations;
+    }
+
+    /*! @brief Benchmarks a single thread emitting to count listeners. */
+    void BenchListeners(std::size_t count, std::size_t iterations)
+    {
+        std::vector < Counter > counters(count);
+
+        Source source;
+        RD::Signal < int > virtualSignal;
+        RD::Signal < int > directSignal;
+
+        for (auto& counter : counters)
+        {
+            source.addListener(&counter);
+            virtualSignal.connect < &Listener::onEvent >(static_cast < Listener* >(&counter));
+            directSignal.connect(&counter, [](void* object, int value){ static_cast < Counter* >(object)->onEvent(value); });
+        }
+
+        double emitter = Measure(iterations, [&](int i){ source.fire(i); });
+        double signalVirtual = Measure(iterations, [&](int i){ virtualSignal.emit(i); });
+        double signalDirect = Measure(iterations, [&](int i){ directSignal.emit(i); });
+
+        for (auto& counter : counters)
+            sink = sink + counter.sum;
+
+        std::printf("%4zu listeners | Emitter %8.1f ns | Signal (virtual) %8.1f ns | Signal (final) %8.1f ns\n",
+                    count, emitter, signalVirtual, signalDirect);
+    }
+
+    /*! @brief Benchmarks threads emitting concurrently on the same Emitter. */
+    void BenchThreads(std::size_t threads, std::size_t iterations)
+    {
+        std::vector < Counter > counters(threads * 4);
+        Source source;
+
+        for (auto& counter : counters)
+            source.addListener(&counter);
+
+        auto begin = RD::Clock::now();
+        std::vector < std::thread > workers;
+
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&source, iterations](){
+                for (std::size_t i = 0; i < iterations; ++i)
+                    source.fire(0);
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        auto end = RD::Clock::now();
+        double seconds = std::chrono::duration < double >(end - begin).count();
+
+        std::printf("%4zu threads   | Emitter %8.2f Memit/s\n", threads, threads * iterations / seconds / 1e6);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    for (std::size_t count : { 1, 4, 16, 64 })
+        BenchListeners(count, iterations);
+
+    std::size_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (std::size_t threads = 1; threads <= hardware; threads *= 2)
+        BenchThreads(threads, iterations);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+//
+//  main.cpp
+//  FormatBench
+//
+//  Created by agent on 19/10/2026.
+//
+//  Compares snprintf and RD::FormatTo on the formats used by exceptions and notifications: integers,
+//  floating points, pointers and a mixed message.
+//
+
+#include <RD/Format.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    //! @brief Prevents the compiler from removing the benchmarked loop.
+    volatile std::size_t sink = 0;
+
+    /*! @brief Runs func iterations times and returns nanoseconds per iteration. */
+    template < typename Func >
+    double Measure(std::size_t iterations, Func&& func)
+    {
+        auto begin = RD::Clock::now();
+
+        for (std::size_t i = 0; i < iterations; ++i)
+            sink = sink + func(i);
+
+        auto end = RD::Clock::now();
+        return std::chrono::duration < double, std::nano >(end - begin).count() / iterations;
+    }
+
+    /*! @brief Prints the cost of both functions for one format. */
+    void Print(const char* name, double snprintfTime, double formatTime)
+    {
+        std::printf("%-8s | snprintf %7.1f ns | RD::FormatTo %7.1f ns | x%.2f\n",
+                    name, snprintfTime, formatTime, snprintfTime / formatTime);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    // Values are read from a table so the compiler can not format them at compile time.
+    std::vector < long long > integers(1024);
+    std::vector < double > doubles(1024);
+    std::vector < const void* > pointers(1024);
+
+    for (std::size_t i = 0; i < integers.size(); ++i)
+    {
+        integers[i] = static_cast < long long >(i * 2654435761u) - (1ll << 31);
+        doubles[i] = static_cast < double >(integers[i]) / 997.0;
+        pointers[i] = &integers[i];
+    }
+
+    char buffer[256];
+
+    Print("int",
+          Measure(iterations, [&](std::size_t i){ return std::size_t(std::snprintf(buffer, sizeof(buffer), "%lld", integers[i & 1023])); }),
+          Measure(iterations, [&](std::size_t i){ return RD::FormatTo(buffer, sizeof(buffer), RDFormatString("%lld"), integers[i & 1023]).size; }));
+
+    Print("float",
+          Measure(iterations, [&](std::size_t i){ return std::size_t(std::snprintf(buffer, sizeof(buffer), "%.3f", doubles[i & 1023])); }),
+          Measure(iterations, [&](std::size_t i){ return RD::FormatTo(buffer, sizeof(buffer), RDFormatString("%.3f"), doubles[i & 1023]).size; }));
+
+    Print("pointer",
+          Measure(iterations, [&](std::size_t i){ return std::size_t(std::snprintf(buffer, sizeof(buffer), "%p", pointers[i & 1023])); }),
+          Measure(iterations, [&](std::size_t i){ return RD::FormatTo(buffer, sizeof(buffer), RDFormatString("%p"), pointers[i & 1023]).size; }));
+
+    Print("mixed",
+          Measure(iterations, [&](std::size_t i){ return std::size_t(std::snprintf(buffer, sizeof(buffer), "Driver %s created surface %s (%dx%d) at %p.", "Gl3Driver", "MainSurface", int(i & 1023), 768, pointers[i & 1023])); }),
+          Measure(iterations, [&](std::size_t i){ return RD::FormatTo(buffer, sizeof(buffer), RDFormatString("Driver %s created surface %s (%dx%d) at %p."), "Gl3Driver", "MainSurface", int(i & 1023), 768, pointers[i & 1023]).size; }));
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+//
+//  main.cpp
+//  RenderQueueBench
+//
+//  Created by agent on 19/10/2026.
+//
+//  Compares RD::RenderQueue::Sort with std::sort and std::stable_sort on draw items whose keys look
+//  like a scene's: a few layers and passes, 512 materials of 32 pipelines, and any depth. Also prints
+//  the state changes a driver would make with the items submitted, and sorted.
+//
+
+#include <RD/RenderQueue.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    /*! @brief Returns items with random keys, from a fixed seed. */
+    std::vector < RD::DrawItem > MakeItems(std::size_t count)
+    {
+        std::vector < RD::DrawItem > items(count);
+        std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+
+            auto layer = std::uint8_t(seed % 2);
+            auto pass = std::uint8_t((seed >> 8) % 3);
+            auto material = std::uint16_t((seed >> 16) % 512);
+            auto pipeline = std::uint16_t(material % 32);
+            auto depth = RD::DrawKey::QuantizeDepth(float((seed >> 40) & 0xFFFF) / 65535.0f);
+
+            items[i] = RD::DrawItem { RD::DrawKey::Make(layer, pass, pipeline, material, depth), i };
+        }
+
+        return items;
+    }
+
+    /*! @brief Returns the pipeline and material changes made by drawing items in order. */
+    std::size_t StateChanges(const std::vector < RD::DrawItem >& items)
+    {
+        std::size_t changes = 0;
+
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (i == 0 || (items[i].key >> 16) != (items[i - 1].key >> 16))
+                changes++;
+        }
+
+        return changes;
+    }
+
+    /*! @brief Sorts a copy of items repeats times with sort, and returns nanoseconds per item. */
+    template < typename Sort >
+    double Measure(const std::vector < RD::DrawItem >& items, std::size_t repeats, Sort&& sort)
+    {
+        std::vector < RD::DrawItem > copy;
+        RD::Clock::duration elapsed { 0 };
+
+        for (std::size_t r = 0; r < repeats; ++r)
+        {
+            copy = items;
+
+            auto begin = RD::Clock::now();
+            sort(copy);
+            elapsed += RD::Clock::now() - begin;
+        }
+
+        return std::chrono::duration < double, std::nano >(elapsed).count() / double(repeats * items.size());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t largest = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    auto byKey = [](const RD::DrawItem& lhs, const RD::DrawItem& rhs){ return lhs.key < rhs.key; };
+    std::vector < RD::DrawItem > scratch;
+
+    for (std::size_t count = 1000; count <= largest; count *= 10)
+    {
+        std::vector < RD::DrawItem > items = MakeItems(count);
+        std::size_t repeats = std::max < std::size_t >(1, 10000000 / count);
+
+        double radix = Measure(items, repeats, [&](std::vector < RD::DrawItem >& v){ RD::RenderQueue::Sort(v, scratch); });
+        double stable = Measure(items, repeats, [&](std::vector < RD::DrawItem >& v){ std::stable_sort(v.begin(), v.end(), byKey); });
+        double unstable = Measure(items, repeats, [&](std::vector < RD::DrawItem >& v){ std::sort(v.begin(), v.end(), byKey); });
+
+        // Radix sort is stable: it must give exactly what std::stable_sort gives.
+        std::vector < RD::DrawItem > sorted = items, expected = items;
+        RD::RenderQueue::Sort(sorted, scratch);
+        std::stable_sort(expected.begin(), expected.end(), byKey);
+
+        bool same = std::equal(sorted.begin(), sorted.end(), expected.begin(), [](const RD::DrawItem& lhs, const RD::DrawItem& rhs){
+            return lhs.key == rhs.key && lhs.data == rhs.data;
+        });
+
+        std::printf("%8zu items | radix %6.2f ns | stable_sort %6.2f ns | sort %6.2f ns | x%.2f | state changes %zu -> %zu%s\n",
+                    count, radix, stable, unstable, stable / radix,
+                    StateChanges(items), StateChanges(sorted), same ? "" : " | MISMATCH");
+
+        if (!same)
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+//
+//  main.cpp
+//  SoftBench
+//
+//  Created by agent on 19/10/2026.
+//
+//  Renders the same frame with SoftDriver for every instruction set and number of threads, and prints the
+//  time per frame and a hash of the image, which must be the same for every configuration.
+//
+//  Usage: SoftBench [frames] [triangles] [capture]. If a capture path is given, the first configuration is
+//  captured into it (see RD::Driver::startCapture), to be replayed with rdreplay.
+//
+
+#include <SoftModule/SoftModule.h>
+#include <SoftModule/SoftDriver.h>
+#include <SoftModule/SoftSurface.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+    /*! @brief Returns count random triangles of about size pixels, some of them partly out of screen. */
+    std::vector < Soft::SoftVertex > Scene(std::size_t count, uint32_t width, uint32_t height, float size)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution < float > centerX(-size, width + size), centerY(-size, height + size);
+        std::uniform_real_distribution < float > offset(-size, size), depth(0.0f, 1.0f);
+
+        std::vector < Soft::SoftVertex > vertices;
+        vertices.reserve(count * 3);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float x = centerX(random), y = centerY(random);
+
+            for (int k = 0; k < 3; ++k)
+                vertices.push_back(Soft::SoftVertex { x + offset(random), y + offset(random), depth(random), uint32_t(random()) });
+        }
+
+        return vertices;
+    }
+
+    /*! @brief Returns the FNV-1a hash of an image. */
+    std::uint64_t Hash(const std::vector < uint32_t >& pixels)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+        for (uint32_t pixel : pixels)
+            hash = (hash ^ pixel) * 0x100000001b3ULL;
+
+        return hash;
+    }
+
+    /*! @brief Parses a positive decimal count. Returns false for zero, or if text is not a number. */
+    bool ParseCount(const char* text, std::size_t& count)
+    {
+        char* end = nullptr;
+        unsigned long long value = std::strtoull(text, &end, 10);
+
+        if (end == text || *end || *text == '-' || !value)
+            return false;
+
+        count = static_cast < std::size_t >(value);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t frames = 10;
+    std::size_t triangles = 20000;
+    const char* capturePath = argc > 3 ? argv[3] : nullptr;
+
+    if ((argc > 1 && !ParseCount(argv[1], frames)) || (argc > 2 && !ParseCount(argv[2], triangles)))
+    {
+        std::fprintf(stderr, "usage: %s [frames] [triangles] [capture]\n", argv[0]);
+        return 1;
+    }
+
+    const uint32_t width = 1920, height = 1080;
+    auto vertices = Scene(triangles, width, height, 48.0f);
+    auto module = RD::CreateHandle < Soft::Module >();
+
+    uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    for (Soft::SoftSimd simd : { Soft::SoftSimd::Scalar, Soft::SoftSimd::SSE2, Soft::SoftSimd::AVX2 })
+    {
+        if (!Soft::SoftSupportsSimd(simd))
+            continue;
+
+        for (uint32_t threads = 1; threads <= hardware; threads *= 2)
+        {
+            Soft::SoftDriverConfiguration softConfig;
+            softConfig.simd = simd;
+            softConfig.threads = threads;
+
+            RD::DriverConfiguration config;
+            config.extension = &softConfig;
+
+            auto driver = module->loadClass < RD::Driver >(&config);
+
+            if (capturePath)
+            {
+                driver->startCapture(capturePath);
+                capturePath = nullptr;
+            }
+
+            auto surface = driver->createSurface(width, height, "SoftBench", "SoftBench");
+            auto* softSurface = static_cast < Soft::SoftSurface* >(surface.ptr());
+
+            RD::CommandQueue& queue = driver->getCommandQueue();
+            auto begin = RD::Clock::now();
+
+            for (std::size_t i = 0; i < frames; ++i)
+            {
+                auto buffer = queue.acquire();
+                Soft::RecordClear(*buffer, softSurface, 0xFF000000);
+                Soft::RecordDraw(*buffer, softSurface, vertices.data(), uint32_t(vertices.size()));
+
+                queue.submit(std::move(buffer));
+                driver->present();
+            }
+
+            queue.wait();
+            auto end = RD::Clock::now();
+            driver->stopCapture();
+
+            std::vector < uint32_t > pixels;
+            softSurface->readPixels(pixels);
+
+            std::printf("%-6s | %2u thread(s) | %8.2f ms/frame | %016llx\n", Soft::SoftSimdName(simd), threads,
+                        std::chrono::duration < double, std::milli >(end - begin).count() / frames,
+                        (unsigned long long) Hash(pixels));
+
+            surface->close();
+        }
+    }
+
+    return 0;
+}
@@ -16,9 +16,31 @@
 #include "Module.h"
 #include "NotificationCenter.h"
 #include "Spinlock.h"
+#include "TimerWheel.h"
+#include "WorkerPool.h"
+#include "CpuTopology.h"
+#include "FramePipeline.h"
+#include "FrameScheduler.h"
+#include "EventQueue.h"
+#include "MemoryPressure.h"
 
 namespace RD
 {
+    /**
+     * @brief Point of the tick where the default EventQueue is flushed.
+     */
+    enum class EventFlushPoint
+    {
+        //! @brief After posted work and timers, before onApplicationWillUpdate().
+        BeginTick,
+        
+        //! @brief After modules update, before the pipeline simulation and onApplicationDidUpdate().
+        AfterModules,
+        
+        //! @brief After onApplicationDidUpdate().
+        EndTick
+    };
+    
     /**
      * @brief Generic Application design interface.
      *
@@ -29,9 +51,13 @@ namespace RD
      * An Application life is always the same:
      *  - it begins with start(), which send to delegate onApplicationWillStart() and onApplicationDidStart().
      *  - it continues with run(), while its stop() function is not called. For each tick, it does call
-     *    onApplicationWillUpdate() and onApplicationDidUpdate().
+     *    onApplicationWillUpdate() and onApplicationDidUpdate(). Ticks are paced by the FrameScheduler.
      *  - it ends with terminate(), which send onApplicationWillTerminate().
      *
+     * In pipelined mode (see setPipelineDepth()), each tick also calls onApplicationSimulate() to fill a
+     * FrameData, which is rendered with onApplicationRender() by a render thread while the next frames are
+     * simulated.
+     *
      * When deriving Application, user should call parent functions to send events correctly to the application
      * delegate. Users should use ApplicationDelegate instead of deriving this class.
      */
@@ -64,6 +90,40 @@ namespace RD
         //! directly on Handle is not supported yet).
         mutable Spinlock defaultCenterSpinlock;
         
+        //! @brief Timers advanced at each loop of run(). Callbacks dispatched on the main thread are called
+        //! before the delegate's onApplicationWillUpdate().
+        TimerWheel timers;
+        
+        //! @brief Paces the run loop, and holds work posted to the main thread.
+        FrameScheduler scheduler;
+        
+        //! @brief Where the default EventQueue is flushed in tick().
+        EventFlushPoint eventFlushPoint;
+        
+        //! @brief Workers shared by the engine subsystems. Created in start() and destroyed in terminate().
+        Handle < WorkerPool > workerPool;
+        
+        //! @brief How the workers, main and render threads are pinned.
+        ThreadConfiguration threadConfiguration;
+        
+        //! @brief Topology of the host, detected in start().
+        CpuTopology topology;
+        
+        //! @brief How MemoryPressureMonitor::Default() is started in start().
+        MemoryPressureConfiguration memoryPressureConfiguration;
+        
+        //! @brief Number of frames in the pipeline. Zero disables pipelined mode.
+        std::size_t pipelineDepth;
+        
+        //! @brief Frames handed from the simulation stage to the render stage. Created in start().
+        Handle < FramePipeline > pipeline;
+        
+        //! @brief Thread running the render stage when pipelineDepth is greater than one.
+        std::thread renderThread;
+        
+        //! @brief Index of the next simulated frame.
+        std::uint64_t frameCount;
+        
     public:
         
         /*! @brief Default constructor. */
@@ -92,9 +152,34 @@ namespace RD
          */
         virtual void run();
         
-        /*! @brief Tells the application to stop its update loop. */
+        /*! @brief Runs one tick of the update loop, without waiting. Called by run(). */
+        virtual void tick();
+        
+        /*! @brief Tells the application to stop its update loop. Can be called from any thread. */
         virtual void stop();
         
+        /*! @brief Posts work to be called on the main thread at the beginning of the next tick.
+         *
+         * Can be called from any thread. In idle mode, it also wakes up the run loop.
+         */
+        virtual void post( std::function < void() >&& work );
+        
+        /*! @brief Wakes up the run loop if it is waiting. Can be called from any thread. */
+        virtual void wake();
+        
+        /*! @brief Changes the point of the tick where deferred and coalesced events are dispatched.
+         *
+         * Events recorded in EventQueue::Default() are dispatched once per tick, on the main thread.
+         * By default, they are dispatched after modules update.
+         */
+        virtual void setEventFlushPoint( EventFlushPoint point );
+        
+        /*! @brief Returns the point of the tick where deferred and coalesced events are dispatched. */
+        virtual EventFlushPoint getEventFlushPoint() const;
+        
+        /*! @brief Returns the FrameScheduler pacing the run loop. */
+        virtual FrameScheduler& getFrameScheduler();
+        
         /*! @brief Registers a new module.
          *
          * If Application is already started, module is started immediatly. If not,
@@ -104,6 +189,13 @@ namespace RD
          */
         virtual void addModule( const Handle < Module >& module );
         
+        /*! @brief Registers a new module, like \ref addModule, but returns a kErrorHandleNotUnique error
+         * instead of throwing if it is already registered.
+         *
+         * @return The module, or the error.
+         */
+        virtual Expected < Handle < Module > > tryAddModule( const Handle < Module >& module );
+        
         /*! @brief Loads a module from a dynamic library.
          *
          * Dynamic library must have function 'CreateModule' that returns a valid Module
@@ -118,9 +210,69 @@ namespace RD
          */
         virtual Handle < Module > loadModule( const std::string& libname, bool required = false );
         
+        /*! @brief Loads a module from a dynamic library, like \ref loadModule, but returns errors instead
+         * of throwing.
+         *
+         * @param[in] libname Module's library name.
+         *
+         * @return The loaded module, a kErrorModuleNotLoaded error if it could not be loaded, or a
+         *      kErrorHandleNotUnique error if it is already registered.
+         */
+        virtual Expected < Handle < Module > > tryLoadModule( const std::string& libname );
+        
         /*! @brief Returns the default NotificationCenter. */
         virtual Handle < NotificationCenter > getNotificationCenter();
         
+        /*! @brief Returns the TimerWheel advanced by the run loop.
+         *
+         * Modules that need to run something after a delay or periodically should schedule a timer here
+         * instead of comparing Clock::now() in their update. Callbacks can be dispatched on the main thread,
+         * or on the Application's WorkerPool.
+         */
+        virtual TimerWheel& getTimerWheel();
+        
+        /*! @brief Returns the WorkerPool shared by the engine. Invalid before start() and after terminate(). */
+        virtual Handle < WorkerPool > getWorkerPool();
+        
+        /*! @brief Changes the threads configuration.
+         *
+         * Must be called before start(). The main thread is pinned in start() if configuration.mainCpu is
+         * not negative, and WorkerPool's threads are pinned according to configuration.workerPolicy.
+         */
+        virtual void setThreadConfiguration( const ThreadConfiguration& configuration );
+        
+        /*! @brief Returns the threads configuration. */
+        virtual const ThreadConfiguration& getThreadConfiguration() const;
+        
+        /*! @brief Returns the CPU topology detected in start(). Empty before start(). */
+        virtual const CpuTopology& getCpuTopology() const;
+        
+        /*! @brief Changes how memory pressure is watched.
+         *
+         * Must be called before start(), which starts MemoryPressureMonitor::Default() with this configuration.
+         * Pressures are dispatched to the reclaimers at the beginning of each tick, after the work posted to
+         * the main thread, and the monitor is stopped in terminate(), or when run() exits by an exception.
+         */
+        virtual void setMemoryPressureConfiguration( const MemoryPressureConfiguration& configuration );
+        
+        /*! @brief Returns how memory pressure is watched. */
+        virtual const MemoryPressureConfiguration& getMemoryPressureConfiguration() const;
+        
+        /*! @brief Enables pipelined mode.
+         *
+         * Must be called before start(). With a depth of zero (the default), run() calls the delegate's update
+         * functions and the modules update only. With a depth of one, each tick also calls onApplicationSimulate()
+         * then onApplicationRender() on the main thread. With a greater depth, onApplicationRender() is called on
+         * a render thread (pinned to ThreadConfiguration::renderCpu if set), and the main thread can simulate up
+         * to depth - 1 frames ahead of the rendered one.
+         *
+         * @param[in] depth Number of frames in the pipeline. 2 is double buffering, 3 triple buffering.
+         */
+        virtual void setPipelineDepth( std::size_t depth );
+        
+        /*! @brief Returns the number of frames in the pipeline. */
+        virtual std::size_t getPipelineDepth() const;
+        
         /*! @brief Finds the module which name is exactly the string given.
          *
          * @param[in] name Main module name. This is not the complete module name.
@@ -133,6 +285,18 @@ namespace RD
         
         /*! @brief Terminates the application. */
         virtual void terminate();
+        
+    private:
+        
+        /*! @brief Fills the next frame of the pipeline, and renders it when the pipeline has a depth of one. */
+        void simulate();
+        
+        /*! @brief Main function of the render thread. */
+        void render();
+        
+        /*! @brief Closes the pipeline and joins the render thread. Does nothing if they are already
+         * stopped. */
+        void stopRenderStage();
     };
 }
 
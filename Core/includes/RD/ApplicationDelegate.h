@@ -10,6 +10,7 @@
 #define ApplicationDelegate_h
 
 #include "Global.h"
+#include "FramePipeline.h"
 
 namespace RD
 {
@@ -46,12 +47,54 @@ namespace RD
          */
         virtual void onApplicationWillUpdate( Application& application, const Clock::time_point& now ) { }
         
+        /*! @brief Called for each fixed step, after onApplicationWillUpdate() and before modules update.
+         *
+         * Only called when a fixed timestep is set on the Application's FrameScheduler. It can be called
+         * several times per frame to catch up, or not at all.
+         *
+         * @param[in] application Application that called this function.
+         * @param[in] now Time point of when this function is called.
+         * @param[in] step Duration of the fixed step.
+         */
+        virtual void onApplicationFixedUpdate( Application& application, const Clock::time_point& now, const Clock::duration& step ) { }
+        
         /*! @brief Called after application updated.
          * @param[in] application Application that called this function.
          * @param[in] now Time point of when this function is called.
          */
         virtual void onApplicationDidUpdate( Application& application, const Clock::time_point& now ) { }
         
+        /*! @brief Called in start() to create the frames of the pipeline, when pipelined mode is enabled
+         * with \ref Application::setPipelineDepth. Called once for each frame of the pipeline.
+         *
+         * @param[in] application Application that called this function.
+         *
+         * @return A new FrameData, usually a derived class holding what the render stage needs.
+         */
+        virtual Handle < FrameData > onApplicationCreateFrameData( Application& application ) { return CreateHandle < FrameData >(); }
+        
+        /*! @brief Called on the main thread, after modules update, to fill the next frame of the pipeline.
+         *
+         * Only called in pipelined mode. The frame is not used by the render stage while this function runs.
+         *
+         * @param[in] application Application that called this function.
+         * @param[in] now Time point of when this function is called.
+         * @param[in] frame Frame to fill.
+         */
+        virtual void onApplicationSimulate( Application& application, const Clock::time_point& now, FrameData& frame ) { }
+        
+        /*! @brief Called by the render stage to render a frame filled by onApplicationSimulate().
+         *
+         * Only called in pipelined mode. With a depth of 1, it is called on the main thread right after
+         * onApplicationSimulate(). With a greater depth, it is called on the render thread while the main
+         * thread simulates the next frames, so it must only read the frame and thread-safe objects.
+         *
+         * @param[in] application Application that called this function.
+         * @param[in] now Time point of when this function is called.
+         * @param[in] frame Frame to render.
+         */
+        virtual void onApplicationRender( Application& application, const Clock::time_point& now, const FrameData& frame ) { }
+        
         /*! @brief Called before application terminates.
          * @param[in] application Application that called this function.
          * @param[in] now Time point of when this function is called.
@@ -0,0 +1,156 @@
+//
+//  CommandBuffer.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef CommandBuffer_h
+#define CommandBuffer_h
+
+#include "Global.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Header of a command recorded in a CommandBuffer, followed by its payload.
+     */
+    struct CommandHeader
+    {
+        //! @brief Type of the command, interpreted by the Driver executing it.
+        std::uint32_t type;
+
+        //! @brief Size of the payload in bytes, without padding.
+        std::uint32_t size;
+    };
+
+    /**
+     * @brief Commands recorded by one thread, in linear memory, and executed later by a Driver.
+     *
+     * A command is a type and a trivially copyable payload, copied after its header in a contiguous
+     * buffer. Recording never locks: a CommandBuffer belongs to the thread recording it until it is
+     * submitted to a CommandQueue. Buffers are acquired from and recycled by their CommandQueue, so once
+     * buffers have grown to the size of a frame, recording does not allocate.
+     *
+     * Buffers of a frame are executed by increasing \ref order, then in submission order.
+     *
+     * @code
+     * auto buffer = driver.getCommandQueue().acquire(pass);
+     * buffer->record(kDrawCommand, DrawCommand { mesh, material, count });
+     * driver.getCommandQueue().submit(std::move(buffer));
+     * @endcode
+     */
+    class CommandBuffer
+    {
+        friend class CommandQueue;
+        friend class DriverCapture;
+        friend class CaptureReplayer;
+
+        //! @brief Alignment of headers and payloads.
+        static constexpr std::size_t kAlignment = 8;
+
+        //! @brief Recorded commands.
+        std::vector < unsigned char > data;
+
+        //! @brief Order of the buffer in its frame.
+        std::uint32_t bufferOrder = 0;
+
+        //! @brief Submission sequence, set by CommandQueue::submit.
+        std::uint64_t sequence = 0;
+
+        //! @brief Number of recorded commands.
+        std::size_t count = 0;
+
+        //! @brief Next buffer in CommandQueue's submission list.
+        CommandBuffer* next = nullptr;
+
+    public:
+
+        /*! @brief Constructs an empty buffer. */
+        explicit CommandBuffer(std::uint32_t order = 0) noexcept : bufferOrder(order) {}
+
+        /*! @brief Records a command with an uninitialized payload of size bytes.
+         * @return The payload, valid until the next command is recorded.
+         */
+        void* allocate(std::uint32_t type, std::uint32_t size)
+        {
+            std::size_t offset = data.size();
+            data.resize(offset + sizeof(CommandHeader) + Align(size));
+
+            CommandHeader header { type, size };
+            std::memcpy(data.data() + offset, &header, sizeof(header));
+
+            count++;
+            return data.data() + offset + sizeof(CommandHeader);
+        }
+
+        /*! @brief Records a command with a copy of payload. */
+        template < typename T >
+        void record(std::uint32_t type, const T& payload)
+        {
+            static_assert(std::is_trivially_copyable_v < T >, "Command payloads are copied as bytes.");
+            static_assert(alignof(T) <= kAlignment, "Command payloads are aligned on 8 bytes.");
+
+            std::memcpy(allocate(type, static_cast < std::uint32_t >(sizeof(T))), &payload, sizeof(T));
+        }
+
+        /*! @brief Records a command without payload. */
+        void record(std::uint32_t type)
+        {
+            allocate(type, 0);
+        }
+
+        /*! @brief Calls func(const CommandHeader& header, const void* payload) for every command, in
+         * recording order. */
+        template < typename Func >
+        void forEach(Func&& func) const
+        {
+            const unsigned char* it = data.data();
+            const unsigned char* end = it + data.size();
+
+            while (it < end)
+            {
+                const CommandHeader& header = *reinterpret_cast < const CommandHeader* >(it);
+                func(header, static_cast < const void* >(it + sizeof(CommandHeader)));
+                it += sizeof(CommandHeader) + Align(header.size);
+            }
+        }
+
+        /*! @brief Removes every command, keeping the memory. */
+        void reset() noexcept
+        {
+            data.clear();
+            count = 0;
+        }
+
+        /*! @brief Returns the order of the buffer in its frame. */
+        std::uint32_t order() const noexcept { return bufferOrder; }
+
+        /*! @brief Sets the order of the buffer in its frame. */
+        void setOrder(std::uint32_t order) noexcept { bufferOrder = order; }
+
+        /*! @brief Returns the number of recorded commands. */
+        std::size_t size() const noexcept { return count; }
+
+        /*! @brief Returns true if no command is recorded. */
+        bool empty() const noexcept { return count == 0; }
+
+        /*! @brief Returns the number of bytes used by recorded commands. */
+        std::size_t bytes() const noexcept { return data.size(); }
+
+    private:
+
+        /*! @brief Rounds size up to kAlignment. */
+        static constexpr std::size_t Align(std::size_t size) noexcept
+        {
+            return (size + kAlignment - 1) & ~(kAlignment - 1);
+        }
+    };
+}
+
+#endif /* CommandBuffer_h */
@@ -0,0 +1,140 @@
+//
+//  CommandQueue.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef CommandQueue_h
+#define CommandQueue_h
+
+#include "Global.h"
+#include "CommandBuffer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <thread>
+
+namespace RD
+{
+    class Driver;
+
+    /**
+     * @brief Collects the CommandBuffers of a Driver and executes them, frame by frame, on its own thread.
+     *
+     * Any number of threads acquire buffers with \ref acquire, record commands into them without locking,
+     * and \ref submit them. Submitting is lock-free: buffers are pushed onto an atomic list, with a
+     * sequence number giving their submission order.
+     *
+     * \ref present closes the current frame: its buffers are sorted by CommandBuffer::order, then by
+     * submission order, and handed to the execution thread, which calls Driver::executeCommand for each of
+     * their commands, or Driver::executeDrawItems for the draws recorded by a RenderQueue. Frames are
+     * executed in the order they were presented, and executed buffers are recycled by \ref acquire. The
+     * execution thread is started by the first frame presented.
+     *
+     * Commands are defined by each driver: NullDriver, SoftDriver and Gl3Driver execute theirs.
+     *
+     * @note
+     * The queue must be stopped with \ref stop while its driver is still alive, as the execution thread
+     * calls its driver.
+     */
+    class CommandQueue
+    {
+        /*! @brief Buffers of a presented frame, in execution order. */
+        struct Frame
+        {
+            //! @brief Buffers.
+            std::vector < std::unique_ptr < CommandBuffer > > buffers;
+        };
+
+        //! @brief Driver executing the commands.
+        Driver& driver;
+
+        //! @brief Buffers submitted since the last present, last submitted first.
+        std::atomic < CommandBuffer* > submitted { nullptr };
+
+        //! @brief Next submission sequence.
+        std::atomic < std::uint64_t > sequence { 0 };
+
+        //! @brief Executed buffers, ready to be acquired again.
+        std::vector < std::unique_ptr < CommandBuffer > > freeBuffers;
+
+        //! @brief Mutex protecting freeBuffers.
+        std::mutex freeMutex;
+
+        //! @brief Frames presented and not executed yet.
+        std::deque < Frame > frames;
+
+        //! @brief Number of frames presented.
+        std::uint64_t presented = 0;
+
+        //! @brief Number of frames executed.
+        std::uint64_t executed = 0;
+
+        //! @brief True from the beginning of \ref stop until its execution thread is joined.
+        bool stopping = false;
+
+        //! @brief Mutex protecting frames, the counters, stopping and thread.
+        mutable std::mutex framesMutex;
+
+        //! @brief Signals a new frame, or stopping, to the execution thread.
+        std::condition_variable framesCondition;
+
+        //! @brief Signals an executed frame to \ref wait.
+        std::condition_variable executedCondition;
+
+        //! @brief Signals the end of \ref stop to \ref present and other stop calls.
+        std::condition_variable stoppedCondition;
+
+        //! @brief Execution thread.
+        std::thread thread;
+
+    public:
+
+        /*! @brief Constructs a queue executing its commands with a driver. */
+        explicit CommandQueue(Driver& driver) noexcept;
+
+        /*! @brief Stops the queue. */
+        ~CommandQueue();
+
+        CommandQueue(const CommandQueue&) = delete;
+        CommandQueue& operator = (const CommandQueue&) = delete;
+
+        /*! @brief Returns an empty buffer, recycled when possible.
+         * @param[in] order Order of the buffer in its frame.
+         */
+        std::unique_ptr < CommandBuffer > acquire(std::uint32_t order = 0);
+
+        /*! @brief Submits a buffer to the current frame. Never locks. Empty buffers are accepted. */
+        void submit(std::unique_ptr < CommandBuffer > buffer);
+
+        /*! @brief Closes the current frame and hands it to the execution thread. Does not wait for its
+         * execution, but waits for a concurrent \ref stop to return. Submissions racing with present belong
+         * to this frame or to the next one. */
+        void present();
+
+        /*! @brief Blocks until every frame presented has been executed. */
+        void wait();
+
+        /*! @brief Executes every frame presented, then stops the execution thread. Buffers submitted
+         * but not presented are dropped. The queue can be used again after. */
+        void stop();
+
+        /*! @brief Returns the number of frames presented. */
+        std::uint64_t presentedFrames() const;
+
+        /*! @brief Returns the number of frames executed. */
+        std::uint64_t executedFrames() const;
+
+    private:
+
+        /*! @brief Loop of the execution thread. */
+        void run();
+
+        /*! @brief Executes every command of a frame, and recycles its buffers. */
+        void execute(Frame& frame);
+    };
+}
+
+#endif /* CommandQueue_h */
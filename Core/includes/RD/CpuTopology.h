@@ -0,0 +1,162 @@
+//
+//  CpuTopology.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef CpuTopology_h
+#define CpuTopology_h
+
+#include "Global.h"
+
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Describes one logical CPU (a hardware thread).
+     */
+    struct CpuInfo
+    {
+        //! @brief Logical CPU number, as used by the operating system.
+        int id = 0;
+
+        //! @brief Physical core identifier, unique in the whole system. SMT siblings share it.
+        int core = 0;
+
+        //! @brief Physical package (socket) identifier.
+        int package = 0;
+
+        //! @brief NUMA node of this CPU.
+        int node = 0;
+
+        //! @brief Identifier of the L3 cache domain, which is the lowest CPU id sharing this L3 cache.
+        int l3 = 0;
+    };
+
+    /**
+     * @brief How worker threads are pinned to CPUs.
+     */
+    enum class AffinityPolicy
+    {
+        //! @brief Threads are not pinned, the operating system schedules them freely.
+        None,
+
+        //! @brief Threads are packed on the fewest cores, L3 domains and nodes possible, SMT siblings
+        //! first. Best when workers share a lot of data.
+        Compact,
+
+        //! @brief Threads are spread round-robin over NUMA nodes and L3 domains, one thread per physical
+        //! core before using SMT siblings. Best for memory bandwidth.
+        Scatter,
+
+        //! @brief One thread per physical core, ordered by node. SMT siblings are used only when there are
+        //! more threads than physical cores.
+        PhysicalCores
+    };
+
+    /**
+     * @brief Configuration of the threads started by the Application.
+     *
+     * Must be given to \ref Application::setThreadConfiguration before \ref Application::start.
+     */
+    struct ThreadConfiguration
+    {
+        //! @brief Policy used to pin WorkerPool's threads.
+        AffinityPolicy workerPolicy = AffinityPolicy::None;
+
+        //! @brief Number of workers. Zero starts one worker per available CPU (CPUs not reserved).
+        std::size_t workerCount = 0;
+
+        //! @brief If not negative, workers are restricted to this NUMA node.
+        int workerNode = -1;
+
+        //! @brief If not negative, the main thread is pinned to this CPU and its physical core is reserved.
+        int mainCpu = -1;
+
+        //! @brief If not negative, the render thread is pinned to this CPU and its physical core is reserved.
+        int renderCpu = -1;
+
+        //! @brief Size of each chunk allocated by worker's NodeArena. Zero disables worker arenas.
+        std::size_t arenaChunkSize = 1 << 20;
+    };
+
+    /**
+     * @brief CPU topology of the host: cores, SMT siblings, NUMA nodes and L3 domains.
+     *
+     * On Linux, the topology is read from '/sys/devices/system/cpu' and '/sys/devices/system/node'. On other
+     * platforms, or if those directories are not readable (like in some containers), every logical CPU is
+     * considered as its own core on node 0.
+     */
+    class CpuTopology
+    {
+        //! @brief Online CPUs, sorted by id.
+        std::vector < CpuInfo > cpuList;
+
+    public:
+
+        /*! @brief Default constructor. (Empty topology) */
+        CpuTopology() = default;
+
+        /*! @brief Detects the topology of the host.
+         *
+         * @param[in] root Root of the sysfs 'system' directory. It can be changed to read a topology
+         *      saved from another host.
+         */
+        static CpuTopology Detect(const std::string& root = "/sys/devices/system");
+
+        /*! @brief Returns online CPUs, sorted by id. */
+        const std::vector < CpuInfo >& cpus() const;
+
+        /*! @brief Returns the CpuInfo of the given CPU, or nullptr if it is not online. */
+        const CpuInfo* find(int cpu) const;
+
+        /*! @brief Returns the number of physical cores. */
+        std::size_t coreCount() const;
+
+        /*! @brief Returns the number of NUMA nodes. */
+        std::size_t nodeCount() const;
+
+        /*! @brief Returns the number of L3 cache domains. */
+        std::size_t l3Count() const;
+
+        /*! @brief Returns the NUMA node of the given CPU, or 0 if unknown. */
+        int nodeOf(int cpu) const;
+
+        /*! @brief Returns every CPU sharing the physical core of the given CPU, including itself. */
+        std::vector < int > siblingsOf(int cpu) const;
+
+        /*! @brief Selects one CPU per thread according to a policy.
+         *
+         * @param[in] policy Policy to apply. AffinityPolicy::None returns an empty list.
+         * @param[in] count Number of threads. If zero, one thread per CPU available.
+         * @param[in] node If not negative, only CPUs of this node are selected.
+         * @param[in] reserved CPUs which physical cores must not be selected (like the main thread's CPU).
+         *
+         * @return A list of CPUs, where element i is the CPU for thread i. If count is greater than the
+         *      number of CPUs available, CPUs are used more than once.
+         */
+        std::vector < int > select(AffinityPolicy policy, std::size_t count, int node = -1, const std::vector < int >& reserved = {}) const;
+
+    public:
+
+        /*! @brief Pins a thread to a set of CPUs.
+         * @return True on success. Always false on platforms without thread affinity.
+         */
+        static bool PinThread(std::thread& thread, const std::vector < int >& cpus);
+
+        /*! @brief Pins the calling thread to a set of CPUs.
+         * @return True on success. Always false on platforms without thread affinity.
+         */
+        static bool PinCurrentThread(const std::vector < int >& cpus);
+
+        /*! @brief Returns the CPU the calling thread is running on, or -1 if unknown. */
+        static int CurrentCpu();
+    };
+
+    /*! @brief Parses a sysfs CPU list (like '0-3,8,10-11') into a list of CPUs. */
+    std::vector < int > ParseCpuList(const std::string& list);
+}
+
+#endif /* CpuTopology_h */
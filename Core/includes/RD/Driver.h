@@ -16,6 +16,12 @@
 #include "Emitter.h"
 #include "SurfaceObserver.h"
 #include "Module.h"
+#include "ResourceRegistry.h"
+#include "CommandQueue.h"
+#include "RenderQueue.h"
+#include "DriverCapture.h"
+
+#include <deque>
 
 namespace RD
 {
@@ -74,18 +80,130 @@ namespace RD
         
         /*! @brief Called after a driver did clear its resources. */
         virtual void onDriverDidClear(const Driver*) {}
+        
+        /*! @brief Called when the memory usage of a kind goes over its budget (see Driver::setMemoryBudget),
+         * after kDriverMemoryBudgetExceededNotification. Observers may evict resources, whose memory is freed
+         * once they are released. Called once until the usage goes back under the budget.
+         */
+        virtual void onDriverMemoryBudgetExceeded(Driver* driver, MemoryKind kind, std::uint64_t usage, std::uint64_t budget) {}
+    };
+    
+    /**
+     * @brief DriverObserver events as Signals.
+     *
+     * Any class implementing DriverObserver's functions can be connected with \ref connect. See ModuleSignals.
+     */
+    struct DriverSignals
+    {
+        Signal < const Driver*, const Surface* > createsSurface;
+        Signal < const Driver* > willClear;
+        Signal < const Driver* > didClear;
+        Signal < Driver*, MemoryKind, std::uint64_t, std::uint64_t > memoryBudgetExceeded;
+        
+        /*! @brief Connects every DriverObserver function of an observer. */
+        template < typename Observer >
+        void connect(Observer* observer)
+        {
+            createsSurface.connect(observer, [](void* o, const Driver* d, const Surface* s){ static_cast < Observer* >(o)->onDriverCreatesSurface(d, s); });
+            willClear.connect(observer, [](void* o, const Driver* d){ static_cast < Observer* >(o)->onDriverWillClear(d); });
+            didClear.connect(observer, [](void* o, const Driver* d){ static_cast < Observer* >(o)->onDriverDidClear(d); });
+            memoryBudgetExceeded.connect(observer, [](void* o, Driver* d, MemoryKind k, std::uint64_t u, std::uint64_t b){ static_cast < Observer* >(o)->onDriverMemoryBudgetExceeded(d, k, u, b); });
+        }
+        
+        /*! @brief Disconnects every function of an observer. */
+        void disconnect(const void* observer)
+        {
+            createsSurface.disconnect(observer);
+            willClear.disconnect(observer);
+            didClear.disconnect(observer);
+            memoryBudgetExceeded.disconnect(observer);
+        }
     };
     
     /** @defgroup DriverNotifications
      * @{
      */
     
-    static constexpr const char* kDriverInvalidSurfaceCreationNotification = "DriverInvalidSurfaceCreationNotification";
-    static constexpr const char* kDriverSurfaceCreatedNotification = "DriverSurfaceCreatedNotification";
-    static constexpr const char* kDriverDidClearNotification = "DriverDidClearNotification";
+    static constexpr HashedString kDriverInvalidSurfaceCreationNotification = "DriverInvalidSurfaceCreationNotification";
+    static constexpr HashedString kDriverSurfaceCreatedNotification = "DriverSurfaceCreatedNotification";
+    static constexpr HashedString kDriverDidClearNotification = "DriverDidClearNotification";
+    static constexpr HashedString kDriverMemoryBudgetExceededNotification = "DriverMemoryBudgetExceededNotification";
      
     /** @} */
     
+    /**
+     * @brief A thread using the resources of a Driver, like a render thread, which fences their destruction.
+     *
+     * A reader locks itself while it may use resources of its driver (typically for a whole frame), and
+     * unlocks itself when done; std::lock_guard < DriverEpochReader > can be used. Resources retired by
+     * the driver while a reader is locked are not destroyed before the reader unlocks. An unlocked reader
+     * does not delay any destruction.
+     *
+     * @note
+     * A reader must be destroyed, unlocked, before its driver.
+     */
+    class DriverEpochReader
+    {
+        friend class Driver;
+        
+        //! @brief Driver read.
+        Driver& driver;
+        
+        //! @brief Epoch of the driver observed when locked, or zero when unlocked.
+        std::atomic < std::uint64_t > observed { 0 };
+        
+    public:
+        
+        /*! @brief Registers a reader of driver. */
+        explicit DriverEpochReader(Driver& driver);
+        
+        /*! @brief Unregisters the reader. */
+        ~DriverEpochReader();
+        
+        DriverEpochReader(const DriverEpochReader&) = delete;
+        DriverEpochReader& operator = (const DriverEpochReader&) = delete;
+        
+        /*! @brief Enters the current epoch of the driver. */
+        void lock();
+        
+        /*! @brief Leaves the epoch entered by \ref lock. */
+        void unlock();
+    };
+    
+    /**
+     * @brief Resources waiting for their destruction in a Driver. See Driver::releaseStats.
+     */
+    struct DriverReleaseStats
+    {
+        /*! @brief Resources retired during one epoch. */
+        struct Bucket
+        {
+            //! @brief Epoch of the driver when the resources were retired.
+            std::uint64_t epoch = 0;
+            
+            //! @brief Number of resources.
+            std::size_t count = 0;
+            
+            //! @brief Sum of the resources' DriverResource::memorySize.
+            std::size_t bytes = 0;
+        };
+        
+        //! @brief Buckets waiting for readers to leave their epoch, oldest first.
+        std::vector < Bucket > buckets;
+        
+        //! @brief Number of resources whose epoch is over, but which are still locked.
+        std::size_t pinnedCount = 0;
+        
+        //! @brief Memory held by pinned resources.
+        std::size_t pinnedBytes = 0;
+        
+        //! @brief Number of resources waiting, pinned included.
+        std::size_t pendingCount = 0;
+        
+        //! @brief Memory held by resources waiting, pinned included.
+        std::size_t pendingBytes = 0;
+    };
+    
     /**
      * @brief Generic interface for a Graphic API wrapper.
      *
@@ -93,8 +211,17 @@ namespace RD
      * has many functions like handling Windows (or Surfaces) creation, handling buffers swaps,
      * and creation of most of the objects related to the graphic pipeline.
      *
-     * A Driver has one or more CommandQueues. Those queues can be commited to the graphic pipeline
-     * whenever you want, and the commands commited will be executed after a call to 'present()'.
+     * A Driver has a CommandQueue (see \ref getCommandQueue). Any thread records commands in CommandBuffers
+     * and submits them to the queue whenever it wants; the commands submitted are executed after a call to
+     * \ref present, by the queue's thread, which calls \ref executeCommand for each of them.
+     *
+     * Draws are submitted to its RenderQueue (see \ref getRenderQueue) with a DrawKey. \ref present sorts them
+     * by key, and the queue's thread hands them to \ref executeDrawItems in that order, which minimizes the
+     * state changes of the Driver.
+     *
+     * A Driver can capture what it is submitted (see \ref startCapture): surfaces and resources created and
+     * destroyed, surfaces events, and the command buffers of each frame presented, into a file which a
+     * CaptureReplayer (or the rdreplay tool) replays later against any driver.
      *
      * @note
      * Driver can only be created by Modules, as they always implie some platform-dependent or API-dependent
@@ -102,10 +229,20 @@ namespace RD
      * module and load it with \ref Application::addModule.
      *
      * Driver does a kind of garbage collection with DriverResources. When a resource is about to be destroyed,
-     * as other threads might use them (like Surface) or did not finish their tasks, the resource is sent into
-     * a later released queue. At \ref onModuleDidUpdate, the queue is popped from all the resources untill one
-     * has its used flag set. DriverResource's users have the responsability to lock and unlock the resource
-     * (which set and unset this flag) to tell the Driver if it can destroy the Handle or not.
+     * as other threads might use them (like Surface) or did not finish their tasks, it is retired (see
+     * \ref retire) in the bucket of the driver's current epoch. The epoch advances at each \ref onModuleDidUpdate,
+     * which then releases every bucket older than the epoch of all locked DriverEpochReaders. A resource of
+     * such a bucket which is still locked (see DriverResource::lock) is pinned and released at a later update,
+     * without delaying the others. \ref releaseStats returns the resources still waiting. Retired resources
+     * are also a reclaimer of MemoryPressureMonitor::Default(), with priority MemoryReclaimPriority::Unused:
+     * under memory pressure, the epoch advances and they are released without waiting for the next update.
+     *
+     * Driver accounts the memory of its resources by MemoryKind (see DriverResource::memorySize and
+     * DriverResource::memoryKind), from their registration to their release: retired resources are still
+     * accounted. Each kind can have a budget (see \ref setMemoryBudget); when accounting a resource makes the
+     * usage go over it, kDriverMemoryBudgetExceededNotification is notified and
+     * DriverObserver::onDriverMemoryBudgetExceeded is emitted, letting the application evict resources. They
+     * are notified again only once the usage went back under the budget.
      *
      * A Surface doesn't need any locking, apart when the surface is closing. Surface may lock itself untill it
      * is closed and unlock itself when its done.
@@ -117,8 +254,8 @@ namespace RD
          * @brief Helper to be notifiated when a Surface is closed.
          *
          * Registered for each surface created. When a surface closes, it calls onSurfaceWillClose
-         * which makes us remove the surface from the surface's list. Resource is moved to a later released
-         * queue, released when module calls \ref ModuleListener::onModuleUpdate.
+         * which makes us remove the surface from the surface's list. Resource is retired, and released by a
+         * later call to \ref ModuleListener::onModuleDidUpdate.
          *
          * @note
          * If you want the surface to be completly destroyed, you can still make your own observer and
@@ -139,38 +276,127 @@ namespace RD
             /*! @brief Default destructor. */
             ~SurfaceHelper() noexcept = default;
             
-            /*! @brief Removes the surface from the driver's list and append the handle for later release. */
+            /*! @brief Removes the surface from the driver's list and retires it. */
             void onSurfaceWillClose(const Surface*);
+            
+            /*! @brief Captures the move if the driver is capturing. */
+            void onSurfaceDidMove(const Surface*, const ScreenPosition&);
+            
+            /*! @brief Captures the resize if the driver is capturing. */
+            void onSurfaceDidResize(const Surface*, const RectSize&);
+            
+            /*! @brief Captures the hide if the driver is capturing. */
+            void onSurfaceWillHide(const Surface*);
+            
+            /*! @brief Captures the unhide if the driver is capturing. */
+            void onSurfaceUnhide(const Surface*);
+            
+            /*! @brief Captures the focus lock if the driver is capturing. */
+            void onSurfaceLockFocus(const Surface*);
         };
         
         // Makes it a friend because we own this class.
         friend class SurfaceHelper;
         
-        //! @brief Resources created by this Driver.
-        std::map < HashedString, Handle < DriverResource > > resources;
+        //! @brief Resources and surfaces created by this Driver.
+        ResourceRegistry registry;
         
-        //! @brief Surfaces handled by the Driver.
-        std::map < HashedString, Handle < Surface > > surfaces;
-        
-        //! @brief Mutex to lock when accessing data.
+        //! @brief Mutex serializing surfaces creation.
         mutable std::mutex mutex;
         
         //! @brief Helper to destroy closed surfaces.
         SurfaceHelper surfaceHelper;
         
-        //! @brief An array of DriverResource to be destroyed at next update.
-        std::queue < Handle < DriverResource > > laterReleaseQueue;
+        // Makes it a friend to let readers observe the epoch.
+        friend class DriverEpochReader;
+        
+        /*! @brief A resource waiting for its destruction. */
+        struct RetiredResource
+        {
+            //! @brief The resource.
+            Handle < DriverResource > resource;
+            
+            //! @brief Its memory size, when it was retired.
+            std::size_t bytes;
+        };
+        
+        /*! @brief Resources retired during one epoch. */
+        struct RetiredBucket
+        {
+            //! @brief Epoch of the driver when the resources were retired.
+            std::uint64_t epoch;
+            
+            //! @brief Retired resources.
+            std::vector < RetiredResource > resources;
+            
+            //! @brief Sum of the resources' sizes.
+            std::size_t bytes;
+        };
+        
+        //! @brief Current epoch, advanced after each module update. Starts at 1, as readers use zero
+        //! when unlocked.
+        std::atomic < std::uint64_t > epoch { 1 };
+        
+        //! @brief Buckets of retired resources, oldest first.
+        std::deque < RetiredBucket > retiredBuckets;
+        
+        //! @brief Resources of released buckets which were still locked.
+        std::vector < RetiredResource > pinnedResources;
+        
+        //! @brief Mutex protecting retiredBuckets and pinnedResources.
+        mutable std::mutex releaseMutex;
+        
+        //! @brief Identifier of the retired resources' reclaimer in MemoryPressureMonitor::Default().
+        std::uint64_t reclaimerId = 0;
+        
+        //! @brief Readers of this driver.
+        std::vector < DriverEpochReader* > readers;
+        
+        //! @brief Mutex protecting readers.
+        mutable std::mutex readersMutex;
+        
+        // Makes it a friend to let the queue execute commands.
+        friend class CommandQueue;
+        
+        //! @brief Queue of the command buffers submitted to this driver.
+        CommandQueue commandQueue;
         
-        //! @brief Mutex to access later release queue.
-        mutable std::mutex lrqMutex;
+        //! @brief Queue of the draws submitted to this driver, flushed into commandQueue.
+        RenderQueue renderQueue;
+        
+        // Makes it a friend to let captures be replayed.
+        friend class CaptureReplayer;
+        
+        //! @brief Capture in progress, or null.
+        std::unique_ptr < DriverCapture > capture;
+        
+        //! @brief True while capture is not null. Read without locking by every function capturing.
+        std::atomic < bool > capturing { false };
+        
+        //! @brief Mutex protecting capture, and serializing its records.
+        std::mutex captureMutex;
+        
+        //! @brief Bytes held by registered and retired resources, by MemoryKind.
+        std::atomic < std::uint64_t > memoryUsages[kMemoryKindCount] {};
+        
+        //! @brief Budgets by MemoryKind, zero for none.
+        std::atomic < std::uint64_t > memoryBudgets[kMemoryKindCount] {};
+        
+        //! @brief True while the usage of a MemoryKind is over its budget, once notified.
+        std::atomic < bool > budgetsExceeded[kMemoryKindCount] {};
         
     public:
         
         /*! @brief Default constructor. */
         Driver() noexcept;
         
-        /*! @brief Default destructor. */
-        virtual ~Driver() noexcept = default;
+        /*! @brief Stops the command queue.
+         *
+         * @note
+         * A derived driver overriding \ref executeCommand must stop the queue in its own destructor, as
+         * the queue's thread may still be executing commands.
+         */
+        virtual ~Driver() noexcept;
         
         /*! @brief Returns the driver's name. */
         virtual const std::string name() const noexcept = 0;
@@ -189,27 +415,49 @@ namespace RD
          * @param[in] objectName Name for this surface.
          * @param[in] style Style used to create the surface, applicable if it is a Window.
          * @param[in] extension A custom structure for platform-dependent configuration.
+         *
+         * @return The surface, or an invalid handle if the driver could not create it.
+         * @throw AbortRequestedException if the surface could not be created and an observer of
+         *      kDriverInvalidSurfaceCreationNotification requested an abort.
          */
         Handle < Surface > createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style = SurfaceStyle::Default, const void* extension = nullptr);
         
-        /*! @brief Copies the surface's list to be accessed by a derived class.
+        /*! @brief Creates a surface, like \ref createSurface, but returns errors instead of throwing.
          *
-         * As this might seems a slow operation, this lets us locking the internal data and
-         * copy it into a new map. Derived classes can then access this array freely.
+         * @return The surface, a kErrorSurfaceNotCreated error if the driver could not create it, or a
+         *      kErrorAbortRequested error if an observer of kDriverInvalidSurfaceCreationNotification
+         *      requested an abort.
+         */
+        Expected < Handle < Surface > > tryCreateSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style = SurfaceStyle::Default, const void* extension = nullptr);
+        
+        /*! @brief Copies the surface's list.
          *
-         * @sa lockResources(), unlockResources().
+         * Every handle is copied: prefer \ref forEachSurface, which visits surfaces without copying them.
          */
         std::map < HashedString, Handle < Surface > > loadSurfaces();
         
-        /*! @brief Copies the resource's list to be accessed by a derived class.
+        /*! @brief Copies the resource's list.
          *
-         * As this might seems a slow operation, this lets us locking the internal data and
-         * copy it into a new map. Derived classes can then access this array freely.
-         *
-         * @sa lockResources(), unlockResources().
+         * Every handle is copied: prefer \ref forEachResource, which visits resources without copying them.
          */
         std::map < HashedString, Handle < DriverResource > > loadResources();
         
+        /*! @brief Calls func(const HashedString& name, const Handle < DriverResource >& resource) for every
+         * resource, surfaces included, without locking nor copying. See ResourceRegistry. */
+        template < typename Func >
+        void forEachResource(Func&& func) const
+        {
+            registry.forEachResource(std::forward < Func >(func));
+        }
+        
+        /*! @brief Calls func(const HashedString& name, const Handle < Surface >& surface) for every surface,
+         * without locking nor copying. See ResourceRegistry. */
+        template < typename Func >
+        void forEachSurface(Func&& func) const
+        {
+            registry.forEachSurface(std::forward < Func >(func));
+        }
+        
         /*! @brief Clears every DriverResources created by this driver.
          *
          * Basically it only emits \ref DriverResource::onDriverClear() function to every DriverResource
@@ -224,25 +472,143 @@ namespace RD
         /*! @brief Returns the number of surfaces present. */
         std::size_t getSurfacesCount() const;
         
+        /*! @brief Returns the number of resources present, surfaces included. */
+        std::size_t getResourcesCount() const;
+        
+        /*! @brief Returns the resource with the given name, surfaces included, or an invalid handle. */
+        Handle < DriverResource > findResource(const HashedString& name) const;
+        
+        /*! @brief Retires a resource: \ref DriverResource::onDriverClear is called, and the handle released,
+         * once every DriverEpochReader locked at the current epoch has unlocked and the resource is not
+         * locked anymore. */
+        void retire(const Handle < DriverResource >& resource);
+        
+        /*! @brief Returns the current epoch of the driver. */
+        std::uint64_t releaseEpoch() const;
+        
+        /*! @brief Returns the resources waiting for their destruction, by epoch. */
+        DriverReleaseStats releaseStats() const;
+        
+        /*! @brief Returns the queue commands are submitted to. */
+        CommandQueue& getCommandQueue();
+        
+        /*! @brief Returns the queue draws are submitted to. */
+        RenderQueue& getRenderQueue();
+        
+        /*! @brief Flushes the render queue, then closes the current frame of the command queue: commands
+         * and draws submitted until now are executed by the queue's thread, in the order of their buffers.
+         * Does not wait for their execution. */
+        void present();
+        
+        /*! @brief Returns the bytes held by the resources of a kind, registered or retired and not released
+         * yet. */
+        std::uint64_t memoryUsage(MemoryKind kind) const;
+        
+        /*! @brief Returns the budget of a kind, zero if it has none. */
+        std::uint64_t memoryBudget(MemoryKind kind) const;
+        
+        /*! @brief Sets the budget of a kind, in bytes. Zero removes it (the default). If the usage is already
+         * over the new budget, observers are notified right away. */
+        void setMemoryBudget(MemoryKind kind, std::uint64_t bytes);
+        
+        /*! @brief Starts capturing into a file everything submitted to this driver, until \ref stopCapture.
+         *
+         * The surfaces and resources existing are written first, so the capture can be replayed alone.
+         * Their titles and names are not known anymore: they are named after their name's hash. Then are
+         * written, in the order they happen, surfaces created and their events, resources added and removed,
+         * and, at each \ref present, the command buffers of the frame sorted like they are executed. A capture
+         * already in progress is stopped.
+         *
+         * @note
+         * Surfaces moves and resizes are written when observers receive them, which is once per tick.
+         *
+         * @throw FileOpenException if the file can not be created.
+         */
+        void startCapture(const std::string& path);
+        
+        /*! @brief Stops the capture in progress, if any, and closes its file. */
+        void stopCapture();
+        
+        /*! @brief Returns true while capturing. */
+        bool isCapturing() const;
+        
         /*! @brief Called right after the Module has updated.
          *
-         * Tries to clear the laterReleaseQueue from its resources. Once a resource which has its used flag set
-         * is met, the function returns and other resources are not released yet.
+         * Advances the epoch, and releases every retired resource no reader can still use. Resources still
+         * locked are pinned and checked again at the next update.
          */
         virtual void onModuleDidUpdate(Module* module);
         
         /*! @brief Called right before module terminates.
          *
-         * Currently only call \ref clearResources to clear all DriverResource. Notes that if some resources
-         * are in use, they will be placed in \ref laterReleaseQueue and will be released next update time.
-         * However, as no update will be called because module is terminated, \ref laterReleaseQueue will be
-         * destroyed in destructor, thus releasing all DriverResource objects at this time. Hopefully, terminating
+         * Stops the command queue, then calls \ref clearResources to clear all DriverResource. Notes that if some resources
+         * are in use, they are retired and would be released at the next update. However, as no update will
+         * be called because module is terminated, they will be released in destructor. Hopefully, terminating
          * a module doesn't unload it (with dlclose) so code will not be broken.
          */
         virtual void onModuleWillTerminate(Module*);
         
     protected:
         
+        /*! @brief Executes a command submitted to the command queue. Called by the queue's thread only,
+         * frame by frame. Default implementation ignores every command.
+         *
+         * @param[in] header Type and size of the command.
+         * @param[in] payload Payload of the command, of header.size bytes.
+         */
+        virtual void executeCommand(const CommandHeader& header, const void* payload);
+        
+        /*! @brief Executes draws flushed by the render queue, sorted by key. Called by the command queue's
+         * thread only, instead of \ref executeCommand for kDrawItemsCommand. Default implementation ignores
+         * every draw.
+         *
+         * @param[in] items Draws, sorted by DrawItem::key.
+         * @param[in] count Number of draws.
+         */
+        virtual void executeDrawItems(const DrawItem* items, std::size_t count);
+        
+        /*! @brief Fixes a captured command before a CaptureReplayer submits it to this driver. Default
+         * implementation keeps every command as captured.
+         *
+         * A driver whose commands point to resources replaces them with the resources replaying them (see
+         * CaptureRelocator::relocate), and does what recording them would have done, like locking them.
+         * Called for every command but kDrawItemsCommand.
+         *
+         * @param[in] header Type and size of the command.
+         * @param[in, out] payload Copy of the captured payload, submitted once fixed.
+         * @param[in] relocator Resources of the replay, by identifier in the capture.
+         * @return False to skip the command, when it can not be replayed.
+         */
+        virtual bool relocateCommand(const CommandHeader& header, void* payload, const CaptureRelocator& relocator);
+        
+        /*! @brief Creates a resource replaying a captured one. Default implementation returns an invalid
+         * handle, as a Driver does not know what its resources are: captured resources are then skipped.
+         *
+         * @param[in] name Name of the captured resource.
+         * @param[in] memorySize Its DriverResource::memorySize when captured.
+         * @param[in] kind Its DriverResource::memoryKind when captured.
+         * @return The resource, registered with \ref addResource, or an invalid handle.
+         */
+        virtual Handle < DriverResource > createReplayResource(const std::string& name, std::size_t memorySize, MemoryKind kind);
+        
+        /*! @brief Registers a resource created by a derived driver, so it is visited, counted, accounted and
+         * cleared like surfaces.
+         *
+         * @return False if a resource with the same name is already registered.
+         */
+        bool addResource(const HashedString& name, const Handle < DriverResource >& resource);
+        
+        /*! @brief Accounts again the memory of a registered resource whose DriverResource::memorySize
+         * changed. Surfaces are accounted again when they resize. Does nothing once the resource is released.
+         */
+        void updateMemoryUsage(const DriverResource* resource);
+        
+        /*! @brief Unregisters a resource added with \ref addResource and retires it (see \ref retire).
+         *
+         * @return False if the resource was not registered.
+         */
+        bool removeResource(const DriverResource* resource);
+        
         /*! @brief Virtual method to override to create the surface handle.
          *
          * Derived class can use this method to create the custom Surface class depending
@@ -258,30 +624,34 @@ namespace RD
          *
          * @return a Handle to the newly created surface.
          */
-        virtual Handle < Surface > _createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const;
+        virtual Handle < Surface > _createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const = 0;
         
-        /*! @brief Locks the data mutex to access resource's map.
-         *
-         * \ref unlockResources must be called after accessing data to unlock the internal
-         * mutex. It can be used as a faster solution than \ref loadSurfaces or \ref loadResources.
-         * However, if \ref unlockResources is not called, mutex is never unlocked.
-         *
-         * @return A reference to the internal resource map.
-         */
-        std::map < HashedString, Handle < DriverResource > >& lockResources();
+    private:
         
-        /*! @brief Locks the data mutex to access surface's map.
-         *
-         * \ref unlockResources must be called after accessing data to unlock the internal
-         * mutex. It can be used as a faster solution than \ref loadSurfaces or \ref loadResources.
-         * However, if \ref unlockResources is not called, mutex is never unlocked.
-         *
-         * @return A reference to the internal surfaces map.
+        /*! @brief Advances the epoch, and releases every retired resource no reader can still use.
+         * @return The memory size of the resources released.
          */
-        std::map < HashedString, Handle < Surface > >& lockSurfaces();
+        std::size_t releaseRetired();
+        
+        /*! @brief Removes a resource's memory from the usage, before it is cleared. */
+        void releaseMemory(const DriverResource* resource);
         
-        /*! @brief Unlocks the data mutex. */
-        void unlockResources();
+        /*! @brief Notifies and emits DriverObserver::onDriverMemoryBudgetExceeded if the usage of a kind
+         * just went over its budget. */
+        void checkBudget(MemoryKind kind, std::uint64_t usage);
+        
+        /*! @brief Calls func(DriverCapture&) with the capture locked, if capturing. */
+        template < typename Func >
+        void record(Func&& func)
+        {
+            if (!capturing.load(std::memory_order_relaxed))
+                return;
+            
+            std::lock_guard < std::mutex > lock(captureMutex);
+            
+            if (capture)
+                func(*capture);
+        }
     };
 }
 
@@ -0,0 +1,318 @@
+//
+//  DriverCapture.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef DriverCapture_h
+#define DriverCapture_h
+
+#include "Global.h"
+#include "Handle.h"
+#include "DriverResource.h"
+#include "CommandBuffer.h"
+
+#include <cstdio>
+#include <unordered_map>
+
+namespace RD
+{
+    class Driver;
+    class Surface;
+
+    /**
+     * @brief Type of a record in a capture file.
+     *
+     * A capture file starts with a header (magic 'RDCAPTUR', version, name of the captured driver), followed
+     * by records: a CaptureRecordHeader, then its payload. Every payload starts with a fixed structure,
+     * sometimes followed by strings or bytes. Integers are written in the byte order of the machine.
+     */
+    enum class CaptureRecordType : std::uint32_t
+    {
+        //! @brief A surface was created. Payload is a CaptureSurface, its title, then its name.
+        SurfaceCreated = 1,
+
+        //! @brief A surface moved. Payload is a CaptureSurfaceEvent with its position.
+        SurfaceMoved = 2,
+
+        //! @brief A surface resized. Payload is a CaptureSurfaceEvent with its size.
+        SurfaceResized = 3,
+
+        //! @brief A surface was hidden. Payload is a CaptureSurfaceEvent.
+        SurfaceHidden = 4,
+
+        //! @brief A surface was unhidden. Payload is a CaptureSurfaceEvent.
+        SurfaceUnhidden = 5,
+
+        //! @brief A surface locked the focus. Payload is a CaptureSurfaceEvent.
+        SurfaceLockedFocus = 6,
+
+        //! @brief A surface was closed. Payload is a CaptureSurfaceEvent.
+        SurfaceClosed = 7,
+
+        //! @brief A resource was added. Payload is a CaptureResource, then its name.
+        ResourceCreated = 8,
+
+        //! @brief A resource was removed. Payload is a CaptureResource without name.
+        ResourceDestroyed = 9,
+
+        //! @brief A command buffer of the next frame. Payload is a CaptureCommandBuffer, then the commands
+        //! as recorded by CommandBuffer.
+        CommandBuffer = 10,
+
+        //! @brief The frame was presented. Payload is a CapturePresent.
+        Present = 11
+    };
+
+    /*! @brief Header of a record. */
+    struct CaptureRecordHeader
+    {
+        //! @brief A CaptureRecordType.
+        std::uint32_t type;
+
+        //! @brief Size of the payload in bytes.
+        std::uint32_t size;
+    };
+
+    /*! @brief Payload of CaptureRecordType::SurfaceCreated. */
+    struct CaptureSurface
+    {
+        //! @brief Identifier of the surface, see CaptureId.
+        std::uint64_t id;
+
+        //! @brief Size of the surface when captured.
+        std::uint32_t width, height;
+
+        //! @brief SurfaceStyle.
+        std::uint32_t style;
+
+        //! @brief Sizes of the title and of the name following.
+        std::uint32_t titleSize, nameSize;
+
+        //! @brief Zero.
+        std::uint32_t reserved;
+    };
+
+    /*! @brief Payload of the surface events. x and y are the position or the size, zero otherwise. */
+    struct CaptureSurfaceEvent
+    {
+        //! @brief Identifier of the surface.
+        std::uint64_t id;
+
+        //! @brief Position or size.
+        std::uint32_t x, y;
+    };
+
+    /*! @brief Payload of CaptureRecordType::ResourceCreated and ResourceDestroyed. */
+    struct CaptureResource
+    {
+        //! @brief Identifier of the resource.
+        std::uint64_t id;
+
+        //! @brief DriverResource::memorySize when captured.
+        std::uint64_t memorySize;
+
+        //! @brief Size of the name following.
+        std::uint32_t nameSize;
+
+        //! @brief DriverResource::memoryKind when captured.
+        std::uint32_t memoryKind;
+    };
+
+    /*! @brief Payload of CaptureRecordType::CommandBuffer. */
+    struct CaptureCommandBuffer
+    {
+        //! @brief CommandBuffer::order.
+        std::uint32_t order;
+
+        //! @brief Zero.
+        std::uint32_t reserved;
+    };
+
+    /*! @brief Payload of CaptureRecordType::Present. */
+    struct CapturePresent
+    {
+        //! @brief Number of the frame in the capture, from zero.
+        std::uint64_t frame;
+    };
+
+    /*! @brief Returns the identifier of a resource in a capture: the address of its most derived object,
+     * which is the value command payloads hold when they point to it, whatever their pointer type. */
+    inline std::uint64_t CaptureId(const DriverResource* resource)
+    {
+        return reinterpret_cast < std::uintptr_t >(dynamic_cast < const void* >(resource));
+    }
+
+    /**
+     * @brief A capture file loaded in memory.
+     */
+    struct Capture
+    {
+        /*! @brief A record of the capture. */
+        struct Record
+        {
+            //! @brief Its type.
+            CaptureRecordType type;
+
+            //! @brief Offset of its payload in data.
+            std::size_t offset;
+
+            //! @brief Size of its payload.
+            std::uint32_t size;
+        };
+
+        //! @brief Name of the captured driver.
+        std::string driver;
+
+        //! @brief Records, in capture order.
+        std::vector < Record > records;
+
+        //! @brief Number of frames presented.
+        std::size_t frames = 0;
+
+        //! @brief Content of the file.
+        std::vector < unsigned char > data;
+
+        /*! @brief Returns the payload of a record. */
+        const unsigned char* payload(const Record& record) const noexcept { return data.data() + record.offset; }
+
+        /*! @brief Reads a capture written by DriverCapture.
+         * @throw FileOpenException if the file can not be read or is not a capture.
+         */
+        static Capture Read(const std::string& path);
+    };
+
+    /**
+     * @brief Writes the capture of a Driver (see Driver::startCapture).
+     *
+     * Records are buffered and written in the order the driver calls \ref write, which the driver serializes.
+     */
+    class DriverCapture
+    {
+        //! @brief File written.
+        FILE* file;
+
+        //! @brief Frames presented since the capture started.
+        std::uint64_t frames = 0;
+
+    public:
+
+        /*! @brief Creates the file and writes its header.
+         * @throw FileOpenException if the file can not be created.
+         */
+        DriverCapture(const std::string& path, const std::string& driverName);
+
+        /*! @brief Closes the file. */
+        ~DriverCapture();
+
+        DriverCapture(const DriverCapture&) = delete;
+        DriverCapture& operator = (const DriverCapture&) = delete;
+
+        /*! @brief Writes a record whose payload is a structure followed by size bytes. */
+        template < typename T >
+        void write(CaptureRecordType type, const T& payload, const void* bytes = nullptr, std::size_t size = 0)
+        {
+            writeRecord(type, &payload, sizeof(T), bytes, size, nullptr, 0);
+        }
+
+        /*! @brief Writes a CaptureRecordType::SurfaceCreated record. */
+        void writeSurface(const Surface* surface, const std::string& title, const std::string& name, std::uint32_t style);
+
+        /*! @brief Writes a CaptureRecordType::CommandBuffer record. */
+        void writeBuffer(const CommandBuffer& buffer);
+
+        /*! @brief Writes a CaptureRecordType::Present record. */
+        void writePresent();
+
+    private:
+
+        /*! @brief Writes a record whose payload is the three parts given. */
+        void writeRecord(CaptureRecordType type, const void* first, std::size_t firstSize, const void* second,
+                         std::size_t secondSize, const void* third, std::size_t thirdSize);
+    };
+
+    /**
+     * @brief Maps the identifiers of a capture to the resources created by its replay.
+     */
+    class CaptureRelocator
+    {
+    protected:
+
+        //! @brief Resources replayed, by identifier in the capture.
+        std::unordered_map < std::uint64_t, Handle < DriverResource > > resources;
+
+    public:
+
+        /*! @brief Returns the resource replaying the captured one, or null. */
+        const DriverResource* find(std::uint64_t id) const;
+
+        /*! @brief Returns the resource replaying the one a captured pointer pointed to, or null if it was
+         * not replayed or is not a T. Used by Driver::relocateCommand. */
+        template < typename T >
+        const T* relocate(const T* captured) const
+        {
+            return dynamic_cast < const T* >(find(reinterpret_cast < std::uintptr_t >(captured)));
+        }
+    };
+
+    /**
+     * @brief Replays a Capture against a Driver, frame by frame.
+     *
+     * Surfaces and resources are created again, surfaces events are applied to them, and command buffers
+     * are submitted to the driver's CommandQueue with their order. Commands pointing to captured resources
+     * are fixed by Driver::relocateCommand; draws are replayed already sorted, as RenderQueue flushed them.
+     * A driver replays the commands of its own kind only: others are passed to its \ref Driver::executeCommand
+     * as they were captured.
+     */
+    class CaptureReplayer : public CaptureRelocator
+    {
+        //! @brief Driver replaying.
+        Driver& driver;
+
+        //! @brief Capture replayed.
+        const Capture& capture;
+
+        //! @brief Next record.
+        std::size_t next = 0;
+
+        //! @brief Commands skipped because Driver::relocateCommand refused them.
+        std::size_t skippedCommands = 0;
+
+        //! @brief Resources the driver could not create.
+        std::size_t skippedResources = 0;
+
+    public:
+
+        /*! @brief Constructs a replayer, at the beginning of the capture. */
+        CaptureReplayer(Driver& driver, const Capture& capture);
+
+        /*! @brief Closes and removes what the replay created. */
+        ~CaptureReplayer();
+
+        /*! @brief Replays the records of the next frame, up to its present, which is done with
+         * Driver::present.
+         * @return False if every frame was replayed.
+         */
+        bool step();
+
+        /*! @brief Closes the surfaces and removes the resources created, and rewinds the capture. */
+        void reset();
+
+        /*! @brief Returns the number of commands skipped since construction. */
+        std::size_t skippedCommandsCount() const noexcept { return skippedCommands; }
+
+        /*! @brief Returns the number of resources the driver could not create since construction. */
+        std::size_t skippedResourcesCount() const noexcept { return skippedResources; }
+
+    private:
+
+        /*! @brief Replays a record other than Present. */
+        void replay(const Capture::Record& record);
+
+        /*! @brief Submits a captured command buffer. */
+        void replayBuffer(const unsigned char* bytes, std::size_t size, std::uint32_t order);
+    };
+}
+
+#endif /* DriverCapture_h */
@@ -14,6 +14,27 @@ namespace RD
 {
     class Driver;
     
+    /**
+     * @brief Kind of memory a DriverResource holds, accounted separately by its Driver.
+     */
+    enum class MemoryKind : std::uint32_t
+    {
+        //! @brief Memory of the device only, like textures and render targets.
+        Device = 0,
+        
+        //! @brief Memory the host can read and write, like CPU surfaces or mapped buffers.
+        HostVisible = 1,
+        
+        //! @brief Host memory used to upload data to the device.
+        Staging = 2
+    };
+    
+    //! @brief Number of MemoryKind.
+    static constexpr std::size_t kMemoryKindCount = 3;
+    
+    /*! @brief Returns the name of a memory kind, like 'Device'. */
+    const char* MemoryKindName(MemoryKind kind) noexcept;
+    
     /**
      * @brief A Resource created and owned by a Driver.
      *
@@ -32,6 +53,10 @@ namespace RD
      * to lock/unlock the resource in a C++ way.
      *
      * @sa DriverResource::lock, DriverResource::unlock
+     *
+     * @note
+     * A resource reports the memory it holds with \ref memorySize and \ref memoryKind. Its Driver accounts it
+     * when registered, until released (see Driver::memoryUsage).
      */
     class DriverResource
     {
@@ -43,6 +68,12 @@ namespace RD
         //! @brief Flag to tell the driver if the resource is currently in use.
         mutable std::atomic < std::size_t > uses;
         
+        //! @brief Bytes accounted in the driver's memory usage, or kMemoryReleased once released.
+        mutable std::atomic < std::size_t > accountedBytes { 0 };
+        
+        //! @brief Value of accountedBytes once the resource's memory was released by its driver.
+        static constexpr std::size_t kMemoryReleased = ~std::size_t(0);
+        
     public:
         
         /*! @brief Default constructor. */
@@ -77,6 +108,14 @@ namespace RD
         /*! @brief Returns true if \ref uses is superior to zero. */
         bool isUsed() const;
         
+        /*! @brief Returns the memory held by this resource, in bytes. Used by Driver's metrics. The default
+         * implementation returns zero. */
+        virtual std::size_t memorySize() const;
+        
+        /*! @brief Returns the kind of memory held by this resource. The default implementation returns
+         * MemoryKind::Device. */
+        virtual MemoryKind memoryKind() const;
+        
     protected:
         
         /*! @brief Called when Driver must clear every resources.
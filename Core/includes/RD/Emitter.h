@@ -9,6 +9,11 @@
 #define Emitter_h
 
 #include "ThreadedTasks.h"
+#include "Exception.h"
+#include "Epoch.h"
+#include "EventQueue.h"
+
+#include <vector>
 
 namespace RD
 {
@@ -19,6 +24,9 @@ namespace RD
      * or Asynchronized (multithreaded). If you don't want your emitter to emit its notification in
      * multithreaded mode, use EmittingPolicy::Asynchronized when declaring your emitters.
      *
+     * Deferred emitters record their events in their EventQueue, and listeners are called synchronously
+     * when the queue is flushed (once per tick for the default queue).
+     *
      * @note
      * When compiling a custom version of this library, one can set EmittingPolicy::Default to whatever
      * value he wants to affect every emitting objects of the library.
@@ -27,6 +35,7 @@ namespace RD
     {
         Synchronized,
         Asynchronized,
+        Deferred,
         
         Default = Asynchronized
     };
@@ -44,26 +53,71 @@ namespace RD
     template < typename Class, EmittingPolicy emitPolicy = EmittingPolicy::Default >
     class Emitter
     {
-        //! @brief List of listeners for this type. Notes listeners are stored only as pointers.
-        //! It is impossible for an emitter to ensure its listener is still valid. Listeners must
+        //! @brief Immutable list of listeners.
+        typedef std::vector < Class* > ListenerList;
+        
+        //! @brief Current list of listeners for this type, or null if empty. Notes listeners are stored only
+        //! as pointers. It is impossible for an emitter to ensure its listener is still valid. Listeners must
         //! unregiser themself from their emitter when they are destroyed.
-        std::forward_list < Class* > listeners;
+        //!
+        //! A list is never modified once published: adding or removing a listener publishes a modified copy
+        //! and retires the previous list with Epoch::Retire. Emitting reads the current list inside an
+        //! EpochGuard, without any lock, so listeners can add or remove listeners while being called.
+        std::atomic < const ListenerList* > listeners;
         
-        //! @brief Locks the forward_list when iterating over it.
+        //! @brief Serializes writers of the listeners list. Never locked while emitting.
         std::mutex mutex;
         
+        //! @brief Queue where deferred and coalesced events are recorded.
+        std::atomic < EventQueue* > queue;
+        
+        //! @brief True if an event was ever recorded in queue, so pending events must be purged when
+        //! this emitter is destroyed.
+        std::atomic_bool queued;
+        
     public:
         
         /*! @brief Default constructor. */
-        Emitter() noexcept = default;
+        Emitter() noexcept : listeners( nullptr ), queue( &EventQueue::Default() ), queued( false ) { }
         
         /*! @brief Default destructor. */
-        virtual ~Emitter() noexcept = default;
+        virtual ~Emitter() noexcept
+        {
+            if ( queued.load() )
+                queue.load()->purge( this );
+            
+            // No emission can be in progress while the emitter is destroyed, so the list is not retired.
+            delete listeners.load();
+        }
+        
+        /*! @brief Changes the queue where deferred and coalesced events are recorded.
+         *
+         * Events already recorded in the previous queue are purged.
+         *
+         * @param[in] eventQueue New queue, or null for the default queue.
+         */
+        void setEventQueue(EventQueue* eventQueue)
+        {
+            EventQueue* previous = queue.exchange(eventQueue ? eventQueue : &EventQueue::Default());
+            
+            if ( queued.load() && previous != queue.load() )
+                previous->purge( this );
+        }
+        
+        /*! @brief Returns the queue where deferred and coalesced events are recorded. */
+        EventQueue& getEventQueue() const
+        {
+            return *queue.load();
+        }
         
         /*! @brief Register a listener for all events emitted by this object.
          *
          * @param[in] listener Pointer to the listener object. Throw a NullPointerException
-         *      if null. Listener is added to the end of the listening list.
+         *      if null. Listener is added to the front of the listening list: the last listener added
+         *      is called first.
+         *
+         * @note
+         * Can be called while this object is emitting. The listener will be called from the next emission.
          */
         virtual void addListener(Class* listener)
         {
@@ -71,13 +125,21 @@ namespace RD
                 throw NullPointerException("Null pointer 'listener' for '%s::addListener()'.", typeid(*this).name());
             
             std::lock_guard<std::mutex> lock(mutex);
-            listeners.push_front(listener);
+            const ListenerList* current = listeners.load();
+            
+            ListenerList* list = current ? new ListenerList(*current) : new ListenerList();
+            list->insert(list->begin(), listener);
+            publish(list, current);
         }
         
         /*! @brief Unregisters a listener from this object's lists.
          *
          * @param[in] listener Pointer to the listener object. Throw a NullPointerException
          *      if null.
+         *
+         * @note
+         * Can be called while this object is emitting, even from the listener being removed. An emission
+         * already in progress may still call the listener.
          */
         virtual void removeListener(Class* listener)
         {
@@ -85,14 +147,50 @@ namespace RD
                 throw NullPointerException("Null pointer 'listener' for '%s::removeListener()'.", typeid(*this).name());
             
             std::lock_guard<std::mutex> lock(mutex);
-            listeners.remove(listener);
+            const ListenerList* current = listeners.load();
+            
+            if (!current || std::find(current->begin(), current->end(), listener) == current->end())
+                return;
+            
+            ListenerList* list = new ListenerList(*current);
+            list->erase(std::remove(list->begin(), list->end(), listener), list->end());
+            
+            if (list->empty())
+            {
+                delete list;
+                list = nullptr;
+            }
+            
+            publish(list, current);
         }
         
         /*! @brief Clear all listeners in this emitter. */
         virtual void clearListeners()
         {
             std::lock_guard < std::mutex > lock(mutex);
-            listeners.clear();
+            publish(nullptr, listeners.load());
+        }
+        
+    private:
+        
+        /*! @brief Returns a function calling emitSync with a copy of the given arguments. */
+        template < typename Listener, typename ConnectFunc, typename... Args >
+        inline std::function < void() > makeDispatch( ConnectFunc func, Args&&... args )
+        {
+            return [this, func, arguments = std::make_tuple( std::forward < Args >( args )... )]() {
+                std::apply( [this, func]( const auto&... values ) {
+                    emitSync < Listener >( func, values... );
+                }, arguments );
+            };
+        }
+        
+        /*! @brief Publishes a new listeners list and retires the previous one. Mutex must be locked. */
+        void publish(const ListenerList* list, const ListenerList* previous)
+        {
+            listeners.store(list);
+            
+            if (previous)
+                Epoch::Retire(previous);
         }
         
     protected:
@@ -110,10 +208,60 @@ namespace RD
         template < typename Listener, typename ConnectFunc, typename... Args >
         inline void emit( ConnectFunc func, Args&&... args )
         {
-            if ( emitPolicy == EmittingPolicy::Synchronized )
+            if constexpr ( emitPolicy == EmittingPolicy::Synchronized )
                 emitSync< Listener >( func, std::forward < Args >(args)... );
-            else if ( emitPolicy == EmittingPolicy::Asynchronized )
+            else if constexpr ( emitPolicy == EmittingPolicy::Asynchronized )
                 emitAsync< Listener >( func, std::forward < Args >(args)... );
+            else if constexpr ( emitPolicy == EmittingPolicy::Deferred )
+                emitDeferred< Listener >( func, std::forward < Args >(args)... );
+        }
+        
+        /*! @brief Records an event dispatched to each listener when the event queue is flushed.
+         *
+         * @tparam Listener Class of the listener to send the notification.
+         * @tparam ConnectFunc Function where to send the notification.
+         * @tparam Args Arguments to pass to the function. They are copied in the event.
+         *
+         * @param[in] func Pointer to the connected function.
+         * @param[in] args Arguments to pass.
+         *
+         * @note
+         * Listeners are those registered when the queue is flushed, not when the event is recorded.
+         */
+        template < typename Listener, typename ConnectFunc, typename... Args >
+        inline void emitDeferred( ConnectFunc func, Args&&... args )
+        {
+            queued.store( true );
+            queue.load()->push( this, makeDispatch < Listener >( func, std::forward < Args >( args )... ) );
+        }
+        
+        /*! @brief Records an event replacing the pending event for the same function, if any.
+         *
+         * Used for events where only the last value matters, like a resize: when the queue is flushed,
+         * listeners are called once with the last arguments recorded. Can be used with any policy.
+         *
+         * @tparam Listener Class of the listener to send the notification.
+         * @tparam ConnectFunc Function where to send the notification.
+         * @tparam Args Arguments to pass to the function. They are copied in the event.
+         *
+         * @param[in] func Pointer to the connected function.
+         * @param[in] args Arguments to pass.
+         */
+        template < typename Listener, typename ConnectFunc, typename... Args >
+        inline void emitCoalesced( ConnectFunc func, Args&&... args )
+        {
+            // The function pointer bytes (member function pointers may be larger than a pointer) are hashed
+            // with FNV-1a to get the event's key.
+            unsigned char bytes[sizeof(ConnectFunc)];
+            std::memcpy( bytes, &func, sizeof(ConnectFunc) );
+            
+            std::uint64_t key = 0xcbf29ce484222325ULL;
+            
+            for ( unsigned char byte : bytes )
+                key = ( key ^ byte ) * 0x100000001b3ULL;
+            
+            queued.store( true );
+            queue.load()->coalesce( this, key ? key : 1, makeDispatch < Listener >( func, std::forward < Args >( args )... ) );
         }
         
         /*! @brief Emits to each listener the connected function with passed arguments.
@@ -127,14 +275,19 @@ namespace RD
          *
          * @note
          * Synchronized version notifiates each listener one by one. Order of invocation
-         * is guaranteed between listeners.
+         * is guaranteed between listeners. No lock is held, so concurrent emissions do not
+         * wait for each other.
          */
         template < typename Listener, typename ConnectFunc, typename... Args >
         inline void emitSync( ConnectFunc func, Args&&... args )
         {
-            std::lock_guard < std::mutex > lock( mutex );
+            EpochGuard guard;
+            const ListenerList* list = listeners.load();
+            
+            if ( !list )
+                return;
             
-            for ( auto l : listeners )
+            for ( auto l : *list )
             {
                 auto listener = static_cast < Listener* >( l );
                 std::invoke( func, listener, std::forward < Args >( args )... );
@@ -157,10 +310,15 @@ namespace RD
         template < typename Listener, typename ConnectFunc, typename... Args >
         inline void emitAsync( ConnectFunc func, Args&&... args )
         {
-            std::lock_guard < std::mutex > lock( mutex );
+            EpochGuard guard;
+            const ListenerList* list = listeners.load();
+            
+            if ( !list )
+                return;
+            
             ThreadedTasks threads;
             
-            for ( auto l : listeners )
+            for ( auto l : *list )
             {
                 threads.push( std::thread([func, l]( Args&&... args ) {
                     
@@ -0,0 +1,109 @@
+//
+//  Epoch.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Epoch_h
+#define Epoch_h
+
+#include "Global.h"
+
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Epoch-based reclamation of objects read without lock.
+     *
+     * Lock-free readers (like Emitter's emit functions) read a shared object inside an EpochGuard. Writers
+     * never delete an object readers might still see: they unlink it, then give it to \ref Retire. The
+     * object is deleted only when every thread that was inside an EpochGuard at that time has left it.
+     *
+     * A global epoch counter is advanced when every thread inside a guard has observed the current epoch.
+     * An object retired at epoch E is deleted once the global epoch reaches E + 2. Each thread gets a
+     * record the first time it enters a guard, released when the thread exits.
+     *
+     * @note
+     * Guards can be nested. A thread must not wait for another thread to reclaim memory while inside a
+     * guard, but it can call \ref Retire.
+     */
+    class Epoch
+    {
+    public:
+
+        /*! @brief Function deleting a retired object. */
+        typedef void (*Deleter)( void* );
+
+        /*! @brief Per-thread state, linked in a global list never freed. */
+        struct Record
+        {
+            //! @brief Epoch observed when the thread entered its outermost guard, or zero outside guards.
+            std::atomic < std::uint64_t > epoch;
+
+            //! @brief True while a thread owns this record.
+            std::atomic_bool used;
+
+            //! @brief Number of nested guards of the owning thread.
+            std::uint32_t nesting;
+
+            //! @brief Next record in the global list.
+            Record* next;
+        };
+
+        /*! @brief Enters a read-side critical section for the calling thread. */
+        static void Enter();
+
+        /*! @brief Leaves a read-side critical section for the calling thread. */
+        static void Leave();
+
+        /*! @brief Retires an object, deleted with deleter once no reader can see it anymore. */
+        static void Retire( void* object, Deleter deleter );
+
+        /*! @brief Retires an object deleted with 'delete'. */
+        template < typename T >
+        static void Retire( T* object )
+        {
+            Retire( const_cast < void* >( static_cast < const void* >( object ) ), []( void* p ){
+                delete static_cast < T* >( p );
+            });
+        }
+
+        /*! @brief Tries to advance the global epoch and deletes every object safe to delete.
+         *
+         * @return The number of objects deleted.
+         */
+        static std::size_t Collect();
+
+        /*! @brief Returns the number of objects retired and not deleted yet. */
+        static std::size_t Pending();
+
+        /*! @brief Returns the current global epoch. */
+        static std::uint64_t Current();
+
+    private:
+
+        /*! @brief Returns the record of the calling thread, acquiring one if needed. */
+        static Record* LocalRecord();
+    };
+
+    /**
+     * @brief Keeps the calling thread inside an epoch read-side critical section during its scope.
+     */
+    class EpochGuard
+    {
+    public:
+
+        /*! @brief Enters the critical section. */
+        EpochGuard() { Epoch::Enter(); }
+
+        /*! @brief Leaves the critical section. */
+        ~EpochGuard() { Epoch::Leave(); }
+
+        EpochGuard( const EpochGuard& ) = delete;
+        EpochGuard& operator = ( const EpochGuard& ) = delete;
+    };
+}
+
+#endif /* Epoch_h */
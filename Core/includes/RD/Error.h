@@ -0,0 +1,106 @@
+//
+//  Error.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Error_h
+#define Error_h
+
+#include "Global.h"
+#include "Format.h"
+
+#include <string_view>
+
+namespace RD
+{
+    /*! @brief Codes of the errors reported by the engine. Exceptions use the same codes. */
+    enum ErrorCode : uint32_t
+    {
+        //! @brief A null pointer was accessed. Raised as NullPointerException.
+        kErrorNullPointer = 1,
+
+        //! @brief A handle is already in a list where it should be unique. Raised as HandleNotUniqueException.
+        kErrorHandleNotUnique = 2,
+
+        //! @brief A module could not be loaded. Raised as ModuleNotLoadedException.
+        kErrorModuleNotLoaded = 3,
+
+        //! @brief An observer requested an abort. Raised as AbortRequestedException.
+        kErrorAbortRequested = 4,
+
+        //! @brief A file could not be opened. Raised as FileOpenException.
+        kErrorFileOpen = 5,
+
+        //! @brief A driver could not create a surface. Raised as Exception.
+        kErrorSurfaceNotCreated = 6
+    };
+
+    /**
+     * @brief An error returned as a value by the non-throwing variants of the engine's functions.
+     *
+     * An Error holds the same code and message as the exception the throwing variant raises, and can
+     * raise it with \ref raise. Module and function name where the error comes from, when known, are
+     * static strings and are not copied.
+     */
+    class Error
+    {
+        //! @brief Code of the error.
+        uint32_t errorCode = 0;
+
+        //! @brief Message of the error.
+        std::string text;
+
+        //! @brief Module where the error comes from, or empty.
+        std::string_view errorModule;
+
+        //! @brief Function where the error comes from, or empty.
+        std::string_view errorFunction;
+
+    public:
+
+        /*! @brief Constructs an error.
+         *
+         * @param[in] code Code of the error.
+         * @param[in] message Message of the error.
+         */
+        Error(uint32_t code, std::string message) noexcept
+        : errorCode(code), text(std::move(message))
+        {}
+
+        /*! @brief Constructs an error coming from a module's function.
+         *
+         * @param[in] module Module where the error comes from. Must be a static string.
+         * @param[in] function Function where the error comes from. Must be a static string.
+         * @param[in] code Code of the error.
+         * @param[in] message Message of the error.
+         */
+        Error(std::string_view module, std::string_view function, uint32_t code, std::string message) noexcept
+        : errorCode(code), text(std::move(message)), errorModule(module), errorFunction(function)
+        {}
+
+        /*! @brief Constructs an error with a formatted message (see Format.h). */
+        template < typename Format, typename... Args >
+        Error(uint32_t code, const Format& format, const Args&... args)
+        : Error(code, FormatToString(format, args...))
+        {}
+
+        /*! @brief Returns the code of the error. */
+        uint32_t code() const noexcept { return errorCode; }
+
+        /*! @brief Returns the message of the error. */
+        const std::string& message() const noexcept { return text; }
+
+        /*! @brief Returns the module where the error comes from, or an empty string. */
+        std::string_view module() const noexcept { return errorModule; }
+
+        /*! @brief Returns the function where the error comes from, or an empty string. */
+        std::string_view function() const noexcept { return errorFunction; }
+
+        /*! @brief Throws the exception matching the error's code. */
+        [[noreturn]] void raise() const;
+    };
+}
+
+#endif /* Error_h */
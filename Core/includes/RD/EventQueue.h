@@ -0,0 +1,123 @@
+//
+//  EventQueue.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef EventQueue_h
+#define EventQueue_h
+
+#include "Global.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Queue of deferred events, dispatched all at once by \ref flush.
+     *
+     * Emitters using EmittingPolicy::Deferred, or calling emitCoalesced(), record their events here instead
+     * of calling their listeners. The Application flushes the default queue once per tick, at the point
+     * chosen with \ref Application::setEventFlushPoint.
+     *
+     * An event is identified by its emitter and a key (the listener's function for Emitter). A coalesced
+     * event replaces the pending event with the same identifier, if any: only the last resize of a surface
+     * is dispatched, with its last size. The replacing event takes the position of the last event recorded,
+     * so events are always dispatched in the order of their last occurence.
+     *
+     * @note
+     * Every function can be called from any thread. Events recorded while flushing are dispatched by the
+     * next flush.
+     */
+    class EventQueue
+    {
+        /*! @brief An event waiting to be dispatched. */
+        struct Event
+        {
+            //! @brief Object which recorded the event.
+            const void* emitter;
+
+            //! @brief Key of the event, or zero if the event is not coalesced.
+            std::uint64_t key;
+
+            //! @brief Dispatches the event. Empty if the event was coalesced or purged.
+            std::function < void() > dispatch;
+        };
+
+        /*! @brief Identifier of a coalesced event. */
+        struct EventId
+        {
+            const void* emitter;
+            std::uint64_t key;
+
+            bool operator == ( const EventId& rhs ) const { return emitter == rhs.emitter && key == rhs.key; }
+        };
+
+        /*! @brief Hash of an EventId. */
+        struct EventIdHash
+        {
+            std::size_t operator () ( const EventId& id ) const
+            {
+                return std::hash < const void* >()( id.emitter ) ^ ( id.key * 0x9E3779B97F4A7C15ULL );
+            }
+        };
+
+        //! @brief Events recorded, in order.
+        std::vector < Event > events;
+
+        //! @brief Events being dispatched by flush().
+        std::vector < Event > dispatching;
+
+        //! @brief True while flush() dispatches events.
+        bool flushing;
+
+        //! @brief Index in events of each coalesced event pending.
+        std::unordered_map < EventId, std::size_t, EventIdHash > coalesced;
+
+        //! @brief Number of events replaced by a coalesced event since construction.
+        std::uint64_t coalescedCount;
+
+        //! @brief Mutex protecting the queue.
+        mutable std::mutex mutex;
+
+    public:
+
+        /*! @brief Constructs an empty queue. */
+        EventQueue();
+
+        /*! @brief Records an event dispatched as is by the next flush. */
+        void push( const void* emitter, std::function < void() >&& dispatch );
+
+        /*! @brief Records an event replacing any pending event with the same emitter and key.
+         *
+         * @param[in] emitter Object recording the event.
+         * @param[in] key Key of the event. Must not be zero.
+         * @param[in] dispatch Function dispatching the event.
+         */
+        void coalesce( const void* emitter, std::uint64_t key, std::function < void() >&& dispatch );
+
+        /*! @brief Removes every pending event of an emitter, including events not dispatched yet by a flush in
+         * progress. Called when the emitter is destroyed. */
+        void purge( const void* emitter );
+
+        /*! @brief Dispatches every pending event, in order.
+         *
+         * @return The number of events dispatched, or zero if called while already flushing.
+         */
+        std::size_t flush();
+
+        /*! @brief Returns the number of pending events. */
+        std::size_t pending() const;
+
+        /*! @brief Returns the number of events replaced by a coalesced event. */
+        std::uint64_t coalescedEvents() const;
+
+        /*! @brief Returns the queue used by default by every Emitter, and flushed by the Application. Never
+         * destroyed. */
+        static EventQueue& Default();
+    };
+}
+
+#endif /* EventQueue_h */
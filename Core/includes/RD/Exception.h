@@ -10,11 +10,15 @@
 #define Exception_h
 
 #include "Global.h"
+#include "Error.h"
+#include "Format.h"
 
 namespace RD
 {
     /**
      * @brief Generic exception that may be throwed by any part of RD's engine.
+     *
+     * Constructing an Exception records it in the FlightRecorder, which dumps its rings if a dump path is set.
      */
     class Exception : public std::exception
     {
@@ -33,13 +37,20 @@ namespace RD
          */
         Exception( uint32_t error, const std::string& str ) noexcept;
         
-        /*! @brief Constructs an Exception with a message handled by vsnprintf.
+        /*! @brief Constructs an Exception with the code and message of an error. */
+        explicit Exception( const Error& error ) noexcept;
+        
+        /*! @brief Constructs an Exception with a formatted message.
          *
          * @param[in] error Error code to output.
-         * @param[in] format String to use to format output message.
-         * @param[in] ... Parameters according to format and vsnprintf.
+         * @param[in] format printf-like format of the message (see Format.h). Checked against args at
+         *      compile time if written with RDFormatString.
+         * @param[in] args Arguments of format.
          */
-        Exception( uint32_t error, const char* format, ... );
+        template < typename Format, typename... Args >
+        Exception( uint32_t error, const Format& format, const Args&... args )
+        : Exception( error, FormatToString( format, args... ) )
+        {}
         
         /*! @brief Default destructor. */
         virtual ~Exception() noexcept = default;
@@ -62,20 +73,24 @@ namespace RD
     class NullPointerException : public Exception
     {
         //! Error code of this exception.
-        static constexpr uint32_t ErrorCode = 1;
+        static constexpr uint32_t ErrorCode = kErrorNullPointer;
         
     public:
         
         /*! @brief Constructs this exception.
          *
          * @tparam Args Type of arguments to pass to Exception base constructor.
-         * @param[in] format String to use to output the message.
-         * @param[in] args Arguments to pass to vsnprintf.
+         * @param[in] format printf-like format of the message (see Format.h).
+         * @param[in] args Arguments of format.
          */
-        template < typename... Args >
-        NullPointerException( const char* format, Args&&... args )
-        : Exception( ErrorCode, format, std::forward<Args>(args)... )
+        template < typename Format, typename... Args,
+                   typename = std::enable_if_t < !std::is_base_of_v < Exception, std::decay_t < Format > > > >
+        NullPointerException( const Format& format, const Args&... args )
+        : Exception( ErrorCode, format, args... )
         {}
+        
+        /*! @brief Constructs this exception from an error. */
+        explicit NullPointerException( const Error& error ) noexcept;
     };
     
     /**
@@ -87,7 +102,7 @@ namespace RD
     class HandleNotUniqueException : public Exception
     {
         //! Error code of this exception.
-        static constexpr uint32_t ErrorCode = 2;
+        static constexpr uint32_t ErrorCode = kErrorHandleNotUnique;
         
     public:
         
@@ -96,6 +111,9 @@ namespace RD
          * @param[in] ptr Address of the handle.
          */
         HandleNotUniqueException( uintptr_t ptr );
+        
+        /*! @brief Constructs this exception from an error. */
+        explicit HandleNotUniqueException( const Error& error ) noexcept;
     };
     
     /**
@@ -106,7 +124,7 @@ namespace RD
     class ModuleNotLoadedException : public Exception
     {
         //! @brief Error code for this exception.
-        static constexpr uint32_t ErrorCode = 3;
+        static constexpr uint32_t ErrorCode = kErrorModuleNotLoaded;
         
     public:
         
@@ -114,6 +132,9 @@ namespace RD
          * @param[in] libname Library that should be loaded.
          */
         ModuleNotLoadedException( const std::string& libname );
+        
+        /*! @brief Constructs this exception from an error. */
+        explicit ModuleNotLoadedException( const Error& error ) noexcept;
     };
     
     /**
@@ -124,7 +145,7 @@ namespace RD
     class AbortRequestedException : public Exception
     {
         //! @brief Error code for this exception.
-        static constexpr uint32_t ErrorCode = 4;
+        static constexpr uint32_t ErrorCode = kErrorAbortRequested;
         
     public:
         
@@ -136,6 +157,28 @@ namespace RD
         AbortRequestedException(const std::string& module, const std::string& function, const std::string& message);
     };
     
+    /**
+     * @brief Launched when a file used by the engine (like a log file) can not be opened.
+     *
+     * ErrorCode = 5.
+     */
+    class FileOpenException : public Exception
+    {
+        //! @brief Error code for this exception.
+        static constexpr uint32_t ErrorCode = kErrorFileOpen;
+        
+    public:
+        
+        /*! @brief Default constructor.
+         * @param[in] path Path of the file.
+         * @param[in] error Value of errno when opening the file failed.
+         */
+        FileOpenException(const std::string& path, int error);
+        
+        /*! @brief Constructs this exception from an error. */
+        explicit FileOpenException(const Error& error) noexcept;
+    };
+    
     /*! @brief Defines a new exception with its error code, and a default constructor. */
 #   define RDDefineException(name, code)                                                        \
         class name : public RD::Exception { static constexpr std::uint32_t ErrorCode = code ;   \
@@ -143,7 +186,7 @@ namespace RD
         }
     
     /*! @brief Implements the exception name with its default constructor and given message, which can
-     * be formatted like a call to C \ref printf. */
+     * be formatted like a call to C \ref printf (see Format.h). */
 #   define RDImplementException(name, ...) \
         name :: name () : RD::Exception(ErrorCode, __VA_ARGS__) {}
 }
@@ -0,0 +1,105 @@
+//
+//  Expected.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Expected_h
+#define Expected_h
+
+#include "Global.h"
+#include "Error.h"
+
+#include <variant>
+
+namespace RD
+{
+    /**
+     * @brief Holds either a value or the error which prevented computing it.
+     *
+     * Returned by the non-throwing variants of the engine's functions (tryLoadModule, tryCreateSurface,
+     * Handle::tryGet, TryNotifiateAbort...). Testing the result is cheap and never unwinds the stack; the
+     * throwing variants simply call \ref value, which raises the error.
+     *
+     * @tparam T Type of the value.
+     * @tparam E Type of the error. Must have a 'raise()' function, used by \ref value.
+     */
+    template < typename T, typename E = Error >
+    class Expected
+    {
+        static_assert(!std::is_same_v < T, E >, "Value and error types must differ.");
+
+        //! @brief Value or error.
+        std::variant < T, E > storage;
+
+    public:
+
+        /*! @brief Constructs a result holding a value. */
+        Expected(const T& value) : storage(std::in_place_index < 0 >, value) {}
+
+        /*! @brief Constructs a result holding a value. */
+        Expected(T&& value) noexcept(std::is_nothrow_move_constructible_v < T >)
+        : storage(std::in_place_index < 0 >, std::move(value)) {}
+
+        /*! @brief Constructs a result holding an error. */
+        Expected(const E& error) : storage(std::in_place_index < 1 >, error) {}
+
+        /*! @brief Constructs a result holding an error. */
+        Expected(E&& error) noexcept : storage(std::in_place_index < 1 >, std::move(error)) {}
+
+        /*! @brief Returns true if a value is held. */
+        bool hasValue() const noexcept { return storage.index() == 0; }
+
+        /*! @brief Same as \ref hasValue. */
+        explicit operator bool() const noexcept { return hasValue(); }
+
+        /*! @brief Returns the value, or raises the error if none. */
+        T& value() &
+        {
+            if (!hasValue())
+                std::get < 1 >(storage).raise();
+            return std::get < 0 >(storage);
+        }
+
+        /*! @brief Returns the value, or raises the error if none. */
+        const T& value() const &
+        {
+            if (!hasValue())
+                std::get < 1 >(storage).raise();
+            return std::get < 0 >(storage);
+        }
+
+        /*! @brief Returns the value, or raises the error if none. */
+        T&& value() &&
+        {
+            if (!hasValue())
+                std::get < 1 >(storage).raise();
+            return std::move(std::get < 0 >(storage));
+        }
+
+        /*! @brief Returns the value, or other if an error is held. */
+        template < typename U >
+        T valueOr(U&& other) const &
+        {
+            return hasValue() ? std::get < 0 >(storage) : static_cast < T >(std::forward < U >(other));
+        }
+
+        /*! @brief Returns the error. A value must not be held. */
+        const E& error() const noexcept { return *std::get_if < 1 >(&storage); }
+
+        /*! @brief Returns the value. An error must not be held. */
+        T& operator * () noexcept { return *std::get_if < 0 >(&storage); }
+
+        /*! @brief Returns the value. An error must not be held. */
+        const T& operator * () const noexcept { return *std::get_if < 0 >(&storage); }
+
+        /*! @brief Returns the value. An error must not be held. */
+        T* operator -> () noexcept { return std::get_if < 0 >(&storage); }
+
+        /*! @brief Returns the value. An error must not be held. */
+        const T* operator -> () const noexcept { return std::get_if < 0 >(&storage); }
+    };
+}
+
+#endif /* Expected_h */
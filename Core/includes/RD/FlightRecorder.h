@@ -0,0 +1,173 @@
+//
+//  FlightRecorder.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef FlightRecorder_h
+#define FlightRecorder_h
+
+#include "Global.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Always-on recorder of the engine's recent events, dumped when something goes wrong.
+     *
+     * Each thread records events in its own fixed-size ring of 64 bytes events, without locking: recording
+     * an event reads the CPU's time stamp counter and copies a few bytes. The engine records every notification, module update
+     * boundaries, surfaces events and driver resources creation and destruction. Applications can record
+     * their own events with \ref Mark.
+     *
+     * When a dump path is set, rings are written to this file when an RD::Exception is constructed, and when
+     * a fatal signal arrives if \ref InstallSignalHandlers was called. Dumping only uses async-signal-safe
+     * functions, and does not allocate. The rdflightdump tool prints a dump.
+     *
+     * @note
+     * Rings of other threads are read while they may still record: the oldest events of a dump can be
+     * torn. Rings of terminated threads are kept until a new thread reuses them.
+     */
+    class FlightRecorder
+    {
+    public:
+
+        /*! @brief Type of a recorded event. */
+        enum class EventType : std::uint16_t
+        {
+            //! @brief A notification was sent. value is the hash of its name, text is 'module:name'.
+            Notification = 1,
+
+            //! @brief A module starts its update. object is the module, text its name.
+            ModuleUpdateBegin = 2,
+
+            //! @brief A module finished its update. object is the module.
+            ModuleUpdateEnd = 3,
+
+            //! @brief A driver created a surface. object is the surface, value its size (width in high
+            //! bits), text its object name.
+            SurfaceCreated = 4,
+
+            //! @brief A surface is closing. object is the surface.
+            SurfaceClosed = 5,
+
+            //! @brief A surface moved. object is the surface, value its position (x in high bits).
+            SurfaceMoved = 6,
+
+            //! @brief A surface was resized. object is the surface, value its size (width in high bits).
+            SurfaceResized = 7,
+
+            //! @brief A driver resource was created. object is the resource, value its driver.
+            ResourceCreated = 8,
+
+            //! @brief A driver resource was destroyed. object is the resource, value its driver.
+            ResourceDestroyed = 9,
+
+            //! @brief An RD::Exception was constructed. value is its code, text its message.
+            Exception = 10,
+
+            //! @brief An application event recorded with \ref Mark.
+            Mark = 11
+        };
+
+        /*! @brief A recorded event. */
+        struct Event
+        {
+            //! @brief Time of the event. Recorded in CPU ticks, converted by \ref Read in nanoseconds since
+            //! the epoch of Clock.
+            std::uint64_t time;
+
+            //! @brief Type of the event.
+            EventType type;
+
+            //! @brief Reserved.
+            std::uint16_t reserved;
+
+            //! @brief Identifier of the recording thread.
+            std::uint32_t thread;
+
+            //! @brief Object concerned by the event, or null.
+            std::uint64_t object;
+
+            //! @brief Value depending on the type.
+            std::uint64_t value;
+
+            //! @brief Text depending on the type, truncated and null-terminated.
+            char text[32];
+        };
+
+        static_assert(sizeof(Event) == 64, "Flight recorder events are 64 bytes.");
+
+        //! @brief Number of events kept by each thread.
+        static constexpr std::size_t kEventsPerThread = 1024;
+
+        /*! @brief Content of a dump, read with \ref Read. */
+        struct Dump
+        {
+            //! @brief Why the dump was written.
+            std::string reason;
+
+            //! @brief Time of the dump, in nanoseconds since the epoch of Clock.
+            std::uint64_t time = 0;
+
+            //! @brief Events of every thread, sorted by time.
+            std::vector < Event > events;
+        };
+
+    public:
+
+        /*! @brief Records an event for the calling thread.
+         *
+         * @param[in] type Type of the event.
+         * @param[in] object Object concerned, or null.
+         * @param[in] value Value depending on type.
+         * @param[in] text Text copied in the event (truncated), or null.
+         * @param[in] suffix If not null, appended to text after a ':' character.
+         */
+        static void Record(EventType type, const void* object, std::uint64_t value, const char* text,
+                           const char* suffix = nullptr);
+
+        /*! @brief Records an application event. */
+        static void Mark(const char* text, std::uint64_t value = 0);
+
+        /*! @brief Enables or disables recording. Enabled by default. */
+        static void SetEnabled(bool enabled);
+
+        /*! @brief Returns true if events are recorded. */
+        static bool Enabled();
+
+        /*! @brief Sets the file written by \ref Write. An empty path disables dumps (the default). Must be
+         * called before any thread can dump. */
+        static void SetDumpPath(const std::string& path);
+
+        /*! @brief Enables or disables dumps when an RD::Exception is constructed. Enabled by default. */
+        static void SetDumpOnException(bool enabled);
+
+        /*! @brief Writes every ring to the dump path. Async-signal-safe.
+         *
+         * @param[in] reason Why the dump is written, truncated to 127 characters.
+         * @return True if the dump was written.
+         */
+        static bool Write(const char* reason);
+
+        /*! @brief Records an exception and dumps the rings if enabled. Called by RD::Exception. */
+        static void RecordException(std::uint32_t code, const char* message);
+
+        /*! @brief Dumps the rings on SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT, then calls the handler
+         * previously installed for the signal. */
+        static void InstallSignalHandlers();
+
+        /*! @brief Reads a dump written by \ref Write.
+         * @throw FileOpenException if the file can not be read or is not a flight recorder dump.
+         */
+        static Dump Read(const std::string& path);
+
+        /*! @brief Returns the name of an event type. */
+        static const char* TypeName(EventType type);
+    };
+}
+
+#endif /* FlightRecorder_h */
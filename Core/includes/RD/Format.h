@@ -0,0 +1,381 @@
+//
+//  Format.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Format_h
+#define Format_h
+
+#include "Global.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace RD
+{
+    /**
+     * @brief Type-safe printf-like formatting, used by Exception and Notification.
+     *
+     * Formats use printf's syntax, but each argument is formatted from its C++ type: length modifiers ('l',
+     * 'll', 'z', ...) are accepted and ignored, and std::string or std::string_view can be given to '%s'.
+     * Integers, pointers, strings and '%f' are formatted without calling the C library. Other conversions,
+     * and the few cases where a fast path can not guarantee printf's output (like a '%f' value too close to
+     * a rounding tie), fall back to snprintf.
+     *
+     * Formats written with \ref RDFormatString are checked at compile time against the arguments' types:
+     * a wrong conversion or a wrong number of arguments fails to compile. A format given as a plain string
+     * is checked while formatting: a conversion which does not match its argument prints '?'.
+     *
+     * Output is written in a caller-provided buffer (\ref FormatTo), in a FormatBuffer holding a small inline
+     * buffer, or in a std::string. Truncation is never silent: every function returns the size the whole
+     * output needs.
+     *
+     * FormatStringTag is the base of the types created by \ref RDFormatString.
+     */
+    struct FormatStringTag
+    {
+
+    };
+
+    /*! @brief Creates a format checked at compile time by the formatting functions.
+     *
+     * @code
+     * throw NullPointerException(RDFormatString("Null pointer in %s (%d)."), name, line);
+     * @endcode
+     */
+#   define RDFormatString(string)                                                                     \
+        []() {                                                                                          \
+            struct RDFormatStringLiteral : RD::FormatStringTag {                                       \
+                static constexpr const char* value() { return string; }                                \
+                constexpr operator const char* () const { return string; }                             \
+            };                                                                                          \
+            return RDFormatStringLiteral{};                                                             \
+        }()
+
+    /**
+     * @brief An argument of a format, with its type erased.
+     */
+    class FormatArgument
+    {
+    public:
+
+        /*! @brief Kind of value held. */
+        enum class Type : std::uint8_t
+        {
+            Int, UInt, Double, Pointer, String
+        };
+
+    private:
+
+        //! @brief Kind of value held.
+        Type type;
+
+        //! @brief Size in bytes of an integer argument, to print negative values with unsigned conversions.
+        std::uint8_t bytes = 8;
+
+        //! @brief Value held.
+        union
+        {
+            std::int64_t i;
+            std::uint64_t u;
+            double d;
+            const void* p;
+            struct { const char* data; std::size_t size; } s;
+        };
+
+    public:
+
+        /*! @brief Constructs an argument from a value printf accepts, a std::string or a std::string_view. */
+        template < typename T >
+        FormatArgument(const T& value) noexcept
+        {
+            using Type_ = std::decay_t < T >;
+
+            if constexpr (std::is_array_v < T > && std::is_same_v < std::remove_cv_t < std::remove_extent_t < T > >, char >)
+            {
+                // Arrays and string literals are never null: no check, which warns under -Wall.
+                type = Type::String;
+                s.data = value;
+                s.size = std::char_traits < char >::length(value);
+            }
+            else if constexpr (std::is_same_v < Type_, char* > || std::is_same_v < Type_, const char* >)
+            {
+                type = value ? Type::String : Type::Pointer;
+                s.data = value;
+                s.size = value ? std::char_traits < char >::length(value) : 0;
+            }
+            else if constexpr (std::is_same_v < Type_, std::string > || std::is_same_v < Type_, std::string_view >)
+            {
+                type = Type::String;
+                s.data = value.data();
+                s.size = value.size();
+            }
+            else if constexpr (std::is_floating_point_v < Type_ >)
+            {
+                type = Type::Double;
+                d = static_cast < double >(value);
+            }
+            else if constexpr (std::is_enum_v < Type_ >)
+            {
+                *this = FormatArgument(static_cast < std::underlying_type_t < Type_ > >(value));
+            }
+            else if constexpr (std::is_integral_v < Type_ > && std::is_signed_v < Type_ >)
+            {
+                type = Type::Int;
+                bytes = sizeof(Type_);
+                i = static_cast < std::int64_t >(value);
+            }
+            else if constexpr (std::is_integral_v < Type_ >)
+            {
+                type = Type::UInt;
+                bytes = sizeof(Type_);
+                u = static_cast < std::uint64_t >(value);
+            }
+            else if constexpr (std::is_null_pointer_v < Type_ >)
+            {
+                type = Type::Pointer;
+                p = nullptr;
+            }
+            else
+            {
+                static_assert(std::is_pointer_v < Type_ >, "Argument can not be formatted.");
+
+                type = Type::Pointer;
+                p = reinterpret_cast < const void* >(value);
+            }
+        }
+
+        /*! @brief Returns the kind of value held. */
+        Type kind() const noexcept { return type; }
+
+        /*! @brief Returns the size in bytes of an integer argument. */
+        std::size_t size() const noexcept { return bytes; }
+
+        /*! @brief Returns the value as a signed integer. */
+        std::int64_t asInt() const noexcept { return i; }
+
+        /*! @brief Returns the value as an unsigned integer. */
+        std::uint64_t asUInt() const noexcept { return u; }
+
+        /*! @brief Returns the value as a double. */
+        double asDouble() const noexcept { return d; }
+
+        /*! @brief Returns the value as a pointer. Null strings are held as pointers. */
+        const void* asPointer() const noexcept { return p; }
+
+        /*! @brief Returns the value as a string. */
+        std::string_view asString() const noexcept { return std::string_view(s.data, s.size); }
+    };
+
+    /*! @brief Result of a formatting function. */
+    struct FormatResult
+    {
+        //! @brief Number of characters of the whole output, not counting the terminating null character.
+        std::size_t size = 0;
+
+        //! @brief True if the output did not fit in the buffer.
+        bool truncated = false;
+    };
+
+    /*! @brief Formats type-erased arguments.
+     *
+     * @param[out] buffer Buffer receiving the output, always null-terminated if capacity is not zero.
+     * @param[in] capacity Size of buffer.
+     * @param[in] format printf-like format.
+     * @param[in] arguments Arguments of the format.
+     * @param[in] count Number of arguments.
+     */
+    FormatResult FormatArguments(char* buffer, std::size_t capacity, const char* format,
+                                 const FormatArgument* arguments, std::size_t count) noexcept;
+
+    /*! @brief Formats type-erased arguments in a std::string. Allocates only for the string. */
+    std::string FormatArgumentsToString(const char* format, const FormatArgument* arguments, std::size_t count);
+
+    namespace FormatDetail
+    {
+        /*! @brief Category of an argument type, as seen by a conversion. */
+        enum class Category
+        {
+            Integer, Floating, String, Pointer, Invalid
+        };
+
+        /*! @brief Returns the category of T. */
+        template < typename T >
+        constexpr Category CategoryOf()
+        {
+            using Type = std::decay_t < T >;
+
+            if constexpr (std::is_same_v < Type, char* > || std::is_same_v < Type, const char* > ||
+                          std::is_same_v < Type, std::string > || std::is_same_v < Type, std::string_view >)
+                return Category::String;
+            else if constexpr (std::is_floating_point_v < Type >)
+                return Category::Floating;
+            else if constexpr (std::is_integral_v < Type > || std::is_enum_v < Type >)
+                return Category::Integer;
+            else if constexpr (std::is_pointer_v < Type > || std::is_null_pointer_v < Type >)
+                return Category::Pointer;
+            else
+                return Category::Invalid;
+        }
+
+        /*! @brief Returns true if a conversion accepts an argument of the given category. */
+        constexpr bool Accepts(char conversion, Category category)
+        {
+            switch (conversion)
+            {
+                case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+                    return category == Category::Integer;
+
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    return category == Category::Floating;
+
+                case 's':
+                    return category == Category::String;
+
+                case 'p':
+                    return category == Category::Pointer || category == Category::String;
+
+                default:
+                    return false;
+            }
+        }
+
+        /*! @brief Returns true if format matches the categories of its arguments. */
+        constexpr bool Check(const char* format, const Category* categories, std::size_t count)
+        {
+            std::size_t index = 0;
+
+            while (*format)
+            {
+                if (*format++ != '%')
+                    continue;
+
+                if (*format == '%')
+                {
+                    format++;
+                    continue;
+                }
+
+                while (*format == '-' || *format == '+' || *format == ' ' || *format == '#' || *format == '0')
+                    format++;
+
+                // Widths and precisions given as '*' take an integer argument.
+                for (int part = 0; part < 2; ++part)
+                {
+                    if (part == 1)
+                    {
+                        if (*format != '.')
+                            break;
+                        format++;
+                    }
+
+                    if (*format == '*')
+                    {
+                        if (index >= count || categories[index++] != Category::Integer)
+                            return false;
+                        format++;
+                    }
+
+                    while (*format >= '0' && *format <= '9')
+                        format++;
+                }
+
+                while (*format == 'h' || *format == 'l' || *format == 'L' || *format == 'q' ||
+                       *format == 'j' || *format == 'z' || *format == 't')
+                    format++;
+
+                if (!*format || index >= count || !Accepts(*format, categories[index++]))
+                    return false;
+
+                format++;
+            }
+
+            return index == count;
+        }
+
+        /*! @brief Returns the format held by a format type. */
+        inline const char* StringOf(const char* format) noexcept { return format; }
+
+        /*! @brief Returns the format held by a format type. */
+        template < typename Format, typename = std::enable_if_t < std::is_base_of_v < FormatStringTag, Format > > >
+        constexpr const char* StringOf(const Format&) noexcept { return Format::value(); }
+    }
+
+    /*! @brief Returns true if Format is not checked at compile time, or if it matches Args. */
+    template < typename Format, typename... Args >
+    constexpr bool CheckFormat()
+    {
+        if constexpr (std::is_base_of_v < FormatStringTag, Format >)
+        {
+            constexpr FormatDetail::Category categories[] = { FormatDetail::CategoryOf < Args >()..., FormatDetail::Category::Invalid };
+            return FormatDetail::Check(Format::value(), categories, sizeof...(Args));
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    /*! @brief Formats arguments in a caller-provided buffer. The output is always null-terminated.
+     *
+     * @return The size of the whole output. If it is not less than capacity, the output was truncated.
+     */
+    template < typename Format, typename... Args >
+    FormatResult FormatTo(char* buffer, std::size_t capacity, const Format& format, const Args&... args) noexcept
+    {
+        static_assert(CheckFormat < Format, Args... >(), "Format does not match the arguments' types.");
+
+        const FormatArgument arguments[] = { FormatArgument(args)..., FormatArgument(0) };
+        return FormatArguments(buffer, capacity, FormatDetail::StringOf(format), arguments, sizeof...(Args));
+    }
+
+    /*! @brief Formats arguments in a std::string. */
+    template < typename Format, typename... Args >
+    std::string FormatToString(const Format& format, const Args&... args)
+    {
+        static_assert(CheckFormat < Format, Args... >(), "Format does not match the arguments' types.");
+
+        const FormatArgument arguments[] = { FormatArgument(args)..., FormatArgument(0) };
+        return FormatArgumentsToString(FormatDetail::StringOf(format), arguments, sizeof...(Args));
+    }
+
+    /**
+     * @brief Formats arguments in an inline buffer of Capacity characters (including the terminating null).
+     *
+     * Output which does not fit is truncated, and \ref truncated returns true.
+     */
+    template < std::size_t Capacity >
+    class FormatBuffer
+    {
+        //! @brief Output.
+        char data[Capacity];
+
+        //! @brief Result of the formatting.
+        FormatResult result;
+
+    public:
+
+        /*! @brief Formats arguments in the buffer. */
+        template < typename Format, typename... Args >
+        FormatBuffer(const Format& format, const Args&... args) noexcept
+        {
+            result = FormatTo(data, Capacity, format, args...);
+        }
+
+        /*! @brief Returns the output, null-terminated. */
+        const char* c_str() const noexcept { return data; }
+
+        /*! @brief Returns the output. */
+        std::string_view view() const noexcept { return std::string_view(data, truncated() ? Capacity - 1 : result.size); }
+
+        /*! @brief Returns true if the output did not fit. */
+        bool truncated() const noexcept { return result.truncated; }
+
+        /*! @brief Returns the size the whole output needs. */
+        std::size_t size() const noexcept { return result.size; }
+    };
+}
+
+#endif /* Format_h */
@@ -0,0 +1,113 @@
+//
+//  FramePipeline.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef FramePipeline_h
+#define FramePipeline_h
+
+#include "Global.h"
+#include "Handle.h"
+
+#include <condition_variable>
+#include <exception>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Snapshot of one frame, produced by the simulation stage and consumed by the render stage.
+     *
+     * Users derive FrameData to store whatever the render stage needs (transforms, draw lists, camera...).
+     * Instances are created once by \ref ApplicationDelegate::onApplicationCreateFrameData and reused: the
+     * simulation stage must overwrite every field it uses at each frame.
+     */
+    class FrameData
+    {
+    public:
+
+        //! @brief Index of the frame, incremented at each simulated frame.
+        std::uint64_t frame = 0;
+
+        //! @brief Time point at which the frame was simulated.
+        Clock::time_point time;
+
+        /*! @brief Default destructor. */
+        virtual ~FrameData() = default;
+    };
+
+    /**
+     * @brief Bounded ring of FrameData handed from one producer thread to one consumer thread.
+     *
+     * The producer (simulation stage) acquires a free frame with \ref acquireWrite, fills it and calls
+     * \ref publish. The consumer (render stage) acquires the oldest published frame with \ref acquireRead
+     * and gives it back with \ref release. A frame is never accessed by both stages at the same time.
+     *
+     * The depth of the ring bounds latency: with a depth of N, simulation is at most N - 1 frames ahead of
+     * rendering, and \ref acquireWrite blocks until the render stage releases a frame. A depth of 2 is double
+     * buffering (simulate frame N + 1 while rendering frame N), a depth of 3 is triple buffering.
+     */
+    class FramePipeline
+    {
+        //! @brief Frames of the ring.
+        std::vector < Handle < FrameData > > frames;
+
+        //! @brief Number of frames published by the producer.
+        std::uint64_t published;
+
+        //! @brief Number of frames released by the consumer.
+        std::uint64_t released;
+
+        //! @brief True when the pipeline is closed.
+        bool closed;
+
+        //! @brief Error which closed the pipeline, if any.
+        std::exception_ptr error;
+
+        //! @brief Mutex protecting counters.
+        std::mutex mutex;
+
+        //! @brief Condition notified when a frame is published or released, or the pipeline is closed.
+        std::condition_variable condition;
+
+    public:
+
+        /*! @brief Constructs the pipeline with the given frames. Its depth is the number of frames. */
+        explicit FramePipeline( std::vector < Handle < FrameData > >&& data );
+
+        /*! @brief Returns the number of frames in the ring. */
+        std::size_t depth() const;
+
+        /*! @brief Waits for a free frame.
+         *
+         * @return The frame to fill, or nullptr if the pipeline was closed.
+         *
+         * @note
+         * If the pipeline was closed with an error, the error is rethrown.
+         */
+        FrameData* acquireWrite();
+
+        /*! @brief Makes the frame acquired with acquireWrite() available to the consumer. */
+        void publish();
+
+        /*! @brief Waits for the oldest published frame.
+         *
+         * @return The frame to consume, or nullptr if the pipeline is closed and every published frame
+         *      has been consumed.
+         */
+        const FrameData* acquireRead();
+
+        /*! @brief Gives the frame acquired with acquireRead() back to the producer. */
+        void release();
+
+        /*! @brief Closes the pipeline, waking up both stages.
+         *
+         * @param[in] reason Error rethrown by the next call to acquireWrite(), or nullptr for a normal close.
+         */
+        void close( std::exception_ptr reason = nullptr );
+    };
+}
+
+#endif /* FramePipeline_h */
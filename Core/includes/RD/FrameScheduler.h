@@ -0,0 +1,174 @@
+//
+//  FrameScheduler.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef FrameScheduler_h
+#define FrameScheduler_h
+
+#include "Global.h"
+
+#include <condition_variable>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Frame times measured by a FrameScheduler.
+     */
+    struct FrameStatistics
+    {
+        //! @brief Number of frames measured.
+        std::uint64_t frames = 0;
+
+        //! @brief Duration between the beginning of the last two frames.
+        Clock::duration last = Clock::duration::zero();
+
+        //! @brief Shortest frame duration.
+        Clock::duration minimum = Clock::duration::max();
+
+        //! @brief Longest frame duration.
+        Clock::duration maximum = Clock::duration::zero();
+
+        //! @brief Exponential moving average of the frame duration (1/16 weight for the last frame).
+        Clock::duration average = Clock::duration::zero();
+
+        //! @brief Time spent working in the last frame, without waiting.
+        Clock::duration work = Clock::duration::zero();
+
+        //! @brief Number of fixed steps run.
+        std::uint64_t fixedSteps = 0;
+
+        //! @brief Number of fixed steps dropped because the catch-up bound was reached.
+        std::uint64_t droppedSteps = 0;
+    };
+
+    /**
+     * @brief Paces the Application's run loop.
+     *
+     * The scheduler has three modes:
+     *  - unpaced (target rate of zero, the default): frames run back to back.
+     *  - paced: frames start at a target rate. The scheduler sleeps until shortly before the next frame,
+     *    then spins for the remaining time, because sleeping is not accurate below the scheduler's quantum.
+     *  - idle: the loop blocks until work is posted with \ref post, \ref wake is called, or the deadline
+     *    given to \ref wait (the next timer) is reached. This is the mode for headless servers.
+     *
+     * Independently of the mode, a fixed timestep can be set. Elapsed time is accumulated and consumed by
+     * steps of fixed duration with \ref fixedSteps. The number of steps per frame is bounded, so a long
+     * frame does not trigger a spiral of catch-up steps: exceeding time is dropped.
+     *
+     * @note
+     * \ref post and \ref wake can be called from any thread. Other functions must be called by the thread
+     * running the loop.
+     */
+    class FrameScheduler
+    {
+        //! @brief Duration of a frame in paced mode, or zero when unpaced.
+        Clock::duration period;
+
+        //! @brief Time spinned before each paced frame instead of sleeping.
+        Clock::duration spinThreshold;
+
+        //! @brief True when in idle mode.
+        bool idle;
+
+        //! @brief Duration of a fixed step, or zero if disabled.
+        Clock::duration step;
+
+        //! @brief Maximum number of fixed steps run in one frame.
+        std::uint32_t maxSteps;
+
+        //! @brief Time not consumed by fixed steps yet.
+        Clock::duration accumulator;
+
+        //! @brief Beginning of the current frame.
+        Clock::time_point frameStart;
+
+        //! @brief Time point at which the next paced frame begins.
+        Clock::time_point nextFrame;
+
+        //! @brief Measured frame times.
+        FrameStatistics statistics;
+
+        //! @brief Work posted to the loop's thread.
+        std::vector < std::function < void() > > posted;
+
+        //! @brief True when wake() has been called since the last wait.
+        bool woken;
+
+        //! @brief Mutex protecting posted and woken.
+        std::mutex mutex;
+
+        //! @brief Condition notified by post() and wake().
+        std::condition_variable condition;
+
+    public:
+
+        /*! @brief Constructs an unpaced scheduler without fixed timestep. */
+        FrameScheduler();
+
+        /*! @brief Sets the number of frames per second in paced mode. Zero disables pacing. */
+        void setTargetRate( double hertz );
+
+        /*! @brief Returns the duration of a paced frame, or zero when unpaced. */
+        Clock::duration targetPeriod() const;
+
+        /*! @brief Changes the time spinned before each paced frame. One millisecond by default. */
+        void setSpinThreshold( Clock::duration threshold );
+
+        /*! @brief Enables or disables idle mode. Idle mode takes precedence over the target rate. */
+        void setIdle( bool enabled );
+
+        /*! @brief Returns true in idle mode. */
+        bool isIdle() const;
+
+        /*! @brief Sets the fixed timestep.
+         *
+         * @param[in] duration Duration of a fixed step, or zero to disable fixed steps.
+         * @param[in] maximum Maximum number of steps run in one frame.
+         */
+        void setFixedTimestep( Clock::duration duration, std::uint32_t maximum = 8 );
+
+        /*! @brief Returns the duration of a fixed step. */
+        Clock::duration fixedTimestep() const;
+
+        /*! @brief Marks the beginning of a frame and updates statistics. */
+        void beginFrame( const Clock::time_point& now );
+
+        /*! @brief Returns the number of fixed steps to run in this frame, and consumes their time. */
+        std::uint32_t fixedSteps();
+
+        /*! @brief Returns the time not consumed by fixed steps, as a fraction of a step in [0, 1).
+         * Useful to interpolate between the last two fixed states. */
+        double interpolation() const;
+
+        /*! @brief Calls every work posted since the last call, in the order they were posted. */
+        void runPosted();
+
+        /*! @brief Waits until the next frame should begin.
+         *
+         * @param[in] deadline Time point at which the wait must end in any case, usually the next timer.
+         */
+        void wait( const Clock::time_point& deadline );
+
+        /*! @brief Posts work to be called on the loop's thread at the beginning of the next frame, and
+         * wakes up the loop. */
+        void post( std::function < void() >&& work );
+
+        /*! @brief Wakes up the loop if it is waiting. */
+        void wake();
+
+        /*! @brief Returns measured frame times. */
+        const FrameStatistics& getStatistics() const;
+
+    private:
+
+        /*! @brief Blocks until woken, work is posted (if wakeOnPosted is true), or the time point is reached.
+         * Returns true if woken by wake(). */
+        bool sleepUntil( const Clock::time_point& time, bool wakeOnPosted );
+    };
+}
+
+#endif /* FrameScheduler_h */
@@ -26,6 +26,10 @@
 #include <string>
 #include <queue>
 #include <functional>
+#include <cstring>
+#include <cassert>
+#include <atomic>
+#include <vector>
 
 namespace RD
 {
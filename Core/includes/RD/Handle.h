@@ -11,6 +11,7 @@
 
 #include "Global.h"
 #include "Exception.h"
+#include "Expected.h"
 #include "Allocator.h"
 
 namespace RD
@@ -77,6 +78,22 @@ namespace RD
         /*! @brief Returns true if handled object has only one shared pointer. */
         inline bool owned() const noexcept { return instance.unique(); }
         
+        /*! @brief Returns a pointer to the handled object, or a kErrorNullPointer error if null. */
+        Expected < Handled* > tryGet()
+        {
+            if ( !instance )
+                return Error( kErrorNullPointer, RDFormatString("%s: Null handled object but 'tryGet' is called."), typeid(*this).name() );
+            return instance.get();
+        }
+        
+        /*! @brief Returns a pointer to the handled object, or a kErrorNullPointer error if null. */
+        Expected < const Handled* > tryGet() const
+        {
+            if ( !instance )
+                return Error( kErrorNullPointer, RDFormatString("%s: Null handled object but 'tryGet' is called."), typeid(*this).name() );
+            return static_cast < const Handled* >( instance.get() );
+        }
+        
         /*! @brief Returns the handled object.
          *
          * If null, throws a NullPointerException exception.
@@ -84,7 +101,7 @@ namespace RD
         Handled& operator * ()
         {
             if ( !instance )
-                throw NullPointerException( "%s: Null handled object but 'operator *' is called.", typeid(*this).name() );
+                throw NullPointerException( RDFormatString("%s: Null handled object but 'operator *' is called."), typeid(*this).name() );
             return *instance;
         }
         
@@ -95,7 +112,7 @@ namespace RD
         const Handled& operator * () const
         {
             if ( !instance )
-                throw NullPointerException( "%s: Null handled object but 'operator *' is called.", typeid(*this).name() );
+                throw NullPointerException( RDFormatString("%s: Null handled object but 'operator *' is called."), typeid(*this).name() );
             return *instance;
         }
         
@@ -87,6 +87,9 @@ namespace RD
         constexpr bool operator==(const HashedString &other) const noexcept {
             return hash == other.hash;
         }
+        constexpr bool operator<(const HashedString &other) const noexcept {
+            return hash < other.hash;
+        }
         
     private:
         const hash_type hash;
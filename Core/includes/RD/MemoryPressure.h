@@ -0,0 +1,231 @@
+//
+//  MemoryPressure.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef MemoryPressure_h
+#define MemoryPressure_h
+
+#include "Global.h"
+#include "HashedString.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RD
+{
+    /** @defgroup MemoryPressureNotifications
+     * @{
+     */
+
+    static constexpr HashedString kMemoryPressureNotification = "MemoryPressureNotification";
+
+    /** @} */
+
+    /**
+     * @brief How much the system lacks memory.
+     */
+    enum class MemoryPressureLevel : std::uint32_t
+    {
+        //! @brief No pressure.
+        None = 0,
+
+        //! @brief Some tasks stall on memory, or the cgroup went over memory.high: reclaim what is cheap.
+        Moderate = 1,
+
+        //! @brief Every task stalls on memory, or the cgroup hit memory.max or the OOM killer: reclaim
+        //! everything possible.
+        Critical = 2
+    };
+
+    /*! @brief Returns the name of a level, like 'Moderate'. */
+    const char* MemoryPressureLevelName(MemoryPressureLevel level) noexcept;
+
+    /**
+     * @brief Priorities of reclaimers, see MemoryPressureMonitor::addReclaimer. Reclaimers of lower
+     * priority are called first.
+     */
+    namespace MemoryReclaimPriority
+    {
+        //! @brief Memory nobody uses anymore, like retired resources or free lists.
+        static constexpr int Unused = 0;
+
+        //! @brief Caches, rebuilt on demand.
+        static constexpr int Cache = 100;
+
+        //! @brief Memory expensive to rebuild, like resident assets.
+        static constexpr int Expensive = 200;
+    }
+
+    /**
+     * @brief Configuration of a MemoryPressureMonitor.
+     */
+    struct MemoryPressureConfiguration
+    {
+        //! @brief Stall of some tasks, in a window, reported as MemoryPressureLevel::Moderate.
+        std::chrono::microseconds someStall { 150000 };
+
+        //! @brief Stall of every task, in a window, reported as MemoryPressureLevel::Critical.
+        std::chrono::microseconds fullStall { 100000 };
+
+        //! @brief PSI window. Unprivileged processes need a multiple of 2 seconds.
+        std::chrono::microseconds window { 2000000 };
+
+        //! @brief Period at which pressure averages are read, when PSI triggers can not be created.
+        std::chrono::milliseconds pollInterval { 1000 };
+
+        //! @brief Bytes reclaimed at MemoryPressureLevel::Moderate before reclaimers stop being called.
+        std::size_t moderateTarget = std::size_t(64) << 20;
+
+        //! @brief Directory of the cgroup v2 watched, like '/sys/fs/cgroup/app'. Empty to use the
+        //! process' cgroup.
+        std::string cgroupPath;
+    };
+
+    /**
+     * @brief Watches the memory pressure of the process, and calls the reclaimers registered by the
+     * engine's subsystems on the main thread before the kernel runs out of memory.
+     *
+     * On Linux, \ref start creates a thread waiting for:
+     * - PSI triggers on the memory.pressure of the process' cgroup v2, or on /proc/pressure/memory
+     *   otherwise: a stall of some tasks is a Moderate pressure, a stall of every task a Critical one.
+     *   If triggers can not be created, pressure averages are read every pollInterval instead.
+     * - The cgroup v2 memory.events: 'high' events are a Moderate pressure, 'max', 'oom' and 'oom_kill'
+     *   events a Critical one.
+     *
+     * The thread only records the highest level seen, and wakes the main loop. \ref dispatch, called by
+     * Application at the beginning of each tick, calls the reclaimers by increasing priority, then
+     * bigger estimate first: at Moderate, until moderateTarget bytes are reclaimed; at Critical, all of
+     * them. It then notifies kMemoryPressureNotification. Other platforms only get pressures signaled
+     * with \ref signal.
+     *
+     * Driver registers its retired resources with priority MemoryReclaimPriority::Unused.
+     */
+    class MemoryPressureMonitor
+    {
+    public:
+
+        /*! @brief Returns an estimate of the bytes a reclaimer can free. */
+        using EstimateFunction = std::function < std::size_t() >;
+
+        /*! @brief Frees memory, trying to free target bytes, and returns the bytes freed. */
+        using ReclaimFunction = std::function < std::size_t(MemoryPressureLevel level, std::size_t target) >;
+
+    private:
+
+        /*! @brief A registered reclaimer. */
+        struct Reclaimer
+        {
+            std::uint64_t id;
+            std::string name;
+            int priority;
+            EstimateFunction estimate;
+            ReclaimFunction reclaim;
+            bool removed;
+        };
+
+        //! @brief Reclaimers, in registration order.
+        std::vector < std::shared_ptr < Reclaimer > > reclaimers;
+
+        //! @brief Mutex protecting reclaimers, held while they are called. Recursive, so reclaimers can
+        //! be removed from a reclaim function.
+        mutable std::recursive_mutex reclaimersMutex;
+
+        //! @brief Next reclaimer's identifier.
+        std::uint64_t nextId = 1;
+
+        //! @brief Highest level signaled since the last dispatch.
+        std::atomic < std::uint32_t > pending { 0 };
+
+        //! @brief Level of the last dispatch.
+        std::atomic < std::uint32_t > lastLevel { 0 };
+
+        //! @brief Configuration given to start.
+        MemoryPressureConfiguration configuration;
+
+        //! @brief Called when a pressure is signaled, to wake the main loop.
+        std::function < void() > wake;
+
+        //! @brief Mutex protecting wake, held while it is called.
+        std::mutex wakeMutex;
+
+        //! @brief Thread watching the kernel.
+        std::thread thread;
+
+        //! @brief Descriptor written to stop the thread, or -1.
+        int stopDescriptor = -1;
+
+        //! @brief Mutex serializing start and stop.
+        std::mutex threadMutex;
+
+    public:
+
+        /*! @brief Returns the monitor started by Application. Never destroyed. */
+        static MemoryPressureMonitor& Default();
+
+        /*! @brief Constructs a stopped monitor. */
+        MemoryPressureMonitor() = default;
+
+        /*! @brief Stops the monitor. */
+        ~MemoryPressureMonitor();
+
+        MemoryPressureMonitor(const MemoryPressureMonitor&) = delete;
+        MemoryPressureMonitor& operator = (const MemoryPressureMonitor&) = delete;
+
+        /*! @brief Starts watching the kernel, if not already.
+         *
+         * @param[in] configuration Triggers and targets.
+         * @param[in] wakeFunction Called from the monitor's thread when a pressure is signaled, like
+         *      Application::wake. May be empty.
+         * @return False if no source of pressure could be watched, or on platforms other than Linux.
+         */
+        bool start(const MemoryPressureConfiguration& configuration, std::function < void() > wakeFunction);
+
+        /*! @brief Stops watching the kernel, and removes the wake function given to \ref start. Pressures
+         * already signaled are still dispatched. */
+        void stop();
+
+        /*! @brief Registers a reclaimer.
+         *
+         * @param[in] name Name, for notifications.
+         * @param[in] priority Reclaimers of lower priority are called first. See MemoryReclaimPriority.
+         * @param[in] estimate Returns how many bytes the reclaimer could free. Called on the main thread.
+         * @param[in] reclaim Frees memory. Called on the main thread.
+         * @return Identifier for \ref removeReclaimer.
+         */
+        std::uint64_t addReclaimer(const std::string& name, int priority, EstimateFunction estimate, ReclaimFunction reclaim);
+
+        /*! @brief Unregisters a reclaimer. Once returned, the reclaimer is not called anymore, unless it
+         * is removed from the thread dispatching. */
+        void removeReclaimer(std::uint64_t id);
+
+        /*! @brief Records a pressure, dispatched at the next \ref dispatch, and wakes the main loop. Can
+         * be called from any thread. */
+        void signal(MemoryPressureLevel level);
+
+        /*! @brief Calls the reclaimers for the pressure signaled since the last call, if any, and notifies
+         * kMemoryPressureNotification. Called by Application at the beginning of each tick.
+         *
+         * @return The bytes reclaimed.
+         */
+        std::size_t dispatch();
+
+        /*! @brief Returns the sum of the reclaimers' estimates. */
+        std::size_t reclaimableBytes() const;
+
+        /*! @brief Returns the level of the last pressure dispatched. */
+        MemoryPressureLevel level() const noexcept;
+
+    private:
+
+        /*! @brief Main function of the monitor's thread, until stopEvent is written. */
+        void run(MemoryPressureConfiguration configuration, int stopEvent);
+    };
+}
+
+#endif /* MemoryPressure_h */
@@ -11,6 +11,7 @@
 
 #include "Handle.h"
 #include "Emitter.h"
+#include "Signal.h"
 
 namespace RD
 {
@@ -43,6 +44,40 @@ namespace RD
         virtual void onModuleDidUpdate(Module*) {}
     };
     
+    /**
+     * @brief ModuleListener events as Signals.
+     *
+     * Any class implementing ModuleListener's functions can be connected with \ref connect. Stubs call the
+     * functions on the listener's static type, so they are not virtual calls if the listener's class (or its
+     * functions) are final.
+     */
+    struct ModuleSignals
+    {
+        Signal < Module* > didStart;
+        Signal < Module* > willTerminate;
+        Signal < Module* > willUpdate;
+        Signal < Module* > didUpdate;
+        
+        /*! @brief Connects every ModuleListener function of a listener. */
+        template < typename Listener >
+        void connect(Listener* listener)
+        {
+            didStart.connect(listener, [](void* l, Module* m){ static_cast < Listener* >(l)->onModuleDidStart(m); });
+            willTerminate.connect(listener, [](void* l, Module* m){ static_cast < Listener* >(l)->onModuleWillTerminate(m); });
+            willUpdate.connect(listener, [](void* l, Module* m){ static_cast < Listener* >(l)->onModuleWillUpdate(m); });
+            didUpdate.connect(listener, [](void* l, Module* m){ static_cast < Listener* >(l)->onModuleDidUpdate(m); });
+        }
+        
+        /*! @brief Disconnects every function of a listener. */
+        void disconnect(const void* listener)
+        {
+            didStart.disconnect(listener);
+            willTerminate.disconnect(listener);
+            willUpdate.disconnect(listener);
+            didUpdate.disconnect(listener);
+        }
+    };
+    
     /**
      * @brief Generic module design.
      *
@@ -0,0 +1,100 @@
+//
+//  NodeArena.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NodeArena_h
+#define NodeArena_h
+
+#include "Global.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Linear allocator which memory is placed on a given NUMA node.
+     *
+     * Memory is reserved by chunks mapped directly from the system. On Linux, each chunk is bound to the
+     * arena's node with a preferred memory policy, so pages are allocated on this node while it has free
+     * memory. On other platforms, or if the node is negative, chunks are regular allocations.
+     *
+     * Allocations are never freed individually: \ref reset makes every chunk available again. This makes
+     * NodeArena well suited for worker-local scratch memory, reset at every task or frame.
+     *
+     * @note
+     * A NodeArena is not thread-safe. WorkerPool gives one arena to each of its workers, accessible
+     * with \ref WorkerPool::LocalArena.
+     */
+    class NodeArena
+    {
+        /*! @brief A chunk of memory mapped from the system. */
+        struct Chunk
+        {
+            unsigned char* memory;
+            std::size_t size;
+        };
+
+        //! @brief Chunks mapped, in order of allocation.
+        std::vector < Chunk > chunks;
+
+        //! @brief Index of the chunk currently used.
+        std::size_t current;
+
+        //! @brief Offset of the next allocation in the current chunk.
+        std::size_t offset;
+
+        //! @brief Default size of a chunk.
+        std::size_t chunkSize;
+
+        //! @brief NUMA node of this arena.
+        int nodeId;
+
+    public:
+
+        /*! @brief Constructs an empty arena. No memory is mapped until the first allocation.
+         *
+         * @param[in] node NUMA node where memory is placed, or -1 for no placement.
+         * @param[in] chunk Size of each chunk. Larger allocations get their own chunk.
+         */
+        explicit NodeArena(int node = -1, std::size_t chunk = 1 << 20);
+
+        /*! @brief Unmaps every chunk. */
+        ~NodeArena();
+
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator = (const NodeArena&) = delete;
+
+        /*! @brief Allocates memory from the arena.
+         *
+         * @param[in] size Number of bytes to allocate.
+         * @param[in] alignment Alignment of the returned pointer. Must be a power of two.
+         *
+         * @return A pointer to the memory, or nullptr if the system could not map a new chunk.
+         */
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /*! @brief Constructs an object in the arena. Its destructor is never called by the arena. */
+        template < typename T, typename... Args >
+        T* create(Args&&... args)
+        {
+            void* memory = allocate(sizeof(T), alignof(T));
+            return memory ? new (memory) T(std::forward < Args >(args)...) : nullptr;
+        }
+
+        /*! @brief Makes every chunk available again. Previous allocations must not be used anymore. */
+        void reset();
+
+        /*! @brief Returns the NUMA node of this arena. */
+        int node() const;
+
+        /*! @brief Returns the number of bytes mapped by this arena. */
+        std::size_t capacity() const;
+    };
+}
+
+#endif /* NodeArena_h */
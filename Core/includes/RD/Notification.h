@@ -9,56 +9,189 @@
 #define Notification_h
 
 #include "Global.h"
+#include "HashedString.h"
+#include "Format.h"
+#include "NotificationEncoding.h"
+
+#include <string_view>
+#include <tuple>
 
 namespace RD
 {
     /**
      * @brief Defines a Notification structure.
+     *
+     * A Notification is identified by its module, function and name, which are static identifiers
+     * (HashedString constants or string literals): they are never copied, and comparing them only
+     * compares their hashes.
+     *
+     * The message is formatted lazily. A notification sent with \ref NotificationCenter::Notifiate only
+     * references its format and its arguments, and formats the message the first time \ref message is
+     * called. If no observer reads the message, it is never formatted.
+     *
+     * Lazy notifications can also encode their arguments (see NotificationEncoding), so a sink can keep
+     * them and format the message later, on another thread.
+     *
+     * @note
+     * A lazy notification references arguments living on the sender's stack. Copying a Notification
+     * formats its message, so copies can be kept after the sender returns.
      */
     class Notification
     {
+    public:
+        
+        /*! @brief Function formatting a message from a format and captured arguments. */
+        typedef void (*Formatter)( const char* format, const void* arguments, std::string& message );
+        
+        /*! @brief Function encoding captured arguments with NotificationEncoding. Returns the number of bytes
+         * written. */
+        typedef std::size_t (*Encoder)( const void* arguments, unsigned char* buffer, std::size_t capacity );
+        
+    private:
+        
         //! @brief Module that sends this notification.
-        std::string moduleStr;
+        HashedString moduleId;
         
         //! @brief Function that sends this notification.
-        std::string functionStr;
+        HashedString functionId;
         
         //! @brief Unique notification identifier (name).
-        std::string notification;
+        HashedString nameId;
+        
+        //! @brief Format of the message.
+        const char* format;
+        
+        //! @brief Arguments captured by the sender, or null if the message is already formatted.
+        const void* arguments;
+        
+        //! @brief Formats the message from arguments, or null if the message is already formatted.
+        Formatter formatter;
+        
+        //! @brief Encodes arguments, or null if they can not be encoded.
+        Encoder encoder;
+        
+        //! @brief Message associated, formatted on first access.
+        mutable std::string messageStr;
         
-        //! @brief Message associated.
-        std::string messageStr;
+        //! @brief True when messageStr holds the message.
+        mutable bool formatted;
         
     public:
         
         /*! @brief Default constructor. */
-        Notification() noexcept = default;
+        Notification() noexcept;
         
-        /*! @brief Extended constructor. */
+        /*! @brief Extended constructor. The message is copied.
+         *
+         * @note
+         * moduleName, functionName and notifName must be static strings: they are referenced, not copied.
+         */
         Notification(const char* moduleName,
                      const char* functionName,
                      const char* notifName,
                      const char* message);
         
+        /*! @brief Constructs a notification which message is formatted on first access.
+         *
+         * @param[in] module Module that sends this notification.
+         * @param[in] function Function that sends this notification.
+         * @param[in] name Unique notification identifier.
+         * @param[in] fmt Format of the message.
+         * @param[in] args Arguments captured for the message. Must live as long as this notification.
+         * @param[in] fmtFunction Function formatting the message from fmt and args.
+         * @param[in] encFunction Function encoding args, or null.
+         */
+        Notification(const HashedString& module,
+                     const HashedString& function,
+                     const HashedString& name,
+                     const char* fmt,
+                     const void* args,
+                     Formatter fmtFunction,
+                     Encoder encFunction = nullptr) noexcept;
+        
+        /*! @brief Copy constructor. Formats the message of other if needed. */
+        Notification(const Notification& other);
+        
         /*! @brief Default destructor. */
         ~Notification() noexcept = default;
         
         /*! @brief Returns the notification's module. */
-        const std::string& module() const;
+        std::string_view module() const;
         
         /*! @brief Returns the notification's function. */
-        const std::string& function() const;
+        std::string_view function() const;
         
         /*! @brief Returns the notification's name. */
-        const std::string& name() const;
+        std::string_view name() const;
         
-        /*! @brief Returns the notification's message. */
+        /*! @brief Returns the notification's message, formatting it on first call. */
         const std::string& message() const;
+        
+        /*! @brief Returns the hash of the notification's module. */
+        HashedString::hash_type moduleHash() const;
+        
+        /*! @brief Returns the hash of the notification's name. */
+        HashedString::hash_type nameHash() const;
+        
+        /*! @brief Returns true if the notification has the given name. Only hashes are compared. */
+        bool is(const HashedString& notificationName) const;
+        
+        /*! @brief Encodes the notification's arguments for deferred formatting.
+         *
+         * If the notification has no encoder, or its message is already formatted, the message is encoded
+         * as a string argument of the format "%s".
+         *
+         * @param[out] buffer Buffer receiving the arguments.
+         * @param[in] capacity Size of buffer. Encoding stops at the first argument which does not fit, and
+         *      the arguments are marked truncated.
+         * @param[out] size Number of bytes written.
+         *
+         * @return The format to use with the encoded arguments.
+         */
+        const char* encode(unsigned char* buffer, std::size_t capacity, std::size_t& size) const;
+        
+    public:
+        
+        /*! @brief Formatter for arguments captured in a tuple with std::forward_as_tuple. */
+        template < typename Tuple >
+        static void FormatTuple( const char* format, const void* arguments, std::string& message )
+        {
+            std::apply( [format, &message]( const auto&... args ) {
+                
+                const FormatArgument values[] = { FormatArgument( args )..., FormatArgument( 0 ) };
+                message = FormatArgumentsToString( format, values, sizeof...(args) );
+                
+            }, *static_cast < const Tuple* >( arguments ) );
+        }
+        
+        /*! @brief Encoder for arguments captured in a tuple with std::forward_as_tuple. */
+        template < typename Tuple >
+        static std::size_t EncodeTuple( const void* arguments, unsigned char* buffer, std::size_t capacity )
+        {
+            return std::apply( [buffer, capacity]( const auto&... args ) {
+                
+                std::size_t size = 0;
+                
+                [[maybe_unused]] auto encode = [buffer, capacity, &size]( const auto& arg ) {
+                    std::size_t written = NotificationEncoding::Encode( arg, buffer + size, capacity - size );
+                    size += written;
+                    return written != 0;
+                };
+                
+                // Stops at the first argument which does not fit, so the next ones are not read by the
+                // conversions of the missing one.
+                if ( !( encode( args ) && ... ) )
+                    size += NotificationEncoding::EncodeTruncated( buffer + size, capacity - size );
+                
+                return size;
+                
+            }, *static_cast < const Tuple* >( arguments ) );
+        }
     };
     
     //! @brief Notification that can be sent when a NotificationObserver has request a module abort from
     //! another notification.
-    extern const char* kNotificationAbortRequested;
+    static constexpr HashedString kNotificationAbortRequested = "RDNotificationAbortRequested";
 }
 
 #endif /* Notification_h */
@@ -10,11 +10,50 @@
 
 #include "NotificationObserver.h"
 #include "Handle.h"
+#include "Epoch.h"
+#include "FlightRecorder.h"
+
+#include <unordered_map>
+#include <vector>
 
 namespace RD
 {
     class Application;
     
+    /**
+     * @brief Which notifications an observer is subscribed to.
+     */
+    struct NotificationSubscription
+    {
+        /*! @brief What the subscription matches. */
+        enum class Kind
+        {
+            //! @brief Every notification.
+            Wildcard,
+            
+            //! @brief Notifications with a given name.
+            Name,
+            
+            //! @brief Notifications sent by a given module.
+            Module
+        };
+        
+        //! @brief What the subscription matches.
+        Kind kind;
+        
+        //! @brief Hash of the name or module matched, unused for wildcard subscriptions.
+        HashedString::hash_type hash;
+        
+        /*! @brief Subscribes to every notification. */
+        static NotificationSubscription Any() { return { Kind::Wildcard, 0 }; }
+        
+        /*! @brief Subscribes to notifications with the given name. */
+        static NotificationSubscription Name(const HashedString& name) { return { Kind::Name, name }; }
+        
+        /*! @brief Subscribes to notifications sent by the given module. */
+        static NotificationSubscription Module(const HashedString& module) { return { Kind::Module, module }; }
+    };
+    
     /**
      * @brief Defines a basic interface for a NotificationCenter.
      *
@@ -28,53 +67,150 @@ namespace RD
      *
      * Application main object creates the NotificationCenter. Before Application is instanciated, no
      * NotificationCenter is available. It is then stored as a Handle.
+     *
+     * Observers subscribe to notifications by name, by module, or to every notification (see
+     * NotificationSubscription). The center indexes subscriptions by hash, so a notification only reaches
+     * the observers subscribed to its name or module, and wildcard observers. Those observers can still
+     * refuse a notification with NotificationObserver::shouldObserve.
+     *
+     * Notifiate() and NotifiateAbort() only capture references to their arguments: the message is formatted
+     * if an observer reads it. When the default center has no observer, they return immediately. Every
+     * notification sent to the default center is recorded by the FlightRecorder.
+     *
+     * Dispatching does not lock: subscriptions are published as an immutable index, replaced (copy on write)
+     * when an observer is added or removed, and read inside an EpochGuard. Notifications sent from several
+     * threads run concurrently, and observers can notifiate, or add and remove observers, from observe().
+     * Answers are returned to each caller. Keeping them for collectedAnswers() is optional, and per thread.
      */
     class NotificationCenter
     {
-        //! @brief Last answers collected.
-        std::forward_list < NotificationAnswer > answers;
+        /*! @brief A subscribed observer. */
+        struct Subscriber
+        {
+            //! @brief Observer subscribed.
+            Handle < NotificationObserver > observer;
+            
+            //! @brief Order of the observer's first subscription. Every subscription of an observer has the
+            //! same order, and lists are sorted by order, so observers are called in a stable order.
+            std::uint64_t order;
+        };
+        
+        /*! @brief Immutable subscriptions index. */
+        struct Index
+        {
+            //! @brief Observers subscribed to every notification.
+            std::vector < Subscriber > wildcards;
+            
+            //! @brief Observers subscribed to a notification name, by hash of the name.
+            std::unordered_map < HashedString::hash_type, std::vector < Subscriber > > byName;
+            
+            //! @brief Observers subscribed to a module, by hash of the module.
+            std::unordered_map < HashedString::hash_type, std::vector < Subscriber > > byModule;
+        };
+        
+        //! @brief Current index, or null if no observer is subscribed.
+        std::atomic < const Index* > index;
         
-        //! @brief Observers registered.
-        std::forward_list < Handle < NotificationObserver > > observers;
+        //! @brief Order given to the next observer.
+        std::uint64_t nextOrder;
         
-        //! @brief Mutex to access data.
+        //! @brief Number of subscriptions, readable without locking the mutex.
+        std::atomic < std::size_t > observerCount;
+        
+        //! @brief True if each thread keeps the answers of its last notification.
+        std::atomic_bool collectAnswers;
+        
+        //! @brief Serializes writers of the index. Never locked while dispatching.
         mutable std::mutex mutex;
         
     public:
         
         /*! @brief Default constructor. */
-        NotificationCenter() noexcept = default;
+        NotificationCenter() noexcept;
         
         /*! @brief Default destructor. */
-        virtual ~NotificationCenter() noexcept = default;
+        virtual ~NotificationCenter() noexcept;
         
         /*! @brief Calls every observers for the given notification.
          * @return Answers collected while notifiating to every observers.
          */
         virtual std::forward_list < NotificationAnswer > notifiate(const Notification& notification);
         
-        /*! @brief Returns answers collected with the last notification call. */
+        /*! @brief Returns answers collected with the last notification call of the calling thread.
+         *
+         * Always empty unless setCollectAnswers(true) was called.
+         */
         virtual std::forward_list < NotificationAnswer > collectedAnswers() const;
         
-        /*! @brief Register an observer. */
+        /*! @brief Enables or disables keeping the answers of the last notification of each thread. Disabled
+         * by default, as it copies every answers list. */
+        void setCollectAnswers(bool enabled);
+        
+        /*! @brief Register an observer for every notification. */
         virtual void addObserver(const Handle < NotificationObserver >& observer);
         
-        /*! @brief Unregister an observer. */
+        /*! @brief Register an observer for the notifications matching subscription.
+         *
+         * An observer can have several subscriptions. It is called once per notification, even if several
+         * of its subscriptions match. Adding a subscription the observer already has does nothing.
+         */
+        virtual void addObserver(const Handle < NotificationObserver >& observer, const NotificationSubscription& subscription);
+        
+        /*! @brief Unregister an observer from every subscription.
+         *
+         * The center releases its handles to the observer before returning, unless a notification being
+         * dispatched can still call it: they are then released by the next removal.
+         */
         virtual void removeObserver(const Handle < NotificationObserver >& observer);
         
+        /*! @brief Unregister an observer from one subscription. */
+        virtual void removeObserver(const Handle < NotificationObserver >& observer, const NotificationSubscription& subscription);
+        
         /*! @brief Clear all observers. */
         virtual void clearObservers();
         
+        /*! @brief Returns true if at least one observer is registered. Does not lock. */
+        bool hasObservers() const;
+        
     public:
         
         /*! @brief Notifiate by using the default NotificationCenter. */
         static std::forward_list < NotificationAnswer > Notifiate(const Notification& notification);
         
-        /*! @brief Notifiates by using the default NotificationCenter and creates a default notification. */
-        static std::forward_list < NotificationAnswer > Notifiate(const char* moduleName,
-                                                                  const char* functionName,
-                                                                  const char* notificationName,
-                                                                  const char* format, ...);
+        /*! @brief Notifiates by using the default NotificationCenter and creates a default notification.
+         *
+         * @param[in] module Module sending the notification. Must be a static string.
+         * @param[in] function Function sending the notification. Must be a static string.
+         * @param[in] name Notification's name. Must be a static string.
+         * @param[in] format printf-like format of the message (see Format.h). Must be a static string, and
+         *      is checked against args at compile time if written with RDFormatString.
+         * @param[in] args Arguments for format. They are not copied, and only formatted if an observer
+         *      reads the notification's message.
+         */
+        template < typename Format, typename... Args >
+        static std::forward_list < NotificationAnswer > Notifiate(const HashedString& module,
+                                                                  const HashedString& function,
+                                                                  const HashedString& name,
+                                                                  const Format& format,
+                                                                  Args&&... args)
+        {
+            static_assert(CheckFormat < Format, std::decay_t < Args >... >(), "Format does not match the arguments' types.");
+            
+            if (!IsObserved())
+            {
+                FlightRecorder::Record(FlightRecorder::EventType::Notification, nullptr,
+                                       static_cast < HashedString::hash_type >(name), module, name);
+                return std::forward_list < NotificationAnswer >();
+            }
+            
+            auto arguments = std::forward_as_tuple(args...);
+            return Notifiate(Notification(module, function, name, FormatDetail::StringOf(format), &arguments,
+                                          &Notification::FormatTuple < decltype(arguments) >,
+                                          &Notification::EncodeTuple < decltype(arguments) >));
+        }
+        
+        /*! @brief Returns true if the default NotificationCenter exists and has observers. Does not lock. */
+        static bool IsObserved();
         
         /*! @brief Returns last answers collected by the default NotificationCenter. */
         static std::forward_list < NotificationAnswer > CollectedAnswers();
@@ -86,15 +222,70 @@ namespace RD
         
         //! @brief Declares Application as a friend to let it access this member.
         friend class Application;
+        
+        /*! @brief Returns the subscribers list of a subscription in an index, or null if none. */
+        static std::vector < Subscriber >* FindSubscribers(Index& index, const NotificationSubscription& subscription, bool create);
+        
+        /*! @brief Publishes a new index and retires the current one. Mutex must be locked. */
+        void publish(Index* next);
+        
+        /*! @brief Deletes the retired indexes no dispatch can see anymore, releasing the observers they
+         * hold. Mutex must not be locked, as an observer's destructor may remove observers. */
+        static void collect();
     };
     
+    /*! @brief Notifiates a notification with the default NotificationCenter and returns a kErrorAbortRequested
+     * error if one of the answer's shouldAbort() returns true. In this case, kNotificationAbortRequested is
+     * also notifiated with the same message. Never throws an AbortRequestedException.
+     *
+     * @return The answers, or the error. Its message is the notification's message, and its module and
+     *      function are the notification's ones.
+     */
+    extern Expected < std::forward_list < NotificationAnswer > > TryNotifiateAbort(const Notification& notification);
+    
+    /*! @brief Notifiates a notification with the default NotificationCenter and throw an AbortRequestedException
+     * if one of the answer's shouldAbort() returns true. In this case, kNotificationAbortRequested is also
+     * notifiated with the same message.
+     */
+    extern std::forward_list < NotificationAnswer > NotifiateAbort(const Notification& notification);
+    
+    /*! @brief Notifiates something and returns a kErrorAbortRequested error if one of the answer's
+     * shouldAbort() returns true. Arguments are the same as NotificationCenter::Notifiate.
+     */
+    template < typename Format, typename... Args >
+    Expected < std::forward_list < NotificationAnswer > > TryNotifiateAbort(const HashedString& module,
+                                                                            const HashedString& function,
+                                                                            const HashedString& name,
+                                                                            const Format& format,
+                                                                            Args&&... args)
+    {
+        static_assert(CheckFormat < Format, std::decay_t < Args >... >(), "Format does not match the arguments' types.");
+        
+        if (!NotificationCenter::IsObserved())
+        {
+            FlightRecorder::Record(FlightRecorder::EventType::Notification, nullptr,
+                                   static_cast < HashedString::hash_type >(name), module, name);
+            return std::forward_list < NotificationAnswer >();
+        }
+        
+        auto arguments = std::forward_as_tuple(args...);
+        return TryNotifiateAbort(Notification(module, function, name, FormatDetail::StringOf(format), &arguments,
+                                              &Notification::FormatTuple < decltype(arguments) >,
+                                              &Notification::EncodeTuple < decltype(arguments) >));
+    }
+    
     /*! @brief Notifiates something and throw a AbortRequestedException if one of the answer's shouldAbort()
-     * returns true.
+     * returns true. Arguments are the same as NotificationCenter::Notifiate.
      */
-    extern std::forward_list < NotificationAnswer > NotifiateAbort(const char* moduleName,
-                                                                   const char* functionName,
-                                                                   const char* notificationName,
-                                                                   const char* format, ...);
+    template < typename Format, typename... Args >
+    std::forward_list < NotificationAnswer > NotifiateAbort(const HashedString& module,
+                                                            const HashedString& function,
+                                                            const HashedString& name,
+                                                            const Format& format,
+                                                            Args&&... args)
+    {
+        return TryNotifiateAbort(module, function, name, format, std::forward < Args >(args)...).value();
+    }
 }
 
 #endif /* NotificationCenter_h */
@@ -0,0 +1,133 @@
+//
+//  NotificationEncoding.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NotificationEncoding_h
+#define NotificationEncoding_h
+
+#include "Global.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace RD
+{
+    /**
+     * @brief Compact binary encoding of a notification's arguments, for deferred formatting.
+     *
+     * Each argument is encoded as a one byte tag followed by its value. Integers are widened to 64 bits,
+     * floating points to double, and strings are copied (truncated if the buffer is too small). Values use
+     * the host's byte order.
+     *
+     * Encoded arguments are formatted later with \ref Format, with the notification's format. This lets
+     * a sink like NotificationLogger copy a few bytes on the sender's thread, and format the message on
+     * its own thread or offline.
+     */
+    namespace NotificationEncoding
+    {
+        /*! @brief Tag of an encoded argument. */
+        enum Tag : std::uint8_t
+        {
+            //! @brief Signed integer, 8 bytes.
+            kTagInt = 1,
+
+            //! @brief Unsigned integer, 8 bytes.
+            kTagUInt = 2,
+
+            //! @brief Floating point, 8 bytes.
+            kTagDouble = 3,
+
+            //! @brief Pointer, 8 bytes.
+            kTagPointer = 4,
+
+            //! @brief String: 2 bytes length followed by the characters, without terminating null.
+            kTagString = 5,
+
+            //! @brief Null string, no value.
+            kTagNullString = 6,
+
+            //! @brief The next arguments did not fit in the buffer. No value, always last.
+            kTagTruncated = 7
+        };
+
+        /*! @brief Encodes a tag followed by a 8 bytes value. Returns the number of bytes written, or zero
+         * if buffer is too small. */
+        template < typename T >
+        std::size_t EncodeScalar( Tag tag, T value, unsigned char* buffer, std::size_t capacity )
+        {
+            static_assert( sizeof(T) == 8, "Scalars are encoded on 8 bytes." );
+
+            if ( capacity < 1 + sizeof(T) )
+                return 0;
+
+            buffer[0] = tag;
+            std::memcpy( buffer + 1, &value, sizeof(T) );
+            return 1 + sizeof(T);
+        }
+
+        /*! @brief Encodes a string, truncated to fit in capacity. Returns the number of bytes written. */
+        std::size_t EncodeString( const char* value, unsigned char* buffer, std::size_t capacity );
+
+        /*! @brief Encodes length characters of a string, truncated to fit in capacity. Returns the number
+         * of bytes written. */
+        std::size_t EncodeString( const char* value, std::size_t length, unsigned char* buffer, std::size_t capacity );
+
+        /*! @brief Marks the arguments encoded before as truncated. Returns the number of bytes written, or
+         * zero if buffer is full. */
+        std::size_t EncodeTruncated( unsigned char* buffer, std::size_t capacity );
+
+        /*! @brief Encodes one argument. Returns the number of bytes written, or zero if the buffer is too
+         * small. Only arguments printf accepts, std::string and std::string_view can be encoded. */
+        template < typename T >
+        std::size_t Encode( const T& value, unsigned char* buffer, std::size_t capacity )
+        {
+            using Type = std::decay_t < T >;
+
+            if constexpr ( std::is_same_v < Type, char* > || std::is_same_v < Type, const char* > )
+                return EncodeString( value, buffer, capacity );
+
+            else if constexpr ( std::is_same_v < Type, std::string > || std::is_same_v < Type, std::string_view > )
+                return EncodeString( value.data(), value.size(), buffer, capacity );
+
+            else if constexpr ( std::is_floating_point_v < Type > )
+                return EncodeScalar( kTagDouble, static_cast < double >( value ), buffer, capacity );
+
+            else if constexpr ( std::is_enum_v < Type > )
+                return Encode( static_cast < std::underlying_type_t < Type > >( value ), buffer, capacity );
+
+            else if constexpr ( std::is_integral_v < Type > && std::is_signed_v < Type > )
+                return EncodeScalar( kTagInt, static_cast < std::int64_t >( value ), buffer, capacity );
+
+            else if constexpr ( std::is_integral_v < Type > )
+                return EncodeScalar( kTagUInt, static_cast < std::uint64_t >( value ), buffer, capacity );
+
+            else if constexpr ( std::is_pointer_v < Type > )
+                return EncodeScalar( kTagPointer, static_cast < std::uint64_t >( reinterpret_cast < std::uintptr_t >( value ) ), buffer, capacity );
+
+            else
+            {
+                static_assert( std::is_null_pointer_v < Type >, "Argument can not be passed to a printf-like format." );
+                return EncodeScalar( kTagPointer, std::uint64_t( 0 ), buffer, capacity );
+            }
+        }
+
+        /*! @brief Formats encoded arguments with a printf-like format.
+         *
+         * Length modifiers of the format are ignored, as every value is stored on 8 bytes. A conversion with
+         * no argument left, or after the arguments were truncated, is printed as '?'. Integer and floating point values are converted when the
+         * conversion expects the other kind.
+         *
+         * @param[in] format Format of the message.
+         * @param[in] arguments Arguments encoded with \ref Encode.
+         * @param[in] size Size of arguments.
+         * @param[out] message Formatted message.
+         */
+        void Format( const char* format, const unsigned char* arguments, std::size_t size, std::string& message );
+    }
+}
+
+#endif /* NotificationEncoding_h */
@@ -0,0 +1,277 @@
+//
+//  NotificationLogger.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NotificationLogger_h
+#define NotificationLogger_h
+
+#include "NotificationObserver.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief NotificationObserver writing notifications to a file, without doing any I/O in observe().
+     *
+     * observe() copies the notification's identifiers and encoded arguments (see Notification::encode) in a
+     * fixed-size record of a bounded lock-free ring, shared by every sending thread. A writer thread wakes
+     * every flush interval (or earlier, when the ring gets half full), and writes all pending records at once
+     * with writev. Messages are never formatted on the sender's thread.
+     *
+     * When the ring is full, records are either dropped (and counted, the count being written to the file
+     * with the next batch), or the sender waits for the writer to free a record.
+     *
+     * In binary encoding, a record only stores the identifiers of its strings: each module, function, name
+     * and format is written once, the first time it is seen. Messages are formatted when the log is read with
+     * NotificationLogReader (and the rdlogdump tool). In text encoding, the writer thread formats each line.
+     *
+     * @note
+     * Module, function, name and format of every notification must be static strings, as they are read by
+     * the writer thread after the notification was sent.
+     */
+    class NotificationLogger : public NotificationObserver
+    {
+    public:
+
+        /*! @brief What happens when a notification is sent while the ring is full. */
+        enum class OverflowPolicy
+        {
+            //! @brief The notification is not logged. Dropped notifications are counted.
+            Drop,
+
+            //! @brief The sender waits until the writer thread frees a record.
+            Block
+        };
+
+        /*! @brief How the log file is written. */
+        enum class Encoding
+        {
+            //! @brief Compact binary records, formatted when read with NotificationLogReader.
+            Binary,
+
+            //! @brief One formatted line per notification.
+            Text
+        };
+
+        /*! @brief Configuration of a logger. */
+        struct Configuration
+        {
+            //! @brief Path of the log file. It is truncated if it exists.
+            std::string path;
+
+            //! @brief Encoding of the file.
+            Encoding encoding = Encoding::Binary;
+
+            //! @brief Behaviour when the ring is full.
+            OverflowPolicy overflow = OverflowPolicy::Drop;
+
+            //! @brief Number of records in the ring. Rounded up to a power of two.
+            std::size_t capacity = 4096;
+
+            //! @brief Maximum time a record waits before being written.
+            std::chrono::milliseconds flushInterval = std::chrono::milliseconds(10);
+        };
+
+        //! @brief Maximum size of the encoded arguments of a notification. Arguments over this size are not
+        //! logged, and strings are truncated.
+        static constexpr std::size_t kMaxArgumentsSize = 200;
+
+    private:
+
+        /*! @brief A notification copied in the ring. */
+        struct Record
+        {
+            const char* module;
+            const char* function;
+            const char* name;
+            const char* format;
+            std::uint64_t time;
+            std::uint32_t thread;
+            std::uint16_t size;
+            unsigned char arguments[kMaxArgumentsSize];
+        };
+
+        /*! @brief A slot of the ring. Its sequence tells which position of the ring it holds, and if the
+         * record is published. */
+        struct alignas(64) Slot
+        {
+            std::atomic < std::uint64_t > sequence;
+            Record record;
+        };
+
+        //! @brief Configuration of this logger.
+        Configuration configuration;
+
+        //! @brief Slots of the ring.
+        std::unique_ptr < Slot[] > slots;
+
+        //! @brief Number of slots minus one.
+        std::uint64_t mask;
+
+        //! @brief Next position claimed by a sender.
+        alignas(64) std::atomic < std::uint64_t > head;
+
+        //! @brief Next position written by the writer thread.
+        alignas(64) std::atomic < std::uint64_t > tail;
+
+        //! @brief Number of notifications dropped.
+        std::atomic < std::uint64_t > droppedCount;
+
+        //! @brief Number of notifications written.
+        std::atomic < std::uint64_t > writtenCount;
+
+        //! @brief Log file descriptor.
+        int fd;
+
+        //! @brief Time the logger was created, written in the binary header.
+        std::uint64_t startTime;
+
+        //! @brief Writer thread.
+        std::thread writer;
+
+        //! @brief Protects wakeRequested and stopping, and used with both conditions.
+        std::mutex mutex;
+
+        //! @brief Wakes the writer thread.
+        std::condition_variable wakeCondition;
+
+        //! @brief Wakes threads waiting for records to be written.
+        std::condition_variable writtenCondition;
+
+        //! @brief True if the writer must not wait for the flush interval.
+        bool wakeRequested;
+
+        //! @brief True when the logger is destroyed.
+        bool stopping;
+
+        //! @brief Identifiers of the strings already written, used by the writer thread only.
+        std::unordered_map < const char*, std::uint32_t > strings;
+
+        //! @brief Dropped count already written, used by the writer thread only.
+        std::uint64_t droppedWritten;
+
+    public:
+
+        /*! @brief Opens the log file and starts the writer thread.
+         * @throw FileOpenException if the file can not be opened.
+         */
+        explicit NotificationLogger(const Configuration& config);
+
+        /*! @brief Writes pending records, stops the writer thread and closes the file. */
+        ~NotificationLogger() noexcept;
+
+        /*! @brief Copies the notification in the ring. */
+        NotificationAnswer observe(const NotificationCenter* center, const Notification& notification);
+
+        /*! @brief Returns true: every notification the logger is subscribed to is logged. */
+        bool shouldObserve(const NotificationCenter* center, const Notification& notification) const;
+
+        /*! @brief Waits until every notification sent before this call is written to the file. */
+        void flush();
+
+        /*! @brief Returns the number of notifications dropped because the ring was full. */
+        std::uint64_t dropped() const;
+
+        /*! @brief Returns the number of notifications written. */
+        std::uint64_t written() const;
+
+    public:
+
+        /*! @brief Formats a log line, as written in text encoding and printed by rdlogdump.
+         *
+         * @param[out] line Line, without new line character.
+         * @param[in] seconds Seconds since the log started.
+         * @param[in] thread Identifier of the sending thread.
+         * @param[in] module Module of the notification.
+         * @param[in] function Function of the notification.
+         * @param[in] name Name of the notification.
+         * @param[in] message Message of the notification.
+         */
+        static void FormatLine(std::string& line, double seconds, std::uint32_t thread,
+                               std::string_view module, std::string_view function,
+                               std::string_view name, std::string_view message);
+
+    private:
+
+        /*! @brief Main function of the writer thread. */
+        void work();
+
+        /*! @brief Writes every published record. Returns the number of records written. */
+        std::size_t drain();
+
+        /*! @brief Returns the identifier of a string. If the string was never written, appends its definition
+         * to buffer. Binary encoding only. */
+        std::uint32_t stringId(std::vector < unsigned char >& buffer, const char* string);
+    };
+
+    /**
+     * @brief Reads a log written by NotificationLogger in binary encoding.
+     */
+    class NotificationLogReader
+    {
+    public:
+
+        /*! @brief An entry of the log. */
+        struct Entry
+        {
+            //! @brief Nanoseconds since the log started.
+            std::uint64_t time = 0;
+
+            //! @brief Identifier of the sending thread.
+            std::uint32_t thread = 0;
+
+            //! @brief Module of the notification.
+            std::string_view module;
+
+            //! @brief Function of the notification.
+            std::string_view function;
+
+            //! @brief Name of the notification.
+            std::string_view name;
+
+            //! @brief Formatted message.
+            std::string message;
+
+            //! @brief If not zero, the entry is not a notification: this number of notifications was
+            //! dropped before the next entry.
+            std::uint64_t dropped = 0;
+        };
+
+    private:
+
+        //! @brief Content of the file.
+        std::vector < unsigned char > content;
+
+        //! @brief Offset of the next entry.
+        std::size_t offset;
+
+        //! @brief Strings read so far, by identifier.
+        std::unordered_map < std::uint32_t, std::string > strings;
+
+        //! @brief Time the log started.
+        std::uint64_t start;
+
+    public:
+
+        /*! @brief Reads a log file.
+         * @throw FileOpenException if the file can not be read, or is not a binary notifications log.
+         */
+        explicit NotificationLogReader(const std::string& path);
+
+        /*! @brief Reads the next entry. Returns false at the end of the log, or if the log is truncated. */
+        bool next(Entry& entry);
+
+        /*! @brief Returns the time the log started, in nanoseconds since the epoch of Clock. */
+        std::uint64_t startTime() const;
+    };
+}
+
+#endif /* NotificationLogger_h */
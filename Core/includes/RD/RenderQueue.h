@@ -0,0 +1,220 @@
+//
+//  RenderQueue.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef RenderQueue_h
+#define RenderQueue_h
+
+#include "Global.h"
+#include "CommandBuffer.h"
+
+#include <memory>
+#include <mutex>
+
+namespace RD
+{
+    class CommandQueue;
+
+    /**
+     * @brief Packs and unpacks the 64-bit sort key of a DrawItem.
+     *
+     * Fields are ordered from the most significant bits, so sorting keys groups draws by layer, then by
+     * pass, then by pipeline and material, which are the most expensive states to change, and finally by
+     * depth:
+     *
+     * | Bits    | Field    |
+     * |---------|----------|
+     * | 63 - 56 | layer    |
+     * | 55 - 48 | pass     |
+     * | 47 - 32 | pipeline |
+     * | 31 - 16 | material |
+     * | 15 - 0  | depth    |
+     *
+     * Every field is a whole number of bytes, which lets RenderQueue's radix sort skip the bytes every key
+     * shares (usually the layer and the pass).
+     */
+    struct DrawKey
+    {
+        /*! @brief Returns the key of a draw. */
+        static constexpr std::uint64_t Make(std::uint8_t layer, std::uint8_t pass, std::uint16_t pipeline, std::uint16_t material, std::uint16_t depth) noexcept
+        {
+            return (std::uint64_t(layer) << 56)
+                 | (std::uint64_t(pass) << 48)
+                 | (std::uint64_t(pipeline) << 32)
+                 | (std::uint64_t(material) << 16)
+                 |  std::uint64_t(depth);
+        }
+
+        /*! @brief Returns the layer of a key. */
+        static constexpr std::uint8_t Layer(std::uint64_t key) noexcept { return std::uint8_t(key >> 56); }
+
+        /*! @brief Returns the pass of a key. */
+        static constexpr std::uint8_t Pass(std::uint64_t key) noexcept { return std::uint8_t(key >> 48); }
+
+        /*! @brief Returns the pipeline of a key. */
+        static constexpr std::uint16_t Pipeline(std::uint64_t key) noexcept { return std::uint16_t(key >> 32); }
+
+        /*! @brief Returns the material of a key. */
+        static constexpr std::uint16_t Material(std::uint64_t key) noexcept { return std::uint16_t(key >> 16); }
+
+        /*! @brief Returns the depth of a key. */
+        static constexpr std::uint16_t Depth(std::uint64_t key) noexcept { return std::uint16_t(key); }
+
+        /*! @brief Quantizes a depth in [0, 1], clamped, to the 16 bits of a key.
+         * @param[in] depth Depth, 0 being the nearest.
+         * @param[in] backToFront True to sort the farthest draws first, as transparent draws need.
+         */
+        static std::uint16_t QuantizeDepth(float depth, bool backToFront = false) noexcept
+        {
+            float clamped = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+            std::uint16_t quantized = std::uint16_t(clamped * 65535.0f + 0.5f);
+            return backToFront ? std::uint16_t(65535 - quantized) : quantized;
+        }
+    };
+
+    /**
+     * @brief A draw submitted to a RenderQueue: its sort key, and a value the Driver uses to find what to
+     * draw (an index in the caller's draw list, a pointer, etc.).
+     */
+    struct DrawItem
+    {
+        //! @brief Sort key, see DrawKey.
+        std::uint64_t key;
+
+        //! @brief Value interpreted by the Driver.
+        std::uint64_t data;
+    };
+
+    /*! @brief Type of the command RenderQueue records its sorted items with. CommandQueue executes it with
+     * Driver::executeDrawItems instead of Driver::executeCommand. Types from 0xFFFFFF00 are reserved. */
+    static constexpr std::uint32_t kDrawItemsCommand = 0xFFFFFF00;
+
+    /**
+     * @brief DrawItems pushed by one thread, before they are submitted to a RenderQueue.
+     *
+     * Like a CommandBuffer, a DrawList belongs to the thread pushing into it until it is submitted, and is
+     * recycled by its RenderQueue: pushing does not lock nor allocate, once lists have grown.
+     */
+    class DrawList
+    {
+        friend class RenderQueue;
+
+        //! @brief Items, in push order.
+        std::vector < DrawItem > items;
+
+        //! @brief Submission sequence, set by RenderQueue::submit.
+        std::uint64_t sequence = 0;
+
+        //! @brief Next list in RenderQueue's submission list.
+        DrawList* next = nullptr;
+
+    public:
+
+        /*! @brief Pushes a draw. */
+        void push(std::uint64_t key, std::uint64_t data)
+        {
+            items.push_back(DrawItem { key, data });
+        }
+
+        /*! @brief Removes every item, keeping the memory. */
+        void reset() noexcept { items.clear(); }
+
+        /*! @brief Returns the number of items. */
+        std::size_t size() const noexcept { return items.size(); }
+
+        /*! @brief Returns true if no item was pushed. */
+        bool empty() const noexcept { return items.empty(); }
+    };
+
+    /**
+     * @brief Collects the DrawItems of a frame from any number of threads, sorts them by key, and hands them
+     * to the Driver in that order.
+     *
+     * Threads acquire DrawLists with \ref acquire, push items without locking, and \ref submit them:
+     * submitting is lock-free, like CommandQueue::submit. \ref flush merges the lists submitted, in
+     * submission order, sorts the items by key with \ref Sort, and records them as one kDrawItemsCommand
+     * into the CommandQueue. The queue's thread then calls Driver::executeDrawItems with the items sorted,
+     * so the Driver changes its pipeline and material states as few times as the keys allow.
+     *
+     * Driver::present flushes its RenderQueue before presenting its CommandQueue.
+     */
+    class RenderQueue
+    {
+        //! @brief Queue the sorted items are recorded into.
+        CommandQueue& commandQueue;
+
+        //! @brief Lists submitted since the last flush, last submitted first.
+        std::atomic < DrawList* > submitted { nullptr };
+
+        //! @brief Next submission sequence.
+        std::atomic < std::uint64_t > sequence { 0 };
+
+        //! @brief Flushed lists, ready to be acquired again.
+        std::vector < std::unique_ptr < DrawList > > freeLists;
+
+        //! @brief Mutex protecting freeLists.
+        std::mutex freeMutex;
+
+        //! @brief Items being flushed, then sorted.
+        std::vector < DrawItem > items;
+
+        //! @brief Scratch buffer of the sort.
+        std::vector < DrawItem > scratch;
+
+        //! @brief Order of the command buffer flushed, in its frame.
+        std::atomic < std::uint32_t > bufferOrder { 0 };
+
+        //! @brief Mutex serializing flushes.
+        std::mutex flushMutex;
+
+    public:
+
+        /*! @brief Below this number of items, \ref Sort uses std::stable_sort, which is faster while the
+         * items fit in the L1 cache: a radix sort clears and scans its histograms whatever the number of
+         * items. */
+        static constexpr std::size_t kRadixThreshold = 1024;
+
+        /*! @brief Constructs a queue recording its sorted items into a CommandQueue. */
+        explicit RenderQueue(CommandQueue& queue) noexcept;
+
+        /*! @brief Deletes the lists submitted and not flushed. */
+        ~RenderQueue();
+
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator = (const RenderQueue&) = delete;
+
+        /*! @brief Returns an empty list, recycled when possible. */
+        std::unique_ptr < DrawList > acquire();
+
+        /*! @brief Submits a list to the current frame. Never locks. Empty lists are accepted. */
+        void submit(std::unique_ptr < DrawList > list);
+
+        /*! @brief Sorts the items submitted since the last flush and records them into the CommandQueue.
+         * Submissions racing with flush belong to this flush or to the next one.
+         * @return The number of items flushed.
+         */
+        std::size_t flush();
+
+        /*! @brief Returns the order of the command buffer flushed (see CommandBuffer::order). */
+        std::uint32_t order() const noexcept { return bufferOrder.load(std::memory_order_relaxed); }
+
+        /*! @brief Sets the order of the command buffer flushed. Defaults to 0: draws are executed after
+         * the buffers of the same order submitted before the flush. */
+        void setOrder(std::uint32_t order) noexcept { bufferOrder.store(order, std::memory_order_relaxed); }
+
+        /*! @brief Sorts items by key, keeping the order of equal keys.
+         *
+         * Uses a least significant digit radix sort, one byte per pass, and skips the passes where every
+         * key has the same byte. Below kRadixThreshold items, std::stable_sort is used.
+         *
+         * @param[in, out] items Items to sort.
+         * @param[in, out] scratch Buffer the sort may swap with items, reused to avoid allocating.
+         */
+        static void Sort(std::vector < DrawItem >& items, std::vector < DrawItem >& scratch);
+    };
+}
+
+#endif /* RenderQueue_h */
@@ -0,0 +1,194 @@
+//
+//  ResourceRegistry.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef ResourceRegistry_h
+#define ResourceRegistry_h
+
+#include "Global.h"
+#include "HashedString.h"
+#include "Handle.h"
+#include "Epoch.h"
+#include "Surface.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Registry of the DriverResources and Surfaces of a Driver, indexed by name and by pointer.
+     *
+     * Entries are spread over \ref kShardCount shards by the hash of their name, each with its own mutex,
+     * and a second set of shards indexes them by pointer. Inserting, finding or removing an entry (by
+     * name or by pointer) only locks one shard of each set, and costs a hash lookup.
+     *
+     * \ref forEachResource and \ref forEachSurface visit an immutable snapshot of each shard, without
+     * locking and without copying any handle. A shard's snapshot is built on the first visit after the
+     * shard changed, and retired through Epoch when it changes again: a visit sees every entry present
+     * when it started visiting a shard, and a visitor can safely insert or remove entries.
+     *
+     * Snapshots hold handles, so a removed entry is only destroyed with the last snapshot holding it. The
+     * owner calls \ref collect at a point where releasing resources is safe, like Driver::releaseRetired,
+     * and the destructor collects what is left.
+     */
+    class ResourceRegistry
+    {
+    public:
+
+        //! @brief Number of shards.
+        static constexpr std::size_t kShardCount = 16;
+
+        /*! @brief An entry of the registry. */
+        struct Entry
+        {
+            //! @brief Name of the resource.
+            HashedString name;
+
+            //! @brief The resource.
+            Handle < DriverResource > resource;
+
+            //! @brief The resource as a Surface, or an invalid handle if it is not a Surface.
+            Handle < Surface > surface;
+        };
+
+        /*! @brief Immutable content of a shard. */
+        struct Snapshot
+        {
+            //! @brief Entries of the shard.
+            std::vector < Entry > entries;
+        };
+
+    private:
+
+        /*! @brief Entries whose name hash to this shard. */
+        struct Shard
+        {
+            //! @brief Mutex protecting entries.
+            mutable std::mutex mutex;
+
+            //! @brief Entries, by name's hash.
+            std::unordered_map < HashedString::hash_type, Entry > entries;
+
+            //! @brief Snapshot of entries, or null if entries changed since the last snapshot.
+            mutable std::atomic < const Snapshot* > snapshot { nullptr };
+        };
+
+        /*! @brief Names of the entries whose pointer hash to this shard. */
+        struct PointerShard
+        {
+            //! @brief Mutex protecting names.
+            std::mutex mutex;
+
+            //! @brief Name's hash of each resource.
+            std::unordered_map < const DriverResource*, HashedString::hash_type > names;
+        };
+
+        //! @brief Shards by name.
+        Shard shards[kShardCount];
+
+        //! @brief Shards by pointer.
+        PointerShard pointerShards[kShardCount];
+
+        //! @brief Number of entries.
+        std::atomic < std::size_t > resourcesCount { 0 };
+
+        //! @brief Number of entries which are surfaces.
+        std::atomic < std::size_t > surfacesCount { 0 };
+
+    public:
+
+        /*! @brief Constructs an empty registry. */
+        ResourceRegistry() = default;
+
+        /*! @brief Destroys the registry and its snapshots. No visit must be running. */
+        ~ResourceRegistry();
+
+        ResourceRegistry(const ResourceRegistry&) = delete;
+        ResourceRegistry& operator = (const ResourceRegistry&) = delete;
+
+        /*! @brief Inserts a resource.
+         * @return False if a resource with the same name is already present.
+         */
+        bool insert(const HashedString& name, const Handle < DriverResource >& resource);
+
+        /*! @brief Inserts a surface.
+         * @return False if a resource with the same name is already present.
+         */
+        bool insert(const HashedString& name, const Handle < Surface >& surface);
+
+        /*! @brief Returns the resource with the given name, or an invalid handle. */
+        Handle < DriverResource > find(const HashedString& name) const;
+
+        /*! @brief Returns the surface with the given name, or an invalid handle. */
+        Handle < Surface > findSurface(const HashedString& name) const;
+
+        /*! @brief Removes a resource.
+         * @return The removed resource, or an invalid handle if it was not present.
+         */
+        Handle < DriverResource > remove(const DriverResource* resource);
+
+        /*! @brief Removes every resource. */
+        void clear();
+
+        /*! @brief Deletes the retired snapshots no visit can see anymore, releasing the handles they hold.
+         * Must not be called inside a visit. */
+        void collect();
+
+        /*! @brief Returns the number of resources, surfaces included. */
+        std::size_t size() const;
+
+        /*! @brief Returns the number of surfaces. */
+        std::size_t surfacesSize() const;
+
+        /*! @brief Calls func(const HashedString& name, const Handle < DriverResource >& resource) for
+         * every resource, surfaces included. */
+        template < typename Func >
+        void forEachResource(Func&& func) const
+        {
+            EpochGuard guard;
+
+            for (const Shard& shard : shards)
+            {
+                for (const Entry& entry : snapshotOf(shard)->entries)
+                    func(entry.name, entry.resource);
+            }
+        }
+
+        /*! @brief Calls func(const HashedString& name, const Handle < Surface >& surface) for every
+         * surface. */
+        template < typename Func >
+        void forEachSurface(Func&& func) const
+        {
+            EpochGuard guard;
+
+            for (const Shard& shard : shards)
+            {
+                for (const Entry& entry : snapshotOf(shard)->entries)
+                {
+                    if (entry.surface.valid())
+                        func(entry.name, entry.surface);
+                }
+            }
+        }
+
+    private:
+
+        /*! @brief Inserts an entry. */
+        bool insert(const Entry& entry);
+
+        /*! @brief Returns the snapshot of a shard, building it if needed. Caller must be in an EpochGuard. */
+        const Snapshot* snapshotOf(const Shard& shard) const;
+
+        /*! @brief Returns the shard of a name. */
+        static std::size_t ShardOf(HashedString::hash_type hash);
+
+        /*! @brief Returns the shard of a pointer. */
+        static std::size_t ShardOf(const DriverResource* resource);
+    };
+}
+
+#endif /* ResourceRegistry_h */
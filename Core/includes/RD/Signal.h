@@ -0,0 +1,278 @@
+//
+//  Signal.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Signal_h
+#define Signal_h
+
+#include "Global.h"
+#include "Exception.h"
+
+namespace RD
+{
+    /**
+     * @brief Statically typed list of delegates, called one by one when the signal is emitted.
+     *
+     * A delegate is an object pointer and a stub function pointer. Stubs are generated at compile time for
+     * each connected member function (see \ref connect), so emitting a signal is one indirect call per
+     * delegate, with no virtual call unless the connected function itself is virtual. Delegates are stored
+     * contiguously, inline for the first InlineCapacity ones, and emitting never allocates.
+     *
+     * Contrary to Emitter, Signal is not thread-safe: connecting, disconnecting and emitting must be done
+     * by the same thread (or be externally synchronized). Delegates can be connected and disconnected
+     * while the signal is emitting: a disconnected delegate is not called anymore by the current emission,
+     * and a connected delegate is called from the next emission.
+     *
+     * @tparam Args Arguments passed to every delegate.
+     */
+    template < typename... Args >
+    class Signal
+    {
+    public:
+        
+        /*! @brief Function called for a delegate, with its object as first argument. */
+        typedef void (*Stub)( void*, Args... );
+        
+        /*! @brief An object and the stub to call for it. */
+        struct Delegate
+        {
+            void* object;
+            Stub stub;
+        };
+        
+        //! @brief Number of delegates stored without allocation.
+        static constexpr std::size_t InlineCapacity = 4;
+        
+    private:
+        
+        //! @brief Storage for the first delegates.
+        Delegate inlineDelegates[InlineCapacity];
+        
+        //! @brief Delegates: inlineDelegates, or a heap array when more delegates are connected.
+        Delegate* delegates;
+        
+        //! @brief Number of delegates, including those disconnected during an emission.
+        std::size_t count;
+        
+        //! @brief Number of delegates delegates can hold.
+        std::size_t capacity;
+        
+        //! @brief Depth of nested emissions.
+        std::uint32_t emitting;
+        
+        //! @brief True if a delegate was disconnected during an emission.
+        bool dirty;
+        
+    public:
+        
+        /*! @brief Constructs an empty signal. */
+        Signal() noexcept : delegates( inlineDelegates ), count( 0 ), capacity( InlineCapacity ), emitting( 0 ), dirty( false ) { }
+        
+        /*! @brief Frees the delegates. */
+        ~Signal() noexcept
+        {
+            if ( delegates != inlineDelegates )
+                delete [] delegates;
+        }
+        
+        Signal( const Signal& ) = delete;
+        Signal& operator = ( const Signal& ) = delete;
+        
+        /*! @brief Connects an object with a stub. The same pair can be connected more than once. */
+        void connect( void* object, Stub stub )
+        {
+            if ( !stub )
+                throw NullPointerException( "Null pointer 'stub' for 'Signal::connect()'." );
+            
+            if ( count == capacity )
+                grow();
+            
+            delegates[count++] = Delegate { object, stub };
+        }
+        
+        /*! @brief Connects a member function of an object.
+         *
+         * @code
+         * signal.connect < &MyListener::onResize >( &listener );
+         * @endcode
+         */
+        template < auto Method, typename T >
+        void connect( T* object )
+        {
+            connect( const_cast < void* >( static_cast < const void* >( object ) ), &MethodStub < Method, T > );
+        }
+        
+        /*! @brief Disconnects the first delegate matching object and stub.
+         *
+         * @return true if a delegate was disconnected.
+         */
+        bool disconnect( const void* object, Stub stub )
+        {
+            for ( std::size_t i = 0; i < count; ++i )
+            {
+                if ( delegates[i].object == object && delegates[i].stub == stub )
+                {
+                    erase( i );
+                    return true;
+                }
+            }
+            
+            return false;
+        }
+        
+        /*! @brief Disconnects a member function of an object connected with connect < Method >(). */
+        template < auto Method, typename T >
+        bool disconnect( T* object )
+        {
+            return disconnect( static_cast < const void* >( object ), &MethodStub < Method, T > );
+        }
+        
+        /*! @brief Disconnects every delegate of an object.
+         *
+         * @return The number of delegates disconnected.
+         */
+        std::size_t disconnect( const void* object )
+        {
+            std::size_t removed = 0;
+            
+            for ( std::size_t i = 0; i < count; )
+            {
+                if ( delegates[i].object == object && delegates[i].stub )
+                {
+                    erase( i );
+                    removed++;
+                    
+                    if ( emitting )
+                        ++i;
+                }
+                
+                else
+                    ++i;
+            }
+            
+            return removed;
+        }
+        
+        /*! @brief Disconnects every delegate. */
+        void clear()
+        {
+            if ( emitting )
+            {
+                for ( std::size_t i = 0; i < count; ++i )
+                    delegates[i].stub = nullptr;
+                
+                dirty = true;
+            }
+            
+            else
+                count = 0;
+        }
+        
+        /*! @brief Returns the number of delegates connected. */
+        std::size_t size() const
+        {
+            std::size_t result = 0;
+            
+            for ( std::size_t i = 0; i < count; ++i )
+                result += delegates[i].stub != nullptr;
+            
+            return result;
+        }
+        
+        /*! @brief Returns true if no delegate is connected. */
+        bool empty() const
+        {
+            return size() == 0;
+        }
+        
+        /*! @brief Calls every delegate, in order of connection. */
+        inline void emit( Args... args )
+        {
+            // Delegates connected by a delegate are not called by this emission. The array is re-read at each
+            // iteration, as connecting may reallocate it.
+            const std::size_t last = count;
+            EmitScope scope( *this );
+            
+            for ( std::size_t i = 0; i < last; ++i )
+            {
+                const Delegate delegate = delegates[i];
+                
+                if ( delegate.stub )
+                    delegate.stub( delegate.object, args... );
+            }
+        }
+        
+        /*! @brief Same as emit(). */
+        inline void operator () ( Args... args )
+        {
+            emit( args... );
+        }
+        
+        /*! @brief Stub calling a member function. */
+        template < auto Method, typename T >
+        static void MethodStub( void* object, Args... args )
+        {
+            ( static_cast < T* >( object )->*Method )( args... );
+        }
+        
+    private:
+        
+        /*! @brief Counts an emission for its scope, and compacts the delegates when the outermost emission
+         * ends, even if a delegate throws. */
+        struct EmitScope
+        {
+            Signal& signal;
+            
+            explicit EmitScope( Signal& s ) noexcept : signal( s ) { signal.emitting++; }
+            
+            ~EmitScope()
+            {
+                if ( --signal.emitting == 0 && signal.dirty )
+                    signal.compact();
+            }
+        };
+        
+        /*! @brief Doubles the capacity. */
+        void grow()
+        {
+            Delegate* grown = new Delegate[capacity * 2];
+            std::copy( delegates, delegates + count, grown );
+            
+            if ( delegates != inlineDelegates )
+                delete [] delegates;
+            
+            delegates = grown;
+            capacity *= 2;
+        }
+        
+        /*! @brief Removes a delegate, or marks it as removed while emitting. */
+        void erase( std::size_t index )
+        {
+            if ( emitting )
+            {
+                delegates[index].stub = nullptr;
+                dirty = true;
+                return;
+            }
+            
+            std::copy( delegates + index + 1, delegates + count, delegates + index );
+            count--;
+        }
+        
+        /*! @brief Removes delegates marked as removed. */
+        void compact()
+        {
+            Delegate* end = std::remove_if( delegates, delegates + count, []( const Delegate& delegate ){
+                return delegate.stub == nullptr;
+            });
+            
+            count = static_cast < std::size_t >( end - delegates );
+            dirty = false;
+        }
+    };
+}
+
+#endif /* Signal_h */
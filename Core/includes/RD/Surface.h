@@ -115,6 +115,16 @@ namespace RD
         
         /*! @brief Calls \ref close when called. */
         virtual void onDriverClear();
+        
+        /*! @brief Notifies observers that the surface moved. Implementations should call this function
+         * instead of emitting onSurfaceDidMove() directly: moves are coalesced, and observers only receive
+         * the last position once per tick. */
+        void emitDidMove(const ScreenPosition& position);
+        
+        /*! @brief Notifies observers that the surface resized. Implementations should call this function
+         * instead of emitting onSurfaceDidResize() directly: resizes are coalesced, and observers only
+         * receive the last size once per tick. */
+        void emitDidResize(const RectSize& newSize);
     };
     
 }
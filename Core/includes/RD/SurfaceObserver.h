@@ -11,6 +11,7 @@
 #include "Global.h"
 #include "ScreenPosition.h"
 #include "RectSize.h"
+#include "Signal.h"
 
 namespace RD
 {
@@ -56,6 +57,53 @@ namespace RD
         /*! @brief Called when a surface unhide (or show). */
         virtual void onSurfaceUnhide(const Surface* surface) {}
     };
+    
+    /**
+     * @brief SurfaceObserver events as Signals.
+     *
+     * Any class implementing SurfaceObserver's functions can be connected with \ref connect. See ModuleSignals.
+     */
+    struct SurfaceSignals
+    {
+        Signal < const Surface*, const ScreenPosition& > didMove;
+        Signal < const Surface*, const RectSize& > didResize;
+        Signal < const Surface* > entersResizing;
+        Signal < const Surface* > exitsResizing;
+        Signal < const Surface* > willClose;
+        Signal < const Surface* > willHide;
+        Signal < const Surface* > lockFocus;
+        Signal < const Surface* > unlockFocus;
+        Signal < const Surface* > unhide;
+        
+        /*! @brief Connects every SurfaceObserver function of an observer. */
+        template < typename Observer >
+        void connect(Observer* observer)
+        {
+            didMove.connect(observer, [](void* o, const Surface* s, const ScreenPosition& p){ static_cast < Observer* >(o)->onSurfaceDidMove(s, p); });
+            didResize.connect(observer, [](void* o, const Surface* s, const RectSize& r){ static_cast < Observer* >(o)->onSurfaceDidResize(s, r); });
+            entersResizing.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceEntersResizing(s); });
+            exitsResizing.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceExitsResizing(s); });
+            willClose.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceWillClose(s); });
+            willHide.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceWillHide(s); });
+            lockFocus.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceLockFocus(s); });
+            unlockFocus.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceUnlockFocus(s); });
+            unhide.connect(observer, [](void* o, const Surface* s){ static_cast < Observer* >(o)->onSurfaceUnhide(s); });
+        }
+        
+        /*! @brief Disconnects every function of an observer. */
+        void disconnect(const void* observer)
+        {
+            didMove.disconnect(observer);
+            didResize.disconnect(observer);
+            entersResizing.disconnect(observer);
+            exitsResizing.disconnect(observer);
+            willClose.disconnect(observer);
+            willHide.disconnect(observer);
+            lockFocus.disconnect(observer);
+            unlockFocus.disconnect(observer);
+            unhide.disconnect(observer);
+        }
+    };
 }
 
 #endif /* SurfaceObserver_h */
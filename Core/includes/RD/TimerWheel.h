@@ -0,0 +1,212 @@
+//
+//  TimerWheel.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef TimerWheel_h
+#define TimerWheel_h
+
+#include "Global.h"
+#include "Spinlock.h"
+
+#include <deque>
+#include <vector>
+
+namespace RD
+{
+    class WorkerPool;
+
+    /*! @brief Identifier of a timer scheduled in a TimerWheel. Zero is never a valid identifier. */
+    using TimerId = std::uint64_t;
+
+    /**
+     * @brief Where a TimerWheel fires the callback of an expired timer.
+     */
+    enum class TimerDispatch
+    {
+        //! @brief Callback is called by the thread advancing the wheel (the main thread for Application).
+        MainThread,
+
+        //! @brief Callback is pushed to the WorkerPool set with \ref TimerWheel::setWorkerPool. If no pool
+        //! is set, the callback is called like MainThread.
+        WorkerPool
+    };
+
+    /**
+     * @brief Hierarchical timer wheel for delayed and periodic tasks.
+     *
+     * Time is divided in ticks of a fixed resolution (one millisecond by default). The wheel has four
+     * levels of 256 slots: level 0 holds timers expiring in the next 256 ticks, level 1 in the next 2^16
+     * ticks, and so on. When level 0 wraps, the next slot of level 1 is cascaded down, so each timer is
+     * moved at most three times during its life. Scheduling and cancelling a timer are O(1), and
+     * advancing the wheel only touches the slots of the elapsed ticks.
+     *
+     * Application owns one TimerWheel, advanced at each loop of \ref Application::run. Modules should use it
+     * instead of comparing Clock::now() in every update.
+     *
+     * @note
+     * \ref schedule, \ref schedulePeriodic and \ref cancel can be called from any thread, including from a
+     * timer callback. \ref advance must always be called by the same thread.
+     */
+    class TimerWheel
+    {
+        //! @brief Number of bits used to index slots in one level.
+        static constexpr std::uint32_t SlotBits = 8;
+
+        //! @brief Number of slots in one level.
+        static constexpr std::uint32_t SlotCount = 1 << SlotBits;
+
+        //! @brief Number of levels in the wheel.
+        static constexpr std::uint32_t LevelCount = 4;
+
+        //! @brief Index used to mark the end of a slot list.
+        static constexpr std::uint32_t NullIndex = 0xFFFFFFFF;
+
+        //! @brief State of a timer slot in \ref timers.
+        enum class TimerState : std::uint8_t { Free, Armed, Firing, Cancelled };
+
+        /*! @brief A timer, stored in an intrusive doubly linked list per slot. */
+        struct Timer
+        {
+            std::function < void() > callback;
+            std::uint64_t expiry = 0;
+            std::uint64_t period = 0;
+            std::uint32_t prev = NullIndex;
+            std::uint32_t next = NullIndex;
+            std::uint32_t generation = 1;
+            std::uint16_t slot = 0;
+            std::uint8_t level = 0;
+            TimerState state = TimerState::Free;
+            TimerDispatch dispatch = TimerDispatch::MainThread;
+        };
+
+        //! @brief Timers storage.
+        std::deque < Timer > timers;
+
+        //! @brief Free indexes in \ref timers.
+        std::vector < std::uint32_t > freeList;
+
+        //! @brief Head of each slot list.
+        std::uint32_t slots[LevelCount][SlotCount];
+
+        //! @brief One bit per non-empty slot, used to find the next deadline quickly.
+        std::uint64_t occupied[LevelCount][SlotCount / 64];
+
+        /*! @brief A timer expired during \ref advance, with its callback moved out of \ref timers. */
+        struct Expired
+        {
+            std::uint32_t index;
+            TimerDispatch dispatch;
+            std::function < void() > callback;
+        };
+
+        //! @brief Timers expired during the current \ref advance call.
+        std::vector < Expired > expired;
+
+        //! @brief Last tick processed by \ref advance.
+        std::uint64_t currentTick;
+
+        //! @brief Number of armed timers.
+        std::size_t armedCount;
+
+        //! @brief Time point of tick zero.
+        Clock::time_point origin;
+
+        //! @brief Duration of one tick.
+        Clock::duration resolution;
+
+        //! @brief Pool used for TimerDispatch::WorkerPool callbacks.
+        std::atomic < WorkerPool* > workerPool;
+
+        //! @brief Protects every member above. Never held while a callback runs.
+        mutable Spinlock spinlock;
+
+    public:
+
+        /*! @brief Constructs an empty wheel.
+         *
+         * @param[in] tick Resolution of the wheel. Timers never fire before their deadline, but may fire up
+         *      to one tick after it.
+         * @param[in] start Time point of tick zero.
+         */
+        explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(1), const Clock::time_point& start = Clock::now());
+
+        /*! @brief Default destructor. Pending timers are dropped without being fired. */
+        ~TimerWheel() = default;
+
+        /*! @brief Schedules a callback to be called once after the given delay.
+         *
+         * @param[in] delay Delay from now.
+         * @param[in] callback Function to call when the timer expires.
+         * @param[in] dispatch Where the callback is called.
+         *
+         * @return An identifier that can be given to \ref cancel.
+         */
+        TimerId schedule(Clock::duration delay, std::function < void() > callback, TimerDispatch dispatch = TimerDispatch::MainThread);
+
+        /*! @brief Schedules a callback to be called every period, the first time one period from now.
+         *
+         * If the wheel is advanced late, missed periods are skipped: a periodic timer fires at most once
+         * per call to \ref advance.
+         */
+        TimerId schedulePeriodic(Clock::duration period, std::function < void() > callback, TimerDispatch dispatch = TimerDispatch::MainThread);
+
+        /*! @brief Cancels a timer.
+         *
+         * A timer cancelled while its callback runs finishes its call but is not rearmed.
+         *
+         * @return True if the timer was armed or firing, false if it already expired or was cancelled.
+         */
+        bool cancel(TimerId id);
+
+        /*! @brief Cancels every timer. */
+        void clear();
+
+        /*! @brief Fires every timer whose deadline is before the given time point.
+         *
+         * @return The number of callbacks fired.
+         */
+        std::size_t advance(const Clock::time_point& now);
+
+        /*! @brief Returns a time point at which the next timer may expire.
+         *
+         * It is exact for timers expiring in the next 256 ticks, and a lower bound for other timers (they are
+         * cascaded at that time). The run loop can sleep until this time point without missing any timer.
+         *
+         * @return The deadline, or Clock::time_point::max() if no timer is armed.
+         */
+        Clock::time_point nextDeadline() const;
+
+        /*! @brief Returns the number of armed timers. */
+        std::size_t size() const;
+
+        /*! @brief Changes the WorkerPool used for TimerDispatch::WorkerPool callbacks. */
+        void setWorkerPool(WorkerPool* pool);
+
+    private:
+
+        /*! @brief Allocates a timer expiring after the given delay and inserts it. */
+        TimerId arm(Clock::duration delay, Clock::duration period, std::function < void() >&& callback, TimerDispatch dispatch);
+
+        /*! @brief Converts a duration to a number of ticks, rounding up. */
+        std::uint64_t toTicks(Clock::duration duration) const;
+
+        /*! @brief Inserts the timer in the slot matching its expiry. Spinlock must be held. */
+        void insert(std::uint32_t index);
+
+        /*! @brief Removes the timer from its slot. Spinlock must be held. */
+        void unlink(std::uint32_t index);
+
+        /*! @brief Releases a timer slot. Spinlock must be held. */
+        void release(std::uint32_t index);
+
+        /*! @brief Moves every timer of a slot to a lower level. Spinlock must be held.
+         * @return The slot index that was cascaded.
+         */
+        std::uint32_t cascade(std::uint32_t level);
+    };
+}
+
+#endif /* TimerWheel_h */
@@ -0,0 +1,108 @@
+//
+//  WorkerPool.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+#include "Global.h"
+#include "CpuTopology.h"
+#include "NodeArena.h"
+
+#include <condition_variable>
+#include <vector>
+
+namespace RD
+{
+    /**
+     * @brief Fixed set of worker threads consuming a shared task queue.
+     *
+     * Contrary to ThreadedTasks, which spawns one thread per task, a WorkerPool starts its threads
+     * once and reuses them for every task pushed. It is owned by the Application and used by engine
+     * subsystems that need to run short tasks outside of the main thread (like TimerWheel callbacks
+     * dispatched with TimerDispatch::WorkerPool).
+     *
+     * Workers can be pinned to CPUs following a ThreadConfiguration. Each worker then owns a NodeArena placed
+     * on the NUMA node of its CPU, so worker-local memory stays close to the worker.
+     *
+     * @note
+     * Order of execution between tasks is not guaranteed when the pool has more than one worker.
+     */
+    class WorkerPool
+    {
+        //! @brief Threads owned by this pool.
+        std::vector < std::thread > workers;
+
+        //! @brief Tasks waiting for a worker.
+        std::queue < std::function < void() > > tasks;
+
+        //! @brief Mutex protecting the task queue.
+        std::mutex mutex;
+
+        //! @brief Condition used to wake up workers when a task is pushed.
+        std::condition_variable condition;
+
+        //! @brief Set to true when the pool is being destroyed.
+        bool stopping;
+        
+        //! @brief CPU of each worker, or empty if workers are not pinned.
+        std::vector < int > workerCpus;
+        
+        //! @brief NUMA node of each worker's arena, or empty if workers have no arena.
+        std::vector < int > workerNodes;
+        
+        //! @brief Chunk size of each worker's arena.
+        std::size_t arenaChunkSize;
+
+    public:
+
+        /*! @brief Starts the workers.
+         *
+         * @param[in] count Number of workers to start. If zero, one worker per hardware thread
+         *      is started (minus one for the main thread, with a minimum of one).
+         */
+        explicit WorkerPool(std::size_t count = 0);
+        
+        /*! @brief Starts the workers and pins them according to a configuration.
+         *
+         * CPUs are selected with \ref CpuTopology::select, excluding the physical cores reserved for the
+         * main and render threads. If the configuration asks for no pinning, workers still get an unplaced
+         * arena when configuration.arenaChunkSize is not zero.
+         *
+         * @param[in] configuration Threads configuration.
+         * @param[in] topology Topology of the host.
+         */
+        WorkerPool(const ThreadConfiguration& configuration, const CpuTopology& topology);
+
+        /*! @brief Finishes pending tasks and joins every worker. */
+        ~WorkerPool();
+
+        /*! @brief Pushes a task to be executed by the first available worker. */
+        void push(std::function < void() >&& task);
+
+        /*! @brief Returns the number of workers. */
+        std::size_t size() const;
+        
+        /*! @brief Returns the CPU of each worker, or an empty list if workers are not pinned. */
+        const std::vector < int >& cpus() const;
+        
+    public:
+        
+        /*! @brief Returns the arena of the calling worker, or nullptr if not called from a worker
+         * or if the worker has no arena. */
+        static NodeArena* LocalArena();
+
+    private:
+        
+        /*! @brief Starts count workers. */
+        void startWorkers(std::size_t count);
+
+        /*! @brief Main function of each worker. */
+        void work(std::size_t index);
+    };
+}
+
+#endif /* WorkerPool_h */
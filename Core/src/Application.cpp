@@ -7,11 +7,13 @@
 //
 
 #include "Application.h"
+#include "FlightRecorder.h"
 
 namespace RD
 {
     /////////////////////////////////////////////////////////////////////////////////
     Application::Application()
+    : eventFlushPoint( EventFlushPoint::AfterModules ), pipelineDepth( 0 ), frameCount( 0 )
     {
         shouldTerminate.store( false );
         
@@ -22,6 +24,11 @@ namespace RD
     /////////////////////////////////////////////////////////////////////////////////
     Application::~Application()
     {
+        /* terminate() is not called when run() exits by an exception. */
+        
+        stopRenderStage();
+        MemoryPressureMonitor::Default().stop();
+        
         NotificationCenter::defaultCenter.reset();
     }
     
@@ -40,6 +47,29 @@ namespace RD
         if ( delegate.valid() )
             delegate->onApplicationWillStart( *this, Clock::now() );
         
+        topology = CpuTopology::Detect();
+        
+        if ( threadConfiguration.mainCpu >= 0 )
+            CpuTopology::PinCurrentThread({ threadConfiguration.mainCpu });
+        
+        workerPool = CreateHandle < WorkerPool >( threadConfiguration, topology );
+        timers.setWorkerPool( workerPool.ptr() );
+        
+        MemoryPressureMonitor::Default().start( memoryPressureConfiguration, [this](){ wake(); } );
+        
+        if ( pipelineDepth && delegate.valid() )
+        {
+            std::vector < Handle < FrameData > > frames;
+            
+            for ( std::size_t i = 0; i < pipelineDepth; ++i )
+                frames.push_back( delegate->onApplicationCreateFrameData( *this ) );
+            
+            pipeline = CreateHandle < FramePipeline >( std::move( frames ) );
+            
+            if ( pipelineDepth > 1 )
+                renderThread = std::thread( &Application::render, this );
+        }
+        
         /* Start every modules already registered. */
         
         {
@@ -63,90 +93,181 @@ namespace RD
     {
         start();
         
-        while ( !shouldTerminate )
+        try
         {
-            if ( delegate.valid() )
-                delegate->onApplicationWillUpdate( *this, Clock::now() );
-            
-            /* Updates every registered modules. */
-            
+            while ( true )
             {
-                std::lock_guard < std::mutex > lock( modulesMutex );
-                
-                for ( auto& module : modules )
+                while ( !shouldTerminate )
                 {
-                    if ( module.valid() )
-                        module->update( *this, Clock::now() );
+                    tick();
+                    scheduler.wait( timers.nextDeadline() );
                 }
+                
+                if ( delegate.valid() )
+                    shouldTerminate.store( delegate->onApplicationShouldTerminate( *this ) );
+                
+                if ( shouldTerminate )
+                    break;
             }
-            
-            /* Do here platform updates. */
-            
-            if ( delegate.valid() )
-                delegate->onApplicationDidUpdate( *this, Clock::now() );
         }
         
+        catch ( ... )
+        {
+            // The render thread would stay blocked in the pipeline otherwise, and the monitor would keep
+            // our wake function.
+            stopRenderStage();
+            MemoryPressureMonitor::Default().stop();
+            throw;
+        }
+        
+        terminate();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::tick()
+    {
+        scheduler.beginFrame( Clock::now() );
+        scheduler.runPosted();
+        
+        /* Reclaims memory before the tick allocates more. */
+        
+        MemoryPressureMonitor::Default().dispatch();
+        
+        timers.advance( Clock::now() );
+        
+        if ( eventFlushPoint == EventFlushPoint::BeginTick )
+            EventQueue::Default().flush();
+        
         if ( delegate.valid() )
-            shouldTerminate.store( delegate->onApplicationShouldTerminate( *this ) );
+            delegate->onApplicationWillUpdate( *this, Clock::now() );
         
-        if ( !shouldTerminate )
-            run();
+        std::uint32_t steps = scheduler.fixedSteps();
         
-        else
-            terminate();
+        for ( std::uint32_t i = 0; i < steps && delegate.valid(); ++i )
+            delegate->onApplicationFixedUpdate( *this, Clock::now(), scheduler.fixedTimestep() );
+        
+        /* Updates every registered modules. */
+        
+        {
+            std::lock_guard < std::mutex > lock( modulesMutex );
+            
+            for ( auto& module : modules )
+            {
+                if ( !module.valid() )
+                    continue;
+                
+                if ( FlightRecorder::Enabled() )
+                    FlightRecorder::Record( FlightRecorder::EventType::ModuleUpdateBegin, module.ptr(), 0, module->name().c_str() );
+                
+                module->update( *this, Clock::now() );
+                
+                FlightRecorder::Record( FlightRecorder::EventType::ModuleUpdateEnd, module.ptr(), 0, nullptr );
+            }
+        }
+        
+        /* Do here platform updates. */
+        
+        if ( eventFlushPoint == EventFlushPoint::AfterModules )
+            EventQueue::Default().flush();
+        
+        if ( pipeline.valid() )
+            simulate();
+        
+        if ( delegate.valid() )
+            delegate->onApplicationDidUpdate( *this, Clock::now() );
+        
+        if ( eventFlushPoint == EventFlushPoint::EndTick )
+            EventQueue::Default().flush();
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void Application::stop()
     {
         shouldTerminate.store( true );
+        scheduler.wake();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::post( std::function < void() >&& work )
+    {
+        scheduler.post( std::move( work ) );
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::wake()
+    {
+        scheduler.wake();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::setEventFlushPoint( EventFlushPoint point )
+    {
+        eventFlushPoint = point;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    EventFlushPoint Application::getEventFlushPoint() const
+    {
+        return eventFlushPoint;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    FrameScheduler& Application::getFrameScheduler()
+    {
+        return scheduler;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void Application::addModule(const Handle<RD::Module> &module)
+    {
+        tryAddModule( module ).value();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Expected < Handle < Module > > Application::tryAddModule(const Handle<RD::Module> &module)
     {
         std::lock_guard < std::mutex > lock( modulesMutex );
         auto it = std::find( modules.begin(), modules.end(), module );
-        if ( it != modules.end() ) throw HandleNotUniqueException( (uintptr_t) module.ptr() );
+        
+        if ( it != modules.end() )
+            return Error( kErrorHandleNotUnique, RDFormatString("Handle not unique (0x%zx)."), (uintptr_t) module.ptr() );
         
         modules.push_front( module );
+        return module;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     Handle < Module > Application::loadModule(const std::string &libname, bool required)
+    {
+        Expected < Handle < Module > > module = tryLoadModule( libname );
+        
+        // Only load failures are optional: registering a module twice always throws.
+        if ( !module && !required && module.error().code() == kErrorModuleNotLoaded )
+            return Handle < Module >();
+        
+        return std::move( module ).value();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Expected < Handle < Module > > Application::tryLoadModule(const std::string &libname)
     {
         //! @brief Our function to look for in the library.
         typedef Handle < Module > (*CreateModuleFcn) ( void );
         
         void* handle = dlopen( libname.data(), RTLD_LAZY );
-        bool result = (handle != nullptr);
         
-        if ( !result && required )
-            throw ModuleNotLoadedException( libname );
+        if ( !handle )
+            return Error( kErrorModuleNotLoaded, RDFormatString("%s required but not loaded."), libname );
         
         CreateModuleFcn fcn = (CreateModuleFcn) dlsym( handle, "CreateModule" );
-        result = result && (fcn != nullptr);
+        Handle < Module > module = fcn ? fcn() : Handle < Module >();
         
-        if ( !result && required ) {
+        if ( !module.valid() ) {
             dlclose(handle);
-            throw ModuleNotLoadedException( libname );
+            return Error( kErrorModuleNotLoaded, RDFormatString("%s required but not loaded."), libname );
         }
-        if ( !result ) {
-            dlclose(handle);
-            return Handle < Module >();
-        }
-        
-        Handle < Module > module = fcn();
-        result = result && module.valid();
-        
-        if ( !result && required ) {
-            dlclose(handle);
-            throw ModuleNotLoadedException( libname );
-        }
-        else
-            addModule( module );
         
-        return module;
+        return tryAddModule( module );
     }
     
     /////////////////////////////////////////////////////////////////////////////////
@@ -156,6 +277,60 @@ namespace RD
         return defaultCenter;
     }
     
+    /////////////////////////////////////////////////////////////////////////////////
+    TimerWheel& Application::getTimerWheel()
+    {
+        return timers;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < WorkerPool > Application::getWorkerPool()
+    {
+        return workerPool;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::setThreadConfiguration( const ThreadConfiguration& configuration )
+    {
+        threadConfiguration = configuration;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const ThreadConfiguration& Application::getThreadConfiguration() const
+    {
+        return threadConfiguration;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const CpuTopology& Application::getCpuTopology() const
+    {
+        return topology;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::setMemoryPressureConfiguration( const MemoryPressureConfiguration& configuration )
+    {
+        memoryPressureConfiguration = configuration;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const MemoryPressureConfiguration& Application::getMemoryPressureConfiguration() const
+    {
+        return memoryPressureConfiguration;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::setPipelineDepth( std::size_t depth )
+    {
+        pipelineDepth = depth;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Application::getPipelineDepth() const
+    {
+        return pipelineDepth;
+    }
+    
     /////////////////////////////////////////////////////////////////////////////////
     Handle < Module > Application::findModule(const std::string &name)
     {
@@ -184,6 +359,15 @@ namespace RD
     /////////////////////////////////////////////////////////////////////////////////
     void Application::terminate()
     {
+        /* Stops the render stage first: it may use the modules and the delegate. Frames already
+         * simulated are rendered before the render thread returns. */
+        
+        stopRenderStage();
+        
+        /* Dispatches events recorded during the last tick, while modules are still alive. */
+        
+        EventQueue::Default().flush();
+        
         if ( delegate.valid() )
             delegate->onApplicationWillTerminate( *this, Clock::now() );
         
@@ -203,6 +387,81 @@ namespace RD
         
         /* Do here application's terminating features. */
         
+        MemoryPressureMonitor::Default().stop();
+        
+        timers.clear();
+        timers.setWorkerPool( nullptr );
+        workerPool.reset();
+        
         delegate.reset();
     }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::simulate()
+    {
+        FrameData* frame = nullptr;
+        
+        try
+        {
+            frame = pipeline->acquireWrite();
+        }
+        
+        catch ( ... )
+        {
+            // The render thread failed and already returned.
+            if ( renderThread.joinable() )
+                renderThread.join();
+            
+            throw;
+        }
+        
+        if ( !frame )
+            return;
+        
+        frame->frame = frameCount++;
+        frame->time = Clock::now();
+        delegate->onApplicationSimulate( *this, frame->time, *frame );
+        pipeline->publish();
+        
+        if ( pipelineDepth > 1 )
+            return;
+        
+        const FrameData* rendered = pipeline->acquireRead();
+        delegate->onApplicationRender( *this, Clock::now(), *rendered );
+        pipeline->release();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::stopRenderStage()
+    {
+        if ( pipeline.valid() )
+            pipeline->close();
+        
+        if ( renderThread.joinable() )
+            renderThread.join();
+        
+        pipeline.reset();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Application::render()
+    {
+        if ( threadConfiguration.renderCpu >= 0 )
+            CpuTopology::PinCurrentThread({ threadConfiguration.renderCpu });
+        
+        try
+        {
+            while ( const FrameData* frame = pipeline->acquireRead() )
+            {
+                delegate->onApplicationRender( *this, Clock::now(), *frame );
+                pipeline->release();
+            }
+        }
+        
+        catch ( ... )
+        {
+            // The error is rethrown on the main thread by its next simulate().
+            pipeline->close( std::current_exception() );
+        }
+    }
 }
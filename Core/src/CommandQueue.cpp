@@ -0,0 +1,212 @@
+//
+//  CommandQueue.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "CommandQueue.h"
+#include "Driver.h"
+
+#include <algorithm>
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    CommandQueue::CommandQueue(Driver& d) noexcept : driver(d)
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    CommandQueue::~CommandQueue()
+    {
+        stop();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::unique_ptr < CommandBuffer > CommandQueue::acquire(std::uint32_t order)
+    {
+        std::unique_ptr < CommandBuffer > buffer;
+
+        {
+            std::lock_guard < std::mutex > lock(freeMutex);
+
+            if (!freeBuffers.empty())
+            {
+                buffer = std::move(freeBuffers.back());
+                freeBuffers.pop_back();
+            }
+        }
+
+        if (!buffer)
+            return std::make_unique < CommandBuffer >(order);
+
+        buffer->setOrder(order);
+        return buffer;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CommandQueue::submit(std::unique_ptr < CommandBuffer > buffer)
+    {
+        if (!buffer)
+            return;
+
+        CommandBuffer* raw = buffer.release();
+        raw->sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        raw->next = submitted.load(std::memory_order_relaxed);
+
+        while (!submitted.compare_exchange_weak(raw->next, raw, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CommandQueue::present()
+    {
+        Frame frame;
+        CommandBuffer* buffer = submitted.exchange(nullptr, std::memory_order_acquire);
+
+        while (buffer)
+        {
+            CommandBuffer* next = buffer->next;
+            buffer->next = nullptr;
+            frame.buffers.emplace_back(buffer);
+            buffer = next;
+        }
+
+        std::sort(frame.buffers.begin(), frame.buffers.end(), [](const std::unique_ptr < CommandBuffer >& lhs, const std::unique_ptr < CommandBuffer >& rhs){
+            if (lhs->bufferOrder != rhs->bufferOrder)
+                return lhs->bufferOrder < rhs->bufferOrder;
+            return lhs->sequence < rhs->sequence;
+        });
+
+        // Captured before the execution thread can reset the buffers.
+        driver.record([&frame](DriverCapture& capture){
+            for (const std::unique_ptr < CommandBuffer >& buffer : frame.buffers)
+                capture.writeBuffer(*buffer);
+
+            capture.writePresent();
+        });
+
+        {
+            std::unique_lock < std::mutex > lock(framesMutex);
+
+            // The thread of a running stop() may still execute frames: a second one is only started once
+            // it has been joined.
+            stoppedCondition.wait(lock, [this](){ return !stopping; });
+
+            frames.push_back(std::move(frame));
+            presented++;
+
+            if (!thread.joinable())
+                thread = std::thread(&CommandQueue::run, this);
+        }
+
+        framesCondition.notify_one();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CommandQueue::wait()
+    {
+        std::unique_lock < std::mutex > lock(framesMutex);
+        std::uint64_t target = presented;
+
+        executedCondition.wait(lock, [this, target](){ return executed >= target; });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CommandQueue::stop()
+    {
+        std::thread stopped;
+
+        {
+            std::unique_lock < std::mutex > lock(framesMutex);
+
+            // Only one stop() at a time: the queue stays stopping until the thread is joined.
+            stoppedCondition.wait(lock, [this](){ return !stopping; });
+
+            stopping = true;
+            stopped = std::move(thread);
+        }
+
+        framesCondition.notify_one();
+
+        if (stopped.joinable())
+            stopped.join();
+
+        {
+            std::lock_guard < std::mutex > lock(framesMutex);
+            stopping = false;
+        }
+
+        stoppedCondition.notify_all();
+
+        CommandBuffer* buffer = submitted.exchange(nullptr, std::memory_order_acquire);
+
+        while (buffer)
+        {
+            CommandBuffer* next = buffer->next;
+            delete buffer;
+            buffer = next;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t CommandQueue::presentedFrames() const
+    {
+        std::lock_guard < std::mutex > lock(framesMutex);
+        return presented;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t CommandQueue::executedFrames() const
+    {
+        std::lock_guard < std::mutex > lock(framesMutex);
+        return executed;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CommandQueue::run()
+    {
+        std::unique_lock < std::mutex > lock(framesMutex);
+
+        while (true)
+        {
+            framesCondition.wait(lock, [this](){ return stopping || !frames.empty(); });
+
+            if (frames.empty())
+                return;
+
+            Frame frame = std::move(frames.front());
+            frames.pop_front();
+
+            lock.unlock();
+            execute(frame);
+            lock.lock();
+
+            executed++;
+            executedCondition.notify_all();
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CommandQueue::execute(Frame& frame)
+    {
+        for (std::unique_ptr < CommandBuffer >& buffer : frame.buffers)
+        {
+            buffer->forEach([this](const CommandHeader& header, const void* payload){
+                if (header.type == kDrawItemsCommand)
+                    driver.executeDrawItems(static_cast < const DrawItem* >(payload), header.size / sizeof(DrawItem));
+                else
+                    driver.executeCommand(header, payload);
+            });
+
+            buffer->reset();
+        }
+
+        std::lock_guard < std::mutex > lock(freeMutex);
+
+        for (std::unique_ptr < CommandBuffer >& buffer : frame.buffers)
+            freeBuffers.push_back(std::move(buffer));
+    }
+}
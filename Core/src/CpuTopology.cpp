@@ -0,0 +1,399 @@
+//
+//  CpuTopology.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "CpuTopology.h"
+
+#include <fstream>
+#include <set>
+#include <algorithm>
+#include <tuple>
+
+#if defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
+namespace RD
+{
+    namespace
+    {
+        /*! @brief Reads the first line of a file, or returns an empty string. */
+        std::string ReadLine(const std::string& path)
+        {
+            std::ifstream stream(path);
+            std::string line;
+
+            if (stream)
+                std::getline(stream, line);
+
+            return line;
+        }
+
+        /*! @brief Reads an integer from a file, or returns the default value. */
+        int ReadInt(const std::string& path, int def)
+        {
+            std::string line = ReadLine(path);
+
+            if (line.empty())
+                return def;
+
+            return std::atoi(line.data());
+        }
+
+        /*! @brief Interleaves lists round-robin: first element of each list, then second, etc. */
+        std::vector < int > Interleave(const std::vector < std::vector < int > >& lists)
+        {
+            std::vector < int > result;
+            std::size_t depth = 0;
+
+            for (auto& list : lists)
+                depth = std::max(depth, list.size());
+
+            for (std::size_t i = 0; i < depth; ++i)
+            {
+                for (auto& list : lists)
+                {
+                    if (i < list.size())
+                        result.push_back(list[i]);
+                }
+            }
+
+            return result;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::vector < int > ParseCpuList(const std::string& list)
+    {
+        std::vector < int > cpus;
+
+        for (auto& range : explode(list, ','))
+        {
+            auto bounds = explode(range, '-');
+
+            if (bounds.empty())
+                continue;
+
+            int first = std::atoi(bounds[0].data());
+            int last = bounds.size() > 1 ? std::atoi(bounds[1].data()) : first;
+
+            for (int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        return cpus;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    CpuTopology CpuTopology::Detect(const std::string& root)
+    {
+        CpuTopology topology;
+        const std::string cpuRoot = root + "/cpu";
+
+        std::vector < int > online = ParseCpuList(ReadLine(cpuRoot + "/online"));
+
+        if (online.empty())
+        {
+            // No sysfs: every logical CPU is its own core on node 0.
+            unsigned count = std::max(std::thread::hardware_concurrency(), 1u);
+
+            for (unsigned i = 0; i < count; ++i)
+            {
+                CpuInfo info;
+                info.id = info.core = info.l3 = static_cast < int >(i);
+                topology.cpuList.push_back(info);
+            }
+
+            return topology;
+        }
+
+        // Core ids are only unique inside a package, so we give each (package, core_id) pair a global
+        // identifier.
+        std::map < std::pair < int, int >, int > coreIds;
+
+        for (int cpu : online)
+        {
+            const std::string path = cpuRoot + "/cpu" + std::to_string(cpu);
+
+            CpuInfo info;
+            info.id = cpu;
+            info.package = ReadInt(path + "/topology/physical_package_id", 0);
+
+            auto key = std::make_pair(info.package, ReadInt(path + "/topology/core_id", cpu));
+            auto it = coreIds.find(key);
+
+            if (it == coreIds.end())
+                it = coreIds.insert(std::make_pair(key, static_cast < int >(coreIds.size()))).first;
+
+            info.core = it->second;
+            info.l3 = cpu;
+
+            for (int index = 0; ; ++index)
+            {
+                const std::string cache = path + "/cache/index" + std::to_string(index);
+                const int level = ReadInt(cache + "/level", -1);
+
+                if (level < 0)
+                    break;
+
+                if (level == 3)
+                {
+                    auto shared = ParseCpuList(ReadLine(cache + "/shared_cpu_list"));
+
+                    if (!shared.empty())
+                        info.l3 = *std::min_element(shared.begin(), shared.end());
+
+                    break;
+                }
+            }
+
+            topology.cpuList.push_back(info);
+        }
+
+        // NUMA nodes list their CPUs. Without node directory, every CPU stays on node 0.
+        for (int node : ParseCpuList(ReadLine(root + "/node/online")))
+        {
+            auto cpus = ParseCpuList(ReadLine(root + "/node/node" + std::to_string(node) + "/cpulist"));
+
+            for (int cpu : cpus)
+            {
+                for (auto& info : topology.cpuList)
+                {
+                    if (info.id == cpu)
+                        info.node = node;
+                }
+            }
+        }
+
+        return topology;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const std::vector < CpuInfo >& CpuTopology::cpus() const
+    {
+        return cpuList;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const CpuInfo* CpuTopology::find(int cpu) const
+    {
+        auto it = std::find_if(cpuList.begin(), cpuList.end(), [cpu](const CpuInfo& info){
+            return info.id == cpu;
+        });
+
+        return it != cpuList.end() ? &(*it) : nullptr;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t CpuTopology::coreCount() const
+    {
+        std::set < int > cores;
+
+        for (auto& info : cpuList)
+            cores.insert(info.core);
+
+        return cores.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t CpuTopology::nodeCount() const
+    {
+        std::set < int > nodes;
+
+        for (auto& info : cpuList)
+            nodes.insert(info.node);
+
+        return nodes.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t CpuTopology::l3Count() const
+    {
+        std::set < int > domains;
+
+        for (auto& info : cpuList)
+            domains.insert(info.l3);
+
+        return domains.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    int CpuTopology::nodeOf(int cpu) const
+    {
+        const CpuInfo* info = find(cpu);
+        return info ? info->node : 0;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::vector < int > CpuTopology::siblingsOf(int cpu) const
+    {
+        std::vector < int > siblings;
+        const CpuInfo* info = find(cpu);
+
+        if (!info)
+            return siblings;
+
+        for (auto& other : cpuList)
+        {
+            if (other.core == info->core)
+                siblings.push_back(other.id);
+        }
+
+        return siblings;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::vector < int > CpuTopology::select(AffinityPolicy policy, std::size_t count, int node, const std::vector < int >& reserved) const
+    {
+        if (policy == AffinityPolicy::None)
+            return std::vector < int >();
+
+        std::set < int > reservedCores;
+
+        for (int cpu : reserved)
+        {
+            const CpuInfo* info = find(cpu);
+
+            if (info)
+                reservedCores.insert(info->core);
+        }
+
+        std::vector < CpuInfo > available;
+
+        for (auto& info : cpuList)
+        {
+            if (node >= 0 && info.node != node)
+                continue;
+            if (reservedCores.count(info.core))
+                continue;
+
+            available.push_back(info);
+        }
+
+        if (available.empty())
+            return std::vector < int >();
+
+        std::sort(available.begin(), available.end(), [](const CpuInfo& lhs, const CpuInfo& rhs){
+            return std::tie(lhs.node, lhs.package, lhs.l3, lhs.core, lhs.id)
+                 < std::tie(rhs.node, rhs.package, rhs.l3, rhs.core, rhs.id);
+        });
+
+        std::vector < int > order;
+
+        if (policy == AffinityPolicy::Compact)
+        {
+            for (auto& info : available)
+                order.push_back(info.id);
+        }
+
+        else
+        {
+            // Ranks each CPU inside its core: rank 0 is the first hardware thread of the core, rank 1 its
+            // first SMT sibling, etc. Every rank 0 CPU is used before any rank 1 CPU.
+            std::map < int, int > coreRanks;
+            std::map < int, std::vector < CpuInfo > > ranks;
+
+            for (auto& info : available)
+                ranks[coreRanks[info.core]++].push_back(info);
+
+            for (auto& rank : ranks)
+            {
+                if (policy == AffinityPolicy::PhysicalCores)
+                {
+                    for (auto& info : rank.second)
+                        order.push_back(info.id);
+                    continue;
+                }
+
+                // Scatter: round-robin over nodes, and inside each node round-robin over L3 domains.
+                std::map < int, std::map < int, std::vector < int > > > domains;
+
+                for (auto& info : rank.second)
+                    domains[info.node][info.l3].push_back(info.id);
+
+                std::vector < std::vector < int > > nodes;
+
+                for (auto& nodeDomains : domains)
+                {
+                    std::vector < std::vector < int > > l3s;
+
+                    for (auto& l3 : nodeDomains.second)
+                        l3s.push_back(l3.second);
+
+                    nodes.push_back(Interleave(l3s));
+                }
+
+                auto scattered = Interleave(nodes);
+                order.insert(order.end(), scattered.begin(), scattered.end());
+            }
+        }
+
+        if (!count)
+            count = order.size();
+
+        std::vector < int > result(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            result[i] = order[i % order.size()];
+
+        return result;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool CpuTopology::PinThread(std::thread& thread, const std::vector < int >& cpus)
+    {
+#       if defined(__linux__)
+        if (cpus.empty())
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (int cpu : cpus)
+            CPU_SET(cpu, &set);
+
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+
+#       else
+        return false;
+
+#       endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool CpuTopology::PinCurrentThread(const std::vector < int >& cpus)
+    {
+#       if defined(__linux__)
+        if (cpus.empty())
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (int cpu : cpus)
+            CPU_SET(cpu, &set);
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+
+#       else
+        return false;
+
+#       endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    int CpuTopology::CurrentCpu()
+    {
+#       if defined(__linux__)
+        return sched_getcpu();
+
+#       else
+        return -1;
+
+#       endif
+    }
+}
@@ -7,6 +7,10 @@
 
 #include "Driver.h"
 #include "NotificationCenter.h"
+#include "FlightRecorder.h"
+#include "MemoryPressure.h"
+
+#include <cstring>
 
 namespace RD
 {
@@ -19,88 +23,161 @@ namespace RD
     /////////////////////////////////////////////////////////////////////////////////
     void Driver::SurfaceHelper::onSurfaceWillClose(const RD::Surface * surface)
     {
-        std::lock_guard<std::mutex> lock(driver->mutex);
+        FlightRecorder::Record(FlightRecorder::EventType::SurfaceClosed, surface, 0, nullptr);
         
-        auto it = std::find_if(driver->surfaces.begin(), driver->surfaces.end(), [surface](const Handle < Surface >& handle){
-            if (handle.ptr() == surface)
-                return true;
-            return false;
+        driver->record([surface](DriverCapture& capture){
+            capture.write(CaptureRecordType::SurfaceClosed, CaptureSurfaceEvent { CaptureId(surface), 0, 0 });
         });
         
-        if (it != driver->surfaces.end())
-        {
-            auto itr = std::find_if(driver->resources.begin(), driver->resources.end(), [surface](const Handle < DriverResource >& handle){
-                if (handle.ptr() == surface)
-                    return true;
-                return false;
-            });
-            
-            Handle < DriverResource > handle = itr->second;
-            driver->surfaces.erase(it);
-            driver->resources.erase(itr);
-            
-            std::lock_guard<std::mutex> lock2(driver->lrqMutex);
-            driver->laterReleaseQueue.push(handle);
-        }
+        Handle < DriverResource > handle = driver->registry.remove(surface);
+        
+        if (handle.valid())
+            driver->retire(handle);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    Driver::Driver() noexcept : surfaceHelper(this)
+    void Driver::SurfaceHelper::onSurfaceDidMove(const Surface* surface, const ScreenPosition& position)
     {
+        driver->record([surface, &position](DriverCapture& capture){
+            capture.write(CaptureRecordType::SurfaceMoved, CaptureSurfaceEvent { CaptureId(surface), position.x, position.y });
+        });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::SurfaceHelper::onSurfaceDidResize(const Surface* surface, const RectSize& size)
+    {
+        driver->updateMemoryUsage(surface);
         
+        driver->record([surface, &size](DriverCapture& capture){
+            capture.write(CaptureRecordType::SurfaceResized, CaptureSurfaceEvent { CaptureId(surface), size.width, size.height });
+        });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::SurfaceHelper::onSurfaceWillHide(const Surface* surface)
+    {
+        driver->record([surface](DriverCapture& capture){
+            capture.write(CaptureRecordType::SurfaceHidden, CaptureSurfaceEvent { CaptureId(surface), 0, 0 });
+        });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::SurfaceHelper::onSurfaceUnhide(const Surface* surface)
+    {
+        driver->record([surface](DriverCapture& capture){
+            capture.write(CaptureRecordType::SurfaceUnhidden, CaptureSurfaceEvent { CaptureId(surface), 0, 0 });
+        });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::SurfaceHelper::onSurfaceLockFocus(const Surface* surface)
+    {
+        driver->record([surface](DriverCapture& capture){
+            capture.write(CaptureRecordType::SurfaceLockedFocus, CaptureSurfaceEvent { CaptureId(surface), 0, 0 });
+        });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Driver::Driver() noexcept : surfaceHelper(this), commandQueue(*this), renderQueue(commandQueue)
+    {
+        reclaimerId = MemoryPressureMonitor::Default().addReclaimer("Driver", MemoryReclaimPriority::Unused,
+            [this](){ return releaseStats().pendingBytes; },
+            [this](MemoryPressureLevel, std::size_t){ return releaseRetired(); });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Driver::~Driver() noexcept
+    {
+        MemoryPressureMonitor::Default().removeReclaimer(reclaimerId);
+        commandQueue.stop();
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     Handle < Surface > Driver::createSurface(uint32_t width, uint32_t height, const std::string &title, const std::string &objectName, uint32_t style, const void* extension)
+    {
+        Expected < Handle < Surface > > surface = tryCreateSurface(width, height, title, objectName, style, extension);
+        
+        if (!surface && surface.error().code() == kErrorSurfaceNotCreated)
+            return Handle < Surface >();
+        
+        return std::move(surface).value();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Expected < Handle < Surface > > Driver::tryCreateSurface(uint32_t width, uint32_t height, const std::string &title, const std::string &objectName, uint32_t style, const void* extension)
     {
         HashedString id(objectName.data());
         std::lock_guard < std::mutex > lock(mutex);
         
-        auto it = surfaces.find(id);
+        Handle < Surface > existing = registry.findSurface(id);
         
-        if (it == surfaces.end())
+        if (!existing.valid())
         {
             Handle < Surface > handle = _createSurface(width, height, title, objectName, style, extension);
             
             if (!handle.valid())
             {
-                NotifiateAbort("Core",
-                               "Driver::CreateSurface",
-                               kDriverInvalidSurfaceCreationNotification,
-                               "Driver %s can't create surface %s.",
-                               name().data(), objectName.data());
+                auto answers = TryNotifiateAbort("Core",
+                                                 "Driver::CreateSurface",
+                                                 kDriverInvalidSurfaceCreationNotification,
+                                                 RDFormatString("Driver %s can't create surface %s."),
+                                                 name().data(), objectName.data());
+                
+                if (!answers)
+                    return answers.error();
+                
+                return Error("Core", "Driver::CreateSurface", kErrorSurfaceNotCreated,
+                             FormatToString(RDFormatString("Driver %s can't create surface %s."), name(), objectName));
             }
             
-            resources.insert(std::make_pair(id, handle));
-            surfaces.insert(std::make_pair(id, handle));
+            registry.insert(id, handle);
             handle->addListener(&surfaceHelper);
             
+            record([&](DriverCapture& capture){
+                capture.writeSurface(handle.ptr(), title, objectName, style);
+            });
+            
+            updateMemoryUsage(handle.ptr());
+            
+            FlightRecorder::Record(FlightRecorder::EventType::SurfaceCreated, handle.ptr(),
+                                   (std::uint64_t(width) << 32) | height, objectName.c_str());
+            
             emit < DriverObserver >(&DriverObserver::onDriverCreatesSurface, this, handle.ptr());
             
             NotificationCenter::Notifiate("Core",
                                           "Driver::CreateSurface",
                                           kDriverSurfaceCreatedNotification,
-                                          "Driver %s created surface %s.",
+                                          RDFormatString("Driver %s created surface %s."),
                                           name().data(), objectName.data());
             
             return handle;
         }
         
-        return it->second;
+        return existing;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     std::map < HashedString, Handle < Surface > > Driver::loadSurfaces()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        return surfaces;
+        std::map < HashedString, Handle < Surface > > result;
+        
+        registry.forEachSurface([&result](const HashedString& name, const Handle < Surface >& surface){
+            result.insert(std::make_pair(name, surface));
+        });
+        
+        return result;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     std::map < HashedString, Handle < DriverResource > > Driver::loadResources()
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        return resources;
+        std::map < HashedString, Handle < DriverResource > > result;
+        
+        registry.forEachResource([&result](const HashedString& name, const Handle < DriverResource >& resource){
+            result.insert(std::make_pair(name, resource));
+        });
+        
+        return result;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
@@ -108,88 +185,421 @@ namespace RD
     {
         emit < DriverObserver >(&DriverObserver::onDriverWillClear, this);
         
-        {
-            auto resources2 = loadResources();
+        // Surfaces remove themselves from the registry and retire themselves when closed by onDriverClear:
+        // the snapshot keeps them alive during the visit.
+        registry.forEachResource([this](const HashedString&, Handle < DriverResource > resource){
+            if (!resource.valid())
+                return;
             
-            for (auto pair : resources2)
+            if (!resource->isUsed())
             {
-                if (pair.second.valid())
-                {
-                    if (!pair.second->isUsed())
-                    {
-                        pair.second->onDriverClear();
-                    }
-                    else
-                    {
-                        std::lock_guard < std::mutex > lock(lrqMutex);
-                        laterReleaseQueue.push(pair.second);
-                    }
-                }
+                releaseMemory(resource.ptr());
+                resource->onDriverClear();
             }
-            
-            std::lock_guard < std::mutex > lock(mutex);
-            
-            resources.clear();
-            surfaces.clear();
-        }
+            else
+            {
+                retire(resource);
+            }
+        });
+        
+        registry.clear();
+        registry.collect();
         
         emit < DriverObserver >(&DriverObserver::onDriverDidClear, this);
         NotificationCenter::Notifiate("Core", "Driver::clearResources", kDriverDidClearNotification,
-                                      "Driver %s cleared its resources.", name().data());
+                                      RDFormatString("Driver %s cleared its resources."), name().data());
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     std::size_t Driver::getSurfacesCount() const
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        return surfaces.size();
+        return registry.surfacesSize();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Driver::getResourcesCount() const
+    {
+        return registry.size();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::retire(const Handle < DriverResource >& resource)
+    {
+        if (!resource.valid())
+            return;
+        
+        std::size_t bytes = resource->memorySize();
+        std::lock_guard < std::mutex > lock(releaseMutex);
+        
+        // The epoch is read after the resource was unlinked by the caller: a reader which could still
+        // find it has observed this epoch or an older one.
+        std::uint64_t current = epoch.load();
+        
+        if (retiredBuckets.empty() || retiredBuckets.back().epoch != current)
+            retiredBuckets.push_back(RetiredBucket { current, {}, 0 });
+        
+        RetiredBucket& bucket = retiredBuckets.back();
+        bucket.resources.push_back(RetiredResource { resource, bytes });
+        bucket.bytes += bytes;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t Driver::releaseEpoch() const
+    {
+        return epoch.load();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    DriverReleaseStats Driver::releaseStats() const
+    {
+        DriverReleaseStats stats;
+        std::lock_guard < std::mutex > lock(releaseMutex);
+        
+        for (const RetiredBucket& bucket : retiredBuckets)
+        {
+            stats.buckets.push_back(DriverReleaseStats::Bucket { bucket.epoch, bucket.resources.size(), bucket.bytes });
+            stats.pendingCount += bucket.resources.size();
+            stats.pendingBytes += bucket.bytes;
+        }
+        
+        for (const RetiredResource& pinned : pinnedResources)
+        {
+            stats.pinnedCount++;
+            stats.pinnedBytes += pinned.bytes;
+        }
+        
+        stats.pendingCount += stats.pinnedCount;
+        stats.pendingBytes += stats.pinnedBytes;
+        return stats;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void Driver::onModuleDidUpdate(RD::Module *module)
     {
-        std::lock_guard < std::mutex > lock(lrqMutex);
+        releaseRetired();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Driver::releaseRetired()
+    {
+        // Buckets older than the oldest epoch a locked reader observed can not be used anymore. The epoch
+        // is advanced before readers are scanned, so a reader locking concurrently observes the new one.
+        std::uint64_t safe = epoch.fetch_add(1) + 1;
         
-        while (!laterReleaseQueue.empty())
         {
-            auto handle = laterReleaseQueue.front();
+            std::lock_guard < std::mutex > lock(readersMutex);
             
-            if (!handle.valid()) {
-                laterReleaseQueue.pop();
-                continue;
+            for (const DriverEpochReader* reader : readers)
+            {
+                std::uint64_t observed = reader->observed.load();
+                
+                if (observed && observed < safe)
+                    safe = observed;
             }
+        }
+        
+        std::vector < Handle < DriverResource > > released;
+        
+        {
+            std::lock_guard < std::mutex > lock(releaseMutex);
             
-            if (handle->isUsed())
-                break;
+            // Pinned resources are checked one by one: one resource locked for long does not block others.
+            auto locked = std::partition(pinnedResources.begin(), pinnedResources.end(), [](const RetiredResource& retired){
+                return retired.resource->isUsed();
+            });
             
-            handle->onDriverClear();
-            laterReleaseQueue.pop();
+            for (auto it = locked; it != pinnedResources.end(); ++it)
+                released.push_back(std::move(it->resource));
+            
+            pinnedResources.erase(locked, pinnedResources.end());
+            
+            while (!retiredBuckets.empty() && retiredBuckets.front().epoch < safe)
+            {
+                for (RetiredResource& retired : retiredBuckets.front().resources)
+                {
+                    if (retired.resource->isUsed())
+                        pinnedResources.push_back(std::move(retired));
+                    else
+                        released.push_back(std::move(retired.resource));
+                }
+                
+                retiredBuckets.pop_front();
+            }
+        }
+        
+        // Resources are cleared outside of the lock, as clearing one may retire others.
+        std::size_t bytes = 0;
+        
+        for (Handle < DriverResource >& resource : released)
+        {
+            bytes += resource->memorySize();
+            releaseMemory(resource.ptr());
+            resource->onDriverClear();
         }
+        
+        // Registry snapshots retired since the last call drop their handles here, on this thread.
+        registry.collect();
+        
+        return bytes;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void Driver::onModuleWillTerminate(RD::Module *)
     {
+        commandQueue.stop();
         clearResources();
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    std::map < HashedString, Handle < Surface > >& Driver::lockSurfaces()
+    CommandQueue& Driver::getCommandQueue()
     {
-        mutex.lock();
-        return surfaces;
+        return commandQueue;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    std::map < HashedString, Handle < DriverResource > >& Driver::lockResources()
+    RenderQueue& Driver::getRenderQueue()
     {
-        mutex.lock();
-        return resources;
+        return renderQueue;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::present()
+    {
+        renderQueue.flush();
+        commandQueue.present();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::startCapture(const std::string& path)
+    {
+        auto started = std::make_unique < DriverCapture >(path, name());
+        std::lock_guard < std::mutex > lock(captureMutex);
+        
+        registry.forEachSurface([&started](const HashedString& id, const Handle < Surface >& surface){
+            started->writeSurface(surface.ptr(), std::string(), "Surface" + std::to_string(HashedString::hash_type(id)), SurfaceStyle::Default);
+        });
+        
+        registry.forEachResource([&started](const HashedString& id, const Handle < DriverResource >& resource){
+            if (dynamic_cast < const Surface* >(resource.ptr()))
+                return;
+            
+            std::string text = "Resource" + std::to_string(HashedString::hash_type(id));
+            
+            started->write(CaptureRecordType::ResourceCreated, CaptureResource { CaptureId(resource.ptr()), resource->memorySize(), std::uint32_t(text.size()),
+                           static_cast < std::uint32_t >(resource->memoryKind()) },
+                           text.data(), text.size());
+        });
+        
+        capture = std::move(started);
+        capturing.store(true);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::stopCapture()
+    {
+        std::lock_guard < std::mutex > lock(captureMutex);
+        
+        capturing.store(false);
+        capture.reset();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Driver::isCapturing() const
+    {
+        return capturing.load();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Driver::relocateCommand(const CommandHeader&, void*, const CaptureRelocator&)
+    {
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < DriverResource > Driver::createReplayResource(const std::string&, std::size_t, MemoryKind)
+    {
+        return Handle < DriverResource >();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::executeCommand(const CommandHeader&, const void*)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::executeDrawItems(const DrawItem*, std::size_t)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Driver::addResource(const HashedString& name, const Handle < DriverResource >& resource)
+    {
+        if (!resource.valid())
+            return false;
+        
+        if (!registry.insert(name, resource))
+            return false;
+        
+        record([&](DriverCapture& capture){
+            const char* text = name;
+            std::size_t size = text ? std::strlen(text) : 0;
+            
+            capture.write(CaptureRecordType::ResourceCreated, CaptureResource { CaptureId(resource.ptr()), resource->memorySize(), std::uint32_t(size),
+                          static_cast < std::uint32_t >(resource->memoryKind()) }, text, size);
+        });
+        
+        updateMemoryUsage(resource.ptr());
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::updateMemoryUsage(const DriverResource* resource)
+    {
+        if (!resource)
+            return;
+        
+        std::size_t bytes = resource->memorySize();
+        std::size_t previous = resource->accountedBytes.load();
+        
+        // A resource released meanwhile is not accounted again.
+        do
+        {
+            if (previous == DriverResource::kMemoryReleased || previous == bytes)
+                return;
+        }
+        while (!resource->accountedBytes.compare_exchange_weak(previous, bytes));
+        
+        MemoryKind kind = resource->memoryKind();
+        std::atomic < std::uint64_t >& usage = memoryUsages[static_cast < std::size_t >(kind)];
+        
+        if (bytes < previous)
+            checkBudget(kind, usage.fetch_sub(previous - bytes) - (previous - bytes));
+        else
+            checkBudget(kind, usage.fetch_add(bytes - previous) + (bytes - previous));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::releaseMemory(const DriverResource* resource)
+    {
+        std::size_t previous = resource->accountedBytes.exchange(DriverResource::kMemoryReleased);
+        
+        if (previous == DriverResource::kMemoryReleased || !previous)
+            return;
+        
+        MemoryKind kind = resource->memoryKind();
+        checkBudget(kind, memoryUsages[static_cast < std::size_t >(kind)].fetch_sub(previous) - previous);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::checkBudget(MemoryKind kind, std::uint64_t usage)
+    {
+        std::size_t index = static_cast < std::size_t >(kind);
+        std::uint64_t budget = memoryBudgets[index].load(std::memory_order_relaxed);
+        
+        if (!budget || usage <= budget)
+        {
+            budgetsExceeded[index].store(false, std::memory_order_relaxed);
+            return;
+        }
+        
+        // Only the change going over the budget notifies: observers evicting resources are not flooded
+        // by the resources created meanwhile.
+        if (budgetsExceeded[index].exchange(true))
+            return;
+        
+        const char* kindName = MemoryKindName(kind);
+        
+        NotificationCenter::Notifiate("Core",
+                                      "Driver::updateMemoryUsage",
+                                      kDriverMemoryBudgetExceededNotification,
+                                      RDFormatString("Driver %s exceeds its %s memory budget: %llu bytes used, %llu allowed."),
+                                      name().data(), kindName, usage, budget);
+        
+        // Arguments are given by value, as emit may copy them to another thread.
+        emit < DriverObserver >(&DriverObserver::onDriverMemoryBudgetExceeded, this, MemoryKind(kind), std::uint64_t(usage), std::uint64_t(budget));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t Driver::memoryUsage(MemoryKind kind) const
+    {
+        return memoryUsages[static_cast < std::size_t >(kind)].load();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t Driver::memoryBudget(MemoryKind kind) const
+    {
+        return memoryBudgets[static_cast < std::size_t >(kind)].load();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Driver::setMemoryBudget(MemoryKind kind, std::uint64_t bytes)
+    {
+        memoryBudgets[static_cast < std::size_t >(kind)].store(bytes);
+        budgetsExceeded[static_cast < std::size_t >(kind)].store(false);
+        
+        checkBudget(kind, memoryUsage(kind));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Driver::removeResource(const DriverResource* resource)
+    {
+        Handle < DriverResource > handle = registry.remove(resource);
+        
+        if (!handle.valid())
+            return false;
+        
+        record([resource](DriverCapture& capture){
+            capture.write(CaptureRecordType::ResourceDestroyed, CaptureResource { CaptureId(resource), 0, 0, 0 });
+        });
+        
+        retire(handle);
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < DriverResource > Driver::findResource(const HashedString& name) const
+    {
+        return registry.find(name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    DriverEpochReader::DriverEpochReader(Driver& d) : driver(d)
+    {
+        std::lock_guard < std::mutex > lock(driver.readersMutex);
+        driver.readers.push_back(this);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    DriverEpochReader::~DriverEpochReader()
+    {
+        std::lock_guard < std::mutex > lock(driver.readersMutex);
+        driver.readers.erase(std::find(driver.readers.begin(), driver.readers.end(), this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void DriverEpochReader::lock()
+    {
+        // Publishes the epoch, then checks it did not change meanwhile: otherwise an update may have
+        // scanned readers before seeing the published value, and released a bucket of this epoch.
+        std::uint64_t current = driver.epoch.load();
+        
+        while (true)
+        {
+            observed.store(current);
+            std::uint64_t again = driver.epoch.load();
+            
+            if (again == current)
+                break;
+            
+            current = again;
+        }
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    void Driver::unlockResources()
+    void DriverEpochReader::unlock()
     {
-        mutex.unlock();
+        observed.store(0, std::memory_order_release);
     }
 }
@@ -0,0 +1,378 @@
+//
+//  DriverCapture.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "DriverCapture.h"
+#include "Driver.h"
+#include "Exception.h"
+
+#include <cerrno>
+#include <cstring>
+
+namespace RD
+{
+    namespace
+    {
+        //! @brief First bytes of a capture.
+        const char kCaptureMagic[8] = { 'R', 'D', 'C', 'A', 'P', 'T', 'U', 'R' };
+
+        //! @brief Version of the capture format.
+        constexpr std::uint32_t kCaptureVersion = 1;
+
+        /*! @brief Header of a capture, followed by the name of the driver, then by records. */
+        struct CaptureHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t driverSize;
+        };
+
+        /*! @brief Returns the smallest size of a record's payload, or zero for unknown types. */
+        std::size_t MinimumSize(CaptureRecordType type)
+        {
+            switch (type)
+            {
+                case CaptureRecordType::SurfaceCreated: return sizeof(CaptureSurface);
+                case CaptureRecordType::SurfaceMoved:
+                case CaptureRecordType::SurfaceResized:
+                case CaptureRecordType::SurfaceHidden:
+                case CaptureRecordType::SurfaceUnhidden:
+                case CaptureRecordType::SurfaceLockedFocus:
+                case CaptureRecordType::SurfaceClosed: return sizeof(CaptureSurfaceEvent);
+                case CaptureRecordType::ResourceCreated:
+                case CaptureRecordType::ResourceDestroyed: return sizeof(CaptureResource);
+                case CaptureRecordType::CommandBuffer: return sizeof(CaptureCommandBuffer);
+                case CaptureRecordType::Present: return sizeof(CapturePresent);
+            }
+
+            return 0;
+        }
+
+        /*! @brief Copies a payload's structure, which may not be aligned in the file. */
+        template < typename T >
+        T Load(const unsigned char* payload)
+        {
+            T result;
+            std::memcpy(&result, payload, sizeof(T));
+            return result;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Capture Capture::Read(const std::string& path)
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+
+        if (!file)
+            throw FileOpenException(path, errno);
+
+        Capture capture;
+        unsigned char chunk[1 << 16];
+        std::size_t read = 0;
+
+        while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            capture.data.insert(capture.data.end(), chunk, chunk + read);
+
+        std::fclose(file);
+
+        const std::size_t size = capture.data.size();
+        CaptureHeader header;
+
+        if (size < sizeof(header))
+            throw FileOpenException(path, EINVAL);
+
+        std::memcpy(&header, capture.data.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, kCaptureMagic, sizeof(kCaptureMagic)) || header.version != kCaptureVersion ||
+            header.driverSize > size - sizeof(header))
+            throw FileOpenException(path, EINVAL);
+
+        capture.driver.assign(reinterpret_cast < const char* >(capture.data.data()) + sizeof(header), header.driverSize);
+        std::size_t offset = sizeof(header) + header.driverSize;
+
+        // A record cut by a crash ends the capture: what was written before it can still be replayed.
+        while (size - offset >= sizeof(CaptureRecordHeader))
+        {
+            CaptureRecordHeader record = Load < CaptureRecordHeader >(capture.data.data() + offset);
+            offset += sizeof(record);
+
+            CaptureRecordType type = static_cast < CaptureRecordType >(record.type);
+            std::size_t minimum = MinimumSize(type);
+
+            if (!minimum || record.size < minimum)
+                throw FileOpenException(path, EINVAL);
+
+            if (record.size > size - offset)
+                break;
+
+            capture.records.push_back(Record { type, offset, record.size });
+            offset += record.size;
+
+            if (type == CaptureRecordType::Present)
+                capture.frames++;
+        }
+
+        return capture;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    DriverCapture::DriverCapture(const std::string& path, const std::string& driverName)
+    {
+        file = std::fopen(path.c_str(), "wb");
+
+        if (!file)
+            throw FileOpenException(path, errno);
+
+        CaptureHeader header;
+        std::memcpy(header.magic, kCaptureMagic, sizeof(kCaptureMagic));
+        header.version = kCaptureVersion;
+        header.driverSize = static_cast < std::uint32_t >(driverName.size());
+
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fwrite(driverName.data(), 1, driverName.size(), file);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    DriverCapture::~DriverCapture()
+    {
+        std::fclose(file);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void DriverCapture::writeSurface(const Surface* surface, const std::string& title, const std::string& name, std::uint32_t style)
+    {
+        RectSize size = surface->size();
+
+        CaptureSurface payload { CaptureId(surface), size.width, size.height, style,
+                                 static_cast < std::uint32_t >(title.size()), static_cast < std::uint32_t >(name.size()), 0 };
+
+        writeRecord(CaptureRecordType::SurfaceCreated, &payload, sizeof(payload), title.data(), title.size(), name.data(), name.size());
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void DriverCapture::writeBuffer(const CommandBuffer& buffer)
+    {
+        if (buffer.empty())
+            return;
+
+        CaptureCommandBuffer payload { buffer.order(), 0 };
+        writeRecord(CaptureRecordType::CommandBuffer, &payload, sizeof(payload), buffer.data.data(), buffer.data.size(), nullptr, 0);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void DriverCapture::writePresent()
+    {
+        write(CaptureRecordType::Present, CapturePresent { frames++ });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void DriverCapture::writeRecord(CaptureRecordType type, const void* first, std::size_t firstSize, const void* second,
+                                    std::size_t secondSize, const void* third, std::size_t thirdSize)
+    {
+        CaptureRecordHeader header { static_cast < std::uint32_t >(type), static_cast < std::uint32_t >(firstSize + secondSize + thirdSize) };
+
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fwrite(first, 1, firstSize, file);
+
+        if (secondSize)
+            std::fwrite(second, 1, secondSize, file);
+
+        if (thirdSize)
+            std::fwrite(third, 1, thirdSize, file);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const DriverResource* CaptureRelocator::find(std::uint64_t id) const
+    {
+        auto it = resources.find(id);
+        return it != resources.end() ? it->second.ptr() : nullptr;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    CaptureReplayer::CaptureReplayer(Driver& d, const Capture& c) : driver(d), capture(c)
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    CaptureReplayer::~CaptureReplayer()
+    {
+        reset();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool CaptureReplayer::step()
+    {
+        while (next < capture.records.size())
+        {
+            const Capture::Record& record = capture.records[next++];
+
+            if (record.type == CaptureRecordType::Present)
+            {
+                driver.present();
+                return true;
+            }
+
+            replay(record);
+        }
+
+        return false;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CaptureReplayer::reset()
+    {
+        // Commands submitted may still use the surfaces.
+        driver.getCommandQueue().wait();
+
+        for (auto& entry : resources)
+        {
+            if (Surface* surface = dynamic_cast < Surface* >(entry.second.ptr()))
+                surface->close();
+            else
+                driver.removeResource(entry.second.ptr());
+        }
+
+        resources.clear();
+        next = 0;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CaptureReplayer::replay(const Capture::Record& record)
+    {
+        const unsigned char* payload = capture.payload(record);
+
+        switch (record.type)
+        {
+            case CaptureRecordType::SurfaceCreated:
+            {
+                CaptureSurface created = Load < CaptureSurface >(payload);
+
+                if (sizeof(created) + std::size_t(created.titleSize) + created.nameSize > record.size)
+                    return;
+
+                const char* strings = reinterpret_cast < const char* >(payload) + sizeof(created);
+                std::string title(strings, created.titleSize);
+                std::string name(strings + created.titleSize, created.nameSize);
+
+                Expected < Handle < Surface > > surface = driver.tryCreateSurface(created.width, created.height, title, name, created.style);
+
+                if (surface)
+                    resources[created.id] = Handle < DriverResource >(surface.value());
+                else
+                    skippedResources++;
+
+                return;
+            }
+
+            case CaptureRecordType::ResourceCreated:
+            {
+                CaptureResource created = Load < CaptureResource >(payload);
+
+                if (sizeof(created) + std::size_t(created.nameSize) > record.size)
+                    return;
+
+                std::string name(reinterpret_cast < const char* >(payload) + sizeof(created), created.nameSize);
+                Handle < DriverResource > resource = driver.createReplayResource(name, created.memorySize, static_cast < MemoryKind >(created.memoryKind));
+
+                if (resource.valid())
+                    resources[created.id] = resource;
+                else
+                    skippedResources++;
+
+                return;
+            }
+
+            case CaptureRecordType::ResourceDestroyed:
+            {
+                auto it = resources.find(Load < CaptureResource >(payload).id);
+
+                if (it == resources.end())
+                    return;
+
+                driver.removeResource(it->second.ptr());
+                resources.erase(it);
+                return;
+            }
+
+            case CaptureRecordType::CommandBuffer:
+            {
+                CaptureCommandBuffer buffer = Load < CaptureCommandBuffer >(payload);
+                replayBuffer(payload + sizeof(buffer), record.size - sizeof(buffer), buffer.order);
+                return;
+            }
+
+            case CaptureRecordType::Present:
+                return;
+
+            default:
+                break;
+        }
+
+        // Surfaces events.
+        CaptureSurfaceEvent event = Load < CaptureSurfaceEvent >(payload);
+        auto it = resources.find(event.id);
+
+        if (it == resources.end())
+            return;
+
+        Surface* surface = dynamic_cast < Surface* >(it->second.ptr());
+
+        if (!surface)
+            return;
+
+        switch (record.type)
+        {
+            case CaptureRecordType::SurfaceMoved: surface->move(event.x, event.y); break;
+            case CaptureRecordType::SurfaceResized: surface->resize(event.x, event.y); break;
+            case CaptureRecordType::SurfaceHidden: surface->hide(); break;
+            case CaptureRecordType::SurfaceUnhidden: surface->unhide(); break;
+            case CaptureRecordType::SurfaceLockedFocus: surface->lockFocus(); break;
+
+            case CaptureRecordType::SurfaceClosed:
+                surface->close();
+                resources.erase(it);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void CaptureReplayer::replayBuffer(const unsigned char* bytes, std::size_t size, std::uint32_t order)
+    {
+        CommandQueue& queue = driver.getCommandQueue();
+        std::unique_ptr < CommandBuffer > buffer = queue.acquire(order);
+
+        const unsigned char* it = bytes;
+        const unsigned char* end = bytes + size;
+
+        while (end - it >= std::ptrdiff_t(sizeof(CommandHeader)))
+        {
+            CommandHeader header = Load < CommandHeader >(it);
+            const unsigned char* source = it + sizeof(CommandHeader);
+
+            if (std::size_t(end - source) < header.size)
+                break;
+
+            it = source + std::min < std::size_t >(CommandBuffer::Align(header.size), end - source);
+
+            std::size_t offset = buffer->data.size();
+            void* payload = buffer->allocate(header.type, header.size);
+            std::memcpy(payload, source, header.size);
+
+            if (header.type != kDrawItemsCommand && !driver.relocateCommand(header, payload, *this))
+            {
+                buffer->data.resize(offset);
+                buffer->count--;
+                skippedCommands++;
+            }
+        }
+
+        queue.submit(std::move(buffer));
+    }
+}
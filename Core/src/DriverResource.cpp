@@ -6,19 +6,35 @@
 //
 
 #include "DriverResource.h"
+#include "FlightRecorder.h"
 
 namespace RD
 {
     /////////////////////////////////////////////////////////////////////////////////
-    DriverResource::DriverResource(Driver* driver) : creator(driver), uses(0)
+    const char* MemoryKindName(MemoryKind kind) noexcept
     {
+        switch (kind)
+        {
+            case MemoryKind::Device: return "Device";
+            case MemoryKind::HostVisible: return "HostVisible";
+            case MemoryKind::Staging: return "Staging";
+        }
         
+        return "Unknown";
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    DriverResource::DriverResource(Driver* driver) : creator(driver), uses(0)
+    {
+        FlightRecorder::Record(FlightRecorder::EventType::ResourceCreated, this,
+                               reinterpret_cast < std::uintptr_t >(driver), nullptr);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     DriverResource::~DriverResource()
     {
-        
+        FlightRecorder::Record(FlightRecorder::EventType::ResourceDestroyed, this,
+                               reinterpret_cast < std::uintptr_t >(creator), nullptr);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
@@ -50,4 +66,16 @@ namespace RD
     {
         return usesCount() > 0;
     }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t DriverResource::memorySize() const
+    {
+        return 0;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    MemoryKind DriverResource::memoryKind() const
+    {
+        return MemoryKind::Device;
+    }
 }
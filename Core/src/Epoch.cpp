@@ -0,0 +1,206 @@
+//
+//  Epoch.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "Epoch.h"
+
+namespace RD
+{
+    namespace
+    {
+        /*! @brief An object waiting to be deleted. */
+        struct Retired
+        {
+            void* object;
+            Epoch::Deleter deleter;
+            std::uint64_t epoch;
+        };
+
+        /*! @brief Global state of the epoch domain. Never destroyed, as threads may exit after main(). */
+        struct Domain
+        {
+            //! @brief Global epoch. Starts at 1 because zero means 'outside any guard' in records.
+            std::atomic < std::uint64_t > epoch { 1 };
+
+            //! @brief Head of the records list.
+            std::atomic < Epoch::Record* > records { nullptr };
+
+            //! @brief Objects waiting to be deleted.
+            std::vector < Retired > retired;
+
+            //! @brief Mutex protecting retired.
+            std::mutex mutex;
+        };
+
+        /*! @brief Number of retired objects triggering a collection in Retire(). */
+        constexpr std::size_t CollectThreshold = 64;
+
+        /*! @brief Returns the domain. */
+        Domain& GetDomain()
+        {
+            static Domain* domain = new Domain();
+            return *domain;
+        }
+
+        /*! @brief Releases the record of a thread when it exits. */
+        struct LocalRecordOwner
+        {
+            Epoch::Record* record = nullptr;
+
+            ~LocalRecordOwner()
+            {
+                if ( record )
+                {
+                    record->epoch.store( 0, std::memory_order_release );
+                    record->nesting = 0;
+                    record->used.store( false, std::memory_order_release );
+                }
+            }
+        };
+
+        thread_local LocalRecordOwner localRecord;
+
+        /*! @brief Advances the global epoch if every thread inside a guard observed it. */
+        bool TryAdvance( Domain& domain )
+        {
+            std::uint64_t current = domain.epoch.load();
+
+            for ( Epoch::Record* record = domain.records.load(); record; record = record->next )
+            {
+                std::uint64_t observed = record->epoch.load();
+
+                if ( observed && observed != current )
+                    return false;
+            }
+
+            return domain.epoch.compare_exchange_strong( current, current + 1 );
+        }
+
+        /*! @brief Deletes retired objects older than two epochs. Domain's mutex must be locked. */
+        std::size_t Reclaim( Domain& domain, std::vector < Retired >& deletable )
+        {
+            std::uint64_t current = domain.epoch.load();
+            auto it = std::partition( domain.retired.begin(), domain.retired.end(), [current]( const Retired& r ){
+                return r.epoch + 2 > current;
+            });
+
+            deletable.assign( it, domain.retired.end() );
+            domain.retired.erase( it, domain.retired.end() );
+            return deletable.size();
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void Epoch::Enter()
+    {
+        Record* record = LocalRecord();
+
+        if ( record->nesting++ == 0 )
+        {
+            // The store must be visible before any read of the protected objects, hence seq_cst.
+            record->epoch.store( GetDomain().epoch.load() );
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void Epoch::Leave()
+    {
+        Record* record = localRecord.record;
+
+        if ( record && record->nesting && --record->nesting == 0 )
+            record->epoch.store( 0, std::memory_order_release );
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void Epoch::Retire( void* object, Deleter deleter )
+    {
+        if ( !object )
+            return;
+
+        Domain& domain = GetDomain();
+        bool collect = false;
+
+        {
+            std::lock_guard < std::mutex > lock( domain.mutex );
+            domain.retired.push_back({ object, deleter, domain.epoch.load() });
+            collect = domain.retired.size() >= CollectThreshold;
+        }
+
+        if ( collect )
+            Collect();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Epoch::Collect()
+    {
+        Domain& domain = GetDomain();
+        std::vector < Retired > deletable;
+
+        {
+            std::lock_guard < std::mutex > lock( domain.mutex );
+
+            if ( domain.retired.empty() )
+                return 0;
+
+            TryAdvance( domain );
+            TryAdvance( domain );
+            Reclaim( domain, deletable );
+        }
+
+        // Deleters run outside the lock: they may retire other objects.
+        for ( auto& retired : deletable )
+            retired.deleter( retired.object );
+
+        return deletable.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Epoch::Pending()
+    {
+        Domain& domain = GetDomain();
+        std::lock_guard < std::mutex > lock( domain.mutex );
+        return domain.retired.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t Epoch::Current()
+    {
+        return GetDomain().epoch.load();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Epoch::Record* Epoch::LocalRecord()
+    {
+        if ( localRecord.record )
+            return localRecord.record;
+
+        Domain& domain = GetDomain();
+
+        // Reuses the record of an exited thread if possible.
+        for ( Record* record = domain.records.load(); record; record = record->next )
+        {
+            bool expected = false;
+
+            if ( !record->used.load() && record->used.compare_exchange_strong( expected, true ) )
+            {
+                localRecord.record = record;
+                return record;
+            }
+        }
+
+        Record* record = new Record();
+        record->epoch.store( 0 );
+        record->used.store( true );
+        record->nesting = 0;
+        record->next = domain.records.load();
+
+        while ( !domain.records.compare_exchange_weak( record->next, record ) )
+            continue;
+
+        localRecord.record = record;
+        return record;
+    }
+}
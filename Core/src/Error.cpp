@@ -0,0 +1,37 @@
+//
+//  Error.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "Error.h"
+#include "Exception.h"
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    void Error::raise() const
+    {
+        switch (errorCode)
+        {
+            case kErrorNullPointer:
+                throw NullPointerException(*this);
+
+            case kErrorHandleNotUnique:
+                throw HandleNotUniqueException(*this);
+
+            case kErrorModuleNotLoaded:
+                throw ModuleNotLoadedException(*this);
+
+            case kErrorAbortRequested:
+                throw AbortRequestedException(std::string(errorModule), std::string(errorFunction), text);
+
+            case kErrorFileOpen:
+                throw FileOpenException(*this);
+
+            default:
+                throw Exception(*this);
+        }
+    }
+}
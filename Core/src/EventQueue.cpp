@@ -0,0 +1,152 @@
+//
+//  EventQueue.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "EventQueue.h"
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    EventQueue::EventQueue() : flushing( false ), coalescedCount( 0 )
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void EventQueue::push( const void* emitter, std::function < void() >&& dispatch )
+    {
+        std::lock_guard < std::mutex > lock( mutex );
+        events.push_back({ emitter, 0, std::move( dispatch ) });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void EventQueue::coalesce( const void* emitter, std::uint64_t key, std::function < void() >&& dispatch )
+    {
+        std::lock_guard < std::mutex > lock( mutex );
+        auto result = coalesced.insert( std::make_pair( EventId { emitter, key }, events.size() ) );
+
+        if ( !result.second )
+        {
+            events[result.first->second].dispatch = nullptr;
+            result.first->second = events.size();
+            coalescedCount++;
+        }
+
+        events.push_back({ emitter, key, std::move( dispatch ) });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void EventQueue::purge( const void* emitter )
+    {
+        std::lock_guard < std::mutex > lock( mutex );
+
+        for ( auto& event : events )
+        {
+            if ( event.emitter == emitter )
+            {
+                if ( event.key )
+                    coalesced.erase( EventId { emitter, event.key } );
+
+                event.dispatch = nullptr;
+                event.emitter = nullptr;
+            }
+        }
+
+        for ( auto& event : dispatching )
+        {
+            if ( event.emitter == emitter )
+            {
+                event.dispatch = nullptr;
+                event.emitter = nullptr;
+            }
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t EventQueue::flush()
+    {
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+
+            if ( flushing )
+                return 0;
+
+            flushing = true;
+            dispatching.swap( events );
+            coalesced.clear();
+        }
+
+        std::size_t count = 0;
+
+        for ( std::size_t i = 0; ; ++i )
+        {
+            std::function < void() > dispatch;
+
+            {
+                // Each event is taken under the lock: a listener may destroy an emitter which events are
+                // not dispatched yet.
+                std::lock_guard < std::mutex > lock( mutex );
+
+                if ( i == dispatching.size() )
+                    break;
+
+                dispatch = std::move( dispatching[i].dispatch );
+                dispatching[i].dispatch = nullptr;
+            }
+
+            if ( dispatch )
+            {
+                dispatch();
+                count++;
+            }
+        }
+
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+
+            // Keeps the capacity for the next frame, if nothing was recorded while dispatching.
+            dispatching.clear();
+
+            if ( events.empty() )
+                events.swap( dispatching );
+
+            flushing = false;
+        }
+
+        return count;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t EventQueue::pending() const
+    {
+        std::lock_guard < std::mutex > lock( mutex );
+        std::size_t count = 0;
+
+        for ( auto& event : events )
+        {
+            if ( event.dispatch )
+                count++;
+        }
+
+        return count;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t EventQueue::coalescedEvents() const
+    {
+        std::lock_guard < std::mutex > lock( mutex );
+        return coalescedCount;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    EventQueue& EventQueue::Default()
+    {
+        // Never destroyed: emitters owned by the Application singleton, destroyed after function statics,
+        // purge it from their destructor.
+        static EventQueue* queue = new EventQueue();
+        return *queue;
+    }
+}
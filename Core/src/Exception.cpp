@@ -7,6 +7,9 @@
 //
 
 #include "Exception.h"
+#include "FlightRecorder.h"
+
+#include <cstring>
 
 namespace RD
 {
@@ -14,25 +17,14 @@ namespace RD
     Exception::Exception( uint32_t error, const std::string& str ) noexcept
     : errorCode(error), message(str)
     {
-        
+        FlightRecorder::RecordException(errorCode, message.c_str());
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    Exception::Exception( uint32_t error, const char* format, ... )
-    : errorCode(error)
+    Exception::Exception( const Error& error ) noexcept
+    : Exception( error.code(), error.message() )
     {
-        if ( format && strlen(format) )
-        {
-            va_list ap;
-            va_start(ap, format);
-            
-            char buffer[2048] = { 0 };
-            vsnprintf(buffer, sizeof(buffer), format, ap);
-            
-            va_end(ap);
-            
-            message = std::string( buffer );
-        }
+        
     }
     
     /////////////////////////////////////////////////////////////////////////////////
@@ -47,23 +39,58 @@ namespace RD
         return message.data();
     }
     
+    /////////////////////////////////////////////////////////////////////////////////
+    NullPointerException::NullPointerException( const Error& error ) noexcept
+    : Exception( ErrorCode, error.message() )
+    {
+        
+    }
+    
     /////////////////////////////////////////////////////////////////////////////////
     HandleNotUniqueException::HandleNotUniqueException( uintptr_t ptr )
-    : Exception( ErrorCode, "Handle not unique (%l).", ptr )
+    : Exception( ErrorCode, RDFormatString("Handle not unique (0x%zx)."), ptr )
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    HandleNotUniqueException::HandleNotUniqueException( const Error& error ) noexcept
+    : Exception( ErrorCode, error.message() )
     {
         
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     ModuleNotLoadedException::ModuleNotLoadedException( const std::string& libname )
-    : Exception( ErrorCode, "%s required but not loaded.", libname.data() )
+    : Exception( ErrorCode, RDFormatString("%s required but not loaded."), libname )
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    ModuleNotLoadedException::ModuleNotLoadedException( const Error& error ) noexcept
+    : Exception( ErrorCode, error.message() )
     {
         
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     AbortRequestedException::AbortRequestedException(const std::string& module, const std::string& function, const std::string& message)
-    : Exception(ErrorCode, "[%s](%s) %s", module.data(), function.data(), message.data())
+    : Exception(ErrorCode, RDFormatString("[%s](%s) %s"), module, function, message)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    FileOpenException::FileOpenException(const std::string& path, int error)
+    : Exception(ErrorCode, RDFormatString("Can't open '%s' (%s)."), path, strerror(error))
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    FileOpenException::FileOpenException(const Error& error) noexcept
+    : Exception(ErrorCode, error.message())
     {
         
     }
@@ -0,0 +1,438 @@
+//
+//  FlightRecorder.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "FlightRecorder.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace RD
+{
+    namespace
+    {
+        //! @brief First bytes of a dump.
+        const char kDumpMagic[8] = { 'R', 'D', 'F', 'L', 'I', 'G', 'H', 'T' };
+
+        //! @brief Version of the dump format.
+        constexpr std::uint32_t kDumpVersion = 1;
+
+        /*! @brief Header of a dump, followed by one ThreadHeader and its ring per thread. */
+        struct DumpHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t eventSize;
+            std::uint32_t eventsPerThread;
+            std::uint32_t reserved;
+            std::uint64_t time;
+            std::uint64_t startTicks;
+            std::uint64_t startTime;
+            std::uint64_t dumpTicks;
+            char reason[128];
+        };
+
+        /*! @brief Header of a thread's ring in a dump. */
+        struct ThreadHeader
+        {
+            std::uint32_t thread;
+            std::uint32_t reserved;
+            std::uint64_t count;
+        };
+
+        /*! @brief Ring of a thread, linked in a global list never freed. */
+        struct Ring
+        {
+            //! @brief Events, indexed by count modulo kEventsPerThread.
+            FlightRecorder::Event events[FlightRecorder::kEventsPerThread];
+
+            //! @brief Number of events recorded since the ring was taken.
+            std::atomic < std::uint64_t > count { 0 };
+
+            //! @brief Identifier of the thread owning the ring.
+            std::uint32_t thread = 0;
+
+            //! @brief True while a thread owns the ring.
+            std::atomic_bool used { true };
+
+            //! @brief Next ring in the global list.
+            Ring* next = nullptr;
+        };
+
+        static_assert((FlightRecorder::kEventsPerThread & (FlightRecorder::kEventsPerThread - 1)) == 0,
+                      "kEventsPerThread must be a power of two.");
+
+        //! @brief Every ring ever created.
+        std::atomic < Ring* > rings { nullptr };
+
+        //! @brief Number of rings created, used to identify threads.
+        std::atomic < std::uint32_t > ringCount { 0 };
+
+        //! @brief True if events are recorded.
+        std::atomic_bool enabled { true };
+
+        //! @brief True if exceptions dump the rings.
+        std::atomic_bool dumpOnException { true };
+
+        //! @brief Dump path. Written before any dump, then only read, so signal handlers can use it.
+        char dumpPath[4096] = { 0 };
+
+        //! @brief Signals dumping the rings.
+        const int kFatalSignals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+
+        //! @brief Handlers installed before InstallSignalHandlers, by index in kFatalSignals.
+        struct sigaction previousActions[sizeof(kFatalSignals) / sizeof(kFatalSignals[0])];
+
+        /*! @brief Releases the ring of the current thread when it exits. */
+        struct LocalRingOwner
+        {
+            Ring* ring = nullptr;
+
+            ~LocalRingOwner()
+            {
+                if (ring)
+                    ring->used.store(false, std::memory_order_release);
+            }
+        };
+
+        thread_local LocalRingOwner localRing;
+
+        /*! @brief Returns the ring of the current thread, reusing a released ring if possible. */
+        Ring* LocalRing()
+        {
+            if (localRing.ring)
+                return localRing.ring;
+
+            for (Ring* ring = rings.load(std::memory_order_acquire); ring; ring = ring->next)
+            {
+                bool expected = false;
+
+                if (!ring->used.load(std::memory_order_relaxed) && ring->used.compare_exchange_strong(expected, true))
+                {
+                    ring->count.store(0, std::memory_order_relaxed);
+                    ring->thread = ringCount.fetch_add(1) + 1;
+                    localRing.ring = ring;
+                    return ring;
+                }
+            }
+
+            Ring* ring = new Ring();
+            ring->thread = ringCount.fetch_add(1) + 1;
+            ring->next = rings.load(std::memory_order_relaxed);
+
+            while (!rings.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_relaxed))
+                ;
+
+            localRing.ring = ring;
+            return ring;
+        }
+
+        /*! @brief Copies at most capacity - 1 characters of source, and returns the number copied.
+         * Async-signal-safe. */
+        std::size_t CopyText(char* destination, std::size_t capacity, const char* source)
+        {
+            std::size_t length = 0;
+
+            while (source && source[length] && length + 1 < capacity)
+            {
+                destination[length] = source[length];
+                length++;
+            }
+
+            destination[length] = 0;
+            return length;
+        }
+
+        /*! @brief Writes size bytes, retrying after partial writes. Async-signal-safe. */
+        bool WriteAll(int fd, const void* data, std::size_t size)
+        {
+            const char* bytes = static_cast < const char* >(data);
+
+            while (size)
+            {
+                ssize_t written = ::write(fd, bytes, size);
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                bytes += written;
+                size -= static_cast < std::size_t >(written);
+            }
+
+            return true;
+        }
+
+        /*! @brief Returns the current time in nanoseconds. */
+        std::uint64_t Now()
+        {
+            return static_cast < std::uint64_t >(std::chrono::duration_cast < std::chrono::nanoseconds >(
+                Clock::now().time_since_epoch()).count());
+        }
+
+        /*! @brief Returns the CPU's time stamp counter, or the current time in nanoseconds on CPUs without
+         * one. Events are stamped with ticks as reading Clock costs several times more. */
+        inline std::uint64_t Ticks()
+        {
+#           if defined(__x86_64__) || defined(__i386__)
+            return __builtin_ia32_rdtsc();
+#           elif defined(__aarch64__)
+            std::uint64_t ticks;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+            return ticks;
+#           else
+            return Now();
+#           endif
+        }
+
+        /*! @brief Ticks and time sampled when the library is loaded, to convert ticks to time in dumps. */
+        struct Calibration
+        {
+            std::uint64_t ticks = Ticks();
+            std::uint64_t time = Now();
+        };
+
+        const Calibration calibration;
+
+        /*! @brief Handler of fatal signals: dumps, then forwards the signal to the previous handler. */
+        void SignalHandler(int signal)
+        {
+            std::size_t index = 0;
+
+            while (kFatalSignals[index] != signal)
+                index++;
+
+            const char* names[] = { "SIGSEGV", "SIGBUS", "SIGILL", "SIGFPE", "SIGABRT" };
+            FlightRecorder::Write(names[index]);
+
+            // Restores the previous handler, and raises the signal again for it or the default action: a
+            // signal sent with kill or raise would not be delivered again otherwise. A synchronous fault
+            // also faults again when the handler returns, with the same state.
+            sigaction(signal, &previousActions[index], nullptr);
+            raise(signal);
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::Record(EventType type, const void* object, std::uint64_t value, const char* text, const char* suffix)
+    {
+        if (!enabled.load(std::memory_order_relaxed))
+            return;
+
+        Ring* ring = LocalRing();
+        std::uint64_t count = ring->count.load(std::memory_order_relaxed);
+        Event& event = ring->events[count & (kEventsPerThread - 1)];
+
+        event.time = Ticks();
+        event.type = type;
+        event.reserved = 0;
+        event.thread = ring->thread;
+        event.object = reinterpret_cast < std::uintptr_t >(object);
+        event.value = value;
+
+        std::size_t length = text ? strnlen(text, sizeof(event.text) - 1) : 0;
+        std::memcpy(event.text, text, length);
+
+        if (suffix && length + 2 < sizeof(event.text))
+        {
+            std::size_t suffixLength = strnlen(suffix, sizeof(event.text) - length - 2);
+
+            event.text[length++] = ':';
+            std::memcpy(event.text + length, suffix, suffixLength);
+            length += suffixLength;
+        }
+
+        event.text[length] = 0;
+
+        ring->count.store(count + 1, std::memory_order_release);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::Mark(const char* text, std::uint64_t value)
+    {
+        Record(EventType::Mark, nullptr, value, text);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::SetEnabled(bool value)
+    {
+        enabled.store(value);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool FlightRecorder::Enabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::SetDumpPath(const std::string& path)
+    {
+        CopyText(dumpPath, sizeof(dumpPath), path.c_str());
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::SetDumpOnException(bool value)
+    {
+        dumpOnException.store(value);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool FlightRecorder::Write(const char* reason)
+    {
+        if (!dumpPath[0])
+            return false;
+
+        int fd = ::open(dumpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fd < 0)
+            return false;
+
+        DumpHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kDumpMagic, sizeof(kDumpMagic));
+        header.version = kDumpVersion;
+        header.eventSize = sizeof(Event);
+        header.eventsPerThread = kEventsPerThread;
+        header.time = Now();
+        header.dumpTicks = Ticks();
+        header.startTicks = calibration.ticks;
+        header.startTime = calibration.time;
+        CopyText(header.reason, sizeof(header.reason), reason);
+
+        bool written = WriteAll(fd, &header, sizeof(header));
+
+        for (Ring* ring = rings.load(std::memory_order_acquire); ring && written; ring = ring->next)
+        {
+            ThreadHeader thread = { ring->thread, 0, ring->count.load(std::memory_order_acquire) };
+
+            if (!thread.count)
+                continue;
+
+            written = WriteAll(fd, &thread, sizeof(thread)) && WriteAll(fd, ring->events, sizeof(ring->events));
+        }
+
+        ::close(fd);
+        return written;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::RecordException(std::uint32_t code, const char* message)
+    {
+        Record(EventType::Exception, nullptr, code, message);
+
+        if (dumpOnException.load(std::memory_order_relaxed))
+            Write(message);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FlightRecorder::InstallSignalHandlers()
+    {
+        static std::once_flag once;
+
+        std::call_once(once, [](){
+            for (std::size_t i = 0; i < sizeof(kFatalSignals) / sizeof(kFatalSignals[0]); ++i)
+            {
+                struct sigaction action;
+                std::memset(&action, 0, sizeof(action));
+                action.sa_handler = &SignalHandler;
+                action.sa_flags = SA_NODEFER;
+                sigemptyset(&action.sa_mask);
+
+                sigaction(kFatalSignals[i], &action, &previousActions[i]);
+            }
+        });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    FlightRecorder::Dump FlightRecorder::Read(const std::string& path)
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+
+        if (!file)
+            throw FileOpenException(path, errno);
+
+        DumpHeader header;
+
+        if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+            std::memcmp(header.magic, kDumpMagic, sizeof(kDumpMagic)) ||
+            header.version != kDumpVersion || header.eventSize != sizeof(Event) ||
+            !header.eventsPerThread || (header.eventsPerThread & (header.eventsPerThread - 1)))
+        {
+            std::fclose(file);
+            throw FileOpenException(path, EINVAL);
+        }
+
+        Dump dump;
+        dump.reason.assign(header.reason, strnlen(header.reason, sizeof(header.reason)));
+        dump.time = header.time;
+
+        // Converts ticks to time, assuming ticks are regular between the calibration and the dump.
+        double scale = 1.0;
+
+        if (header.dumpTicks > header.startTicks && header.time > header.startTime)
+            scale = static_cast < double >(header.time - header.startTime) / static_cast < double >(header.dumpTicks - header.startTicks);
+
+        ThreadHeader thread;
+        std::vector < Event > events(header.eventsPerThread);
+
+        while (std::fread(&thread, sizeof(thread), 1, file) == 1 &&
+               std::fread(events.data(), sizeof(Event), events.size(), file) == events.size())
+        {
+            // The ring wrapped if count exceeds its size: events are taken from the oldest one.
+            std::uint64_t valid = std::min < std::uint64_t >(thread.count, events.size());
+
+            for (std::uint64_t i = thread.count - valid; i < thread.count; ++i)
+            {
+                Event event = events[i & (events.size() - 1)];
+                event.text[sizeof(event.text) - 1] = 0;
+                event.time = header.startTime + static_cast < std::uint64_t >(
+                    static_cast < double >(static_cast < std::int64_t >(event.time - header.startTicks)) * scale);
+                dump.events.push_back(event);
+            }
+        }
+
+        std::fclose(file);
+
+        std::stable_sort(dump.events.begin(), dump.events.end(), [](const Event& lhs, const Event& rhs){
+            return lhs.time < rhs.time;
+        });
+
+        return dump;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const char* FlightRecorder::TypeName(EventType type)
+    {
+        switch (type)
+        {
+            case EventType::Notification: return "Notification";
+            case EventType::ModuleUpdateBegin: return "ModuleUpdateBegin";
+            case EventType::ModuleUpdateEnd: return "ModuleUpdateEnd";
+            case EventType::SurfaceCreated: return "SurfaceCreated";
+            case EventType::SurfaceClosed: return "SurfaceClosed";
+            case EventType::SurfaceMoved: return "SurfaceMoved";
+            case EventType::SurfaceResized: return "SurfaceResized";
+            case EventType::ResourceCreated: return "ResourceCreated";
+            case EventType::ResourceDestroyed: return "ResourceDestroyed";
+            case EventType::Exception: return "Exception";
+            case EventType::Mark: return "Mark";
+        }
+
+        return "Unknown";
+    }
+}
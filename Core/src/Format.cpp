@@ -0,0 +1,498 @@
+//
+//  Format.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "Format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace RD
+{
+    namespace
+    {
+        /*! @brief Output of a formatting function. Counts every character, and writes those which fit. */
+        struct Output
+        {
+            char* buffer;
+            std::size_t capacity;
+            std::size_t size;
+
+            /*! @brief Returns the number of characters which can still be written. */
+            std::size_t available() const
+            {
+                return size + 1 < capacity ? capacity - 1 - size : 0;
+            }
+
+            void put(char c)
+            {
+                if (size + 1 < capacity)
+                    buffer[size] = c;
+                size++;
+            }
+
+            void put(const char* data, std::size_t length)
+            {
+                if (std::size_t fitting = std::min(length, available()))
+                    std::memcpy(buffer + size, data, fitting);
+                size += length;
+            }
+
+            void fill(char c, std::ptrdiff_t count)
+            {
+                if (count <= 0)
+                    return;
+
+                if (std::size_t fitting = std::min(static_cast < std::size_t >(count), available()))
+                    std::memset(buffer + size, c, fitting);
+                size += static_cast < std::size_t >(count);
+            }
+        };
+
+        /*! @brief A parsed conversion specification. */
+        struct Spec
+        {
+            bool left = false;
+            bool plus = false;
+            bool space = false;
+            bool alternate = false;
+            bool zero = false;
+            int width = 0;
+            int precision = -1;
+            char conversion = 0;
+        };
+
+        //! @brief Pairs of decimal digits, from "00" to "99".
+        const char kDigitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        //! @brief Powers of ten exactly representable as double and uint64.
+        const std::uint64_t kPowersOfTen[] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+            1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+            100000000000000ull, 1000000000000000ull
+        };
+
+        /*! @brief Writes value in base 10 at the end of a buffer of 20 characters. Returns the first digit. */
+        char* Decimal(std::uint64_t value, char* end)
+        {
+            while (value >= 100)
+            {
+                std::uint64_t pair = (value % 100) * 2;
+                value /= 100;
+                *--end = kDigitPairs[pair + 1];
+                *--end = kDigitPairs[pair];
+            }
+
+            if (value >= 10)
+            {
+                *--end = kDigitPairs[value * 2 + 1];
+                *--end = kDigitPairs[value * 2];
+            }
+            else
+            {
+                *--end = static_cast < char >('0' + value);
+            }
+
+            return end;
+        }
+
+        /*! @brief Writes value in base 8 or 16 at the end of a buffer of 22 characters. Returns the first digit. */
+        char* Radix(std::uint64_t value, char* end, unsigned shift, bool upper)
+        {
+            const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+            const std::uint64_t mask = (1u << shift) - 1;
+
+            do
+            {
+                *--end = digits[value & mask];
+                value >>= shift;
+            }
+            while (value);
+
+            return end;
+        }
+
+        /*! @brief Writes digits with their prefix, honoring width, precision and flags. */
+        void Pad(Output& output, const Spec& spec, const char* prefix, std::size_t prefixLength,
+                 const char* digits, std::size_t length, std::size_t zeros)
+        {
+            if (spec.zero && !spec.left && spec.precision < 0)
+            {
+                std::size_t body = prefixLength + zeros + length;
+                zeros += spec.width > static_cast < int >(body) ? spec.width - body : 0;
+            }
+
+            std::ptrdiff_t padding = spec.width - static_cast < std::ptrdiff_t >(prefixLength + zeros + length);
+
+            if (!spec.left)
+                output.fill(' ', padding);
+
+            output.put(prefix, prefixLength);
+            output.fill('0', static_cast < std::ptrdiff_t >(zeros));
+            output.put(digits, length);
+
+            if (spec.left)
+                output.fill(' ', padding);
+        }
+
+        /*! @brief Returns the sign prefix of a number. */
+        const char* Sign(const Spec& spec, bool negative)
+        {
+            return negative ? "-" : spec.plus ? "+" : spec.space ? " " : "";
+        }
+
+        /*! @brief Formats an integer conversion. */
+        void FormatInteger(Output& output, const Spec& spec, const FormatArgument& argument)
+        {
+            bool negative = false;
+            std::uint64_t value = argument.asUInt();
+
+            if (spec.conversion == 'd' || spec.conversion == 'i')
+            {
+                if (argument.kind() == FormatArgument::Type::Int && argument.asInt() < 0)
+                {
+                    negative = true;
+                    value = 0 - value;
+                }
+            }
+            else if (argument.kind() == FormatArgument::Type::Int && argument.size() < 8)
+            {
+                // Unsigned conversions of negative values print their two's complement at their own size.
+                value &= (std::uint64_t(1) << (argument.size() * 8)) - 1;
+            }
+
+            char buffer[24];
+            char* end = buffer + sizeof(buffer);
+            char* digits;
+
+            if (spec.conversion == 'x' || spec.conversion == 'X')
+                digits = Radix(value, end, 4, spec.conversion == 'X');
+            else if (spec.conversion == 'o')
+                digits = Radix(value, end, 3, false);
+            else
+                digits = Decimal(value, end);
+
+            std::size_t length = static_cast < std::size_t >(end - digits);
+
+            // A zero precision prints nothing for zero.
+            if (!spec.precision && !value)
+                length = 0;
+
+            std::size_t zeros = spec.precision > static_cast < int >(length) ? spec.precision - length : 0;
+            const char* prefix = "";
+
+            if (spec.conversion == 'd' || spec.conversion == 'i')
+                prefix = Sign(spec, negative);
+            else if (spec.alternate && value && spec.conversion == 'x')
+                prefix = "0x";
+            else if (spec.alternate && value && spec.conversion == 'X')
+                prefix = "0X";
+            else if (spec.alternate && spec.conversion == 'o' && !zeros && (!length || *digits != '0'))
+                zeros = 1;
+
+            Pad(output, spec, prefix, std::strlen(prefix), digits, length, zeros);
+        }
+
+        /*! @brief Formats a conversion with snprintf. */
+        template < typename T >
+        void Fallback(Output& output, const Spec& spec, T value)
+        {
+            char format[32];
+            char* it = format;
+
+            *it++ = '%';
+            if (spec.left) *it++ = '-';
+            if (spec.plus) *it++ = '+';
+            if (spec.space) *it++ = ' ';
+            if (spec.alternate) *it++ = '#';
+            if (spec.zero) *it++ = '0';
+
+            if (spec.width > 0)
+                it += std::snprintf(it, 12, "%d", spec.width);
+
+            if (spec.precision >= 0)
+                it += std::snprintf(it, 12, ".%d", spec.precision);
+
+            *it++ = spec.conversion;
+            *it = 0;
+
+            int written = std::snprintf(output.available() ? output.buffer + output.size : nullptr,
+                                        output.available() ? output.available() + 1 : 0, format, value);
+
+            if (written > 0)
+                output.size += static_cast < std::size_t >(written);
+        }
+
+        /*! @brief Formats '%f' without snprintf, or returns false if the result could differ from snprintf's. */
+        bool FixedPoint(Output& output, const Spec& spec, double value)
+        {
+            int precision = spec.precision < 0 ? 6 : spec.precision;
+
+            if (spec.alternate || precision > 15 || !std::isfinite(value))
+                return false;
+
+            bool negative = std::signbit(value);
+            double scaled = std::fabs(value) * static_cast < double >(kPowersOfTen[precision]);
+
+            // The product is rounded once, so scaled is within half an ulp (scaled * 2^-53) of the exact
+            // decimal value of the argument. If its fraction is farther than that from one half, both are
+            // rounded to the same integer. Otherwise snprintf decides.
+            if (!(scaled < 9007199254740992.0))
+                return false;
+
+            double integral = std::floor(scaled);
+            double fraction = scaled - integral;
+
+            if (std::fabs(fraction - 0.5) <= scaled * 0x1p-51)
+                return false;
+
+            std::uint64_t rounded = static_cast < std::uint64_t >(integral) + (fraction > 0.5 ? 1 : 0);
+            std::uint64_t power = kPowersOfTen[precision];
+
+            char buffer[48];
+            char* end = buffer + sizeof(buffer);
+            char* digits = end;
+
+            if (precision)
+            {
+                char* fractionEnd = end;
+                digits = Decimal(rounded % power, end);
+
+                while (fractionEnd - digits < precision)
+                    *--digits = '0';
+
+                *--digits = '.';
+            }
+
+            digits = Decimal(rounded / power, digits);
+
+            const char* prefix = Sign(spec, negative);
+            Pad(output, Spec { spec.left, false, false, false, spec.zero, spec.width, -1, 'f' },
+                prefix, std::strlen(prefix), digits, static_cast < std::size_t >(end - digits), 0);
+
+            return true;
+        }
+
+        /*! @brief Writes a string, honoring width and precision. */
+        void FormatString(Output& output, const Spec& spec, std::string_view string)
+        {
+            if (spec.precision >= 0 && static_cast < std::size_t >(spec.precision) < string.size())
+                string = string.substr(0, static_cast < std::size_t >(spec.precision));
+
+            std::ptrdiff_t padding = spec.width - static_cast < std::ptrdiff_t >(string.size());
+
+            if (!spec.left)
+                output.fill(' ', padding);
+
+            output.put(string.data(), string.size());
+
+            if (spec.left)
+                output.fill(' ', padding);
+        }
+
+        /*! @brief Returns the value of an integer argument given for '*', or zero. */
+        int StarArgument(const FormatArgument* arguments, std::size_t count, std::size_t& index)
+        {
+            if (index >= count)
+                return 0;
+
+            const FormatArgument& argument = arguments[index++];
+
+            if (argument.kind() != FormatArgument::Type::Int && argument.kind() != FormatArgument::Type::UInt)
+                return 0;
+
+            return static_cast < int >(argument.asInt());
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    FormatResult FormatArguments(char* buffer, std::size_t capacity, const char* format,
+                                 const FormatArgument* arguments, std::size_t count) noexcept
+    {
+        Output output = { buffer, capacity, 0 };
+        std::size_t index = 0;
+
+        while (format && *format)
+        {
+            if (*format != '%')
+            {
+                const char* next = std::strchr(format, '%');
+                std::size_t length = next ? static_cast < std::size_t >(next - format) : std::strlen(format);
+
+                output.put(format, length);
+                format += length;
+                continue;
+            }
+
+            format++;
+
+            if (*format == '%')
+            {
+                output.put('%');
+                format++;
+                continue;
+            }
+
+            Spec spec;
+
+            for (;; format++)
+            {
+                if (*format == '-') spec.left = true;
+                else if (*format == '+') spec.plus = true;
+                else if (*format == ' ') spec.space = true;
+                else if (*format == '#') spec.alternate = true;
+                else if (*format == '0') spec.zero = true;
+                else break;
+            }
+
+            if (*format == '*')
+            {
+                spec.width = StarArgument(arguments, count, index);
+                format++;
+
+                if (spec.width < 0)
+                {
+                    spec.left = true;
+                    spec.width = -spec.width;
+                }
+            }
+
+            while (*format >= '0' && *format <= '9')
+                spec.width = spec.width * 10 + (*format++ - '0');
+
+            if (*format == '.')
+            {
+                format++;
+                spec.precision = 0;
+
+                if (*format == '*')
+                {
+                    spec.precision = StarArgument(arguments, count, index);
+                    format++;
+                }
+
+                while (*format >= '0' && *format <= '9')
+                    spec.precision = spec.precision * 10 + (*format++ - '0');
+            }
+
+            while (*format && std::strchr("hlLqjzt", *format))
+                format++;
+
+            spec.conversion = *format;
+
+            if (!spec.conversion)
+                break;
+
+            format++;
+
+            if (index >= count)
+            {
+                output.put('?');
+                continue;
+            }
+
+            const FormatArgument& argument = arguments[index++];
+            const FormatArgument::Type type = argument.kind();
+
+            switch (spec.conversion)
+            {
+                case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+                    if (type == FormatArgument::Type::Int || type == FormatArgument::Type::UInt)
+                        FormatInteger(output, spec, argument);
+                    else
+                        output.put('?');
+                    break;
+
+                case 'c':
+                    if (type == FormatArgument::Type::Int || type == FormatArgument::Type::UInt)
+                    {
+                        char c = static_cast < char >(argument.asInt());
+                        FormatString(output, Spec { spec.left, false, false, false, false, spec.width, -1, 's' },
+                                     std::string_view(&c, 1));
+                    }
+                    else
+                        output.put('?');
+                    break;
+
+                case 'f': case 'F':
+                    if (type != FormatArgument::Type::Double)
+                        output.put('?');
+                    else if (!FixedPoint(output, spec, argument.asDouble()))
+                        Fallback(output, spec, argument.asDouble());
+                    break;
+
+                case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    if (type == FormatArgument::Type::Double)
+                        Fallback(output, spec, argument.asDouble());
+                    else
+                        output.put('?');
+                    break;
+
+                case 's':
+                    if (type == FormatArgument::Type::String)
+                        FormatString(output, spec, argument.asString());
+                    else if (type == FormatArgument::Type::Pointer && !argument.asPointer())
+                        FormatString(output, spec, "(null)");
+                    else
+                        output.put('?');
+                    break;
+
+                case 'p':
+                {
+                    const void* pointer = type == FormatArgument::Type::String ? argument.asString().data()
+                                        : type == FormatArgument::Type::Pointer ? argument.asPointer() : nullptr;
+
+                    if (type != FormatArgument::Type::String && type != FormatArgument::Type::Pointer)
+                        output.put('?');
+                    else if (!pointer)
+                        Fallback(output, spec, pointer);
+                    else
+                    {
+                        char digits[24];
+                        char* end = digits + sizeof(digits);
+                        char* first = Radix(reinterpret_cast < std::uintptr_t >(pointer), end, 4, false);
+
+                        Pad(output, Spec { spec.left, false, false, false, false, spec.width, -1, 'p' },
+                            "0x", 2, first, static_cast < std::size_t >(end - first), 0);
+                    }
+                    break;
+                }
+
+                default:
+                    output.put('?');
+                    break;
+            }
+        }
+
+        FormatResult result;
+        result.size = output.size;
+        result.truncated = output.size >= capacity;
+
+        if (capacity)
+            buffer[std::min(output.size, capacity - 1)] = 0;
+
+        return result;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::string FormatArgumentsToString(const char* format, const FormatArgument* arguments, std::size_t count)
+    {
+        char buffer[256];
+        FormatResult result = FormatArguments(buffer, sizeof(buffer), format, arguments, count);
+
+        if (!result.truncated)
+            return std::string(buffer, result.size);
+
+        std::string string(result.size, '\0');
+        FormatArguments(&string[0], result.size + 1, format, arguments, count);
+        return string;
+    }
+}
@@ -0,0 +1,88 @@
+//
+//  FramePipeline.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "FramePipeline.h"
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    FramePipeline::FramePipeline( std::vector < Handle < FrameData > >&& data )
+    : frames( std::move( data ) ), published( 0 ), released( 0 ), closed( false )
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t FramePipeline::depth() const
+    {
+        return frames.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    FrameData* FramePipeline::acquireWrite()
+    {
+        std::unique_lock < std::mutex > lock( mutex );
+        condition.wait( lock, [this](){ return closed || published - released < frames.size(); } );
+
+        if ( error )
+            std::rethrow_exception( error );
+
+        if ( closed )
+            return nullptr;
+
+        return frames[published % frames.size()].ptr();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FramePipeline::publish()
+    {
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+            published++;
+        }
+
+        condition.notify_all();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const FrameData* FramePipeline::acquireRead()
+    {
+        std::unique_lock < std::mutex > lock( mutex );
+        condition.wait( lock, [this](){ return closed || published > released; } );
+
+        // A normal close still lets the consumer drain published frames.
+        if ( published == released || error )
+            return nullptr;
+
+        return frames[released % frames.size()].ptr();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FramePipeline::release()
+    {
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+            released++;
+        }
+
+        condition.notify_all();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FramePipeline::close( std::exception_ptr reason )
+    {
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+            closed = true;
+
+            if ( reason && !error )
+                error = reason;
+        }
+
+        condition.notify_all();
+    }
+}
@@ -0,0 +1,226 @@
+//
+//  FrameScheduler.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "FrameScheduler.h"
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    FrameScheduler::FrameScheduler()
+    : period( Clock::duration::zero() ), spinThreshold( std::chrono::milliseconds( 1 ) ), idle( false )
+    , step( Clock::duration::zero() ), maxSteps( 8 ), accumulator( Clock::duration::zero() ), woken( false )
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::setTargetRate( double hertz )
+    {
+        if ( hertz <= 0.0 )
+            period = Clock::duration::zero();
+        else
+            period = std::chrono::duration_cast < Clock::duration >( std::chrono::duration < double >( 1.0 / hertz ) );
+
+        nextFrame = Clock::time_point();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Clock::duration FrameScheduler::targetPeriod() const
+    {
+        return period;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::setSpinThreshold( Clock::duration threshold )
+    {
+        spinThreshold = threshold;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::setIdle( bool enabled )
+    {
+        idle = enabled;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool FrameScheduler::isIdle() const
+    {
+        return idle;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::setFixedTimestep( Clock::duration duration, std::uint32_t maximum )
+    {
+        step = duration;
+        maxSteps = maximum ? maximum : 1;
+        accumulator = Clock::duration::zero();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Clock::duration FrameScheduler::fixedTimestep() const
+    {
+        return step;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::beginFrame( const Clock::time_point& now )
+    {
+        if ( frameStart != Clock::time_point() )
+        {
+            Clock::duration elapsed = now - frameStart;
+
+            statistics.last = elapsed;
+            statistics.minimum = std::min( statistics.minimum, elapsed );
+            statistics.maximum = std::max( statistics.maximum, elapsed );
+
+            if ( statistics.frames == 0 )
+                statistics.average = elapsed;
+            else
+                statistics.average += ( elapsed - statistics.average ) / 16;
+
+            statistics.frames++;
+
+            if ( step > Clock::duration::zero() )
+                accumulator += elapsed;
+        }
+
+        frameStart = now;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint32_t FrameScheduler::fixedSteps()
+    {
+        if ( step <= Clock::duration::zero() )
+            return 0;
+
+        std::uint64_t steps = accumulator / step;
+        accumulator -= step * steps;
+
+        if ( steps > maxSteps )
+        {
+            statistics.droppedSteps += steps - maxSteps;
+            steps = maxSteps;
+        }
+
+        statistics.fixedSteps += steps;
+        return static_cast < std::uint32_t >( steps );
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    double FrameScheduler::interpolation() const
+    {
+        if ( step <= Clock::duration::zero() )
+            return 0.0;
+
+        return std::chrono::duration < double >( accumulator ) / std::chrono::duration < double >( step );
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::runPosted()
+    {
+        std::vector < std::function < void() > > works;
+
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+            works.swap( posted );
+        }
+
+        for ( auto& work : works )
+            work();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::wait( const Clock::time_point& deadline )
+    {
+        Clock::time_point now = Clock::now();
+        statistics.work = now - frameStart;
+
+        if ( idle )
+        {
+            sleepUntil( deadline, true );
+            return;
+        }
+
+        if ( period <= Clock::duration::zero() )
+            return;
+
+        // When the loop is late by more than a frame, we do not try to catch up: the schedule restarts
+        // from now.
+        if ( nextFrame == Clock::time_point() || now - nextFrame > period )
+            nextFrame = now;
+
+        // A wait that ended before the frame (on a timer deadline or wake()) keeps the same frame, so
+        // the schedule doesn't drift ahead.
+        if ( now >= nextFrame )
+            nextFrame += period;
+
+        Clock::time_point target = std::min( nextFrame, deadline );
+
+        // Posted work waits for the next frame in paced mode, only wake() ends the wait early.
+        if ( target - now > spinThreshold && sleepUntil( target - spinThreshold, false ) )
+            return;
+
+        while ( Clock::now() < target )
+        {
+            {
+                std::lock_guard < std::mutex > lock( mutex );
+
+                if ( woken )
+                {
+                    woken = false;
+                    return;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::post( std::function < void() >&& work )
+    {
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+            posted.push_back( std::move( work ) );
+        }
+
+        condition.notify_one();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void FrameScheduler::wake()
+    {
+        {
+            std::lock_guard < std::mutex > lock( mutex );
+            woken = true;
+        }
+
+        condition.notify_one();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const FrameStatistics& FrameScheduler::getStatistics() const
+    {
+        return statistics;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool FrameScheduler::sleepUntil( const Clock::time_point& time, bool wakeOnPosted )
+    {
+        std::unique_lock < std::mutex > lock( mutex );
+        auto ready = [this, wakeOnPosted](){ return woken || ( wakeOnPosted && !posted.empty() ); };
+
+        if ( time == Clock::time_point::max() )
+            condition.wait( lock, ready );
+        else
+            condition.wait_until( lock, time, ready );
+
+        bool result = woken;
+        woken = false;
+        return result;
+    }
+}
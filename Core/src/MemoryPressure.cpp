@@ -0,0 +1,443 @@
+//
+//  MemoryPressure.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "MemoryPressure.h"
+#include "NotificationCenter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+#if defined(__linux__)
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <poll.h>
+#   include <sys/eventfd.h>
+#   include <unistd.h>
+#endif
+
+namespace RD
+{
+    namespace
+    {
+#if defined(__linux__)
+        //! @brief Root of the cgroup v2 hierarchy.
+        const char* kCgroupRoot = "/sys/fs/cgroup";
+
+        //! @brief Pressure of the whole system.
+        const char* kSystemPressure = "/proc/pressure/memory";
+
+        /*! @brief Returns the directory of the process' cgroup v2, or an empty string if the process is
+         * not in a cgroup v2 with the memory controller. */
+        std::string ProcessCgroup()
+        {
+            std::ifstream stream("/proc/self/cgroup");
+            std::string line;
+
+            while (std::getline(stream, line))
+            {
+                // The cgroup v2 line is '0::<path>'.
+                if (line.compare(0, 3, "0::"))
+                    continue;
+
+                std::string path = kCgroupRoot + line.substr(3);
+
+                if (!path.empty() && path.back() == '/')
+                    path.pop_back();
+
+                if (!access((path + "/memory.events").c_str(), R_OK))
+                    return path;
+            }
+
+            return std::string();
+        }
+
+        /*! @brief Opens a PSI trigger, or returns -1 if the kernel refuses it. */
+        int OpenTrigger(const std::string& path, const char* kind, std::chrono::microseconds stall, std::chrono::microseconds window)
+        {
+            int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+
+            if (fd < 0)
+                return -1;
+
+            std::string trigger = std::string(kind) + " " + std::to_string(stall.count()) + " " + std::to_string(window.count());
+
+            // The kernel expects the terminating null character.
+            if (write(fd, trigger.c_str(), trigger.size() + 1) < 0)
+            {
+                close(fd);
+                return -1;
+            }
+
+            return fd;
+        }
+
+        /*! @brief Reads the content of a descriptor from its beginning. */
+        std::string ReadDescriptor(int fd)
+        {
+            char buffer[1024];
+            ssize_t size = pread(fd, buffer, sizeof(buffer) - 1, 0);
+            return size > 0 ? std::string(buffer, std::size_t(size)) : std::string();
+        }
+
+        /*! @brief Returns the value of a key in a flat keyed file, like 'oom_kill 2', or zero. */
+        std::uint64_t ReadKey(const std::string& content, const char* key)
+        {
+            std::size_t length = std::strlen(key);
+            std::size_t position = 0;
+
+            while (position < content.size())
+            {
+                if (!content.compare(position, length, key) && position + length < content.size() && content[position + length] == ' ')
+                    return std::strtoull(content.c_str() + position + length + 1, nullptr, 10);
+
+                position = content.find('\n', position);
+
+                if (position == std::string::npos)
+                    break;
+
+                position++;
+            }
+
+            return 0;
+        }
+
+        /*! @brief Counters of memory.events which signal a pressure. */
+        struct MemoryEvents
+        {
+            std::uint64_t high = 0;
+            std::uint64_t critical = 0;
+        };
+
+        /*! @brief Reads memory.events. 'max', 'oom' and 'oom_kill' are summed as critical events. */
+        MemoryEvents ReadEvents(int fd)
+        {
+            std::string content = ReadDescriptor(fd);
+            MemoryEvents events;
+
+            events.high = ReadKey(content, "high");
+            events.critical = ReadKey(content, "max") + ReadKey(content, "oom") + ReadKey(content, "oom_kill");
+            return events;
+        }
+
+        /*! @brief Returns the avg10 of a line of a pressure file ('some' or 'full'), in percent. */
+        double ReadAverage(const std::string& content, const char* kind)
+        {
+            std::size_t line = content.find(kind);
+
+            if (line == std::string::npos)
+                return 0.0;
+
+            std::size_t average = content.find("avg10=", line);
+            return average != std::string::npos ? std::strtod(content.c_str() + average + 6, nullptr) : 0.0;
+        }
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const char* MemoryPressureLevelName(MemoryPressureLevel level) noexcept
+    {
+        switch (level)
+        {
+            case MemoryPressureLevel::None: return "None";
+            case MemoryPressureLevel::Moderate: return "Moderate";
+            case MemoryPressureLevel::Critical: return "Critical";
+        }
+
+        return "Unknown";
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    MemoryPressureMonitor& MemoryPressureMonitor::Default()
+    {
+        // Never destroyed: the Application singleton, destroyed after function statics, stops it.
+        static MemoryPressureMonitor* monitor = new MemoryPressureMonitor();
+        return *monitor;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    MemoryPressureMonitor::~MemoryPressureMonitor()
+    {
+        stop();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool MemoryPressureMonitor::start(const MemoryPressureConfiguration& configuration, std::function < void() > wakeFunction)
+    {
+        std::lock_guard < std::mutex > lock(threadMutex);
+
+        if (thread.joinable())
+            return true;
+
+        {
+            std::lock_guard < std::mutex > wakeLock(wakeMutex);
+            wake = std::move(wakeFunction);
+        }
+
+        this->configuration = configuration;
+
+#if defined(__linux__)
+        std::string cgroup = configuration.cgroupPath.empty() ? ProcessCgroup() : configuration.cgroupPath;
+
+        if (access(kSystemPressure, R_OK) && (cgroup.empty() || access((cgroup + "/memory.events").c_str(), R_OK)))
+            return false;
+
+        stopDescriptor = eventfd(0, EFD_CLOEXEC);
+
+        if (stopDescriptor < 0)
+            return false;
+
+        MemoryPressureConfiguration resolved = this->configuration;
+        resolved.cgroupPath = cgroup;
+
+        thread = std::thread(&MemoryPressureMonitor::run, this, std::move(resolved), stopDescriptor);
+        return true;
+#else
+        (void) configuration;
+        return false;
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void MemoryPressureMonitor::stop()
+    {
+        std::lock_guard < std::mutex > lock(threadMutex);
+
+#if defined(__linux__)
+        if (thread.joinable())
+        {
+            std::uint64_t one = 1;
+
+            while (write(stopDescriptor, &one, sizeof(one)) < 0 && errno == EINTR);
+
+            thread.join();
+            close(stopDescriptor);
+            stopDescriptor = -1;
+        }
+#endif
+
+        // Removed even if start() failed: the owner of the function may be destroyed after this call.
+        std::lock_guard < std::mutex > wakeLock(wakeMutex);
+        wake = nullptr;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t MemoryPressureMonitor::addReclaimer(const std::string& name, int priority, EstimateFunction estimate, ReclaimFunction reclaim)
+    {
+        std::lock_guard < std::recursive_mutex > lock(reclaimersMutex);
+        std::uint64_t id = nextId++;
+
+        reclaimers.push_back(std::make_shared < Reclaimer >(Reclaimer { id, name, priority, std::move(estimate), std::move(reclaim), false }));
+        return id;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void MemoryPressureMonitor::removeReclaimer(std::uint64_t id)
+    {
+        std::lock_guard < std::recursive_mutex > lock(reclaimersMutex);
+
+        auto it = std::find_if(reclaimers.begin(), reclaimers.end(), [id](const std::shared_ptr < Reclaimer >& reclaimer){
+            return reclaimer->id == id;
+        });
+
+        if (it == reclaimers.end())
+            return;
+
+        // A dispatch iterating over its own copy skips the reclaimer.
+        (*it)->removed = true;
+        reclaimers.erase(it);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void MemoryPressureMonitor::signal(MemoryPressureLevel level)
+    {
+        std::uint32_t value = static_cast < std::uint32_t >(level);
+        std::uint32_t current = pending.load();
+
+        while (current < value && !pending.compare_exchange_weak(current, value));
+
+        if (!value)
+            return;
+
+        std::lock_guard < std::mutex > lock(wakeMutex);
+
+        if (wake)
+            wake();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t MemoryPressureMonitor::dispatch()
+    {
+        std::uint32_t value = pending.exchange(0);
+
+        if (!value)
+            return 0;
+
+        MemoryPressureLevel level = static_cast < MemoryPressureLevel >(value);
+        lastLevel.store(value);
+
+        std::lock_guard < std::recursive_mutex > lock(reclaimersMutex);
+
+        // Estimates are taken once: reclaiming changes them.
+        std::vector < std::pair < std::shared_ptr < Reclaimer >, std::size_t > > ordered;
+
+        for (const std::shared_ptr < Reclaimer >& reclaimer : reclaimers)
+            ordered.emplace_back(reclaimer, reclaimer->estimate ? reclaimer->estimate() : 0);
+
+        std::stable_sort(ordered.begin(), ordered.end(), [](const std::pair < std::shared_ptr < Reclaimer >, std::size_t >& lhs,
+                                                            const std::pair < std::shared_ptr < Reclaimer >, std::size_t >& rhs){
+            if (lhs.first->priority != rhs.first->priority)
+                return lhs.first->priority < rhs.first->priority;
+
+            return lhs.second > rhs.second;
+        });
+
+        const std::size_t target = level == MemoryPressureLevel::Critical ? ~std::size_t(0) : configuration.moderateTarget;
+        std::size_t reclaimed = 0;
+        std::size_t called = 0;
+
+        for (auto& entry : ordered)
+        {
+            if (reclaimed >= target)
+                break;
+
+            // At Moderate, reclaimers with nothing to free are not bothered. At Critical, every one is
+            // called, as estimates may be late.
+            if (entry.first->removed || (!entry.second && level != MemoryPressureLevel::Critical))
+                continue;
+
+            reclaimed += entry.first->reclaim(level, target - reclaimed);
+            called++;
+        }
+
+        NotificationCenter::Notifiate("Core",
+                                      "MemoryPressureMonitor::dispatch",
+                                      kMemoryPressureNotification,
+                                      RDFormatString("%s memory pressure: %zu bytes reclaimed by %zu reclaimers."),
+                                      MemoryPressureLevelName(level), reclaimed, called);
+
+        return reclaimed;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t MemoryPressureMonitor::reclaimableBytes() const
+    {
+        std::lock_guard < std::recursive_mutex > lock(reclaimersMutex);
+        std::size_t bytes = 0;
+
+        for (const std::shared_ptr < Reclaimer >& reclaimer : reclaimers)
+            bytes += reclaimer->estimate ? reclaimer->estimate() : 0;
+
+        return bytes;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    MemoryPressureLevel MemoryPressureMonitor::level() const noexcept
+    {
+        return static_cast < MemoryPressureLevel >(lastLevel.load());
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void MemoryPressureMonitor::run(MemoryPressureConfiguration configuration, int stopEvent)
+    {
+#if defined(__linux__)
+        // The cgroup's pressure only counts the stalls of its tasks, which is what its memory.max cares about.
+        std::string pressure = kSystemPressure;
+
+        if (!configuration.cgroupPath.empty() && !access((configuration.cgroupPath + "/memory.pressure").c_str(), R_OK))
+            pressure = configuration.cgroupPath + "/memory.pressure";
+
+        int someTrigger = OpenTrigger(pressure, "some", configuration.someStall, configuration.window);
+        int fullTrigger = OpenTrigger(pressure, "full", configuration.fullStall, configuration.window);
+        int events = -1;
+
+        if (!configuration.cgroupPath.empty())
+            events = open((configuration.cgroupPath + "/memory.events").c_str(), O_RDONLY | O_CLOEXEC);
+
+        // Without triggers (older kernels, or no write access), averages are read at each pollInterval.
+        int averages = -1;
+
+        if (someTrigger < 0 || fullTrigger < 0)
+            averages = open(pressure.c_str(), O_RDONLY | O_CLOEXEC);
+
+        const double someThreshold = 100.0 * configuration.someStall.count() / configuration.window.count();
+        const double fullThreshold = 100.0 * configuration.fullStall.count() / configuration.window.count();
+
+        MemoryEvents last = events >= 0 ? ReadEvents(events) : MemoryEvents();
+
+        while (true)
+        {
+            pollfd descriptors[4] = {
+                { stopEvent, POLLIN, 0 },
+                { someTrigger, POLLPRI, 0 },
+                { fullTrigger, POLLPRI, 0 },
+                { events, POLLPRI, 0 }
+            };
+
+            int timeout = averages >= 0 ? int(configuration.pollInterval.count()) : -1;
+            int result = poll(descriptors, 4, timeout);
+
+            if (result < 0 && errno != EINTR)
+                break;
+
+            if (descriptors[0].revents)
+                break;
+
+            MemoryPressureLevel level = MemoryPressureLevel::None;
+
+            if (descriptors[2].revents & POLLPRI)
+                level = MemoryPressureLevel::Critical;
+            else if (descriptors[1].revents & POLLPRI)
+                level = MemoryPressureLevel::Moderate;
+
+            // A trigger errors when its cgroup is removed: it is not watched anymore.
+            for (int i = 1; i < 3; ++i)
+            {
+                if (descriptors[i].revents & (POLLERR | POLLNVAL) && !(descriptors[i].revents & POLLPRI))
+                {
+                    close(descriptors[i].fd);
+                    (i == 1 ? someTrigger : fullTrigger) = -1;
+                }
+            }
+
+            if (descriptors[3].revents & POLLPRI)
+            {
+                MemoryEvents current = ReadEvents(events);
+
+                if (current.critical > last.critical)
+                    level = MemoryPressureLevel::Critical;
+                else if (current.high > last.high && level == MemoryPressureLevel::None)
+                    level = MemoryPressureLevel::Moderate;
+
+                last = current;
+            }
+
+            if (averages >= 0 && !result)
+            {
+                std::string content = ReadDescriptor(averages);
+
+                if (ReadAverage(content, "full") >= fullThreshold)
+                    level = MemoryPressureLevel::Critical;
+                else if (ReadAverage(content, "some") >= someThreshold && level == MemoryPressureLevel::None)
+                    level = MemoryPressureLevel::Moderate;
+            }
+
+            if (level != MemoryPressureLevel::None)
+                signal(level);
+        }
+
+        for (int fd : { someTrigger, fullTrigger, events, averages })
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+#else
+        (void) configuration;
+        (void) stopEvent;
+#endif
+    }
+}
@@ -0,0 +1,120 @@
+//
+//  NodeArena.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "NodeArena.h"
+
+#include <sys/mman.h>
+
+#if defined(__linux__)
+#   include <linux/mempolicy.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+namespace RD
+{
+    namespace
+    {
+        /*! @brief Maps a chunk of memory and binds it to the given node if possible. */
+        unsigned char* MapChunk(std::size_t size, int node)
+        {
+            void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (memory == MAP_FAILED)
+                return nullptr;
+
+#           if defined(__linux__) && defined(SYS_mbind)
+            // Pages are not touched yet, so the policy applies to every page of the chunk. MPOL_PREFERRED
+            // falls back to other nodes instead of failing when the node is full. Failure of mbind (no NUMA
+            // support in the kernel) is not an error: the chunk is then a regular mapping.
+            if (node >= 0 && node < static_cast < int >(sizeof(unsigned long) * 8))
+            {
+                unsigned long mask = 1UL << node;
+                syscall(SYS_mbind, memory, size, MPOL_PREFERRED, &mask, sizeof(mask) * 8, 0);
+            }
+
+#           endif
+
+            return static_cast < unsigned char* >(memory);
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    NodeArena::NodeArena(int node, std::size_t chunk)
+    : current(0), offset(0), chunkSize(chunk ? chunk : 1 << 20), nodeId(node)
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    NodeArena::~NodeArena()
+    {
+        for (auto& chunk : chunks)
+            munmap(chunk.memory, chunk.size);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void* NodeArena::allocate(std::size_t size, std::size_t alignment)
+    {
+        if (!alignment)
+            alignment = 1;
+
+        while (current < chunks.size())
+        {
+            Chunk& chunk = chunks[current];
+            std::size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+
+            if (aligned + size <= chunk.size)
+            {
+                offset = aligned + size;
+                return chunk.memory + aligned;
+            }
+
+            current++;
+            offset = 0;
+        }
+
+        // Mappings are page aligned, so any power of two alignment up to the page size is satisfied.
+        const std::size_t page = 4096;
+        std::size_t mapped = std::max(chunkSize, (size + page - 1) & ~(page - 1));
+
+        unsigned char* memory = MapChunk(mapped, nodeId);
+
+        if (!memory)
+            return nullptr;
+
+        chunks.push_back({ memory, mapped });
+        current = chunks.size() - 1;
+        offset = size;
+
+        return memory;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void NodeArena::reset()
+    {
+        current = 0;
+        offset = 0;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    int NodeArena::node() const
+    {
+        return nodeId;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t NodeArena::capacity() const
+    {
+        std::size_t total = 0;
+
+        for (auto& chunk : chunks)
+            total += chunk.size;
+
+        return total;
+    }
+}
@@ -9,37 +9,101 @@
 
 namespace RD
 {
+    /////////////////////////////////////////////////////////////////////////////////
+    Notification::Notification() noexcept
+    : moduleId(""), functionId(""), nameId(""), format(""), arguments(nullptr), formatter(nullptr), encoder(nullptr), formatted(true)
+    {
+        
+    }
+    
     /////////////////////////////////////////////////////////////////////////////////
     Notification::Notification(const char* moduleName, const char* functionName, const char* notifName, const char* message)
-    : moduleStr(moduleName), functionStr(functionName), notification(notifName), messageStr(message)
+    : moduleId(moduleName), functionId(functionName), nameId(notifName), format(""), arguments(nullptr), formatter(nullptr)
+    , encoder(nullptr), messageStr(message), formatted(true)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Notification::Notification(const HashedString& module, const HashedString& function, const HashedString& name,
+                               const char* fmt, const void* args, Formatter fmtFunction,
+                               Encoder encFunction) noexcept
+    : moduleId(module), functionId(function), nameId(name), format(fmt), arguments(args), formatter(fmtFunction)
+    , encoder(encFunction), formatted(false)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Notification::Notification(const Notification& other)
+    : moduleId(other.moduleId), functionId(other.functionId), nameId(other.nameId), format("")
+    , arguments(nullptr), formatter(nullptr), encoder(nullptr), messageStr(other.message()), formatted(true)
     {
         
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    const std::string& Notification::module() const
+    std::string_view Notification::module() const
     {
-        return moduleStr;
+        return static_cast < const char* >(moduleId);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    const std::string& Notification::function() const
+    std::string_view Notification::function() const
     {
-        return functionStr;
+        return static_cast < const char* >(functionId);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    const std::string& Notification::name() const
+    std::string_view Notification::name() const
     {
-        return notification;
+        return static_cast < const char* >(nameId);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     const std::string& Notification::message() const
     {
+        if (!formatted)
+        {
+            if (formatter && arguments)
+                formatter(format, arguments, messageStr);
+            else
+                messageStr = format;
+            
+            formatted = true;
+        }
+        
         return messageStr;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    const char* kNotificationAbortRequested = "RDNotificationAbortRequested";
+    HashedString::hash_type Notification::moduleHash() const
+    {
+        return moduleId;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    HashedString::hash_type Notification::nameHash() const
+    {
+        return nameId;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Notification::is(const HashedString& notificationName) const
+    {
+        return nameId == notificationName;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const char* Notification::encode(unsigned char* buffer, std::size_t capacity, std::size_t& size) const
+    {
+        if (!formatted && encoder && arguments)
+        {
+            size = encoder(arguments, buffer, capacity);
+            return format;
+        }
+        
+        size = NotificationEncoding::EncodeString(message().c_str(), buffer, capacity);
+        return "%s";
+    }
 }
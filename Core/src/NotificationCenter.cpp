@@ -9,23 +9,99 @@
 
 namespace RD
 {
+    namespace
+    {
+        /*! @brief Answers of the last notification of the calling thread, when collected. */
+        struct CollectedAnswersSlot
+        {
+            const NotificationCenter* center = nullptr;
+            std::forward_list < NotificationAnswer > answers;
+        };
+        
+        thread_local CollectedAnswersSlot collected;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    NotificationCenter::NotificationCenter() noexcept
+    : index(nullptr), nextOrder(0), observerCount(0), collectAnswers(false)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    NotificationCenter::~NotificationCenter() noexcept
+    {
+        // No notification can be dispatched while the center is destroyed, so the index is not retired.
+        delete index.load();
+        collect();
+    }
+    
     /////////////////////////////////////////////////////////////////////////////////
     std::forward_list < NotificationAnswer > NotificationCenter::notifiate(const Notification& notification)
     {
-        std::lock_guard < std::mutex > lock(mutex);
-        answers.clear();
+        std::forward_list < NotificationAnswer > answers;
+        EpochGuard guard;
         
-        for (auto observer : observers)
+        const Index* current = index.load();
+        
+        if (current)
         {
-            if (observer.valid())
+            // Merges the three lists matching the notification, each sorted by order. An observer subscribed in
+            // more than one list has the same order in each of them, so it is called once.
+            const Subscriber* lists[3][2] = { { nullptr, nullptr }, { nullptr, nullptr }, { nullptr, nullptr } };
+            
+            lists[0][0] = current->wildcards.data();
+            lists[0][1] = current->wildcards.data() + current->wildcards.size();
+            
+            auto name = current->byName.find(notification.nameHash());
+            
+            if (name != current->byName.end())
+            {
+                lists[1][0] = name->second.data();
+                lists[1][1] = name->second.data() + name->second.size();
+            }
+            
+            auto module = current->byModule.find(notification.moduleHash());
+            
+            if (module != current->byModule.end())
+            {
+                lists[2][0] = module->second.data();
+                lists[2][1] = module->second.data() + module->second.size();
+            }
+            
+            while (true)
             {
-                if (observer->shouldObserve(this, notification))
+                const Subscriber* next = nullptr;
+                
+                for (auto& list : lists)
+                {
+                    if (list[0] != list[1] && (!next || list[0]->order < next->order))
+                        next = list[0];
+                }
+                
+                if (!next)
+                    break;
+                
+                for (auto& list : lists)
+                {
+                    if (list[0] != list[1] && list[0]->order == next->order)
+                        list[0]++;
+                }
+                
+                NotificationObserver* observer = const_cast < NotificationObserver* >(next->observer.ptr());
+                
+                if (observer && observer->shouldObserve(this, notification))
                 {
                     answers.push_front(observer->observe(this, notification));
                 }
             }
         }
         
+        if (collectAnswers.load(std::memory_order_relaxed))
+        {
+            collected.center = this;
+            collected.answers = answers;
+        }
         
         return answers;
     }
@@ -33,40 +109,184 @@ namespace RD
     /////////////////////////////////////////////////////////////////////////////////
     std::forward_list < NotificationAnswer > NotificationCenter::collectedAnswers() const
     {
-        std::lock_guard < std::mutex > lock(mutex);
-        return answers;
+        if (collected.center == this)
+            return collected.answers;
+        
+        return std::forward_list < NotificationAnswer >();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationCenter::setCollectAnswers(bool enabled)
+    {
+        collectAnswers.store(enabled);
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void NotificationCenter::addObserver(const Handle<NotificationObserver>& observer)
+    {
+        addObserver(observer, NotificationSubscription::Any());
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationCenter::addObserver(const Handle<NotificationObserver>& observer, const NotificationSubscription& subscription)
     {
         if (observer.valid())
         {
             std::lock_guard < std::mutex > lock(mutex);
-            observers.push_front(observer);
+            const Index* current = index.load();
+            Index* next = current ? new Index(*current) : new Index();
+            
+            // Subscribing twice the same way is a no-op, so the observer is still called once.
+            if (std::vector < Subscriber >* existing = FindSubscribers(*next, subscription, false))
+            {
+                auto it = std::find_if(existing->begin(), existing->end(), [&observer](const Subscriber& subscriber){
+                    return subscriber.observer.ptr() == observer.ptr();
+                });
+                
+                if (it != existing->end())
+                {
+                    delete next;
+                    return;
+                }
+            }
+            
+            // An observer keeps the order of its first subscription still active, so adding a subscription does
+            // not change the order in which observers are called.
+            std::uint64_t order = nextOrder;
+            bool found = false;
+            
+            auto earliest = [&observer, &order, &found](const std::vector < Subscriber >& list){
+                for (auto& subscriber : list)
+                {
+                    if (subscriber.observer.ptr() == observer.ptr())
+                    {
+                        order = subscriber.order;
+                        found = true;
+                    }
+                }
+            };
+            
+            earliest(next->wildcards);
+            
+            for (auto& pair : next->byName)
+                earliest(pair.second);
+            for (auto& pair : next->byModule)
+                earliest(pair.second);
+            
+            if (!found)
+                nextOrder++;
+            
+            auto list = FindSubscribers(*next, subscription, true);
+            auto position = std::upper_bound(list->begin(), list->end(), order, [](std::uint64_t value, const Subscriber& subscriber){
+                return value < subscriber.order;
+            });
+            
+            list->insert(position, Subscriber { observer, order });
+            observerCount++;
+            publish(next);
         }
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void NotificationCenter::removeObserver(const Handle<NotificationObserver>& observer)
     {
-        if (observer.valid())
+        if (!observer.valid())
+            return;
+        
+        {
+            std::lock_guard < std::mutex > lock(mutex);
+            const Index* current = index.load();
+            
+            if (!current)
+                return;
+            
+            Index* next = new Index(*current);
+            auto matches = [&observer](const Subscriber& subscriber){ return subscriber.observer.ptr() == observer.ptr(); };
+            std::size_t removed = 0;
+            
+            auto it = std::remove_if(next->wildcards.begin(), next->wildcards.end(), matches);
+            removed += std::distance(it, next->wildcards.end());
+            next->wildcards.erase(it, next->wildcards.end());
+            
+            for (auto map : { &next->byName, &next->byModule })
+            {
+                for (auto pair = map->begin(); pair != map->end(); )
+                {
+                    auto end = std::remove_if(pair->second.begin(), pair->second.end(), matches);
+                    removed += std::distance(end, pair->second.end());
+                    pair->second.erase(end, pair->second.end());
+                    
+                    if (pair->second.empty())
+                        pair = map->erase(pair);
+                    else
+                        ++pair;
+                }
+            }
+            
+            observerCount -= removed;
+            publish(next);
+        }
+        
+        collect();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationCenter::removeObserver(const Handle<NotificationObserver>& observer, const NotificationSubscription& subscription)
+    {
+        if (!observer.valid())
+            return;
+        
         {
             std::lock_guard < std::mutex > lock(mutex);
-            observers.remove(observer);
+            const Index* current = index.load();
+            
+            if (!current)
+                return;
+            
+            Index* next = new Index(*current);
+            std::vector < Subscriber >* list = FindSubscribers(*next, subscription, false);
+            auto it = list ? std::find_if(list->begin(), list->end(), [&observer](const Subscriber& subscriber){
+                return subscriber.observer.ptr() == observer.ptr();
+            }) : std::vector < Subscriber >::iterator();
+            
+            if (!list || it == list->end())
+            {
+                delete next;
+                return;
+            }
+            
+            list->erase(it);
+            observerCount--;
+            publish(next);
         }
+        
+        collect();
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     void NotificationCenter::clearObservers()
     {
-        std::lock_guard < std::mutex > lock(mutex);
-        observers.clear();
+        {
+            std::lock_guard < std::mutex > lock(mutex);
+            observerCount.store(0);
+            publish(nullptr);
+        }
+        
+        collect();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NotificationCenter::hasObservers() const
+    {
+        return observerCount.load(std::memory_order_relaxed) != 0;
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     std::forward_list < NotificationAnswer > NotificationCenter::Notifiate(const Notification& notification)
     {
+        FlightRecorder::Record(FlightRecorder::EventType::Notification, nullptr, notification.nameHash(),
+                               notification.module().data(), notification.name().data());
+        
         if (defaultCenter.valid())
             return defaultCenter->notifiate(notification);
         else
@@ -74,29 +294,9 @@ namespace RD
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    std::forward_list < NotificationAnswer > NotificationCenter::Notifiate(const char *moduleName,
-                                                                           const char *functionName,
-                                                                           const char *notificationName,
-                                                                           const char *format, ...)
+    bool NotificationCenter::IsObserved()
     {
-        if (defaultCenter.valid())
-        {
-            char buffer[2048];
-            memset(buffer, 0, 2048);
-            
-            va_list args;
-            va_start(args, format);
-            vsnprintf(buffer, 2048, format, args);
-            va_end(args);
-            
-            Notification notification(moduleName, functionName, notificationName, buffer);
-            return defaultCenter->notifiate(notification);
-        }
-        
-        else
-        {
-            return std::forward_list < NotificationAnswer >();
-        }
+        return defaultCenter.valid() && defaultCenter->hasObservers();
     }
     
     /////////////////////////////////////////////////////////////////////////////////
@@ -109,23 +309,43 @@ namespace RD
     }
     
     /////////////////////////////////////////////////////////////////////////////////
-    Handle < NotificationCenter > NotificationCenter::defaultCenter;
+    std::vector < NotificationCenter::Subscriber >* NotificationCenter::FindSubscribers(Index& index, const NotificationSubscription& subscription, bool create)
+    {
+        if (subscription.kind == NotificationSubscription::Kind::Wildcard)
+            return &index.wildcards;
+        
+        auto& map = subscription.kind == NotificationSubscription::Kind::Name ? index.byName : index.byModule;
+        
+        if (create)
+            return &map[subscription.hash];
+        
+        auto it = map.find(subscription.hash);
+        return it != map.end() ? &it->second : nullptr;
+    }
     
     /////////////////////////////////////////////////////////////////////////////////
-    std::forward_list < NotificationAnswer > NotifiateAbort(const char* moduleName,
-                                                            const char *functionName,
-                                                            const char *notificationName,
-                                                            const char *format, ...)
+    void NotificationCenter::publish(Index* next)
     {
-        char buffer[2048];
-        memset(buffer, 0, 2048);
-        
-        va_list args;
-        va_start(args, format);
-        vsnprintf(buffer, 2048, format, args);
-        va_end(args);
+        const Index* previous = index.exchange(next);
         
-        Notification notification(moduleName, functionName, notificationName, buffer);
+        if (previous)
+            Epoch::Retire(previous);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationCenter::collect()
+    {
+        // Retired indexes hold handles to the observers removed: they are released here, on the thread
+        // removing them, rather than by whichever thread next reaches Epoch's threshold.
+        Epoch::Collect();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < NotificationCenter > NotificationCenter::defaultCenter;
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Expected < std::forward_list < NotificationAnswer > > TryNotifiateAbort(const Notification& notification)
+    {
         auto answers = NotificationCenter::Notifiate(notification);
         
         auto it = std::find_if(answers.begin(), answers.end(), [](const RD::NotificationAnswer& answer){
@@ -136,16 +356,23 @@ namespace RD
         
         if (it != answers.end())
         {
-            RD::NotificationCenter::Notifiate(moduleName,
-                                              functionName,
-                                              RD::kNotificationAbortRequested,
-                                              buffer);
-            
-            throw RD::AbortRequestedException(moduleName,
-                                              functionName,
-                                              buffer);
+            // Module and function are static strings, so their views are null-terminated.
+            const std::string& message = notification.message();
+            
+            RD::NotificationCenter::Notifiate(Notification(notification.module().data(),
+                                                           notification.function().data(),
+                                                           RD::kNotificationAbortRequested,
+                                                           message.data()));
+            
+            return Error(notification.module(), notification.function(), kErrorAbortRequested, message);
         }
         
         return answers;
     }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::forward_list < NotificationAnswer > NotifiateAbort(const Notification& notification)
+    {
+        return TryNotifiateAbort(notification).value();
+    }
 }
@@ -0,0 +1,300 @@
+//
+//  NotificationEncoding.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "NotificationEncoding.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace RD
+{
+    namespace NotificationEncoding
+    {
+        namespace
+        {
+            /*! @brief Decoded argument. */
+            struct Argument
+            {
+                Tag tag = kTagNullString;
+                std::uint64_t bits = 0;
+                const char* string = nullptr;
+                std::size_t length = 0;
+            };
+
+            /*! @brief Reads the next argument. Returns false if no argument is left, or if it is truncated. */
+            bool Next( const unsigned char*& it, const unsigned char* end, Argument& argument )
+            {
+                if ( it >= end )
+                    return false;
+
+                argument.tag = static_cast < Tag >( *it++ );
+
+                switch ( argument.tag )
+                {
+                    case kTagInt:
+                    case kTagUInt:
+                    case kTagDouble:
+                    case kTagPointer:
+                        if ( end - it < 8 )
+                            return false;
+                        std::memcpy( &argument.bits, it, 8 );
+                        it += 8;
+                        return true;
+
+                    case kTagString:
+                    {
+                        if ( end - it < 2 )
+                            return false;
+                        std::uint16_t length;
+                        std::memcpy( &length, it, 2 );
+                        it += 2;
+                        if ( static_cast < std::size_t >( end - it ) < length )
+                            return false;
+                        argument.string = reinterpret_cast < const char* >( it );
+                        argument.length = length;
+                        it += length;
+                        return true;
+                    }
+
+                    case kTagNullString:
+                        argument.string = nullptr;
+                        argument.length = 0;
+                        return true;
+
+                    case kTagTruncated:
+                        it = end;
+                        return false;
+
+                    default:
+                        return false;
+                }
+            }
+
+            /*! @brief Returns the argument as a signed integer. */
+            std::int64_t AsInt( const Argument& argument )
+            {
+                if ( argument.tag == kTagDouble )
+                {
+                    double value;
+                    std::memcpy( &value, &argument.bits, 8 );
+                    return static_cast < std::int64_t >( value );
+                }
+
+                return static_cast < std::int64_t >( argument.bits );
+            }
+
+            /*! @brief Returns the argument as a double. */
+            double AsDouble( const Argument& argument )
+            {
+                if ( argument.tag == kTagDouble )
+                {
+                    double value;
+                    std::memcpy( &value, &argument.bits, 8 );
+                    return value;
+                }
+
+                if ( argument.tag == kTagInt )
+                    return static_cast < double >( static_cast < std::int64_t >( argument.bits ) );
+
+                return static_cast < double >( argument.bits );
+            }
+
+            /*! @brief Appends a value formatted with a single conversion specification. */
+            template < typename T >
+            void Append( std::string& message, const char* spec, T value )
+            {
+                char buffer[128];
+                int length = std::snprintf( buffer, sizeof(buffer), spec, value );
+
+                if ( length < 0 )
+                    return;
+
+                if ( static_cast < std::size_t >( length ) < sizeof(buffer) )
+                {
+                    message.append( buffer, static_cast < std::size_t >( length ) );
+                    return;
+                }
+
+                std::size_t offset = message.size();
+                message.resize( offset + static_cast < std::size_t >( length ) + 1 );
+                std::snprintf( &message[offset], static_cast < std::size_t >( length ) + 1, spec, value );
+                message.resize( offset + static_cast < std::size_t >( length ) );
+            }
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////
+        std::size_t EncodeString( const char* value, unsigned char* buffer, std::size_t capacity )
+        {
+            if ( !value )
+            {
+                if ( !capacity )
+                    return 0;
+
+                buffer[0] = kTagNullString;
+                return 1;
+            }
+
+            return EncodeString( value, std::strlen( value ), buffer, capacity );
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////
+        std::size_t EncodeString( const char* value, std::size_t length, unsigned char* buffer, std::size_t capacity )
+        {
+            if ( capacity < 3 )
+                return 0;
+
+            length = std::min( { length, capacity - 3, std::size_t( UINT16_MAX ) } );
+            std::uint16_t stored = static_cast < std::uint16_t >( length );
+
+            buffer[0] = kTagString;
+            std::memcpy( buffer + 1, &stored, 2 );
+            std::memcpy( buffer + 3, value, length );
+            return 3 + length;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////
+        std::size_t EncodeTruncated( unsigned char* buffer, std::size_t capacity )
+        {
+            if ( !capacity )
+                return 0;
+
+            buffer[0] = kTagTruncated;
+            return 1;
+        }
+
+        /////////////////////////////////////////////////////////////////////////////////
+        void Format( const char* format, const unsigned char* arguments, std::size_t size, std::string& message )
+        {
+            message.clear();
+
+            if ( !format )
+                return;
+
+            const unsigned char* it = arguments;
+            const unsigned char* end = arguments + size;
+
+            while ( *format )
+            {
+                if ( *format != '%' )
+                {
+                    const char* next = std::strchr( format, '%' );
+                    std::size_t length = next ? static_cast < std::size_t >( next - format ) : std::strlen( format );
+
+                    message.append( format, length );
+                    format += length;
+                    continue;
+                }
+
+                if ( format[1] == '%' )
+                {
+                    message.push_back( '%' );
+                    format += 2;
+                    continue;
+                }
+
+                // Copies flags, width and precision, drops length modifiers, and adds the length matching
+                // the stored value before the conversion.
+                char spec[32] = { '%' };
+                std::size_t specLength = 1;
+                const char* cursor = format + 1;
+
+                while ( *cursor && std::strchr( "-+ #0123456789.*", *cursor ) )
+                {
+                    if ( specLength < sizeof(spec) - 4 )
+                        spec[specLength++] = *cursor;
+                    cursor++;
+                }
+
+                while ( *cursor && std::strchr( "hlLqjzt", *cursor ) )
+                    cursor++;
+
+                char conversion = *cursor;
+                format = conversion ? cursor + 1 : cursor;
+
+                if ( std::memchr( spec, '*', specLength ) )
+                {
+                    // Widths and precisions passed as arguments are consumed and replaced by their value.
+                    std::string expanded( "%" );
+
+                    for ( std::size_t i = 1; i < specLength; ++i )
+                    {
+                        Argument star;
+
+                        if ( spec[i] != '*' )
+                            expanded.push_back( spec[i] );
+                        else if ( Next( it, end, star ) )
+                            expanded += std::to_string( AsInt( star ) );
+                    }
+
+                    specLength = std::min( expanded.size(), sizeof(spec) - 4 );
+                    std::memcpy( spec, expanded.data(), specLength );
+                }
+
+                Argument argument;
+
+                if ( conversion == 'n' || !conversion )
+                    continue;
+
+                if ( !Next( it, end, argument ) )
+                {
+                    message.push_back( '?' );
+                    continue;
+                }
+
+                switch ( conversion )
+                {
+                    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+                        spec[specLength++] = 'l';
+                        spec[specLength++] = 'l';
+                        spec[specLength++] = conversion;
+                        spec[specLength] = 0;
+
+                        if ( conversion == 'd' || conversion == 'i' )
+                            Append( message, spec, static_cast < long long >( AsInt( argument ) ) );
+                        else
+                            Append( message, spec, static_cast < unsigned long long >( AsInt( argument ) ) );
+                        break;
+
+                    case 'c':
+                        spec[specLength++] = 'c';
+                        spec[specLength] = 0;
+                        Append( message, spec, static_cast < int >( AsInt( argument ) ) );
+                        break;
+
+                    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                        spec[specLength++] = conversion;
+                        spec[specLength] = 0;
+                        Append( message, spec, AsDouble( argument ) );
+                        break;
+
+                    case 'p':
+                        spec[specLength++] = 'p';
+                        spec[specLength] = 0;
+                        Append( message, spec, reinterpret_cast < const void* >( static_cast < std::uintptr_t >( argument.bits ) ) );
+                        break;
+
+                    case 's':
+                        spec[specLength++] = 's';
+                        spec[specLength] = 0;
+
+                        // Encoded strings are not null-terminated.
+                        if ( argument.tag == kTagString )
+                            Append( message, spec, std::string( argument.string, argument.length ).c_str() );
+                        else if ( argument.tag == kTagNullString )
+                            message += "(null)";
+                        else
+                            message.push_back( '?' );
+                        break;
+
+                    default:
+                        message.push_back( '?' );
+                        break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,565 @@
+//
+//  NotificationLogger.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "NotificationLogger.h"
+#include "Exception.h"
+#include "Format.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace RD
+{
+    namespace
+    {
+        //! @brief First bytes of a binary log, followed by the start time on 8 bytes.
+        const char kLogMagic[8] = { 'R', 'D', 'N', 'L', 'O', 'G', '0', '1' };
+
+        /*! @brief Kind of an entry in a binary log. Every entry starts with its kind, on one byte. */
+        enum EntryKind : std::uint8_t
+        {
+            //! @brief Definition of a string: identifier (4 bytes), length (2 bytes), characters.
+            kEntryString = 1,
+
+            //! @brief Notification: time (8 bytes), thread (4 bytes), module, function, name and format
+            //! identifiers (4 bytes each), arguments size (2 bytes), encoded arguments.
+            kEntryRecord = 2,
+
+            //! @brief Notifications dropped: count (8 bytes).
+            kEntryDropped = 3
+        };
+
+        //! @brief Maximum number of records written with one call to writev.
+        constexpr std::size_t kBatchSize = 256;
+
+        //! @brief Identifier given to the next thread sending a notification.
+        std::atomic < std::uint32_t > nextThreadId { 1 };
+
+        //! @brief Identifier of the current thread, zero until its first notification.
+        thread_local std::uint32_t localThreadId = 0;
+
+        /*! @brief Returns a small identifier for the calling thread. */
+        std::uint32_t LocalThreadId()
+        {
+            if (!localThreadId)
+                localThreadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+            return localThreadId;
+        }
+
+        /*! @brief Returns the current time in nanoseconds. */
+        std::uint64_t Now()
+        {
+            return static_cast < std::uint64_t >(std::chrono::duration_cast < std::chrono::nanoseconds >(
+                Clock::now().time_since_epoch()).count());
+        }
+
+        /*! @brief Appends a value to buffer, in host byte order. */
+        template < typename T >
+        void Append(std::vector < unsigned char >& buffer, T value)
+        {
+            const unsigned char* bytes = reinterpret_cast < const unsigned char* >(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        /*! @brief Reads a value from content at offset, and advances offset. Returns false if the content is
+         * too short. */
+        template < typename T >
+        bool Read(const std::vector < unsigned char >& content, std::size_t& offset, T& value)
+        {
+            if (content.size() - offset < sizeof(T))
+                return false;
+
+            std::memcpy(&value, content.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        /*! @brief Writes every vector, retrying after partial writes. */
+        bool WriteAll(int fd, iovec* vectors, std::size_t count)
+        {
+            while (count)
+            {
+                ssize_t written = writev(fd, vectors, static_cast < int >(std::min < std::size_t >(count, IOV_MAX)));
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                while (count && static_cast < std::size_t >(written) >= vectors->iov_len)
+                {
+                    written -= static_cast < ssize_t >(vectors->iov_len);
+                    vectors++;
+                    count--;
+                }
+
+                if (count)
+                {
+                    vectors->iov_base = static_cast < char* >(vectors->iov_base) + written;
+                    vectors->iov_len -= static_cast < std::size_t >(written);
+                }
+            }
+
+            return true;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    NotificationLogger::NotificationLogger(const Configuration& config)
+    : configuration(config), head(0), tail(0), droppedCount(0), writtenCount(0), fd(-1)
+    , startTime(Now()), wakeRequested(false), stopping(false), droppedWritten(0)
+    {
+        std::size_t capacity = 2;
+
+        while (capacity < configuration.capacity)
+            capacity <<= 1;
+
+        slots.reset(new Slot[capacity]);
+        mask = capacity - 1;
+
+        for (std::size_t i = 0; i < capacity; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+
+        fd = open(configuration.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fd < 0)
+            throw FileOpenException(configuration.path, errno);
+
+        if (configuration.encoding == Encoding::Binary)
+        {
+            std::vector < unsigned char > header(kLogMagic, kLogMagic + sizeof(kLogMagic));
+            Append(header, startTime);
+
+            iovec vector = { header.data(), header.size() };
+            WriteAll(fd, &vector, 1);
+        }
+
+        writer = std::thread(&NotificationLogger::work, this);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    NotificationLogger::~NotificationLogger() noexcept
+    {
+        {
+            std::lock_guard < std::mutex > lock(mutex);
+            stopping = true;
+        }
+
+        wakeCondition.notify_one();
+        writer.join();
+
+        writtenCondition.notify_all();
+        close(fd);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    NotificationAnswer NotificationLogger::observe(const NotificationCenter*, const Notification& notification)
+    {
+        std::uint64_t position = head.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true)
+        {
+            slot = &slots[position & mask];
+
+            std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            std::int64_t difference = static_cast < std::int64_t >(sequence - position);
+
+            if (difference == 0)
+            {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+
+            else if (difference < 0)
+            {
+                // The slot still holds the record written one lap before: the ring is full.
+                if (configuration.overflow == OverflowPolicy::Drop)
+                {
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return NotificationAnswer::Null();
+                }
+
+                bool stopped;
+
+                {
+                    std::unique_lock < std::mutex > lock(mutex);
+                    wakeRequested = true;
+                    wakeCondition.notify_one();
+
+                    writtenCondition.wait(lock, [this, position](){
+                        return stopping || tail.load(std::memory_order_acquire) + mask + 1 > position;
+                    });
+
+                    stopped = stopping;
+                }
+
+                if (stopped)
+                {
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return NotificationAnswer::Null();
+                }
+
+                position = head.load(std::memory_order_relaxed);
+            }
+
+            else
+            {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        Record& record = slot->record;
+        std::size_t size = 0;
+
+        record.module = notification.module().data();
+        record.function = notification.function().data();
+        record.name = notification.name().data();
+        record.format = notification.encode(record.arguments, kMaxArgumentsSize, size);
+        record.size = static_cast < std::uint16_t >(size);
+        record.time = Now();
+        record.thread = LocalThreadId();
+
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        // Wakes the writer once per lap, when the ring gets half full, instead of waiting for the interval.
+        if (position - tail.load(std::memory_order_relaxed) == (mask + 1) / 2)
+        {
+            {
+                std::lock_guard < std::mutex > lock(mutex);
+                wakeRequested = true;
+            }
+
+            wakeCondition.notify_one();
+        }
+
+        return NotificationAnswer::Null();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NotificationLogger::shouldObserve(const NotificationCenter*, const Notification&) const
+    {
+        return true;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationLogger::flush()
+    {
+        std::uint64_t target = head.load(std::memory_order_acquire);
+        std::unique_lock < std::mutex > lock(mutex);
+
+        wakeRequested = true;
+        wakeCondition.notify_one();
+
+        writtenCondition.wait(lock, [this, target](){
+            return stopping || tail.load(std::memory_order_acquire) >= target;
+        });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NotificationLogger::dropped() const
+    {
+        return droppedCount.load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NotificationLogger::written() const
+    {
+        return writtenCount.load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationLogger::FormatLine(std::string& line, double seconds, std::uint32_t thread,
+                                        std::string_view module, std::string_view function,
+                                        std::string_view name, std::string_view message)
+    {
+        FormatBuffer < 64 > prefix(RDFormatString("%12.6f [%u] "), seconds, thread);
+
+        line.assign(prefix.view());
+        line += '[';
+        line += module;
+        line += "](";
+        line += function;
+        line += ") ";
+        line += name;
+
+        if (!message.empty())
+        {
+            line += ": ";
+            line += message;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void NotificationLogger::work()
+    {
+        while (true)
+        {
+            bool stop;
+
+            {
+                std::unique_lock < std::mutex > lock(mutex);
+                wakeCondition.wait_for(lock, configuration.flushInterval, [this](){ return wakeRequested || stopping; });
+                wakeRequested = false;
+                stop = stopping;
+            }
+
+            drain();
+
+            if (stop)
+                return;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t NotificationLogger::drain()
+    {
+        /*! @brief Part of a batch: bytes of buffer, or the arguments of a record. */
+        struct Segment
+        {
+            std::size_t offset;
+            const unsigned char* arguments;
+            std::size_t size;
+        };
+
+        std::vector < unsigned char > buffer;
+        std::vector < Segment > segments;
+        std::vector < iovec > vectors;
+        std::string message, line;
+        std::size_t total = 0;
+
+        const bool binary = configuration.encoding == Encoding::Binary;
+
+        while (true)
+        {
+            buffer.clear();
+            segments.clear();
+
+            std::uint64_t position = tail.load(std::memory_order_relaxed);
+            std::uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+            std::size_t count = 0;
+            std::size_t flushed = 0;
+
+            if (dropped != droppedWritten)
+            {
+                if (binary)
+                {
+                    Append(buffer, kEntryDropped);
+                    Append(buffer, dropped - droppedWritten);
+                }
+                else
+                {
+                    line = "-- " + std::to_string(dropped - droppedWritten) + " notifications dropped --\n";
+                    buffer.insert(buffer.end(), line.begin(), line.end());
+                }
+
+                droppedWritten = dropped;
+            }
+
+            for (; count < kBatchSize; ++count)
+            {
+                Slot& slot = slots[(position + count) & mask];
+
+                if (slot.sequence.load(std::memory_order_acquire) != position + count + 1)
+                    break;
+
+                const Record& record = slot.record;
+
+                if (binary)
+                {
+                    // Definitions of new strings come before the record using them.
+                    std::uint32_t module = stringId(buffer, record.module);
+                    std::uint32_t function = stringId(buffer, record.function);
+                    std::uint32_t name = stringId(buffer, record.name);
+                    std::uint32_t format = stringId(buffer, record.format);
+
+                    Append(buffer, kEntryRecord);
+                    Append(buffer, record.time - startTime);
+                    Append(buffer, record.thread);
+                    Append(buffer, module);
+                    Append(buffer, function);
+                    Append(buffer, name);
+                    Append(buffer, format);
+                    Append(buffer, record.size);
+
+                    // Arguments are written from the ring directly: the slot is released after writev.
+                    segments.push_back({ flushed, nullptr, buffer.size() - flushed });
+                    segments.push_back({ 0, record.arguments, record.size });
+                    flushed = buffer.size();
+                }
+                else
+                {
+                    NotificationEncoding::Format(record.format, record.arguments, record.size, message);
+                    FormatLine(line, static_cast < double >(record.time - startTime) * 1e-9, record.thread,
+                               record.module, record.function, record.name, message);
+
+                    line += '\n';
+                    buffer.insert(buffer.end(), line.begin(), line.end());
+                }
+            }
+
+            if (flushed < buffer.size())
+                segments.push_back({ flushed, nullptr, buffer.size() - flushed });
+
+            if (segments.empty())
+                return total;
+
+            vectors.clear();
+
+            for (const Segment& segment : segments)
+            {
+                void* base = segment.arguments ? const_cast < unsigned char* >(segment.arguments) : buffer.data() + segment.offset;
+                vectors.push_back({ base, segment.size });
+            }
+
+            // A failed write loses the batch: the logger never blocks senders on a broken file.
+            WriteAll(fd, vectors.data(), vectors.size());
+
+            for (std::size_t i = 0; i < count; ++i)
+                slots[(position + i) & mask].sequence.store(position + i + mask + 1, std::memory_order_release);
+
+            writtenCount.fetch_add(count, std::memory_order_relaxed);
+            total += count;
+
+            {
+                std::lock_guard < std::mutex > lock(mutex);
+                tail.store(position + count, std::memory_order_release);
+            }
+
+            writtenCondition.notify_all();
+
+            if (count < kBatchSize)
+                return total;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint32_t NotificationLogger::stringId(std::vector < unsigned char >& buffer, const char* string)
+    {
+        auto it = strings.find(string);
+
+        if (it != strings.end())
+            return it->second;
+
+        std::uint32_t identifier = static_cast < std::uint32_t >(strings.size() + 1);
+        std::uint16_t length = static_cast < std::uint16_t >(std::min < std::size_t >(std::strlen(string), UINT16_MAX));
+
+        Append(buffer, kEntryString);
+        Append(buffer, identifier);
+        Append(buffer, length);
+        buffer.insert(buffer.end(), string, string + length);
+
+        strings.emplace(string, identifier);
+        return identifier;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    NotificationLogReader::NotificationLogReader(const std::string& path)
+    : offset(sizeof(kLogMagic) + sizeof(std::uint64_t)), start(0)
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+
+        if (!file)
+            throw FileOpenException(path, errno);
+
+        unsigned char chunk[65536];
+        std::size_t read;
+
+        while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            content.insert(content.end(), chunk, chunk + read);
+
+        std::fclose(file);
+
+        if (content.size() < offset || std::memcmp(content.data(), kLogMagic, sizeof(kLogMagic)))
+            throw FileOpenException(path, EINVAL);
+
+        std::memcpy(&start, content.data() + sizeof(kLogMagic), sizeof(start));
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NotificationLogReader::startTime() const
+    {
+        return start;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NotificationLogReader::next(Entry& entry)
+    {
+        static const std::string unknown("?");
+
+        auto lookup = [this](std::uint32_t identifier) -> const std::string& {
+            auto it = strings.find(identifier);
+            return it != strings.end() ? it->second : unknown;
+        };
+
+        std::uint8_t kind;
+
+        while (Read(content, offset, kind))
+        {
+            if (kind == kEntryString)
+            {
+                std::uint32_t identifier;
+                std::uint16_t length;
+
+                if (!Read(content, offset, identifier) || !Read(content, offset, length) || content.size() - offset < length)
+                    return false;
+
+                strings[identifier].assign(reinterpret_cast < const char* >(content.data() + offset), length);
+                offset += length;
+            }
+
+            else if (kind == kEntryRecord)
+            {
+                std::uint32_t module, function, name, format;
+                std::uint16_t size;
+
+                if (!Read(content, offset, entry.time) || !Read(content, offset, entry.thread) ||
+                    !Read(content, offset, module) || !Read(content, offset, function) ||
+                    !Read(content, offset, name) || !Read(content, offset, format) ||
+                    !Read(content, offset, size) || content.size() - offset < size)
+                    return false;
+
+                entry.module = lookup(module);
+                entry.function = lookup(function);
+                entry.name = lookup(name);
+                entry.dropped = 0;
+
+                NotificationEncoding::Format(lookup(format).c_str(), content.data() + offset, size, entry.message);
+                offset += size;
+                return true;
+            }
+
+            else if (kind == kEntryDropped)
+            {
+                if (!Read(content, offset, entry.dropped))
+                    return false;
+
+                entry.time = 0;
+                entry.thread = 0;
+                entry.module = entry.function = entry.name = std::string_view();
+                entry.message.clear();
+                return true;
+            }
+
+            else
+            {
+                return false;
+            }
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,170 @@
+//
+//  RenderQueue.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "RenderQueue.h"
+#include "CommandQueue.h"
+
+#include <algorithm>
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    RenderQueue::RenderQueue(CommandQueue& queue) noexcept : commandQueue(queue)
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    RenderQueue::~RenderQueue()
+    {
+        DrawList* list = submitted.exchange(nullptr, std::memory_order_acquire);
+
+        while (list)
+        {
+            DrawList* next = list->next;
+            delete list;
+            list = next;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::unique_ptr < DrawList > RenderQueue::acquire()
+    {
+        std::lock_guard < std::mutex > lock(freeMutex);
+
+        if (freeLists.empty())
+            return std::make_unique < DrawList >();
+
+        std::unique_ptr < DrawList > list = std::move(freeLists.back());
+        freeLists.pop_back();
+        return list;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void RenderQueue::submit(std::unique_ptr < DrawList > list)
+    {
+        if (!list)
+            return;
+
+        DrawList* raw = list.release();
+        raw->sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        raw->next = submitted.load(std::memory_order_relaxed);
+
+        while (!submitted.compare_exchange_weak(raw->next, raw, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t RenderQueue::flush()
+    {
+        std::lock_guard < std::mutex > flushLock(flushMutex);
+
+        std::vector < std::unique_ptr < DrawList > > lists;
+        DrawList* list = submitted.exchange(nullptr, std::memory_order_acquire);
+        std::size_t count = 0;
+
+        while (list)
+        {
+            DrawList* next = list->next;
+            list->next = nullptr;
+            count += list->items.size();
+            lists.emplace_back(list);
+            list = next;
+        }
+
+        // Lists are merged in submission order, so the sort being stable, equal keys are drawn in the
+        // order they were submitted.
+        std::sort(lists.begin(), lists.end(), [](const std::unique_ptr < DrawList >& lhs, const std::unique_ptr < DrawList >& rhs){
+            return lhs->sequence < rhs->sequence;
+        });
+
+        items.clear();
+        items.reserve(count);
+
+        for (std::unique_ptr < DrawList >& submittedList : lists)
+        {
+            items.insert(items.end(), submittedList->items.begin(), submittedList->items.end());
+            submittedList->reset();
+        }
+
+        {
+            std::lock_guard < std::mutex > lock(freeMutex);
+
+            for (std::unique_ptr < DrawList >& submittedList : lists)
+                freeLists.push_back(std::move(submittedList));
+        }
+
+        if (items.empty())
+            return 0;
+
+        Sort(items, scratch);
+
+        auto buffer = commandQueue.acquire(order());
+        void* payload = buffer->allocate(kDrawItemsCommand, static_cast < std::uint32_t >(items.size() * sizeof(DrawItem)));
+        std::memcpy(payload, items.data(), items.size() * sizeof(DrawItem));
+        commandQueue.submit(std::move(buffer));
+
+        return items.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void RenderQueue::Sort(std::vector < DrawItem >& items, std::vector < DrawItem >& scratch)
+    {
+        const std::size_t count = items.size();
+
+        if (count < kRadixThreshold)
+        {
+            std::stable_sort(items.begin(), items.end(), [](const DrawItem& lhs, const DrawItem& rhs){
+                return lhs.key < rhs.key;
+            });
+            return;
+        }
+
+        // Histograms of the eight bytes are counted in one pass over the keys. Counts fit in 32 bits, as
+        // the items are recorded in a command of at most 4 GB.
+        std::uint32_t histograms[8][256] = {};
+
+        for (const DrawItem& item : items)
+        {
+            std::uint64_t key = item.key;
+
+            for (unsigned byte = 0; byte < 8; ++byte)
+                histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+        }
+
+        scratch.resize(count);
+        DrawItem* source = items.data();
+        DrawItem* destination = scratch.data();
+
+        for (unsigned byte = 0; byte < 8; ++byte)
+        {
+            std::uint32_t* histogram = histograms[byte];
+            const unsigned shift = byte * 8;
+
+            // Every key has the same byte: this pass would not move anything.
+            if (histogram[(source[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            std::uint32_t offset = 0;
+
+            for (unsigned digit = 0; digit < 256; ++digit)
+            {
+                std::uint32_t digitCount = histogram[digit];
+                histogram[digit] = offset;
+                offset += digitCount;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+                destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+
+            std::swap(source, destination);
+        }
+
+        if (source != items.data())
+            items.swap(scratch);
+    }
+}
@@ -0,0 +1,233 @@
+//
+//  ResourceRegistry.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "ResourceRegistry.h"
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    ResourceRegistry::~ResourceRegistry()
+    {
+        for (Shard& shard : shards)
+            delete shard.snapshot.load();
+
+        // Snapshots retired earlier still hold handles: they are released now rather than by whichever
+        // thread next reaches Epoch's threshold.
+        collect();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool ResourceRegistry::insert(const HashedString& name, const Handle < DriverResource >& resource)
+    {
+        return insert(Entry { name, resource, Handle < Surface >() });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool ResourceRegistry::insert(const HashedString& name, const Handle < Surface >& surface)
+    {
+        return insert(Entry { name, Handle < DriverResource >(surface), surface });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool ResourceRegistry::insert(const Entry& entry)
+    {
+        HashedString::hash_type hash = entry.name;
+        const DriverResource* resource = entry.resource.ptr();
+
+        Shard& shard = shards[ShardOf(hash)];
+        PointerShard& pointerShard = pointerShards[ShardOf(resource)];
+        const Snapshot* retired = nullptr;
+
+        {
+            // The pointer shard stays locked until the entry is in both sets, so a concurrent remove() of
+            // this resource waits for the insertion instead of missing it. Only insert() locks both.
+            std::lock_guard < std::mutex > pointerLock(pointerShard.mutex);
+            std::lock_guard < std::mutex > lock(shard.mutex);
+
+            if (!shard.entries.emplace(hash, entry).second)
+                return false;
+
+            pointerShard.names[resource] = hash;
+            retired = shard.snapshot.exchange(nullptr);
+        }
+
+        resourcesCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (entry.surface.valid())
+            surfacesCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (retired)
+            Epoch::Retire(retired);
+
+        return true;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < DriverResource > ResourceRegistry::find(const HashedString& name) const
+    {
+        HashedString::hash_type hash = name;
+        const Shard& shard = shards[ShardOf(hash)];
+
+        std::lock_guard < std::mutex > lock(shard.mutex);
+        auto it = shard.entries.find(hash);
+        return it != shard.entries.end() ? it->second.resource : Handle < DriverResource >();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < Surface > ResourceRegistry::findSurface(const HashedString& name) const
+    {
+        HashedString::hash_type hash = name;
+        const Shard& shard = shards[ShardOf(hash)];
+
+        std::lock_guard < std::mutex > lock(shard.mutex);
+        auto it = shard.entries.find(hash);
+        return it != shard.entries.end() ? it->second.surface : Handle < Surface >();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Handle < DriverResource > ResourceRegistry::remove(const DriverResource* resource)
+    {
+        HashedString::hash_type hash = 0;
+
+        {
+            PointerShard& pointerShard = pointerShards[ShardOf(resource)];
+            std::lock_guard < std::mutex > lock(pointerShard.mutex);
+
+            auto it = pointerShard.names.find(resource);
+
+            if (it == pointerShard.names.end())
+                return Handle < DriverResource >();
+
+            hash = it->second;
+            pointerShard.names.erase(it);
+        }
+
+        Shard& shard = shards[ShardOf(hash)];
+        Handle < DriverResource > removed;
+        bool surface = false;
+        const Snapshot* retired = nullptr;
+
+        {
+            std::lock_guard < std::mutex > lock(shard.mutex);
+            auto it = shard.entries.find(hash);
+
+            if (it == shard.entries.end() || it->second.resource.ptr() != resource)
+                return Handle < DriverResource >();
+
+            removed = std::move(it->second.resource);
+            surface = it->second.surface.valid();
+
+            shard.entries.erase(it);
+            retired = shard.snapshot.exchange(nullptr);
+        }
+
+        resourcesCount.fetch_sub(1, std::memory_order_relaxed);
+
+        if (surface)
+            surfacesCount.fetch_sub(1, std::memory_order_relaxed);
+
+        if (retired)
+            Epoch::Retire(retired);
+
+        return removed;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void ResourceRegistry::clear()
+    {
+        for (Shard& shard : shards)
+        {
+            std::unordered_map < HashedString::hash_type, Entry > entries;
+            const Snapshot* retired = nullptr;
+
+            {
+                std::lock_guard < std::mutex > lock(shard.mutex);
+                entries.swap(shard.entries);
+                retired = shard.snapshot.exchange(nullptr);
+            }
+
+            for (auto& pair : entries)
+            {
+                const DriverResource* resource = pair.second.resource.ptr();
+                PointerShard& pointerShard = pointerShards[ShardOf(resource)];
+
+                {
+                    std::lock_guard < std::mutex > lock(pointerShard.mutex);
+                    pointerShard.names.erase(resource);
+                }
+
+                resourcesCount.fetch_sub(1, std::memory_order_relaxed);
+
+                if (pair.second.surface.valid())
+                    surfacesCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            if (retired)
+                Epoch::Retire(retired);
+
+            // Handles are released here, outside of the shard's lock.
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void ResourceRegistry::collect()
+    {
+        Epoch::Collect();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t ResourceRegistry::size() const
+    {
+        return resourcesCount.load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t ResourceRegistry::surfacesSize() const
+    {
+        return surfacesCount.load(std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const ResourceRegistry::Snapshot* ResourceRegistry::snapshotOf(const Shard& shard) const
+    {
+        const Snapshot* snapshot = shard.snapshot.load(std::memory_order_acquire);
+
+        if (snapshot)
+            return snapshot;
+
+        std::lock_guard < std::mutex > lock(shard.mutex);
+        snapshot = shard.snapshot.load(std::memory_order_relaxed);
+
+        if (!snapshot)
+        {
+            Snapshot* built = new Snapshot();
+            built->entries.reserve(shard.entries.size());
+
+            for (const auto& pair : shard.entries)
+                built->entries.push_back(pair.second);
+
+            shard.snapshot.store(built, std::memory_order_release);
+            snapshot = built;
+        }
+
+        return snapshot;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t ResourceRegistry::ShardOf(HashedString::hash_type hash)
+    {
+        return static_cast < std::size_t >(hash ^ (hash >> 32)) % kShardCount;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t ResourceRegistry::ShardOf(const DriverResource* resource)
+    {
+        // Low bits of a pointer are mostly alignment.
+        std::uintptr_t bits = reinterpret_cast < std::uintptr_t >(resource);
+        return static_cast < std::size_t >((bits >> 4) ^ (bits >> 12)) % kShardCount;
+    }
+}
@@ -7,6 +7,7 @@
 
 #include "Surface.h"
 #include "NotificationCenter.h"
+#include "FlightRecorder.h"
 
 namespace RD
 {
@@ -31,4 +32,22 @@ namespace RD
     {
         close();
     }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Surface::emitDidMove(const ScreenPosition& position)
+    {
+        FlightRecorder::Record(FlightRecorder::EventType::SurfaceMoved, this,
+                               (std::uint64_t(position.x) << 32) | position.y, nullptr);
+        
+        emitCoalesced < SurfaceObserver >(&SurfaceObserver::onSurfaceDidMove, this, position);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Surface::emitDidResize(const RectSize& newSize)
+    {
+        FlightRecorder::Record(FlightRecorder::EventType::SurfaceResized, this,
+                               (std::uint64_t(newSize.width) << 32) | newSize.height, nullptr);
+        
+        emitCoalesced < SurfaceObserver >(&SurfaceObserver::onSurfaceDidResize, this, newSize);
+    }
 }
@@ -0,0 +1,391 @@
+//
+//  TimerWheel.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "TimerWheel.h"
+#include "WorkerPool.h"
+
+namespace RD
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    TimerWheel::TimerWheel(Clock::duration tick, const Clock::time_point& start)
+    : currentTick(0), armedCount(0), origin(start), resolution(tick), workerPool(nullptr)
+    {
+        if (resolution <= Clock::duration::zero())
+            resolution = std::chrono::milliseconds(1);
+
+        for (auto& level : slots)
+            std::fill(std::begin(level), std::end(level), NullIndex);
+
+        for (auto& level : occupied)
+            std::fill(std::begin(level), std::end(level), 0);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    TimerId TimerWheel::schedule(Clock::duration delay, std::function < void() > callback, TimerDispatch dispatch)
+    {
+        return arm(delay, Clock::duration::zero(), std::move(callback), dispatch);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    TimerId TimerWheel::schedulePeriodic(Clock::duration period, std::function < void() > callback, TimerDispatch dispatch)
+    {
+        return arm(period, period, std::move(callback), dispatch);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool TimerWheel::cancel(TimerId id)
+    {
+        const std::uint32_t index = static_cast < std::uint32_t >(id & 0xFFFFFFFF);
+        const std::uint32_t generation = static_cast < std::uint32_t >(id >> 32);
+
+        std::lock_guard < Spinlock > lock(spinlock);
+
+        if (index >= timers.size())
+            return false;
+
+        Timer& timer = timers[index];
+
+        if (timer.generation != generation)
+            return false;
+
+        if (timer.state == TimerState::Firing)
+        {
+            timer.state = TimerState::Cancelled;
+            return true;
+        }
+
+        if (timer.state != TimerState::Armed)
+            return false;
+
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void TimerWheel::clear()
+    {
+        std::lock_guard < Spinlock > lock(spinlock);
+
+        for (std::uint32_t index = 0; index < timers.size(); ++index)
+        {
+            Timer& timer = timers[index];
+
+            if (timer.state == TimerState::Armed)
+            {
+                unlink(index);
+                release(index);
+            }
+
+            else if (timer.state == TimerState::Firing)
+            {
+                timer.state = TimerState::Cancelled;
+            }
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t TimerWheel::advance(const Clock::time_point& now)
+    {
+        if (now <= origin)
+            return 0;
+
+        const std::uint64_t target = static_cast < std::uint64_t >((now - origin) / resolution);
+
+        {
+            std::lock_guard < Spinlock > lock(spinlock);
+
+            // Nothing to fire: we can jump directly to the target tick, as every slot is empty.
+            if (!armedCount)
+                currentTick = std::max(currentTick, target);
+
+            while (currentTick < target)
+            {
+                currentTick++;
+
+                const std::uint32_t index = static_cast < std::uint32_t >(currentTick & (SlotCount - 1));
+
+                // When level 0 wraps, the next slot of level 1 is cascaded down. If this slot is also the
+                // first one of level 1, level 2 is cascaded, and so on.
+                if (!index)
+                {
+                    for (std::uint32_t level = 1; level < LevelCount; ++level)
+                    {
+                        if (cascade(level) != 0)
+                            break;
+                    }
+                }
+
+                std::uint32_t current = slots[0][index];
+
+                if (current == NullIndex)
+                    continue;
+
+                slots[0][index] = NullIndex;
+                occupied[0][index / 64] &= ~(std::uint64_t(1) << (index % 64));
+
+                while (current != NullIndex)
+                {
+                    Timer& timer = timers[current];
+                    const std::uint32_t next = timer.next;
+
+                    timer.prev = timer.next = NullIndex;
+                    timer.state = TimerState::Firing;
+                    armedCount--;
+
+                    expired.push_back({ current, timer.dispatch, std::move(timer.callback) });
+                    current = next;
+                }
+            }
+        }
+
+        if (expired.empty())
+            return 0;
+
+        // Callbacks are moved out of the timers while the spinlock is held, and called without holding it,
+        // so they can schedule or cancel timers: \ref timers is never read unlocked.
+        WorkerPool* pool = workerPool.load();
+
+        for (Expired& entry : expired)
+        {
+            if (entry.dispatch == TimerDispatch::WorkerPool && pool)
+                pool->push(std::function < void() >(entry.callback));
+            else if (entry.callback)
+                entry.callback();
+        }
+
+        const std::size_t fired = expired.size();
+
+        {
+            std::lock_guard < Spinlock > lock(spinlock);
+
+            for (Expired& entry : expired)
+            {
+                const std::uint32_t index = entry.index;
+                Timer& timer = timers[index];
+
+                if (timer.state == TimerState::Firing && timer.period)
+                {
+                    timer.callback = std::move(entry.callback);
+
+                    // Skips every period already elapsed, so a late wheel doesn't fire bursts.
+                    std::uint64_t next = timer.expiry + timer.period;
+
+                    if (next <= currentTick)
+                        next += ((currentTick - next) / timer.period + 1) * timer.period;
+
+                    timer.expiry = next;
+                    timer.state = TimerState::Armed;
+                    armedCount++;
+                    insert(index);
+                }
+
+                else
+                {
+                    release(index);
+                }
+            }
+
+            expired.clear();
+        }
+
+        return fired;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    Clock::time_point TimerWheel::nextDeadline() const
+    {
+        std::lock_guard < Spinlock > lock(spinlock);
+
+        if (!armedCount)
+            return Clock::time_point::max();
+
+        std::uint64_t deadline = std::numeric_limits < std::uint64_t >::max();
+
+        for (std::uint32_t level = 0; level < LevelCount; ++level)
+        {
+            const std::uint32_t shift = level * SlotBits;
+            const std::uint64_t position = currentTick >> shift;
+
+            // Finds the first occupied slot after the current position of this level. For level 0, the slot
+            // gives the exact expiry. For upper levels, it gives the tick when the slot is cascaded, which is
+            // before every timer it holds.
+            for (std::uint32_t distance = 1; distance <= SlotCount; ++distance)
+            {
+                const std::uint32_t slot = static_cast < std::uint32_t >((position + distance) & (SlotCount - 1));
+                const std::uint64_t word = occupied[level][slot / 64] >> (slot % 64);
+
+                if (!word)
+                {
+                    // Skips the rest of this 64 bits word.
+                    distance += 63 - (slot % 64);
+                    continue;
+                }
+
+                if (word & 1)
+                {
+                    deadline = std::min(deadline, (position + distance) << shift);
+                    break;
+                }
+            }
+
+            if (deadline <= ((position + 1) << shift))
+                break;
+        }
+
+        return origin + resolution * deadline;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t TimerWheel::size() const
+    {
+        std::lock_guard < Spinlock > lock(spinlock);
+        return armedCount;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void TimerWheel::setWorkerPool(WorkerPool* pool)
+    {
+        workerPool.store(pool);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    TimerId TimerWheel::arm(Clock::duration delay, Clock::duration period, std::function < void() >&& callback, TimerDispatch dispatch)
+    {
+        // Expiry is computed from the current time and not from the last processed tick, so a timer scheduled
+        // long after the last advance() does not fire early.
+        const Clock::time_point now = Clock::now();
+        const std::uint64_t expiry = toTicks((now - origin) + std::max(delay, Clock::duration::zero()));
+        const std::uint64_t periodTicks = period > Clock::duration::zero() ? std::max(toTicks(period), std::uint64_t(1)) : 0;
+
+        std::lock_guard < Spinlock > lock(spinlock);
+        std::uint32_t index;
+
+        if (!freeList.empty())
+        {
+            index = freeList.back();
+            freeList.pop_back();
+        }
+
+        else
+        {
+            index = static_cast < std::uint32_t >(timers.size());
+            timers.emplace_back();
+        }
+
+        Timer& timer = timers[index];
+        timer.callback = std::move(callback);
+        timer.expiry = std::max(expiry, currentTick + 1);
+        timer.period = periodTicks;
+        timer.dispatch = dispatch;
+        timer.state = TimerState::Armed;
+
+        insert(index);
+        armedCount++;
+
+        return (TimerId(timer.generation) << 32) | index;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t TimerWheel::toTicks(Clock::duration duration) const
+    {
+        if (duration <= Clock::duration::zero())
+            return 0;
+
+        return static_cast < std::uint64_t >((duration + resolution - Clock::duration(1)) / resolution);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void TimerWheel::insert(std::uint32_t index)
+    {
+        Timer& timer = timers[index];
+
+        // Expired timers go in the next slot processed by advance().
+        const std::uint64_t expiry = std::max(timer.expiry, currentTick + 1);
+        const std::uint64_t delta = expiry - currentTick;
+
+        std::uint32_t level = 0;
+        std::uint64_t slotTick = expiry;
+
+        while (level < LevelCount - 1 && delta >= (std::uint64_t(1) << (SlotBits * (level + 1))))
+            level++;
+
+        // Timers further than the wheel's range are stored in the last slot reachable, and are cascaded
+        // back into the last level until their expiry is reachable.
+        const std::uint64_t range = std::uint64_t(1) << (SlotBits * LevelCount);
+
+        if (delta >= range)
+            slotTick = currentTick + range - 1;
+
+        const std::uint32_t slot = static_cast < std::uint32_t >((slotTick >> (SlotBits * level)) & (SlotCount - 1));
+
+        timer.level = static_cast < std::uint8_t >(level);
+        timer.slot = static_cast < std::uint16_t >(slot);
+        timer.prev = NullIndex;
+        timer.next = slots[level][slot];
+
+        if (timer.next != NullIndex)
+            timers[timer.next].prev = index;
+
+        slots[level][slot] = index;
+        occupied[level][slot / 64] |= std::uint64_t(1) << (slot % 64);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void TimerWheel::unlink(std::uint32_t index)
+    {
+        Timer& timer = timers[index];
+
+        if (timer.prev != NullIndex)
+            timers[timer.prev].next = timer.next;
+        else
+            slots[timer.level][timer.slot] = timer.next;
+
+        if (timer.next != NullIndex)
+            timers[timer.next].prev = timer.prev;
+
+        if (slots[timer.level][timer.slot] == NullIndex)
+            occupied[timer.level][timer.slot / 64] &= ~(std::uint64_t(1) << (timer.slot % 64));
+
+        timer.prev = timer.next = NullIndex;
+        armedCount--;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void TimerWheel::release(std::uint32_t index)
+    {
+        Timer& timer = timers[index];
+        timer.callback = nullptr;
+        timer.state = TimerState::Free;
+        timer.generation++;
+
+        // Generation zero would give a null TimerId for index zero.
+        if (!timer.generation)
+            timer.generation = 1;
+
+        freeList.push_back(index);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint32_t TimerWheel::cascade(std::uint32_t level)
+    {
+        const std::uint32_t index = static_cast < std::uint32_t >((currentTick >> (SlotBits * level)) & (SlotCount - 1));
+        std::uint32_t current = slots[level][index];
+
+        slots[level][index] = NullIndex;
+        occupied[level][index / 64] &= ~(std::uint64_t(1) << (index % 64));
+
+        while (current != NullIndex)
+        {
+            const std::uint32_t next = timers[current].next;
+            insert(current);
+            current = next;
+        }
+
+        return index;
+    }
+}
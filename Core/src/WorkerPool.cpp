@@ -0,0 +1,149 @@
+//
+//  WorkerPool.cpp
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "WorkerPool.h"
+
+namespace RD
+{
+    //! @brief Arena of the current worker.
+    static thread_local NodeArena* localArena = nullptr;
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    WorkerPool::WorkerPool(std::size_t count) : stopping(false), arenaChunkSize(0)
+    {
+        if (!count)
+        {
+            std::size_t hardware = std::thread::hardware_concurrency();
+            count = hardware > 1 ? hardware - 1 : 1;
+        }
+
+        startWorkers(count);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    WorkerPool::WorkerPool(const ThreadConfiguration& configuration, const CpuTopology& topology)
+    : stopping(false), arenaChunkSize(configuration.arenaChunkSize)
+    {
+        std::vector < int > reserved;
+        
+        if (configuration.mainCpu >= 0)
+            reserved.push_back(configuration.mainCpu);
+        if (configuration.renderCpu >= 0)
+            reserved.push_back(configuration.renderCpu);
+        
+        workerCpus = topology.select(configuration.workerPolicy,
+                                     configuration.workerCount,
+                                     configuration.workerNode,
+                                     reserved);
+        
+        std::size_t count = configuration.workerCount;
+        
+        if (!count)
+            count = workerCpus.size();
+        
+        if (!count)
+        {
+            std::size_t hardware = std::thread::hardware_concurrency();
+            count = hardware > reserved.size() + 1 ? hardware - reserved.size() - 1 : 1;
+        }
+        
+        if (arenaChunkSize)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                workerNodes.push_back(workerCpus.empty() ? configuration.workerNode : topology.nodeOf(workerCpus[i]));
+        }
+        
+        startWorkers(count);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard < std::mutex > lock(mutex);
+            stopping = true;
+        }
+
+        condition.notify_all();
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void WorkerPool::push(std::function < void() >&& task)
+    {
+        {
+            std::lock_guard < std::mutex > lock(mutex);
+            tasks.push(std::move(task));
+        }
+
+        condition.notify_one();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t WorkerPool::size() const
+    {
+        return workers.size();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const std::vector < int >& WorkerPool::cpus() const
+    {
+        return workerCpus;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    NodeArena* WorkerPool::LocalArena()
+    {
+        return localArena;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void WorkerPool::startWorkers(std::size_t count)
+    {
+        workers.reserve(count);
+        
+        for (std::size_t i = 0; i < count; ++i)
+            workers.emplace_back(&WorkerPool::work, this, i);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void WorkerPool::work(std::size_t index)
+    {
+        // The worker pins itself before creating its arena, so the arena's bookkeeping is also allocated
+        // on the worker's node.
+        if (index < workerCpus.size())
+            CpuTopology::PinCurrentThread({ workerCpus[index] });
+        
+        std::unique_ptr < NodeArena > arena;
+        
+        if (index < workerNodes.size())
+        {
+            arena.reset(new NodeArena(workerNodes[index], arenaChunkSize));
+            localArena = arena.get();
+        }
+        
+        while (true)
+        {
+            std::function < void() > task;
+
+            {
+                std::unique_lock < std::mutex > lock(mutex);
+                condition.wait(lock, [this](){ return stopping || !tasks.empty(); });
+
+                if (tasks.empty())
+                    return;
+
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            task();
+        }
+    }
+}
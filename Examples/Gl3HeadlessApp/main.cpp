@@ -0,0 +1,347 @@
+//
+//  main.cpp
+//  gl3headlessapp
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include <RD/Application.h>
+#include <RD/Driver.h>
+#include <RD/CommandQueue.h>
+#include <Gl3Module/Gl3Driver.h>
+#include <Gl3Module/Gl3Surface.h>
+
+#include <cassert>
+#include <cstdlib>
+
+/*! @brief Vertex shader: positions in clip space, one color per vertex. */
+static const char* kVertexShader = R"(
+#version 150 core
+in vec2 position;
+in vec4 color;
+out vec4 vertexColor;
+void main()
+{
+    vertexColor = color;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
+)";
+
+/*! @brief Fragment shader. */
+static const char* kFragmentShader = R"(
+#version 150 core
+in vec4 vertexColor;
+out vec4 fragmentColor;
+void main()
+{
+    fragmentColor = vertexColor;
+}
+)";
+
+/*! @brief A vertex of the scene. */
+struct Vertex
+{
+    float x, y;
+    float r, g, b, a;
+};
+
+/////////////////////////////////////////////////////////////////////////////////
+static GLuint CompileShader(GLenum type, const char* source)
+{
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+    if (status != GL_TRUE)
+    {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cout << "Shader compilation failed: " << log << std::endl;
+    }
+
+    return shader;
+}
+
+/**
+ * @brief Renders a scene of colored triangles into an offscreen Gl3Surface, with a headless Gl3Driver,
+ * and prints the time per frame and a hash of the image read back.
+ *
+ * Triangles are drawn in batches, each setting its whole state through the driver's Gl3StateCache as
+ * independent draw code would: the cache only issues what changes, and the counters of the last frame
+ * are printed. Passing 'validate' checks every elided call against the context. Passing 'queue' records
+ * the same scene as Gl3 commands, executed by the driver's CommandQueue on its own thread: the image is
+ * the same.
+ */
+class Gl3HeadlessAppDelegate : public RD::ApplicationDelegate
+{
+    //! @brief Handle to our driver.
+    RD::Handle < RD::Driver > driver;
+
+    //! @brief Offscreen surface rendered into.
+    RD::Handle < RD::Surface > surface;
+
+    //! @brief Program and vertex buffer of the scene.
+    GLuint program = 0, vertexBuffer = 0;
+
+    //! @brief Layout of vertexBuffer, whose vertex array object is cached by the driver.
+    Gl3::Gl3VertexLayout layout;
+
+    //! @brief Vertex array object of layout, drawn by the queued commands.
+    GLuint vertexArray = 0;
+
+    //! @brief Number of vertices in vertexBuffer.
+    GLsizei verticesCount = 0;
+
+    //! @brief Number of frames to run.
+    uint32_t framesCount;
+
+    //! @brief Number of frames run.
+    uint32_t frame = 0;
+
+    //! @brief True to validate the state cache.
+    bool validate;
+
+    //! @brief True to render through the command queue.
+    bool queued;
+
+    //! @brief Time spent rendering frames.
+    RD::Clock::duration elapsed { 0 };
+
+public:
+
+    static constexpr uint32_t kWidth = 1280;
+    static constexpr uint32_t kHeight = 720;
+    static constexpr uint32_t kTriangles = 10000;
+    static constexpr uint32_t kBatches = 100;
+
+    Gl3HeadlessAppDelegate(uint32_t frames, bool validateState, bool queue) : framesCount(frames), validate(validateState), queued(queue) {}
+
+    ~Gl3HeadlessAppDelegate() = default;
+
+    void onApplicationDidStart(RD::Application& application, const RD::Clock::time_point& ticks)
+    {
+        auto module = application.findModule("Gl3Module");
+
+        if (!module.valid())
+            return;
+
+        Gl3::Gl3DriverConfiguration glConfig;
+        glConfig.validateState = validate;
+
+        RD::DriverConfiguration config;
+        config.extension = &glConfig;
+
+        driver = module->loadClass < RD::Driver >(&config);
+
+        if (!driver.valid() || !driver->valid())
+        {
+            std::cout << "No OpenGL context could be created." << std::endl;
+            driver.reset();
+            return;
+        }
+
+        std::cout << "Driver name: " << driver->name() << std::endl;
+        std::cout << "Driver version: " << driver->version() << std::endl;
+
+        surface = driver->createSurface(kWidth, kHeight, "Gl3HeadlessApp", "Offscreen");
+
+        Gl3::Gl3ContextLock lock(static_cast < const Gl3::Gl3Driver& >(*driver));
+        std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+
+        program = glCreateProgram();
+        GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+        GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        glBindAttribLocation(program, 0, "position");
+        glBindAttribLocation(program, 1, "color");
+        glBindFragDataLocation(program, 0, "fragmentColor");
+        glLinkProgram(program);
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+
+        // Triangles of random positions and colors, with a fixed seed: every run renders the same image.
+        std::vector < Vertex > vertices;
+        uint32_t seed = 0x12345678;
+
+        auto random = [&seed](){
+            seed = seed * 1664525u + 1013904223u;
+            return float(seed >> 8) / float(1 << 24);
+        };
+
+        for (uint32_t i = 0; i < kTriangles; ++i)
+        {
+            float cx = random() * 2.0f - 1.0f, cy = random() * 2.0f - 1.0f;
+            float r = random(), g = random(), b = random();
+
+            for (uint32_t v = 0; v < 3; ++v)
+                vertices.push_back(Vertex { cx + (random() - 0.5f) * 0.2f, cy + (random() - 0.5f) * 0.2f, r, g, b, 1.0f });
+        }
+
+        verticesCount = (GLsizei) vertices.size();
+
+        Gl3::Gl3StateCache& state = static_cast < const Gl3::Gl3Driver& >(*driver).stateCache();
+
+        glGenBuffers(1, &vertexBuffer);
+        state.bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+        Gl3::Gl3VertexAttribute position;
+        position.location = 0;
+        position.size = 2;
+        position.stride = sizeof(Vertex);
+        position.buffer = vertexBuffer;
+
+        Gl3::Gl3VertexAttribute color = position;
+        color.location = 1;
+        color.size = 4;
+        color.offset = 2 * sizeof(float);
+
+        layout.attributes = { position, color };
+        vertexArray = state.vertexArray(layout);
+    }
+
+    void onApplicationDidUpdate(RD::Application& application, const RD::Clock::time_point&)
+    {
+        if (!driver.valid() || frame++ >= framesCount)
+        {
+            application.stop();
+            return;
+        }
+
+        auto* glSurface = static_cast < Gl3::Gl3Surface* >(surface.ptr());
+        GLsizei batchSize = verticesCount / kBatches;
+
+        if (queued)
+        {
+            auto start = RD::Clock::now();
+
+            RD::CommandQueue& queue = driver->getCommandQueue();
+            auto buffer = queue.acquire();
+
+            Gl3::RecordClear(*buffer, glSurface, 0.1f, 0.1f, 0.1f, 1.0f);
+
+            for (uint32_t batch = 0; batch < kBatches; ++batch)
+                Gl3::RecordDraw(*buffer, glSurface, program, vertexArray, GL_TRIANGLES, GLint(batch * batchSize),
+                                batch + 1 < kBatches ? batchSize : verticesCount - GLsizei(batch * batchSize));
+
+            queue.submit(std::move(buffer));
+            driver->present();
+            queue.wait();
+
+            elapsed += RD::Clock::now() - start;
+            return;
+        }
+
+        Gl3::Gl3ContextLock lock(static_cast < const Gl3::Gl3Driver& >(*driver));
+
+        auto start = RD::Clock::now();
+
+        Gl3::Gl3StateCache& state = static_cast < const Gl3::Gl3Driver& >(*driver).stateCache();
+
+        glSurface->bind();
+        state.colorMask(true, true, true, true);
+        state.depthMask(true);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        for (uint32_t batch = 0; batch < kBatches; ++batch)
+        {
+            glSurface->bind();
+            state.useProgram(program);
+            state.bindVertexLayout(layout);
+            state.disable(GL_DEPTH_TEST);
+            state.disable(GL_CULL_FACE);
+            state.disable(GL_BLEND);
+            state.blendFunc(GL_ONE, GL_ZERO);
+
+            glDrawArrays(GL_TRIANGLES, GLint(batch * batchSize), batch + 1 < kBatches ? batchSize : verticesCount - GLsizei(batch * batchSize));
+        }
+
+        glFinish();
+
+        elapsed += RD::Clock::now() - start;
+    }
+
+    void onApplicationWillTerminate(RD::Application& application, const RD::Clock::time_point&)
+    {
+        if (!driver.valid())
+            return;
+
+        auto* glSurface = static_cast < Gl3::Gl3Surface* >(surface.ptr());
+        std::vector < uint32_t > pixels;
+        RD::RectSize size = glSurface->readPixels(pixels);
+
+        // FNV-1a of the image, to compare runs.
+        uint64_t hash = 14695981039346656037ull;
+
+        for (uint32_t pixel : pixels)
+            hash = (hash ^ pixel) * 1099511628211ull;
+
+        double ms = std::chrono::duration < double, std::milli >(elapsed).count();
+        std::cout << "Frames: " << framesCount << ", " << (framesCount ? ms / framesCount : 0.0) << " ms/frame" << std::endl;
+        std::cout << "Image: " << size.width << "x" << size.height << ", hash " << std::hex << hash << std::dec << std::endl;
+
+        {
+            Gl3::Gl3ContextLock lock(static_cast < const Gl3::Gl3Driver& >(*driver));
+            Gl3::Gl3StateCache& state = static_cast < const Gl3::Gl3Driver& >(*driver).stateCache();
+
+            const Gl3::Gl3StateCounters& frameCounters = state.frameCounters();
+            const Gl3::Gl3StateCounters& totalCounters = state.totalCounters();
+
+            std::cout << "State calls, last frame: " << frameCounters.issued << " issued, " << frameCounters.elided << " elided" << std::endl;
+            std::cout << "State calls, all frames: " << totalCounters.issued << " issued, " << totalCounters.elided << " elided, "
+                      << totalCounters.vertexArraysCreated << " vertex arrays created" << std::endl;
+
+            if (validate)
+                std::cout << "State mismatches: " << totalCounters.mismatches + state.validate() << std::endl;
+
+            // Deleting the buffer deletes the vertex array object using it.
+            state.deleteBuffer(vertexBuffer);
+            glDeleteProgram(program);
+        }
+
+        surface.reset();
+        driver.reset();
+    }
+};
+
+int main(int argc, const char * argv[])
+{
+    uint32_t frames = argc > 1 ? (uint32_t) std::atoi(argv[1]) : 60;
+    bool validate = false, queue = false;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        validate = validate || std::string(argv[i]) == "validate";
+        queue = queue || std::string(argv[i]) == "queue";
+    }
+
+    try
+    {
+        {
+            RD::Application& application = RD::Application::Get();
+
+            auto appdelegate = RD::CreateHandle < Gl3HeadlessAppDelegate >(frames, validate, queue);
+            application.setDelegate( appdelegate );
+
+            auto glmodule = application.loadModule("../lib/Modules/libGl3Module" RDModuleSuffix);
+            assert(glmodule.valid());
+
+            application.run();
+        }
+
+        RD::Application::Destroy();
+    }
+
+    catch ( RD::Exception const& e )
+    {
+        std::cout << "Exception caught: " << e.what() << std::endl;
+        return e.code();
+    }
+
+    return 0;
+}
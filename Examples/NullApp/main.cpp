@@ -0,0 +1,242 @@
+//
+//  main.cpp
+//  nullapp
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include <RD/Application.h>
+#include <RD/Driver.h>
+#include <NullModule/NullDriver.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <thread>
+
+/*! @brief A command recorded by the worker threads. */
+struct DrawCommand
+{
+    uint32_t surface;
+    uint32_t mesh;
+    uint32_t count;
+};
+
+static constexpr uint32_t kDrawCommand = 1;
+
+/**
+ * @brief Runs the engine headless with a NullDriver: creates surfaces and resources, records commands
+ * from several threads each frame, and prints what the driver received. Device memory has a budget, and
+ * resources are evicted when it is exceeded. A memory pressure is signaled every kPressurePeriod frames,
+ * as the kernel would, and a cache refilled each frame is reclaimed after the driver's retired resources.
+ */
+class NullAppDelegate : public RD::ApplicationDelegate, public RD::DriverObserver
+{
+    //! @brief Handle to our driver.
+    RD::Handle < RD::Driver > driver;
+
+    //! @brief Number of times the budget was exceeded.
+    std::atomic < uint32_t > budgetExceeded { 0 };
+
+    //! @brief Number of resources evicted.
+    std::atomic < uint32_t > evicted { 0 };
+
+    //! @brief Cache refilled each frame, reclaimed under memory pressure.
+    std::vector < char > cache;
+
+    //! @brief Identifier of the cache's reclaimer.
+    uint64_t reclaimerId = 0;
+
+    //! @brief Bytes of the cache reclaimed.
+    std::size_t cacheReclaimed = 0;
+
+    //! @brief Number of frames to run.
+    uint32_t framesCount;
+
+    //! @brief Number of frames run.
+    uint32_t frame = 0;
+
+public:
+
+    static constexpr uint32_t kSurfaces = 4;
+    static constexpr uint32_t kResources = 64;
+    static constexpr uint32_t kThreads = 4;
+    static constexpr uint32_t kCommandsPerThread = 1000;
+    static constexpr uint32_t kResourceSize = 1 << 16;
+    static constexpr uint64_t kDeviceBudget = kResources / 4 * kResourceSize;
+    static constexpr uint32_t kPressurePeriod = 30;
+    static constexpr std::size_t kCacheSize = 1 << 20;
+
+    explicit NullAppDelegate(uint32_t frames) : framesCount(frames) {}
+
+    ~NullAppDelegate() = default;
+
+    void onApplicationDidStart(RD::Application& application, const RD::Clock::time_point& ticks)
+    {
+        auto module = application.findModule("NullModule");
+
+        if (!module.valid())
+            return;
+
+        Null::NullDriverConfiguration nullConfig;
+        nullConfig.surfaceCreationLatency = std::chrono::microseconds(100);
+        nullConfig.updateLatency = std::chrono::microseconds(500);
+
+        RD::DriverConfiguration config;
+        config.extension = &nullConfig;
+
+        driver = module->loadClass < RD::Driver >(&config);
+        std::cout << "Driver name: " << driver->name() << std::endl;
+        std::cout << "Driver version: " << driver->version() << std::endl;
+
+        driver->addListener(this);
+        driver->setMemoryBudget(RD::MemoryKind::Device, kDeviceBudget);
+
+        for (uint32_t i = 0; i < kSurfaces; ++i)
+            driver->createSurface(640, 480, "NullApp", "Surface" + std::to_string(i));
+
+        reclaimerId = RD::MemoryPressureMonitor::Default().addReclaimer("NullApp cache", RD::MemoryReclaimPriority::Cache,
+            [this](){ return cache.capacity(); },
+            [this](RD::MemoryPressureLevel, std::size_t){
+                std::size_t bytes = cache.capacity();
+                std::vector < char >().swap(cache);
+                cacheReclaimed += bytes;
+                return bytes;
+            });
+    }
+
+    void onApplicationDidUpdate(RD::Application& application, const RD::Clock::time_point&)
+    {
+        if (!driver.valid() || frame++ >= framesCount)
+        {
+            application.stop();
+            return;
+        }
+
+        auto* nullDriver = static_cast < Null::NullDriver* >(driver.ptr());
+        cache.resize(kCacheSize);
+
+        // Reclaimers are called at the beginning of the next tick.
+        if (frame % kPressurePeriod == 0)
+            RD::MemoryPressureMonitor::Default().signal(RD::MemoryPressureLevel::Moderate);
+
+        // Resources are created and destroyed in turn, so retirement always has work to do.
+        for (uint32_t i = 0; i < kResources / 8; ++i)
+        {
+            std::string name = "Resource" + std::to_string((frame * (kResources / 8) + i) % kResources);
+            auto resource = nullDriver->createResource(name, kResourceSize);
+
+            if (frame % 2)
+                nullDriver->destroyResource(resource);
+        }
+
+        std::thread threads[kThreads];
+
+        for (uint32_t t = 0; t < kThreads; ++t)
+        {
+            threads[t] = std::thread([this, t](){
+                auto buffer = driver->getCommandQueue().acquire(t);
+
+                for (uint32_t i = 0; i < kCommandsPerThread; ++i)
+                    buffer->record(kDrawCommand, DrawCommand { i % kSurfaces, i, 3 });
+
+                driver->getCommandQueue().submit(std::move(buffer));
+
+                // The same draws, as items sorted by the driver: pipeline and material change at each
+                // draw when submitted, but not once sorted.
+                auto draws = driver->getRenderQueue().acquire();
+
+                for (uint32_t i = 0; i < kCommandsPerThread; ++i)
+                {
+                    uint16_t depth = RD::DrawKey::QuantizeDepth(float(i) / kCommandsPerThread);
+                    draws->push(RD::DrawKey::Make(0, 0, uint16_t(i % 8), uint16_t(i % 32), depth), i);
+                }
+
+                driver->getRenderQueue().submit(std::move(draws));
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        driver->present();
+    }
+
+    void onDriverMemoryBudgetExceeded(RD::Driver* exceeded, RD::MemoryKind kind, uint64_t usage, uint64_t budget)
+    {
+        budgetExceeded++;
+
+        // Evicts resources of this kind until half of the budget is used. Their memory is freed once
+        // they are released, at a later update.
+        std::vector < RD::Handle < RD::DriverResource > > evictions;
+
+        exceeded->forEachResource([&](const RD::HashedString&, const RD::Handle < RD::DriverResource >& resource){
+            if (usage > budget / 2 && resource->memoryKind() == kind && !dynamic_cast < const RD::Surface* >(resource.ptr()))
+            {
+                evictions.push_back(resource);
+                usage -= std::min < uint64_t >(usage, resource->memorySize());
+            }
+        });
+
+        for (auto& resource : evictions)
+            evicted += static_cast < Null::NullDriver* >(exceeded)->destroyResource(resource);
+    }
+
+    void onApplicationWillTerminate(RD::Application& application, const RD::Clock::time_point&)
+    {
+        if (!driver.valid())
+            return;
+
+        driver->getCommandQueue().wait();
+        auto* nullDriver = static_cast < Null::NullDriver* >(driver.ptr());
+
+        std::cout << "Frames executed: " << driver->getCommandQueue().executedFrames() << std::endl;
+
+        for (uint32_t call = 0; call < static_cast < uint32_t >(Null::NullCall::Count); ++call)
+        {
+            Null::NullCall nullCall = static_cast < Null::NullCall >(call);
+            std::cout << Null::NullCallName(nullCall) << ": " << nullDriver->callsCount(nullCall) << std::endl;
+        }
+
+        std::cout << "Command bytes: " << nullDriver->commandBytesCount() << std::endl;
+        std::cout << "Draw items: " << nullDriver->drawItemsCount() << std::endl;
+        std::cout << "State changes: " << nullDriver->stateChangesCount() << std::endl;
+        std::cout << "Device memory: " << driver->memoryUsage(RD::MemoryKind::Device) << " bytes, budget "
+                  << kDeviceBudget << ", exceeded " << budgetExceeded << " times, " << evicted << " resources evicted" << std::endl;
+        std::cout << "Memory pressure: " << framesCount / kPressurePeriod << " signaled, " << cacheReclaimed
+                  << " bytes of cache reclaimed" << std::endl;
+
+        RD::MemoryPressureMonitor::Default().removeReclaimer(reclaimerId);
+        driver->removeListener(this);
+        driver.reset();
+    }
+};
+
+int main(int argc, const char * argv[])
+{
+    uint32_t frames = argc > 1 ? (uint32_t) std::atoi(argv[1]) : 120;
+
+    try
+    {
+        {
+            RD::Application& application = RD::Application::Get();
+
+            auto appdelegate = RD::CreateHandle < NullAppDelegate >(frames);
+            application.setDelegate( appdelegate );
+
+            auto nullmodule = application.loadModule("../lib/Modules/libNullModule" RDModuleSuffix);
+            assert(nullmodule.valid());
+
+            application.run();
+        }
+
+        RD::Application::Destroy();
+    }
+
+    catch ( RD::Exception const& e )
+    {
+        std::cout << "Exception caught: " << e.what() << std::endl;
+        return e.code();
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+//
+//  Gl3EGLDisplay.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Gl3EGLDisplay_h
+#define Gl3EGLDisplay_h
+
+#ifndef Gl3HaveHeadless
+#   error "File 'EGL/Gl3EGLDisplay.h' cannot be included without headless EGL support."
+#endif
+
+#include "Gl3Includes.h"
+
+namespace RD
+{
+    struct DriverConfiguration;
+}
+
+namespace Gl3
+{
+    /*! @brief Returns the EGL display to create a headless context on, not initialized.
+     *
+     * The surfaceless platform (EGL_MESA_platform_surfaceless) is preferred, as it needs neither a window
+     * system nor a GPU: Mesa falls back to llvmpipe. If the client does not support it, the default display
+     * is returned.
+     *
+     * @return The display, or EGL_NO_DISPLAY.
+     */
+    EGLDisplay Gl3EGLGetDisplay();
+    
+    /*! @brief Initializes a display, once for every driver using it.
+     *
+     * EGL displays are shared by the whole process, and eglTerminate destroys every context created on
+     * them. Drivers initialize and terminate their display with these functions, which only terminate it
+     * when its last driver terminates.
+     *
+     * @return True if the display is initialized.
+     */
+    bool Gl3EGLInitialize(EGLDisplay display);
+    
+    /*! @brief Terminates a display initialized with \ref Gl3EGLInitialize, if no other driver uses it. */
+    void Gl3EGLTerminate(EGLDisplay display);
+    
+    /*! @brief Converts the RD::DriverConfiguration structure to EGL config attributes.
+     *
+     * Configs are always OpenGL renderable and support pbuffers, as the context is never bound to a window.
+     * Currently, flags translated are:
+     * - colors: Converts to EGL_RED_SIZE, EGL_GREEN_SIZE, EGL_BLUE_SIZE and EGL_ALPHA_SIZE.
+     * - bpp: Converts to EGL_BUFFER_SIZE if colors is not used.
+     * - multisampling, sampleBuffers, samples, buffers: Ignored, as surfaces are framebuffer objects.
+     *
+     * @return Attributes, terminated by EGL_NONE.
+     */
+    std::vector < EGLint > Gl3EGLConfigAttribs(const RD::DriverConfiguration* configuration);
+    
+    /*! @brief Converts the RD::DriverConfiguration structure to EGL context attributes.
+     *
+     * Requests a core profile context of at least the version in Gl3DriverConfiguration, or 3.2 if the
+     * configuration has no extension.
+     *
+     * @return Attributes, terminated by EGL_NONE.
+     */
+    std::vector < EGLint > Gl3EGLContextAttribs(const RD::DriverConfiguration* configuration);
+    
+    /*! @brief Returns the name of an EGL error code. */
+    const char* Gl3EGLErrorString(EGLint error);
+}
+
+#endif /* Gl3EGLDisplay_h */
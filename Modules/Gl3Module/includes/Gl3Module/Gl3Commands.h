@@ -0,0 +1,80 @@
+//
+//  Gl3Commands.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Gl3Commands_h
+#define Gl3Commands_h
+
+#include "Gl3Includes.h"
+#include <RD/CommandBuffer.h>
+
+namespace Gl3
+{
+    class Gl3Surface;
+    
+    /** @defgroup Gl3Commands
+     * @{
+     */
+    
+    //! @brief Clears the color and the depth of a surface. Payload is a Gl3ClearCommand.
+    static constexpr uint32_t kGl3ClearCommand = 0x476C0001;
+    
+    //! @brief Draws arrays into a surface. Payload is a Gl3DrawCommand.
+    static constexpr uint32_t kGl3DrawCommand = 0x476C0002;
+    
+    /** @} */
+    
+    /*! @brief Payload of kGl3ClearCommand. */
+    struct Gl3ClearCommand
+    {
+        //! @brief Surface cleared, locked until the command is executed.
+        const Gl3Surface* surface;
+        
+        //! @brief Color as RGBA.
+        GLfloat color[4];
+        
+        //! @brief Depth.
+        GLfloat depth;
+    };
+    
+    /*! @brief Payload of kGl3DrawCommand. */
+    struct Gl3DrawCommand
+    {
+        //! @brief Surface drawn into, locked until the command is executed.
+        const Gl3Surface* surface;
+        
+        //! @brief Program used, zero for none.
+        GLuint program;
+        
+        //! @brief Vertex array object bound, see Gl3StateCache::vertexArray.
+        GLuint vertexArray;
+        
+        //! @brief Primitive mode, like GL_TRIANGLES.
+        GLenum mode;
+        
+        //! @brief First vertex drawn.
+        GLint first;
+        
+        //! @brief Number of vertices drawn.
+        GLsizei count;
+    };
+    
+    /*! @brief Records a kGl3ClearCommand.
+     *
+     * The surface is locked (see RD::DriverResource::lock) until the command is executed, so it is not
+     * destroyed meanwhile. A buffer must not be dropped without being executed, or its surfaces would stay
+     * locked.
+     */
+    void RecordClear(RD::CommandBuffer& buffer, const Gl3Surface* surface, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha,
+                     GLfloat depth = 1.0f);
+    
+    /*! @brief Records a kGl3DrawCommand. The program and the vertex array must still exist when the command
+     * is executed. Surface is locked like \ref RecordClear. */
+    void RecordDraw(RD::CommandBuffer& buffer, const Gl3Surface* surface, GLuint program, GLuint vertexArray, GLenum mode,
+                    GLint first, GLsizei count);
+}
+
+#endif /* Gl3Commands_h */
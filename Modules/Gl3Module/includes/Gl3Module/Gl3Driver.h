@@ -9,9 +9,13 @@
 #define Gl3Driver_h
 
 #include "Gl3Includes.h"
+#include "Gl3StateCache.h"
+#include "Gl3Commands.h"
 #include <RD/Driver.h>
 #include <RD/Module.h>
 
+#include <mutex>
+
 namespace Gl3
 {
     /**
@@ -27,11 +31,79 @@ namespace Gl3
         
         //! @brief OpenGL minor version (minimum).
         short minor = 2;
+        
+        //! @brief True to check the state of the context each time Gl3StateCache elides a call. Reads
+        //! the state from OpenGL, which stalls the pipeline: for debugging only.
+        bool validateState = false;
     };
     
     /** @brief Thrown when given Module does not correspond to the driver's module. */
     RDDefineException(Gl3InvalidModuleException, 1 << 1);
     
+    class Gl3Driver;
+    
+    /**
+     * @brief Makes the context of a Gl3Driver current on the calling thread, for the lifetime of the lock.
+     *
+     * The context can only be current on one thread at a time: locks are serialized by the driver, and
+     * restore the context that was current before them when destroyed. Locks can be nested on the same
+     * thread. OpenGL functions must only be called while a lock is held.
+     *
+     * @code
+     * Gl3::Gl3ContextLock lock(driver);
+     * surface->bind();
+     * glDrawArrays(GL_TRIANGLES, 0, count);
+     * @endcode
+     */
+    class Gl3ContextLock
+    {
+        //! @brief Driver whose context is current.
+        const Gl3Driver& driver;
+        
+        //! @brief Lock on the driver's context mutex.
+        std::unique_lock < std::recursive_mutex > lock;
+        
+#       ifdef Gl3HaveCocoa
+        //! @brief Context current before this lock.
+        CGLContextObj previousContext;
+        
+#       elif defined(Gl3HaveHeadless)
+        //! @brief Context current before this lock.
+        EGLContext previousContext;
+        
+        //! @brief Display of previousContext.
+        EGLDisplay previousDisplay;
+        
+        //! @brief Draw surface of previousContext.
+        EGLSurface previousDraw;
+        
+        //! @brief Read surface of previousContext.
+        EGLSurface previousRead;
+        
+#       endif
+        
+        //! @brief True if the driver's context was made current by this lock.
+        bool made;
+        
+        //! @brief True if the driver's context is current.
+        bool current;
+        
+    public:
+        
+        /*! @brief Locks the driver's context and makes it current. See \ref valid. */
+        explicit Gl3ContextLock(const Gl3Driver& driver);
+        
+        /*! @brief Restores the previous context and unlocks. */
+        ~Gl3ContextLock();
+        
+        Gl3ContextLock(const Gl3ContextLock&) = delete;
+        Gl3ContextLock& operator = (const Gl3ContextLock&) = delete;
+        
+        /*! @brief Returns true if the driver's context is current, false if the driver has no context
+         * anymore (it was terminated) or it could not be made current. */
+        bool valid() const noexcept { return current; }
+    };
+    
     /**
      * @brief OpenGL implementation of RD::Driver.
      *
@@ -43,6 +115,22 @@ namespace Gl3
      * destroys every objects it has created. Thus, it is assumed all objects created by this driver are owned
      * by itself. To destroy manually a driver owned object, call either DriverResource::destroy() or
      * Driver::destroy(object).
+     *
+     * The state of the context is mirrored by a Gl3StateCache (see \ref stateCache), which filters out
+     * redundant state calls and caches vertex array objects. Its counters are those of the last module
+     * update. Gl3Surface binds its framebuffer through it.
+     *
+     * OpenGL is called directly under a Gl3ContextLock, or through the CommandQueue: commands recorded with
+     * \ref RecordClear and \ref RecordDraw are executed by the queue's thread, which holds a Gl3ContextLock
+     * meanwhile. Draws of the RenderQueue and unknown commands are dropped, and notified with
+     * Gl3UnsupportedCommandNotification.
+     *
+     * ### Platform Linux (headless)
+     * When the module is built with the CMake option 'Gl3Headless', the context is created with EGL on a
+     * surfaceless display (EGL_MESA_platform_surfaceless), falling back to the default display, and is
+     * never bound to a window. Without a GPU, Mesa renders with llvmpipe. Surfaces are offscreen
+     * framebuffer objects read back with Gl3Surface::readPixels. Any thread can call OpenGL functions
+     * while it holds a Gl3ContextLock.
      */
     class Gl3Driver : public RD::Driver
     {
@@ -63,8 +151,27 @@ namespace Gl3
         //! @brief CGL PixelFormat for the context.
         CGLPixelFormatObj glPixelFormat;
         
+#       elif defined(Gl3HaveHeadless)
+        //! @brief EGL display, initialized.
+        EGLDisplay glDisplay;
+        
+        //! @brief EGL config of the context.
+        EGLConfig glConfig;
+        
+        //! @brief EGL context, never bound to a surface.
+        EGLContext glContext;
+        
 #       endif
         
+        // Makes it a friend to let it make our context current.
+        friend class Gl3ContextLock;
+        
+        //! @brief Mutex serializing the threads using our context.
+        mutable std::recursive_mutex contextMutex;
+        
+        //! @brief State of our context, used while contextMutex is locked.
+        mutable Gl3StateCache glState;
+        
     public:
         
         /*! @brief Default constructor. */
@@ -91,6 +198,39 @@ namespace Gl3
         
         /*! @brief Returns true if the driver was successfully initialized. */
         bool valid() const;
+        
+        /*! @brief Ends the frame of the state cache, then releases retired resources. */
+        void onModuleDidUpdate(RD::Module* mod);
+        
+        /*! @brief Returns the state cache of the context. Must only be used while holding a Gl3ContextLock. */
+        Gl3StateCache& stateCache() const;
+        
+    protected:
+        
+        /*! @brief Executes a kGl3ClearCommand or a kGl3DrawCommand under a Gl3ContextLock, then unlocks its
+         * surface. Skips the command if the context or the surface is gone. Drops and notifies other commands. */
+        void executeCommand(const RD::CommandHeader& header, const void* payload);
+        
+        /*! @brief Drops the draws: DrawItem::data has no meaning for Gl3Driver. */
+        void executeDrawItems(const RD::DrawItem* items, std::size_t count);
+        
+        /*! @brief Replaces the surface of a kGl3ClearCommand or a kGl3DrawCommand by the surface
+         * replaying it, and locks it like recording the command does. Skips the command if the surface was
+         * not replayed. The program and the vertex array are kept as captured. */
+        bool relocateCommand(const RD::CommandHeader& header, void* payload, const RD::CaptureRelocator& relocator);
+        
+#       if defined(Gl3HaveHeadless)
+    protected:
+        
+        /*! @brief Creates an offscreen Gl3Surface. */
+        RD::Handle < RD::Surface > _createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const;
+        
+    private:
+        
+        /*! @brief Destroys the context and terminates the display, once. Waits for the current lock. */
+        void destroyContext();
+        
+#       endif
     };
 }
 
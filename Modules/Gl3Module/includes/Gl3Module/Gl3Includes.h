@@ -27,4 +27,17 @@
 #
 #endif
 
+#ifdef Gl3HaveEGL
+#   include <EGL/egl.h>
+#   include <EGL/eglext.h>
+#
+#   ifndef GL_GLEXT_PROTOTYPES
+#       define GL_GLEXT_PROTOTYPES
+#   endif
+#   include <GL/glcorearb.h>
+#
+#   define Gl3ContextHandle EGLContext
+#
+#endif
+
 #include <RD/Global.h>
@@ -51,6 +51,9 @@ namespace Gl3
          * If an instance of NSApplication is already available, then a custom delegate
          * is added but NSApplication::updateWindows is never called.
          *
+         * @Platform Linux (headless)
+         * Nothing to start: the EGL display is initialized by each Gl3Driver.
+         *
          * @param[in] application Application that launched this module.
          * @param[in] ticks Clock::time_point when this function is called.
          *
@@ -65,6 +68,9 @@ namespace Gl3
          * is running too. This function calls NSApplication::updateWindows, and poll for the
          * next event in the main event queue.
          *
+         * @Platform Linux (headless)
+         * There is no event to poll: listeners are notified only.
+         *
          * @param[in] application Application that launched this module.
          * @param[in] ticks Clock::time_point when this function is called.
          *
@@ -0,0 +1,377 @@
+//
+//  Gl3StateCache.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef Gl3StateCache_h
+#define Gl3StateCache_h
+
+#include "Gl3Includes.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace Gl3
+{
+    /**
+     * @brief A vertex attribute of a Gl3VertexLayout, as given to glVertexAttribPointer.
+     */
+    struct Gl3VertexAttribute
+    {
+        //! @brief Attribute location.
+        GLuint location = 0;
+        
+        //! @brief Number of components, 1 to 4.
+        GLint size = 4;
+        
+        //! @brief Type of the components, like GL_FLOAT.
+        GLenum type = GL_FLOAT;
+        
+        //! @brief True to normalize integer components.
+        GLboolean normalized = GL_FALSE;
+        
+        //! @brief True for an integer attribute (glVertexAttribIPointer).
+        GLboolean integer = GL_FALSE;
+        
+        //! @brief Bytes between two vertices.
+        GLsizei stride = 0;
+        
+        //! @brief Offset of the first component in buffer.
+        std::size_t offset = 0;
+        
+        //! @brief Buffer the attribute is read from.
+        GLuint buffer = 0;
+        
+        bool operator == (const Gl3VertexAttribute& rhs) const noexcept
+        {
+            return location == rhs.location && size == rhs.size && type == rhs.type && normalized == rhs.normalized
+                && integer == rhs.integer && stride == rhs.stride && offset == rhs.offset && buffer == rhs.buffer;
+        }
+    };
+    
+    /**
+     * @brief Vertex attributes and element buffer of a draw: the state of a vertex array object.
+     */
+    struct Gl3VertexLayout
+    {
+        //! @brief Attributes enabled.
+        std::vector < Gl3VertexAttribute > attributes;
+        
+        //! @brief Element buffer, or zero.
+        GLuint elementBuffer = 0;
+        
+        bool operator == (const Gl3VertexLayout& rhs) const noexcept
+        {
+            return elementBuffer == rhs.elementBuffer && attributes == rhs.attributes;
+        }
+    };
+    
+    /*! @brief Hashes a Gl3VertexLayout. */
+    struct Gl3VertexLayoutHash
+    {
+        std::size_t operator()(const Gl3VertexLayout& layout) const noexcept;
+    };
+    
+    /**
+     * @brief Counters of a Gl3StateCache.
+     */
+    struct Gl3StateCounters
+    {
+        //! @brief State calls passed to OpenGL.
+        std::uint64_t issued = 0;
+        
+        //! @brief State calls filtered out, because the state already had the value.
+        std::uint64_t elided = 0;
+        
+        //! @brief Vertex array objects created by Gl3StateCache::vertexArray.
+        std::uint64_t vertexArraysCreated = 0;
+        
+        //! @brief Vertex array objects found in the cache by Gl3StateCache::vertexArray.
+        std::uint64_t vertexArraysReused = 0;
+        
+        //! @brief States which differed from OpenGL's when validated.
+        std::uint64_t mismatches = 0;
+    };
+    
+    /**
+     * @brief Mirrors the state of a Gl3Driver's context, and filters out the calls which would not change it.
+     *
+     * Draw code binds programs, buffers and textures, and sets the blend, depth and rasterizer states
+     * through the cache instead of calling OpenGL: a call is only passed to OpenGL when the value differs
+     * from the one the cache last set. States are unknown until the cache sets them, and after
+     * \ref invalidate, which must be called when code changed the context's state without the cache.
+     * Objects bound through the cache must be deleted through it, as deleting a bound object unbinds it.
+     *
+     * \ref vertexArray returns a vertex array object for a Gl3VertexLayout, created once: binding it is
+     * one call, where setting the layout again is one per attribute.
+     *
+     * The cache counts the calls issued and elided: \ref frameCounters returns those of the last frame,
+     * ended by \ref endFrame, which Gl3Driver calls at each module update. With validation enabled (see
+     * Gl3DriverConfiguration::validateState), every elided call first reads the state from OpenGL, and
+     * a state which differs is notified with Gl3StateMismatchNotification, then set. \ref validate checks
+     * every known state at once.
+     *
+     * Like OpenGL, the cache is not thread safe: it must only be used while holding a Gl3ContextLock on
+     * its driver.
+     */
+    class Gl3StateCache
+    {
+    public:
+        
+        //! @brief Texture units whose bindings are mirrored. Bindings of other units are always issued.
+        static constexpr GLuint kTextureUnits = 16;
+        
+        //! @brief Texture targets whose bindings are mirrored.
+        static constexpr std::size_t kTextureTargets = 6;
+        
+        //! @brief Buffer targets whose bindings are mirrored. GL_ELEMENT_ARRAY_BUFFER is not: it belongs to
+        //! the vertex array object bound, and its bindings are always issued.
+        static constexpr std::size_t kBufferTargets = 7;
+        
+        //! @brief Capabilities whose state is mirrored.
+        static constexpr std::size_t kCapabilities = 9;
+    
+    private:
+        
+        /*! @brief A state of the context, as last set by the cache. */
+        template < typename T >
+        struct Shadow
+        {
+            //! @brief Value set.
+            T value {};
+            
+            //! @brief False until the cache sets the state.
+            bool known = false;
+        };
+        
+        //! @brief Program in use.
+        Shadow < GLuint > program;
+        
+        //! @brief Vertex array object bound.
+        Shadow < GLuint > vertexArrayBinding;
+        
+        //! @brief Buffers bound, by target index.
+        std::array < Shadow < GLuint >, kBufferTargets > buffers;
+        
+        //! @brief Draw and read framebuffers bound.
+        Shadow < GLuint > drawFramebuffer, readFramebuffer;
+        
+        //! @brief Active texture unit, as an offset from GL_TEXTURE0.
+        Shadow < GLuint > activeUnit;
+        
+        //! @brief Textures bound, by unit and target index.
+        std::array < std::array < Shadow < GLuint >, kTextureTargets >, kTextureUnits > textures;
+        
+        //! @brief Capabilities enabled, by index.
+        std::array < Shadow < bool >, kCapabilities > capabilities;
+        
+        //! @brief Blend functions: source RGB, destination RGB, source alpha, destination alpha.
+        Shadow < std::array < GLenum, 4 > > blendFunctions;
+        
+        //! @brief Blend equations: RGB, then alpha.
+        Shadow < std::array < GLenum, 2 > > blendEquations;
+        
+        //! @brief Depth function.
+        Shadow < GLenum > depthFunction;
+        
+        //! @brief Depth write mask.
+        Shadow < bool > depthWrite;
+        
+        //! @brief Face culled.
+        Shadow < GLenum > cullMode;
+        
+        //! @brief Front face winding.
+        Shadow < GLenum > frontFaceMode;
+        
+        //! @brief Color write mask.
+        Shadow < std::array < bool, 4 > > colorWrite;
+        
+        //! @brief Viewport: x, y, width, height.
+        Shadow < std::array < GLint, 4 > > viewportBox;
+        
+        //! @brief Scissor box: x, y, width, height.
+        Shadow < std::array < GLint, 4 > > scissorBox;
+        
+        //! @brief Vertex array objects, by layout.
+        std::unordered_map < Gl3VertexLayout, GLuint, Gl3VertexLayoutHash > vertexArrays;
+        
+        //! @brief Counters of the current frame.
+        Gl3StateCounters current;
+        
+        //! @brief Counters of the last frame ended.
+        Gl3StateCounters last;
+        
+        //! @brief Counters since construction, current frame excluded.
+        Gl3StateCounters total;
+        
+        //! @brief True to check the state elided calls rely on.
+        bool validating = false;
+    
+    public:
+        
+        /*! @brief Constructs a cache where every state is unknown. Does not call OpenGL. */
+        Gl3StateCache() = default;
+        
+        Gl3StateCache(const Gl3StateCache&) = delete;
+        Gl3StateCache& operator = (const Gl3StateCache&) = delete;
+        
+        /*! @brief glUseProgram. */
+        void useProgram(GLuint name);
+        
+        /*! @brief glBindVertexArray. */
+        void bindVertexArray(GLuint name);
+        
+        /*! @brief glBindBuffer. */
+        void bindBuffer(GLenum target, GLuint name);
+        
+        /*! @brief glBindFramebuffer. GL_FRAMEBUFFER binds both the draw and read framebuffers. */
+        void bindFramebuffer(GLenum target, GLuint name);
+        
+        /*! @brief glActiveTexture, with unit an offset from GL_TEXTURE0. */
+        void activeTexture(GLuint unit);
+        
+        /*! @brief glBindTexture on a unit: activates the unit only if the binding changes. */
+        void bindTexture(GLuint unit, GLenum target, GLuint name);
+        
+        /*! @brief glEnable or glDisable. */
+        void setCapability(GLenum capability, bool enabled);
+        
+        /*! @brief glEnable. */
+        void enable(GLenum capability) { setCapability(capability, true); }
+        
+        /*! @brief glDisable. */
+        void disable(GLenum capability) { setCapability(capability, false); }
+        
+        /*! @brief glBlendFunc. */
+        void blendFunc(GLenum source, GLenum destination) { blendFuncSeparate(source, destination, source, destination); }
+        
+        /*! @brief glBlendFuncSeparate. */
+        void blendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha);
+        
+        /*! @brief glBlendEquation. */
+        void blendEquation(GLenum mode) { blendEquationSeparate(mode, mode); }
+        
+        /*! @brief glBlendEquationSeparate. */
+        void blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+        
+        /*! @brief glDepthFunc. */
+        void depthFunc(GLenum function);
+        
+        /*! @brief glDepthMask. */
+        void depthMask(bool write);
+        
+        /*! @brief glCullFace. */
+        void cullFace(GLenum mode);
+        
+        /*! @brief glFrontFace. */
+        void frontFace(GLenum mode);
+        
+        /*! @brief glColorMask. */
+        void colorMask(bool red, bool green, bool blue, bool alpha);
+        
+        /*! @brief glViewport. */
+        void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+        
+        /*! @brief glScissor. */
+        void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+        
+        /*! @brief Returns the vertex array object of a layout, created and set up the first time.
+         *
+         * Creating one binds it and the layout's buffers. Buffers of the layout must be deleted with
+         * \ref deleteBuffer, which deletes the vertex array objects using them.
+         */
+        GLuint vertexArray(const Gl3VertexLayout& layout);
+        
+        /*! @brief Binds the vertex array object of a layout. */
+        void bindVertexLayout(const Gl3VertexLayout& layout) { bindVertexArray(vertexArray(layout)); }
+        
+        /*! @brief glDeleteBuffers. Bindings to the buffer become zero, and the vertex array objects using
+         * it are deleted. */
+        void deleteBuffer(GLuint name);
+        
+        /*! @brief glDeleteTextures. Bindings to the texture become zero. */
+        void deleteTexture(GLuint name);
+        
+        /*! @brief glDeleteFramebuffers. Bindings to the framebuffer become zero. */
+        void deleteFramebuffer(GLuint name);
+        
+        /*! @brief Marks every state as unknown: the next call setting each of them is issued. Vertex array
+         * objects are kept. */
+        void invalidate();
+        
+        /*! @brief Deletes every vertex array object, and marks every state as unknown. */
+        void clear();
+        
+        /*! @brief Reads every known state from OpenGL, notifies Gl3StateMismatchNotification for each state
+         * which differs, and mirrors OpenGL's value.
+         * @return The number of states which differed.
+         */
+        std::size_t validate();
+        
+        /*! @brief Enables or disables validation of elided calls. Disabled by default: it reads the state
+         * from OpenGL, which stalls the pipeline. */
+        void setValidation(bool enabled) noexcept { validating = enabled; }
+        
+        /*! @brief Returns true if elided calls are validated. */
+        bool validation() const noexcept { return validating; }
+        
+        /*! @brief Ends the current frame: its counters become \ref frameCounters. Does not call OpenGL. */
+        void endFrame() noexcept;
+        
+        /*! @brief Returns the counters of the last frame ended. */
+        const Gl3StateCounters& frameCounters() const noexcept { return last; }
+        
+        /*! @brief Returns the counters of the frame in progress. */
+        const Gl3StateCounters& currentCounters() const noexcept { return current; }
+        
+        /*! @brief Returns the counters of every frame ended. */
+        const Gl3StateCounters& totalCounters() const noexcept { return total; }
+        
+        /*! @brief Returns the number of vertex array objects cached. */
+        std::size_t vertexArraysCount() const noexcept { return vertexArrays.size(); }
+    
+    private:
+        
+        /*! @brief Returns true, and counts an elided call, if state already has value. Otherwise, mirrors
+         * value and counts an issued call.
+         *
+         * When validating, a call about to be elided first reads the state with query: if OpenGL has
+         * another value, the mismatch is notified and the call is issued.
+         */
+        template < typename T, typename Query >
+        bool elide(Shadow < T >& state, const T& value, const char* name, Query&& query)
+        {
+            if (state.known && state.value == value && (!validating || matches(state, query(), name)))
+            {
+                current.elided++;
+                return true;
+            }
+            
+            state.value = value;
+            state.known = true;
+            current.issued++;
+            return false;
+        }
+        
+        /*! @brief Returns true if a known state has the value read from OpenGL. Otherwise, notifies the
+         * mismatch, counts it, and mirrors the value read. */
+        template < typename T >
+        bool matches(Shadow < T >& state, const T& real, const char* name)
+        {
+            if (!state.known || state.value == real)
+                return true;
+            
+            mismatch(name);
+            state.value = real;
+            return false;
+        }
+        
+        /*! @brief Counts and notifies a mismatch. */
+        void mismatch(const char* name);
+    };
+}
+
+#endif /* Gl3StateCache_h */
@@ -11,6 +11,8 @@
 #include "Gl3Includes.h"
 #include <RD/Surface.h>
 
+#include <vector>
+
 namespace Gl3
 {
     /**
@@ -27,6 +29,12 @@ namespace Gl3
      * @note
      * Keys events are received by this view only if the window has focus and is the key window.
      *
+     * ### Platform Linux (headless)
+     * The surface is an offscreen framebuffer object of the driver's context, with a RGBA8 color buffer and
+     * a 24 bits depth and 8 bits stencil buffer. It is neither a window nor a view: \ref bind makes it the
+     * target of OpenGL draw calls, and \ref readPixels reads it back. Its buffers are deleted by \ref close,
+     * which is called when the driver clears its resources.
+     *
      * ### Platform X11
      * Not implemented yet.
      *
@@ -51,6 +59,28 @@ namespace Gl3
         //! @brief Our parent window, if we have one (a NSView always have a parent window, isn't it ?).
         Gl3ID glWindow;
         
+#       elif defined(Gl3HaveHeadless)
+        //! @brief Framebuffer object.
+        GLuint glFramebuffer = 0;
+        
+        //! @brief Color renderbuffer, RGBA8.
+        GLuint glColorbuffer = 0;
+        
+        //! @brief Depth and stencil renderbuffer.
+        GLuint glDepthbuffer = 0;
+        
+        //! @brief Size, as width in the high 32 bits and height in the low ones.
+        std::atomic < std::uint64_t > packedSize { 0 };
+        
+        //! @brief Position, as x in the high 32 bits and y in the low ones.
+        std::atomic < std::uint64_t > packedPosition { 0 };
+        
+        //! @brief True if the surface is hidden.
+        std::atomic < bool > hidden { true };
+        
+        //! @brief True once the surface is closed.
+        std::atomic < bool > isClosed { false };
+        
 #       endif
         
     public:
@@ -71,6 +101,69 @@ namespace Gl3
         
         /*! @brief Default destructor. */
         ~Gl3Surface() = default;
+        
+#       if defined(Gl3HaveHeadless)
+        /*! @brief Returns false. */
+        bool isWindow() const;
+        
+        /*! @brief Returns false. */
+        bool isView() const;
+        
+        /*! @brief Marks the surface as visible. */
+        void show();
+        
+        /*! @brief Changes the position and notifies observers. */
+        void move(uint32_t x, uint32_t y);
+        
+        /*! @brief Reallocates the buffers, undefined, and notifies observers. */
+        void resize(uint32_t width, uint32_t height);
+        
+        /*! @brief Returns the last position set. */
+        RD::ScreenPosition position() const;
+        
+        /*! @brief Returns the size of the buffers. */
+        RD::RectSize size() const;
+        
+        /*! @brief Notifies observers the surface has focus. */
+        void lockFocus();
+        
+        /*! @brief Deletes the buffers and notifies observers, once. */
+        void close();
+        
+        /*! @brief Marks the surface as hidden and notifies observers. */
+        void hide();
+        
+        /*! @brief Marks the surface as visible and notifies observers. */
+        void unhide();
+        
+        /*! @brief Returns true if surface is closed. */
+        bool closed() const;
+        
+        /*! @brief Binds the framebuffer object for drawing and reading, and sets the viewport to its size,
+         * through the driver's Gl3StateCache.
+         * A Gl3ContextLock on the driver must be held. */
+        void bind() const;
+        
+        /*! @brief Returns the framebuffer object, or zero if the surface is closed. */
+        GLuint framebuffer() const;
+        
+        /*! @brief Copies the colors of the color buffer, as RGBA8 row by row from the top. Waits for the
+         * OpenGL commands drawing into it.
+         * @return The size of the buffer, or an empty size if the surface is closed.
+         */
+        RD::RectSize readPixels(std::vector < uint32_t >& pixels) const;
+        
+        /*! @brief Returns the memory held by the buffers. */
+        std::size_t memorySize() const;
+        
+    private:
+        
+        /*! @brief Allocates the renderbuffers with the given size. The context must be current.
+         * @return True if the framebuffer is complete.
+         */
+        bool allocate(uint32_t width, uint32_t height);
+        
+#       endif
     };
 }
 
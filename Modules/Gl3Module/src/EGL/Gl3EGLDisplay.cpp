@@ -0,0 +1,153 @@
+//
+//  Gl3EGLDisplay.cpp
+//  Gl3Module
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "EGL/Gl3EGLDisplay.h"
+#include "Gl3Driver.h"
+
+#include <map>
+
+namespace Gl3
+{
+    //! @brief Number of drivers using each initialized display.
+    static std::map < EGLDisplay, std::size_t > Gl3EGLDisplayReferences;
+    
+    //! @brief Mutex protecting Gl3EGLDisplayReferences.
+    static std::mutex Gl3EGLDisplayMutex;
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    EGLDisplay Gl3EGLGetDisplay()
+    {
+        // Client extensions are queried without display. EGL 1.4 implementations without
+        // EGL_EXT_client_extensions return NULL and raise an error, which is not one for us.
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        
+        if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless"))
+        {
+            auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+            
+            if (getPlatformDisplay)
+            {
+                EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                
+                if (display != EGL_NO_DISPLAY)
+                    return display;
+            }
+        }
+        
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Gl3EGLInitialize(EGLDisplay display)
+    {
+        std::lock_guard < std::mutex > lock(Gl3EGLDisplayMutex);
+        std::size_t& references = Gl3EGLDisplayReferences[display];
+        
+        if (!references && !eglInitialize(display, nullptr, nullptr))
+        {
+            Gl3EGLDisplayReferences.erase(display);
+            return false;
+        }
+        
+        references++;
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3EGLTerminate(EGLDisplay display)
+    {
+        std::lock_guard < std::mutex > lock(Gl3EGLDisplayMutex);
+        auto it = Gl3EGLDisplayReferences.find(display);
+        
+        if (it == Gl3EGLDisplayReferences.end() || --(it->second))
+            return;
+        
+        Gl3EGLDisplayReferences.erase(it);
+        eglTerminate(display);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::vector < EGLint > Gl3EGLConfigAttribs(const RD::DriverConfiguration* configuration)
+    {
+        std::vector < EGLint > result;
+        result.push_back(EGL_SURFACE_TYPE);
+        result.push_back(EGL_PBUFFER_BIT);
+        result.push_back(EGL_RENDERABLE_TYPE);
+        result.push_back(EGL_OPENGL_BIT);
+        
+        if (configuration)
+        {
+            const auto& colors = configuration->colors;
+            
+            if (colors.red || colors.green || colors.blue || colors.alpha)
+            {
+                result.push_back(EGL_RED_SIZE);
+                result.push_back(colors.red);
+                result.push_back(EGL_GREEN_SIZE);
+                result.push_back(colors.green);
+                result.push_back(EGL_BLUE_SIZE);
+                result.push_back(colors.blue);
+                result.push_back(EGL_ALPHA_SIZE);
+                result.push_back(colors.alpha);
+            }
+            
+            else if (configuration->bpp)
+            {
+                result.push_back(EGL_BUFFER_SIZE);
+                result.push_back(configuration->bpp);
+            }
+        }
+        
+        result.push_back(EGL_NONE);
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::vector < EGLint > Gl3EGLContextAttribs(const RD::DriverConfiguration* configuration)
+    {
+        EGLint major = 3;
+        EGLint minor = 2;
+        
+        if (configuration && configuration->extension)
+        {
+            auto ext = (Gl3DriverConfiguration*)configuration->extension;
+            major = ext->major;
+            minor = ext->minor;
+        }
+        
+        return {
+            EGL_CONTEXT_MAJOR_VERSION, major,
+            EGL_CONTEXT_MINOR_VERSION, minor,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const char* Gl3EGLErrorString(EGLint error)
+    {
+        switch (error)
+        {
+            case EGL_SUCCESS:               return "EGL_SUCCESS";
+            case EGL_NOT_INITIALIZED:       return "EGL_NOT_INITIALIZED";
+            case EGL_BAD_ACCESS:            return "EGL_BAD_ACCESS";
+            case EGL_BAD_ALLOC:             return "EGL_BAD_ALLOC";
+            case EGL_BAD_ATTRIBUTE:         return "EGL_BAD_ATTRIBUTE";
+            case EGL_BAD_CONFIG:            return "EGL_BAD_CONFIG";
+            case EGL_BAD_CONTEXT:           return "EGL_BAD_CONTEXT";
+            case EGL_BAD_CURRENT_SURFACE:   return "EGL_BAD_CURRENT_SURFACE";
+            case EGL_BAD_DISPLAY:           return "EGL_BAD_DISPLAY";
+            case EGL_BAD_MATCH:             return "EGL_BAD_MATCH";
+            case EGL_BAD_NATIVE_PIXMAP:     return "EGL_BAD_NATIVE_PIXMAP";
+            case EGL_BAD_NATIVE_WINDOW:     return "EGL_BAD_NATIVE_WINDOW";
+            case EGL_BAD_PARAMETER:         return "EGL_BAD_PARAMETER";
+            case EGL_BAD_SURFACE:           return "EGL_BAD_SURFACE";
+            case EGL_CONTEXT_LOST:          return "EGL_CONTEXT_LOST";
+            default:                        return "Unknown EGL error";
+        }
+    }
+}
@@ -0,0 +1,238 @@
+//
+//  Gl3EGLSurface.cpp
+//  Gl3Module
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "Gl3Surface.h"
+#include "Gl3Driver.h"
+#include <RD/NotificationCenter.h>
+
+#include <algorithm>
+
+namespace Gl3
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    Gl3Surface::Gl3Surface(RD::Driver* driver, uint32_t width, uint32_t height, const std::string& title, const std::string& objectName,
+                           uint32_t style, const void* extension) : RD::Surface(driver, width, height, title, objectName, style, extension)
+    {
+        Gl3ContextLock lock(*static_cast < const Gl3Driver* >(driver));
+        
+        if (!lock.valid())
+        {
+            RD::NotifiateAbort("Gl3Module", "Gl3Surface::Gl3Surface", "Gl3InvalidContextNotification",
+                               RDFormatString("Null OpenGL context to create surface %s."), objectName.data());
+            return;
+        }
+        
+        glGenFramebuffers(1, &glFramebuffer);
+        glGenRenderbuffers(1, &glColorbuffer);
+        glGenRenderbuffers(1, &glDepthbuffer);
+        
+        if (!allocate(width, height))
+        {
+            RD::NotifiateAbort("Gl3Module", "Gl3Surface::Gl3Surface", "Gl3IncompleteFramebufferNotification",
+                               RDFormatString("Framebuffer of surface %s is incomplete (%ux%u)."), objectName.data(), width, height);
+        }
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Gl3Surface::isWindow() const
+    {
+        return false;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Gl3Surface::isView() const
+    {
+        return false;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::show()
+    {
+        hidden.store(false);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::move(uint32_t x, uint32_t y)
+    {
+        packedPosition.store((std::uint64_t(x) << 32) | y);
+        
+        RD::ScreenPosition newPosition;
+        newPosition.x = x;
+        newPosition.y = y;
+        emitDidMove(newPosition);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::resize(uint32_t width, uint32_t height)
+    {
+        {
+            Gl3ContextLock lock(*static_cast < const Gl3Driver* >(driver()));
+            
+            if (!lock.valid() || closed())
+                return;
+            
+            allocate(width, height);
+        }
+        
+        RD::RectSize newSize;
+        newSize.width = width;
+        newSize.height = height;
+        emitDidResize(newSize);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::ScreenPosition Gl3Surface::position() const
+    {
+        std::uint64_t packed = packedPosition.load();
+        
+        RD::ScreenPosition result;
+        result.x = uint32_t(packed >> 32);
+        result.y = uint32_t(packed);
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::RectSize Gl3Surface::size() const
+    {
+        std::uint64_t packed = packedSize.load();
+        
+        RD::RectSize result;
+        result.width = uint32_t(packed >> 32);
+        result.height = uint32_t(packed);
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::lockFocus()
+    {
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceLockFocus, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::close()
+    {
+        if (isClosed.exchange(true))
+            return;
+        
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceWillClose, static_cast < const RD::Surface* >(this));
+        
+        // If the driver has no context anymore, our buffers were destroyed with it.
+        Gl3ContextLock lock(*static_cast < const Gl3Driver* >(driver()));
+        
+        if (lock.valid())
+        {
+            static_cast < const Gl3Driver* >(driver())->stateCache().deleteFramebuffer(glFramebuffer);
+            glDeleteRenderbuffers(1, &glColorbuffer);
+            glDeleteRenderbuffers(1, &glDepthbuffer);
+        }
+        
+        glFramebuffer = 0;
+        glColorbuffer = 0;
+        glDepthbuffer = 0;
+        packedSize.store(0);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::hide()
+    {
+        hidden.store(true);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceWillHide, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::unhide()
+    {
+        hidden.store(false);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceUnhide, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Gl3Surface::closed() const
+    {
+        return isClosed.load();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Surface::bind() const
+    {
+        RD::RectSize current = size();
+        
+        Gl3StateCache& state = static_cast < const Gl3Driver* >(driver())->stateCache();
+        
+        state.bindFramebuffer(GL_FRAMEBUFFER, glFramebuffer);
+        state.viewport(0, 0, (GLsizei) current.width, (GLsizei) current.height);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    GLuint Gl3Surface::framebuffer() const
+    {
+        return glFramebuffer;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::RectSize Gl3Surface::readPixels(std::vector < uint32_t >& pixels) const
+    {
+        Gl3ContextLock lock(*static_cast < const Gl3Driver* >(driver()));
+        
+        if (!lock.valid() || closed())
+        {
+            pixels.clear();
+            return RD::RectSize();
+        }
+        
+        RD::RectSize current = size();
+        pixels.resize(std::size_t(current.width) * current.height);
+        
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, glFramebuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, (GLsizei) current.width, (GLsizei) current.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint) previousFramebuffer);
+        
+        // OpenGL rows start from the bottom.
+        for (uint32_t y = 0; y < current.height / 2; ++y)
+        {
+            auto top = pixels.begin() + std::size_t(y) * current.width;
+            auto bottom = pixels.begin() + std::size_t(current.height - 1 - y) * current.width;
+            std::swap_ranges(top, top + current.width, bottom);
+        }
+        
+        return current;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Gl3Surface::memorySize() const
+    {
+        RD::RectSize current = size();
+        return std::size_t(current.width) * current.height * 8;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Gl3Surface::allocate(uint32_t width, uint32_t height)
+    {
+        glBindRenderbuffer(GL_RENDERBUFFER, glColorbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, (GLsizei) width, (GLsizei) height);
+        glBindRenderbuffer(GL_RENDERBUFFER, glDepthbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, (GLsizei) width, (GLsizei) height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, glFramebuffer);
+        glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, glColorbuffer);
+        glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, glDepthbuffer);
+        
+        GLenum status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint) previousFramebuffer);
+        
+        packedSize.store((std::uint64_t(width) << 32) | height);
+        return status == GL_FRAMEBUFFER_COMPLETE;
+    }
+}
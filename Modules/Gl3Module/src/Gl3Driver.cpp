@@ -6,17 +6,93 @@
 //
 
 #include "Gl3Driver.h"
+#include "Gl3Surface.h"
 #include <RD/NotificationCenter.h>
 
+#include <cstddef>
+#include <cstring>
+
 #ifdef Gl3HaveCocoa
 #   include "OSX/Gl3OSXPFAttribs.h"
 
+#elif defined(Gl3HaveHeadless)
+#   include "EGL/Gl3EGLDisplay.h"
+
 #endif
 
 namespace Gl3
 {
     RDImplementException(Gl3InvalidModuleException, "Gl3: Invalid module (differs from created).")
     
+    /////////////////////////////////////////////////////////////////////////////////
+    void RecordClear(RD::CommandBuffer& buffer, const Gl3Surface* surface, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha, GLfloat depth)
+    {
+        surface->lock();
+        buffer.record(kGl3ClearCommand, Gl3ClearCommand { surface, { red, green, blue, alpha }, depth });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void RecordDraw(RD::CommandBuffer& buffer, const Gl3Surface* surface, GLuint program, GLuint vertexArray, GLenum mode, GLint first, GLsizei count)
+    {
+        surface->lock();
+        buffer.record(kGl3DrawCommand, Gl3DrawCommand { surface, program, vertexArray, mode, first, count });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Gl3ContextLock::Gl3ContextLock(const Gl3Driver& d) : driver(d), lock(d.contextMutex), made(false), current(false)
+    {
+#       ifdef Gl3HaveCocoa
+        previousContext = CGLGetCurrentContext();
+        
+        if (!driver.glContext || previousContext == driver.glContext)
+        {
+            current = (driver.glContext != NULL);
+            return;
+        }
+        
+        made = current = (CGLSetCurrentContext(driver.glContext) == kCGLNoError);
+        
+#       elif defined(Gl3HaveHeadless)
+        if (driver.glContext == EGL_NO_CONTEXT)
+            return;
+        
+        // The bound API is per thread, and current contexts are queried for the bound API.
+        eglBindAPI(EGL_OPENGL_API);
+        previousContext = eglGetCurrentContext();
+        
+        if (previousContext == driver.glContext)
+        {
+            current = true;
+            return;
+        }
+        
+        previousDisplay = eglGetCurrentDisplay();
+        previousDraw = eglGetCurrentSurface(EGL_DRAW);
+        previousRead = eglGetCurrentSurface(EGL_READ);
+        
+        made = current = eglMakeCurrent(driver.glDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, driver.glContext);
+        
+#       endif
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Gl3ContextLock::~Gl3ContextLock()
+    {
+        if (!made)
+            return;
+        
+#       ifdef Gl3HaveCocoa
+        CGLSetCurrentContext(previousContext);
+        
+#       elif defined(Gl3HaveHeadless)
+        if (previousContext != EGL_NO_CONTEXT)
+            eglMakeCurrent(previousDisplay, previousDraw, previousRead, previousContext);
+        else
+            eglMakeCurrent(driver.glDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        
+#       endif
+    }
+    
     /////////////////////////////////////////////////////////////////////////////////
     Gl3Driver::Gl3Driver(RD::Module* mod, RD::DriverConfiguration* config) : module(mod)
     {
@@ -26,6 +102,9 @@ namespace Gl3
         
         mod->addListener((RD::ModuleListener*)this);
         
+        if (config && config->extension)
+            glState.setValidation(((Gl3DriverConfiguration*)config->extension)->validateState);
+        
 #       ifdef Gl3HaveCocoa
         // Creates a CGLContextObj from the DriverConfiguration object. This context will be used in all
         // the OpenGL objects created by this driver. To have a multicontext program, you may use more than
@@ -54,7 +133,7 @@ namespace Gl3
             RD::NotifiateAbort("Gl3Module",
                                "Gl3Driver::Gl3Driver",
                                "Gl3OSXCGLFailedNotification",
-                               "CGLChoosePixelFormat() failed: %s",
+                               RDFormatString("CGLChoosePixelFormat() failed: %s"),
                                CGLErrorString(error));
             
             glPixelFormat = NULL;
@@ -71,7 +150,7 @@ namespace Gl3
             RD::NotifiateAbort("Gl3Module",
                                "Gl3Driver::Gl3Driver",
                                "Gl3OSXCGLFailedNotification",
-                               "CGLCreateContext() failed: %s",
+                               RDFormatString("CGLCreateContext() failed: %s"),
                                CGLErrorString(error));
             
             glPixelFormat = NULL;
@@ -82,7 +161,7 @@ namespace Gl3
         RD::NotificationCenter::Notifiate("Gl3Module",
                                           "Gl3Driver::Gl3Driver",
                                           "Gl3ContextCreatedNotification",
-                                          "OpenGL Context created: %l", (long) glContext);
+                                          RDFormatString("OpenGL Context created: %p"), glContext);
         
         CGLContextObj oldContext = CGLGetCurrentContext();
         error = CGLSetCurrentContext(glContext);
@@ -96,7 +175,7 @@ namespace Gl3
             RD::NotifiateAbort("Gl3Module",
                                "Gl3Driver::Gl3Driver",
                                "Gl3OSXCGLFailedNotification",
-                               "CGLSetCurrentContext() failed: %s.",
+                               RDFormatString("CGLSetCurrentContext() failed: %s."),
                                CGLErrorString(error));
             
             glPixelFormat = NULL;
@@ -111,12 +190,108 @@ namespace Gl3
         
         CGLSetCurrentContext(oldContext);
         
+#       elif defined(Gl3HaveHeadless)
+        // Creates an EGL context which is never bound to a window: surfaces are framebuffer objects of
+        // this context. Any thread can make it current with a Gl3ContextLock.
+        
+        glDisplay = EGL_NO_DISPLAY;
+        glConfig = nullptr;
+        glContext = EGL_NO_CONTEXT;
+        major = 0;
+        minor = 0;
+        
+        EGLDisplay display = Gl3EGLGetDisplay();
+        
+        if (display == EGL_NO_DISPLAY || !Gl3EGLInitialize(display))
+        {
+            RD::NotifiateAbort("Gl3Module",
+                               "Gl3Driver::Gl3Driver",
+                               "Gl3EGLFailedNotification",
+                               RDFormatString("eglInitialize() failed: %s."),
+                               Gl3EGLErrorString(eglGetError()));
+            return;
+        }
+        
+        auto configAttribs = Gl3EGLConfigAttribs(config);
+        EGLint configsCount = 0;
+        
+        if (!eglBindAPI(EGL_OPENGL_API)
+            || !eglChooseConfig(display, configAttribs.data(), &glConfig, 1, &configsCount)
+            || !configsCount)
+        {
+            EGLint error = eglGetError();
+            Gl3EGLTerminate(display);
+            
+            RD::NotifiateAbort("Gl3Module",
+                               "Gl3Driver::Gl3Driver",
+                               "Gl3EGLFailedNotification",
+                               RDFormatString("No OpenGL EGL config found: %s."),
+                               Gl3EGLErrorString(error));
+            
+            glConfig = nullptr;
+            return;
+        }
+        
+        auto contextAttribs = Gl3EGLContextAttribs(config);
+        EGLContext context = eglCreateContext(display, glConfig, EGL_NO_CONTEXT, contextAttribs.data());
+        
+        if (context == EGL_NO_CONTEXT)
+        {
+            EGLint error = eglGetError();
+            Gl3EGLTerminate(display);
+            
+            RD::NotifiateAbort("Gl3Module",
+                               "Gl3Driver::Gl3Driver",
+                               "Gl3EGLFailedNotification",
+                               RDFormatString("eglCreateContext() failed: %s."),
+                               Gl3EGLErrorString(error));
+            
+            glConfig = nullptr;
+            return;
+        }
+        
+        glDisplay = display;
+        glContext = context;
+        
+        {
+            Gl3ContextLock lock(*this);
+            
+            if (!lock.valid())
+            {
+                EGLint error = eglGetError();
+                eglDestroyContext(glDisplay, glContext);
+                Gl3EGLTerminate(glDisplay);
+                
+                glDisplay = EGL_NO_DISPLAY;
+                glConfig = nullptr;
+                glContext = EGL_NO_CONTEXT;
+                
+                RD::NotifiateAbort("Gl3Module",
+                                   "Gl3Driver::Gl3Driver",
+                                   "Gl3EGLFailedNotification",
+                                   RDFormatString("eglMakeCurrent() failed: %s."),
+                                   Gl3EGLErrorString(error));
+                return;
+            }
+            
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+        }
+        
+        RD::NotificationCenter::Notifiate("Gl3Module",
+                                          "Gl3Driver::Gl3Driver",
+                                          "Gl3ContextCreatedNotification",
+                                          RDFormatString("OpenGL Context created: %p"), (void*)glContext);
+        
 #       endif
     }
     
     /////////////////////////////////////////////////////////////////////////////////
     Gl3Driver::~Gl3Driver()
     {
+        // The queue's thread calls executeCommand: it must be stopped before this object is destroyed.
+        getCommandQueue().stop();
+        
         RD::Module* mod = module.load();
         
         if (mod) {
@@ -130,6 +305,9 @@ namespace Gl3
         if (glPixelFormat)
             CGLReleasePixelFormat(glPixelFormat);
         
+#       elif defined(Gl3HaveHeadless)
+        destroyContext();
+        
 #       endif
     }
     
@@ -149,16 +327,20 @@ namespace Gl3
         }
         
         // NOTE [Concurrency]
-        // When RD::Module terminates, it locks its listener list to emit onModuleWillTerminate.
-        // However, 'mod->removeListener' locks also the listener list. To resolve this, we can
-        // copy the listener list to iterate over the copy and remove the listeners. Or, we can
-        // say that when a module terminates, it will always clear its listeners. Regarding
-        // performance, copying the listener's list is slower than clearing all listeners after
-        // emitting 'onModuleWillTerminate'.
-        // mod->removeListener((RD::ModuleListener*)this);
+        // RD::Emitter does not lock its listener list while emitting, so we can unregister
+        // from the module while it emits 'onModuleWillTerminate'.
+        mod->removeListener((RD::ModuleListener*)this);
         
         module.store(nullptr);
         
+        // Vertex array objects are not shared: they are deleted while the context lives.
+        {
+            Gl3ContextLock lock(*this);
+            
+            if (lock.valid())
+                glState.clear();
+        }
+        
 #       ifdef Gl3HaveCocoa
         
         if (glContext) {
@@ -170,6 +352,9 @@ namespace Gl3
             glPixelFormat = NULL;
         }
         
+#       elif defined(Gl3HaveHeadless)
+        destroyContext();
+        
 #       endif
     }
     
@@ -186,9 +371,155 @@ namespace Gl3
         return (glPixelFormat != NULL)
             && (glContext != NULL);
         
+#       elif defined(Gl3HaveHeadless)
+        std::lock_guard < std::recursive_mutex > lock(contextMutex);
+        return glContext != EGL_NO_CONTEXT;
+        
 #       else
         return false;
         
 #       endif
     }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Driver::onModuleDidUpdate(RD::Module* mod)
+    {
+        {
+            std::lock_guard < std::recursive_mutex > lock(contextMutex);
+            glState.endFrame();
+        }
+        
+        RD::Driver::onModuleDidUpdate(mod);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    Gl3StateCache& Gl3Driver::stateCache() const
+    {
+        return glState;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Driver::executeCommand(const RD::CommandHeader& header, const void* payload)
+    {
+        if (header.type != kGl3ClearCommand && header.type != kGl3DrawCommand)
+        {
+            RD::NotificationCenter::Notifiate("Gl3Module",
+                                              "Gl3Driver::executeCommand",
+                                              "Gl3UnsupportedCommandNotification",
+                                              RDFormatString("Unknown command %u of %u bytes dropped."),
+                                              header.type, header.size);
+            return;
+        }
+        
+        // Both commands start with their surface.
+        static_assert(offsetof(Gl3ClearCommand, surface) == 0 && offsetof(Gl3DrawCommand, surface) == 0,
+                      "Gl3 commands start with their surface.");
+        
+        const Gl3Surface* surface;
+        std::memcpy(&surface, payload, sizeof(surface));
+        
+#       if defined(Gl3HaveHeadless)
+        {
+            // The queue's thread makes the context current for the command only, so other threads can
+            // still use it between two commands.
+            Gl3ContextLock lock(*this);
+            
+            if (lock.valid() && !surface->closed())
+            {
+                surface->bind();
+                
+                if (header.type == kGl3ClearCommand)
+                {
+                    Gl3ClearCommand command;
+                    std::memcpy(&command, payload, sizeof(command));
+                    
+                    glState.colorMask(true, true, true, true);
+                    glState.depthMask(true);
+                    glClearColor(command.color[0], command.color[1], command.color[2], command.color[3]);
+                    glClearDepth(command.depth);
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                }
+                
+                else
+                {
+                    Gl3DrawCommand command;
+                    std::memcpy(&command, payload, sizeof(command));
+                    
+                    glState.useProgram(command.program);
+                    glState.bindVertexArray(command.vertexArray);
+                    glDrawArrays(command.mode, command.first, command.count);
+                }
+            }
+        }
+        
+#       else
+        RD::NotificationCenter::Notifiate("Gl3Module",
+                                          "Gl3Driver::executeCommand",
+                                          "Gl3UnsupportedCommandNotification",
+                                          RDFormatString("Command %u dropped: surfaces of this platform can not be drawn into."),
+                                          header.type);
+        
+#       endif
+        
+        surface->unlock();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Driver::executeDrawItems(const RD::DrawItem*, std::size_t count)
+    {
+        RD::NotificationCenter::Notifiate("Gl3Module",
+                                          "Gl3Driver::executeDrawItems",
+                                          "Gl3UnsupportedCommandNotification",
+                                          RDFormatString("%zu draws dropped: Gl3Driver does not define DrawItem::data, record Gl3 commands instead."),
+                                          count);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Gl3Driver::relocateCommand(const RD::CommandHeader& header, void* payload, const RD::CaptureRelocator& relocator)
+    {
+        if (header.type != kGl3ClearCommand && header.type != kGl3DrawCommand)
+            return true;
+        
+        const Gl3Surface* surface;
+        std::memcpy(&surface, payload, sizeof(surface));
+        
+        surface = relocator.relocate(surface);
+        
+        if (!surface)
+            return false;
+        
+        surface->lock();
+        std::memcpy(payload, &surface, sizeof(surface));
+        return true;
+    }
+    
+#   if defined(Gl3HaveHeadless)
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::Handle < RD::Surface > Gl3Driver::_createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const
+    {
+        return RD::CreateHandle < Gl3Surface >(const_cast < Gl3Driver* >(this), width, height, title, objectName, style, extension);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3Driver::destroyContext()
+    {
+        std::lock_guard < std::recursive_mutex > lock(contextMutex);
+        
+        if (glContext == EGL_NO_CONTEXT)
+            return;
+        
+        eglBindAPI(EGL_OPENGL_API);
+        
+        if (eglGetCurrentContext() == glContext)
+            eglMakeCurrent(glDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        
+        eglDestroyContext(glDisplay, glContext);
+        Gl3EGLTerminate(glDisplay);
+        
+        glDisplay = EGL_NO_DISPLAY;
+        glConfig = nullptr;
+        glContext = EGL_NO_CONTEXT;
+    }
+    
+#   endif
 }
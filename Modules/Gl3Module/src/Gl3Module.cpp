@@ -31,7 +31,10 @@ namespace Gl3
     {
         emit < RD::ModuleListener >(&RD::ModuleListener::onModuleWillUpdate, this);
         bool result = Gl3OSXUpdateApplication(this);
-        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleDidUpdate, this);
+        
+        // Listeners only need to know the module updated: the event is dispatched once, when the
+        // Application flushes its event queue.
+        emitCoalesced < RD::ModuleListener >(&RD::ModuleListener::onModuleDidUpdate, this);
         return result;
     }
     
@@ -42,8 +45,8 @@ namespace Gl3
         emit < RD::ModuleListener >(&RD::ModuleListener::onModuleWillTerminate, this);
         
         // NOTE [Design]
-        // To resolve a concurrency problem when emitting 'onModuleWillTerminate' (see Gl3Driver),
-        // Gl3::Module must clear all its listeners after emitting this event.
+        // Listeners should unregister themselves when receiving 'onModuleWillTerminate' (see Gl3Driver).
+        // Remaining listeners are cleared, as the module will not emit anything anymore.
         clearListeners();
         
         return true;
@@ -55,6 +58,46 @@ namespace Gl3
         return "Gl3Module:OSX";
     }
     
+#elif defined(Gl3HaveHeadless)
+
+namespace Gl3
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Module::start(RD::Application &application, const RD::Clock::time_point &ticks)
+    {
+        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleDidStart, this);
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Module::update(RD::Application& application, const RD::Clock::time_point& ticks)
+    {
+        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleWillUpdate, this);
+        
+        // There is no window system to poll. Listeners only need to know the module updated: the event
+        // is dispatched once, when the Application flushes its event queue.
+        emitCoalesced < RD::ModuleListener >(&RD::ModuleListener::onModuleDidUpdate, this);
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Module::terminate(RD::Application &application, const RD::Clock::time_point &ticks)
+    {
+        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleWillTerminate, this);
+        
+        // Listeners unregister themselves when receiving 'onModuleWillTerminate' (see Gl3Driver).
+        // Remaining listeners are cleared, as the module will not emit anything anymore.
+        clearListeners();
+        
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const std::string Module::name() const
+    {
+        return "Gl3Module:EGL";
+    }
+    
 #elif defined(Gl3HaveWindows)
 #include "Windows/WINModule.h"
     
@@ -0,0 +1,605 @@
+//
+//  Gl3StateCache.cpp
+//  Gl3Module
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "Gl3StateCache.h"
+#include <RD/NotificationCenter.h>
+
+#include <functional>
+
+namespace Gl3
+{
+    namespace
+    {
+        /*! @brief A target, and the state OpenGL returns its binding with. */
+        struct Binding
+        {
+            GLenum target;
+            GLenum query;
+        };
+        
+        //! @brief Buffer targets mirrored, by index.
+        const Binding kBufferBindings[Gl3StateCache::kBufferTargets] = {
+            { GL_ARRAY_BUFFER, GL_ARRAY_BUFFER_BINDING },
+            { GL_UNIFORM_BUFFER, GL_UNIFORM_BUFFER_BINDING },
+            { GL_PIXEL_PACK_BUFFER, GL_PIXEL_PACK_BUFFER_BINDING },
+            { GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_UNPACK_BUFFER_BINDING },
+            { GL_COPY_READ_BUFFER, GL_COPY_READ_BUFFER },
+            { GL_COPY_WRITE_BUFFER, GL_COPY_WRITE_BUFFER },
+            { GL_TEXTURE_BUFFER, GL_TEXTURE_BUFFER }
+        };
+        
+        //! @brief Texture targets mirrored, by index.
+        const Binding kTextureBindings[Gl3StateCache::kTextureTargets] = {
+            { GL_TEXTURE_2D, GL_TEXTURE_BINDING_2D },
+            { GL_TEXTURE_3D, GL_TEXTURE_BINDING_3D },
+            { GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BINDING_CUBE_MAP },
+            { GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BINDING_2D_ARRAY },
+            { GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_BINDING_2D_MULTISAMPLE },
+            { GL_TEXTURE_RECTANGLE, GL_TEXTURE_BINDING_RECTANGLE }
+        };
+        
+        //! @brief Capabilities mirrored, by index.
+        const GLenum kCapabilitiesMirrored[Gl3StateCache::kCapabilities] = {
+            GL_BLEND,
+            GL_DEPTH_TEST,
+            GL_CULL_FACE,
+            GL_SCISSOR_TEST,
+            GL_STENCIL_TEST,
+            GL_POLYGON_OFFSET_FILL,
+            GL_MULTISAMPLE,
+            GL_FRAMEBUFFER_SRGB,
+            GL_PRIMITIVE_RESTART
+        };
+        
+        /*! @brief Returns the index of a target in a table, or -1. */
+        template < std::size_t N >
+        int IndexOf(const Binding (&bindings)[N], GLenum target)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (bindings[i].target == target)
+                    return int(i);
+            }
+            
+            return -1;
+        }
+        
+        /*! @brief Returns the index of a capability, or -1. */
+        int CapabilityIndex(GLenum capability)
+        {
+            for (std::size_t i = 0; i < Gl3StateCache::kCapabilities; ++i)
+            {
+                if (kCapabilitiesMirrored[i] == capability)
+                    return int(i);
+            }
+            
+            return -1;
+        }
+        
+        /*! @brief glGetIntegerv of one value. */
+        GLint GetInteger(GLenum state)
+        {
+            GLint value = 0;
+            glGetIntegerv(state, &value);
+            return value;
+        }
+        
+        /*! @brief glGetIntegerv of a binding. */
+        GLuint GetName(GLenum state)
+        {
+            return GLuint(GetInteger(state));
+        }
+        
+        /*! @brief glGetIntegerv of several enumerations. */
+        template < std::size_t N >
+        std::array < GLenum, N > GetEnums(const GLenum (&states)[N])
+        {
+            std::array < GLenum, N > values;
+            
+            for (std::size_t i = 0; i < N; ++i)
+                values[i] = GLenum(GetInteger(states[i]));
+            
+            return values;
+        }
+        
+        /*! @brief glGetIntegerv of a box, like GL_VIEWPORT. */
+        std::array < GLint, 4 > GetBox(GLenum state)
+        {
+            std::array < GLint, 4 > box;
+            glGetIntegerv(state, box.data());
+            return box;
+        }
+        
+        /*! @brief glGetBooleanv of GL_COLOR_WRITEMASK. */
+        std::array < bool, 4 > GetColorMask()
+        {
+            GLboolean mask[4] = { GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE };
+            glGetBooleanv(GL_COLOR_WRITEMASK, mask);
+            return { mask[0] == GL_TRUE, mask[1] == GL_TRUE, mask[2] == GL_TRUE, mask[3] == GL_TRUE };
+        }
+        
+        /*! @brief glGetBooleanv of GL_DEPTH_WRITEMASK. */
+        bool GetDepthMask()
+        {
+            GLboolean mask = GL_FALSE;
+            glGetBooleanv(GL_DEPTH_WRITEMASK, &mask);
+            return mask == GL_TRUE;
+        }
+        
+        /*! @brief Returns the texture bound to a target of a unit, restoring the active unit. */
+        GLuint GetTexture(GLuint unit, GLenum query)
+        {
+            GLint active = GetInteger(GL_ACTIVE_TEXTURE);
+            glActiveTexture(GL_TEXTURE0 + unit);
+            GLuint name = GetName(query);
+            glActiveTexture(GLenum(active));
+            return name;
+        }
+        
+        //! @brief States of the blend functions, in Gl3StateCache's order.
+        const GLenum kBlendFunctionStates[4] = { GL_BLEND_SRC_RGB, GL_BLEND_DST_RGB, GL_BLEND_SRC_ALPHA, GL_BLEND_DST_ALPHA };
+        
+        //! @brief States of the blend equations, in Gl3StateCache's order.
+        const GLenum kBlendEquationStates[2] = { GL_BLEND_EQUATION_RGB, GL_BLEND_EQUATION_ALPHA };
+        
+        /*! @brief Combines a value into a hash. */
+        template < typename T >
+        void Combine(std::size_t& hash, const T& value)
+        {
+            hash ^= std::hash < T >()(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        }
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Gl3VertexLayoutHash::operator()(const Gl3VertexLayout& layout) const noexcept
+    {
+        std::size_t hash = std::hash < GLuint >()(layout.elementBuffer);
+        
+        for (const Gl3VertexAttribute& attribute : layout.attributes)
+        {
+            Combine(hash, attribute.location);
+            Combine(hash, attribute.size);
+            Combine(hash, attribute.type);
+            Combine(hash, (unsigned(attribute.normalized) << 1) | attribute.integer);
+            Combine(hash, attribute.stride);
+            Combine(hash, attribute.offset);
+            Combine(hash, attribute.buffer);
+        }
+        
+        return hash;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::useProgram(GLuint name)
+    {
+        if (!elide(program, name, "program", [](){ return GetName(GL_CURRENT_PROGRAM); }))
+            glUseProgram(name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::bindVertexArray(GLuint name)
+    {
+        if (!elide(vertexArrayBinding, name, "vertex array binding", [](){ return GetName(GL_VERTEX_ARRAY_BINDING); }))
+            glBindVertexArray(name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::bindBuffer(GLenum target, GLuint name)
+    {
+        int index = IndexOf(kBufferBindings, target);
+        
+        if (index < 0)
+        {
+            current.issued++;
+            glBindBuffer(target, name);
+            return;
+        }
+        
+        GLenum query = kBufferBindings[index].query;
+        
+        if (!elide(buffers[index], name, "buffer binding", [query](){ return GetName(query); }))
+            glBindBuffer(target, name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::bindFramebuffer(GLenum target, GLuint name)
+    {
+        if (target == GL_DRAW_FRAMEBUFFER)
+        {
+            if (!elide(drawFramebuffer, name, "draw framebuffer", [](){ return GetName(GL_DRAW_FRAMEBUFFER_BINDING); }))
+                glBindFramebuffer(target, name);
+            
+            return;
+        }
+        
+        if (target == GL_READ_FRAMEBUFFER)
+        {
+            if (!elide(readFramebuffer, name, "read framebuffer", [](){ return GetName(GL_READ_FRAMEBUFFER_BINDING); }))
+                glBindFramebuffer(target, name);
+            
+            return;
+        }
+        
+        // GL_FRAMEBUFFER binds both: the call is elided only if both are bound already.
+        bool bound = drawFramebuffer.known && drawFramebuffer.value == name && readFramebuffer.known && readFramebuffer.value == name;
+        
+        if (bound && validating)
+        {
+            bool draw = matches(drawFramebuffer, GetName(GL_DRAW_FRAMEBUFFER_BINDING), "draw framebuffer");
+            bool read = matches(readFramebuffer, GetName(GL_READ_FRAMEBUFFER_BINDING), "read framebuffer");
+            bound = draw && read;
+        }
+        
+        if (bound)
+        {
+            current.elided++;
+            return;
+        }
+        
+        drawFramebuffer.value = readFramebuffer.value = name;
+        drawFramebuffer.known = readFramebuffer.known = true;
+        current.issued++;
+        glBindFramebuffer(target, name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::activeTexture(GLuint unit)
+    {
+        if (!elide(activeUnit, unit, "active texture", [](){ return GLuint(GetInteger(GL_ACTIVE_TEXTURE) - GL_TEXTURE0); }))
+            glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::bindTexture(GLuint unit, GLenum target, GLuint name)
+    {
+        int index = IndexOf(kTextureBindings, target);
+        
+        if (unit >= kTextureUnits || index < 0)
+        {
+            activeTexture(unit);
+            current.issued++;
+            glBindTexture(target, name);
+            return;
+        }
+        
+        GLenum query = kTextureBindings[index].query;
+        
+        if (elide(textures[unit][index], name, "texture binding", [unit, query](){ return GetTexture(unit, query); }))
+            return;
+        
+        activeTexture(unit);
+        glBindTexture(target, name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::setCapability(GLenum capability, bool enabled)
+    {
+        int index = CapabilityIndex(capability);
+        
+        if (index >= 0 && elide(capabilities[index], enabled, "capability", [capability](){ return glIsEnabled(capability) == GL_TRUE; }))
+            return;
+        
+        if (index < 0)
+            current.issued++;
+        
+        if (enabled)
+            glEnable(capability);
+        else
+            glDisable(capability);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::blendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha)
+    {
+        std::array < GLenum, 4 > functions = { sourceRGB, destinationRGB, sourceAlpha, destinationAlpha };
+        
+        if (!elide(blendFunctions, functions, "blend functions", [](){ return GetEnums(kBlendFunctionStates); }))
+            glBlendFuncSeparate(sourceRGB, destinationRGB, sourceAlpha, destinationAlpha);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+    {
+        std::array < GLenum, 2 > modes = { modeRGB, modeAlpha };
+        
+        if (!elide(blendEquations, modes, "blend equations", [](){ return GetEnums(kBlendEquationStates); }))
+            glBlendEquationSeparate(modeRGB, modeAlpha);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::depthFunc(GLenum function)
+    {
+        if (!elide(depthFunction, function, "depth function", [](){ return GLenum(GetInteger(GL_DEPTH_FUNC)); }))
+            glDepthFunc(function);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::depthMask(bool write)
+    {
+        if (!elide(depthWrite, write, "depth mask", GetDepthMask))
+            glDepthMask(write ? GL_TRUE : GL_FALSE);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::cullFace(GLenum mode)
+    {
+        if (!elide(cullMode, mode, "cull face", [](){ return GLenum(GetInteger(GL_CULL_FACE_MODE)); }))
+            glCullFace(mode);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::frontFace(GLenum mode)
+    {
+        if (!elide(frontFaceMode, mode, "front face", [](){ return GLenum(GetInteger(GL_FRONT_FACE)); }))
+            glFrontFace(mode);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::colorMask(bool red, bool green, bool blue, bool alpha)
+    {
+        std::array < bool, 4 > mask = { red, green, blue, alpha };
+        
+        if (!elide(colorWrite, mask, "color mask", GetColorMask))
+            glColorMask(red ? GL_TRUE : GL_FALSE, green ? GL_TRUE : GL_FALSE, blue ? GL_TRUE : GL_FALSE, alpha ? GL_TRUE : GL_FALSE);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        std::array < GLint, 4 > box = { x, y, width, height };
+        
+        if (!elide(viewportBox, box, "viewport", [](){ return GetBox(GL_VIEWPORT); }))
+            glViewport(x, y, width, height);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        std::array < GLint, 4 > box = { x, y, width, height };
+        
+        if (!elide(scissorBox, box, "scissor box", [](){ return GetBox(GL_SCISSOR_BOX); }))
+            glScissor(x, y, width, height);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    GLuint Gl3StateCache::vertexArray(const Gl3VertexLayout& layout)
+    {
+        auto it = vertexArrays.find(layout);
+        
+        if (it != vertexArrays.end())
+        {
+            current.vertexArraysReused++;
+            return it->second;
+        }
+        
+        GLuint name = 0;
+        glGenVertexArrays(1, &name);
+        bindVertexArray(name);
+        
+        for (const Gl3VertexAttribute& attribute : layout.attributes)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, attribute.buffer);
+            glEnableVertexAttribArray(attribute.location);
+            
+            const void* offset = reinterpret_cast < const void* >(attribute.offset);
+            
+            if (attribute.integer)
+                glVertexAttribIPointer(attribute.location, attribute.size, attribute.type, attribute.stride, offset);
+            else
+                glVertexAttribPointer(attribute.location, attribute.size, attribute.type, attribute.normalized, attribute.stride, offset);
+            
+            current.issued += 2;
+        }
+        
+        // The element buffer binding is stored in the vertex array object.
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, layout.elementBuffer);
+        current.issued++;
+        
+        current.vertexArraysCreated++;
+        vertexArrays.emplace(layout, name);
+        return name;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::deleteBuffer(GLuint name)
+    {
+        if (!name)
+            return;
+        
+        for (auto it = vertexArrays.begin(); it != vertexArrays.end();)
+        {
+            const Gl3VertexLayout& layout = it->first;
+            bool uses = layout.elementBuffer == name;
+            
+            for (const Gl3VertexAttribute& attribute : layout.attributes)
+                uses = uses || attribute.buffer == name;
+            
+            if (!uses)
+            {
+                ++it;
+                continue;
+            }
+            
+            if (vertexArrayBinding.value == it->second)
+                vertexArrayBinding.value = 0;
+            
+            glDeleteVertexArrays(1, &it->second);
+            it = vertexArrays.erase(it);
+        }
+        
+        for (Shadow < GLuint >& buffer : buffers)
+        {
+            if (buffer.value == name)
+                buffer.value = 0;
+        }
+        
+        glDeleteBuffers(1, &name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::deleteTexture(GLuint name)
+    {
+        if (!name)
+            return;
+        
+        for (auto& unit : textures)
+        {
+            for (Shadow < GLuint >& texture : unit)
+            {
+                if (texture.value == name)
+                    texture.value = 0;
+            }
+        }
+        
+        glDeleteTextures(1, &name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::deleteFramebuffer(GLuint name)
+    {
+        if (!name)
+            return;
+        
+        if (drawFramebuffer.value == name)
+            drawFramebuffer.value = 0;
+        
+        if (readFramebuffer.value == name)
+            readFramebuffer.value = 0;
+        
+        glDeleteFramebuffers(1, &name);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::invalidate()
+    {
+        program.known = false;
+        vertexArrayBinding.known = false;
+        drawFramebuffer.known = false;
+        readFramebuffer.known = false;
+        activeUnit.known = false;
+        blendFunctions.known = false;
+        blendEquations.known = false;
+        depthFunction.known = false;
+        depthWrite.known = false;
+        cullMode.known = false;
+        frontFaceMode.known = false;
+        colorWrite.known = false;
+        viewportBox.known = false;
+        scissorBox.known = false;
+        
+        for (Shadow < GLuint >& buffer : buffers)
+            buffer.known = false;
+        
+        for (auto& unit : textures)
+        {
+            for (Shadow < GLuint >& texture : unit)
+                texture.known = false;
+        }
+        
+        for (Shadow < bool >& capability : capabilities)
+            capability.known = false;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::clear()
+    {
+        for (auto& entry : vertexArrays)
+            glDeleteVertexArrays(1, &entry.second);
+        
+        vertexArrays.clear();
+        invalidate();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t Gl3StateCache::validate()
+    {
+        std::size_t mismatches = 0;
+        
+        auto check = [this, &mismatches](auto& state, const auto& real, const char* name){
+            if (!matches(state, real, name))
+                mismatches++;
+        };
+        
+        check(program, GetName(GL_CURRENT_PROGRAM), "program");
+        check(vertexArrayBinding, GetName(GL_VERTEX_ARRAY_BINDING), "vertex array binding");
+        check(drawFramebuffer, GetName(GL_DRAW_FRAMEBUFFER_BINDING), "draw framebuffer");
+        check(readFramebuffer, GetName(GL_READ_FRAMEBUFFER_BINDING), "read framebuffer");
+        
+        for (std::size_t i = 0; i < kBufferTargets; ++i)
+        {
+            if (buffers[i].known)
+                check(buffers[i], GetName(kBufferBindings[i].query), "buffer binding");
+        }
+        
+        // Texture bindings are read unit by unit, then the active unit is restored and checked.
+        GLint active = GetInteger(GL_ACTIVE_TEXTURE);
+        
+        for (GLuint unit = 0; unit < kTextureUnits; ++unit)
+        {
+            bool selected = false;
+            
+            for (std::size_t i = 0; i < kTextureTargets; ++i)
+            {
+                if (!textures[unit][i].known)
+                    continue;
+                
+                if (!selected)
+                {
+                    glActiveTexture(GL_TEXTURE0 + unit);
+                    selected = true;
+                }
+                
+                check(textures[unit][i], GetName(kTextureBindings[i].query), "texture binding");
+            }
+        }
+        
+        glActiveTexture(GLenum(active));
+        check(activeUnit, GLuint(active - GL_TEXTURE0), "active texture");
+        
+        for (std::size_t i = 0; i < kCapabilities; ++i)
+        {
+            if (capabilities[i].known)
+                check(capabilities[i], glIsEnabled(kCapabilitiesMirrored[i]) == GL_TRUE, "capability");
+        }
+        
+        check(blendFunctions, GetEnums(kBlendFunctionStates), "blend functions");
+        check(blendEquations, GetEnums(kBlendEquationStates), "blend equations");
+        check(depthFunction, GLenum(GetInteger(GL_DEPTH_FUNC)), "depth function");
+        check(depthWrite, GetDepthMask(), "depth mask");
+        check(cullMode, GLenum(GetInteger(GL_CULL_FACE_MODE)), "cull face");
+        check(frontFaceMode, GLenum(GetInteger(GL_FRONT_FACE)), "front face");
+        check(colorWrite, GetColorMask(), "color mask");
+        check(viewportBox, GetBox(GL_VIEWPORT), "viewport");
+        check(scissorBox, GetBox(GL_SCISSOR_BOX), "scissor box");
+        
+        return mismatches;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::endFrame() noexcept
+    {
+        total.issued += current.issued;
+        total.elided += current.elided;
+        total.vertexArraysCreated += current.vertexArraysCreated;
+        total.vertexArraysReused += current.vertexArraysReused;
+        total.mismatches += current.mismatches;
+        
+        last = current;
+        current = Gl3StateCounters();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void Gl3StateCache::mismatch(const char* name)
+    {
+        current.mismatches++;
+        
+        RD::NotificationCenter::Notifiate("Gl3Module",
+                                          "Gl3StateCache::validate",
+                                          "Gl3StateMismatchNotification",
+                                          RDFormatString("OpenGL %s differs from the state cache."), name);
+    }
+}
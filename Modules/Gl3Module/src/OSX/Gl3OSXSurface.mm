@@ -66,7 +66,7 @@ namespace Gl3
         if (!currentContext)
         {
             RD::NotifiateAbort("Gl3Module", "Gl3Surface::Gl3Surface", "Gl3InvalidContextNotification",
-                               "Null OpenGL context to create surface %s.", objectName.data());
+                               RDFormatString("Null OpenGL context to create surface %s."), objectName.data());
             return;
         }
         
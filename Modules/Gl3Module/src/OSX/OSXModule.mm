@@ -12,7 +12,7 @@
 #include <RD/Exception.h>
 
 //! @brief Constant to describe Gl3NotificationNibMenuNotFound.
-static const char* kGl3NotificationNibMenuNotFound = "Gl3NotificationNibMenuNotFound";
+static constexpr RD::HashedString kGl3NotificationNibMenuNotFound = "Gl3NotificationNibMenuNotFound";
 
 /////////////////////////////////////////////////////////////////////////////////
 static void SendEmptyEvent( void )
@@ -0,0 +1,177 @@
+//
+//  NullDriver.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NullDriver_h
+#define NullDriver_h
+
+#include <RD/Driver.h>
+#include <RD/Module.h>
+
+#include <chrono>
+
+namespace Null
+{
+    /**
+     * @brief Configuration of the NullDriver object.
+     *
+     * You can give a pointer to an instance of this structure to member RD::DriverConfiguration::extension.
+     * Latencies simulate the cost of a real backend: the driver waits for them on the calling thread, by
+     * spinning when shorter than 50 microseconds and by sleeping otherwise.
+     */
+    struct NullDriverConfiguration
+    {
+        //! @brief Time taken to create a surface.
+        std::chrono::nanoseconds surfaceCreationLatency { 0 };
+        
+        //! @brief Time taken to create a resource.
+        std::chrono::nanoseconds resourceCreationLatency { 0 };
+        
+        //! @brief Time taken to execute one command of the command queue.
+        std::chrono::nanoseconds commandLatency { 0 };
+        
+        //! @brief Time taken by each module update, like a buffer swap.
+        std::chrono::nanoseconds updateLatency { 0 };
+    };
+    
+    /** @brief Calls counted by NullDriver. See NullDriver::callsCount. */
+    enum class NullCall : uint32_t
+    {
+        CreateSurface,
+        CreateResource,
+        DestroyResource,
+        ClearResource,
+        ExecuteCommand,
+        ExecuteDrawItems,
+        ModuleUpdate,
+        ModuleTerminate,
+        SurfaceShow,
+        SurfaceMove,
+        SurfaceResize,
+        SurfaceLockFocus,
+        SurfaceClose,
+        SurfaceHide,
+        SurfaceUnhide,
+        
+        //! @brief Number of calls counted.
+        Count
+    };
+    
+    /*! @brief Returns the name of a call, like 'CreateSurface'. */
+    const char* NullCallName(NullCall call) noexcept;
+    
+    /** @brief Thrown when given Module does not correspond to the driver's module. */
+    RDDefineException(NullInvalidModuleException, 1 << 1);
+    
+    /**
+     * @brief Headless implementation of RD::Driver.
+     *
+     * A NullDriver creates NullSurfaces and NullResources, which only hold their properties, and ignores
+     * every command it executes. The engine's bookkeeping (registry, retirement, notifications, command
+     * queue) runs as with any other driver. Every call received is counted (see \ref callsCount), and
+     * can be slowed down by the latencies of NullDriverConfiguration.
+     */
+    class NullDriver : public RD::Driver
+    {
+        //! @brief Module that created this driver.
+        std::atomic < RD::Module* > module;
+        
+        //! @brief Simulated latencies.
+        NullDriverConfiguration configuration;
+        
+        //! @brief Counters, by NullCall.
+        mutable std::atomic < std::uint64_t > counters[static_cast < std::size_t >(NullCall::Count)];
+        
+        //! @brief Bytes of the command payloads executed.
+        std::atomic < std::uint64_t > commandBytes { 0 };
+        
+        //! @brief Draws executed.
+        std::atomic < std::uint64_t > drawItems { 0 };
+        
+        //! @brief Pipeline and material changes between the draws executed.
+        std::atomic < std::uint64_t > stateChanges { 0 };
+        
+    public:
+        
+        /*! @brief Default constructor.
+         *
+         * @param[in] mod Module that created this driver.
+         * @param[in] config Configuration, whose extension may point to a NullDriverConfiguration. May
+         *      be null.
+         */
+        NullDriver(RD::Module* mod, RD::DriverConfiguration* config);
+        
+        /*! @brief Default destructor. Stops the command queue. */
+        ~NullDriver();
+        
+        /*! @brief Returns 'NullDriver'. */
+        const std::string name() const noexcept;
+        
+        /*! @brief Returns 1.0. */
+        const RD::Version version() const;
+        
+        /*! @brief Returns true. */
+        bool valid() const;
+        
+        /*! @brief Creates a NullResource holding size bytes of memory kind, or returns the resource with the
+         * same name.
+         *
+         * @return The resource, or an invalid handle if another kind of resource has the same name.
+         */
+        RD::Handle < RD::DriverResource > createResource(const std::string& name, std::size_t size, RD::MemoryKind kind = RD::MemoryKind::Device);
+        
+        /*! @brief Unregisters a resource and retires it. Returns false if it was not registered. */
+        bool destroyResource(const RD::Handle < RD::DriverResource >& resource);
+        
+        /*! @brief Returns the number of times a call was received. */
+        std::uint64_t callsCount(NullCall call) const;
+        
+        /*! @brief Returns the number of bytes of command payloads executed. */
+        std::uint64_t commandBytesCount() const;
+        
+        /*! @brief Returns the number of draws executed. */
+        std::uint64_t drawItemsCount() const;
+        
+        /*! @brief Returns the number of pipeline and material changes a real driver would have made to
+         * execute the draws, in the order they were received (see RD::DrawKey). */
+        std::uint64_t stateChangesCount() const;
+        
+        /*! @brief Sets every counter to zero. */
+        void resetCounters();
+        
+        /*! @brief Counts a call. Used by NullSurface and NullResource. */
+        void count(NullCall call) const;
+        
+        /*! @brief Waits for the given latency. */
+        static void Simulate(std::chrono::nanoseconds latency);
+        
+        /*! @brief Counts the update, simulates its latency, and releases retired resources. */
+        void onModuleDidUpdate(RD::Module* mod);
+        
+        /*! @brief Called when module is terminating. Clears every resource and unregisters from the module.
+         *
+         * @param[in] mod Module that created this driver. If mod does not correspond to module,
+         *      exception NullInvalidModuleException is thrown.
+         */
+        void onModuleWillTerminate(RD::Module* mod);
+        
+    protected:
+        
+        /*! @brief Counts the command and simulates its latency. */
+        void executeCommand(const RD::CommandHeader& header, const void* payload);
+        
+        /*! @brief Counts the draws and their state changes, and simulates the command latency for each draw. */
+        void executeDrawItems(const RD::DrawItem* items, std::size_t count);
+        
+        /*! @brief Creates a NullResource holding memorySize bytes of memory kind, with \ref createResource. */
+        RD::Handle < RD::DriverResource > createReplayResource(const std::string& name, std::size_t memorySize, RD::MemoryKind kind);
+        
+        /*! @brief Creates a NullSurface. */
+        RD::Handle < RD::Surface > _createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const;
+    };
+}
+
+#endif /* NullDriver_h */
@@ -0,0 +1,60 @@
+//
+//  NullModule.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NullModule_h
+#define NullModule_h
+
+#include <RD/Module.h>
+
+namespace Null
+{
+    /**
+     * @brief NullModule module class.
+     *
+     * Installs a headless module into the current RD::Application object. NullModule creates a
+     * NullDriver, which accepts surfaces and resources but does no graphics work. It runs on every
+     * platform, without any window system, and is used to benchmark and load-test the engine's core.
+     */
+    class Module : public RD::Module
+    {
+    public:
+        
+        /*! @brief Default constructor. */
+        Module() noexcept = default;
+        
+        /*! @brief Default destructor. */
+        ~Module() noexcept = default;
+        
+        /*! @brief Starts the module. Always succeeds. */
+        bool start(RD::Application& application, const RD::Clock::time_point& ticks);
+        
+        /*! @brief Updates the module. There is no event loop to poll: listeners are notified only. */
+        bool update(RD::Application& application, const RD::Clock::time_point& ticks);
+        
+        /*! @brief Stops the module. Listeners (like NullDriver) receive onModuleWillTerminate, then are
+         * cleared. */
+        bool terminate(RD::Application& application, const RD::Clock::time_point& ticks);
+        
+        /*! @brief Returns this module name ('NullModule'). */
+        const std::string name() const;
+        
+        /*! @brief Returns a new instance of a given class hash, if supported.
+         *
+         * Currently, supported hashes are:
+         *   - RD::Driver: Will create an instance of NullDriver.
+         *
+         * @param hash Hash of the class we want to instanciate.
+         * @param user A RD::DriverConfiguration*, whose extension may point to a NullDriverConfiguration.
+         *
+         * @return A pointer to an handle to the referred class, or nullptr if this hash is
+         *  not supported by the module.
+         */
+        void* loadHash(size_t hash, void* user);
+    };
+}
+
+#endif /* NullModule_h */
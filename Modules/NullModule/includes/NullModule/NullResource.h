@@ -0,0 +1,52 @@
+//
+//  NullResource.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NullResource_h
+#define NullResource_h
+
+#include <RD/DriverResource.h>
+
+namespace Null
+{
+    class NullDriver;
+    
+    /**
+     * @brief Resource of a NullDriver, like a buffer or a texture, which holds no memory.
+     *
+     * A NullResource reports the size it was created with as its memory size, so memory accounting can
+     * be tested without allocating it.
+     */
+    class NullResource : public RD::DriverResource
+    {
+        //! @brief Driver counting our calls.
+        NullDriver* nullDriver;
+        
+        //! @brief Simulated memory size.
+        std::size_t bytes;
+        
+        //! @brief Simulated memory kind.
+        RD::MemoryKind kind;
+        
+    public:
+        
+        /*! @brief Constructs a resource of size bytes of memory kind. */
+        NullResource(NullDriver* driver, std::size_t size, RD::MemoryKind kind = RD::MemoryKind::Device);
+        
+        /*! @brief Returns the size given at creation. */
+        std::size_t memorySize() const;
+        
+        /*! @brief Returns the kind given at creation. */
+        RD::MemoryKind memoryKind() const;
+        
+    protected:
+        
+        /*! @brief Counts the call. */
+        void onDriverClear();
+    };
+}
+
+#endif /* NullResource_h */
@@ -0,0 +1,101 @@
+//
+//  NullSurface.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef NullSurface_h
+#define NullSurface_h
+
+#include <RD/Surface.h>
+
+namespace Null
+{
+    class NullDriver;
+    
+    /**
+     * @brief Surface of a NullDriver, which is never displayed.
+     *
+     * A NullSurface only holds its size, position and state. It is a window unless created with style
+     * RD::SurfaceStyle::Borderless, in which case it is a view. Moves and resizes are notified to
+     * observers as with any surface, and \ref close notifies onSurfaceWillClose once.
+     */
+    class NullSurface : public RD::Surface
+    {
+        //! @brief Driver counting our calls.
+        NullDriver* nullDriver;
+        
+        //! @brief Style used to create the surface.
+        uint32_t style;
+        
+        //! @brief Position, as x in the high 32 bits and y in the low ones.
+        std::atomic < std::uint64_t > packedPosition { 0 };
+        
+        //! @brief Size, as width in the high 32 bits and height in the low ones.
+        std::atomic < std::uint64_t > packedSize;
+        
+        //! @brief True if the surface is hidden.
+        std::atomic < bool > hidden { true };
+        
+        //! @brief True once the surface is closed.
+        std::atomic < bool > isClosed { false };
+        
+    public:
+        
+        /*! @brief Default constructor.
+         *
+         * @param[in] driver Driver which constructed this object.
+         * @param[in] width Width of the surface in pixels.
+         * @param[in] height Height of the surface in pixels.
+         * @param[in] title Title for this Surface, ignored.
+         * @param[in] objectName Name for this surface.
+         * @param[in] style Style used to create the surface.
+         * @param[in] extension Ignored.
+         */
+        NullSurface(NullDriver* driver, uint32_t width, uint32_t height, const std::string& title, const std::string& objectName,
+                    uint32_t style = RD::SurfaceStyle::Default,
+                    const void* extension = nullptr);
+        
+        /*! @brief Default destructor. */
+        ~NullSurface() = default;
+        
+        /*! @brief Returns true unless created borderless. */
+        bool isWindow() const;
+        
+        /*! @brief Returns true if created borderless. */
+        bool isView() const;
+        
+        /*! @brief Marks the surface as visible. */
+        void show();
+        
+        /*! @brief Changes the position and notifies observers. */
+        void move(uint32_t x, uint32_t y);
+        
+        /*! @brief Changes the size and notifies observers. */
+        void resize(uint32_t width, uint32_t height);
+        
+        /*! @brief Returns the last position set. */
+        RD::ScreenPosition position() const;
+        
+        /*! @brief Returns the last size set. */
+        RD::RectSize size() const;
+        
+        /*! @brief Notifies observers the surface has focus. */
+        void lockFocus();
+        
+        /*! @brief Closes the surface and notifies observers, once. */
+        void close();
+        
+        /*! @brief Marks the surface as hidden and notifies observers. */
+        void hide();
+        
+        /*! @brief Marks the surface as visible and notifies observers. */
+        void unhide();
+        
+        /*! @brief Returns true if surface is closed. */
+        bool closed() const;
+    };
+}
+
+#endif /* NullSurface_h */
@@ -0,0 +1,252 @@
+//
+//  NullDriver.cpp
+//  NullModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "NullDriver.h"
+#include "NullSurface.h"
+#include "NullResource.h"
+
+#include <thread>
+
+namespace Null
+{
+    RDImplementException(NullInvalidModuleException, "Null: Invalid module (differs from created).")
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const char* NullCallName(NullCall call) noexcept
+    {
+        switch (call)
+        {
+            case NullCall::CreateSurface: return "CreateSurface";
+            case NullCall::CreateResource: return "CreateResource";
+            case NullCall::DestroyResource: return "DestroyResource";
+            case NullCall::ClearResource: return "ClearResource";
+            case NullCall::ExecuteCommand: return "ExecuteCommand";
+            case NullCall::ExecuteDrawItems: return "ExecuteDrawItems";
+            case NullCall::ModuleUpdate: return "ModuleUpdate";
+            case NullCall::ModuleTerminate: return "ModuleTerminate";
+            case NullCall::SurfaceShow: return "SurfaceShow";
+            case NullCall::SurfaceMove: return "SurfaceMove";
+            case NullCall::SurfaceResize: return "SurfaceResize";
+            case NullCall::SurfaceLockFocus: return "SurfaceLockFocus";
+            case NullCall::SurfaceClose: return "SurfaceClose";
+            case NullCall::SurfaceHide: return "SurfaceHide";
+            case NullCall::SurfaceUnhide: return "SurfaceUnhide";
+            default: return "Unknown";
+        }
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    NullDriver::NullDriver(RD::Module* mod, RD::DriverConfiguration* config) : module(mod)
+    {
+        if (!mod) {
+            throw NullInvalidModuleException();
+        }
+        
+        if (config && config->extension)
+            configuration = *static_cast < const NullDriverConfiguration* >(config->extension);
+        
+        resetCounters();
+        mod->addListener((RD::ModuleListener*)this);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    NullDriver::~NullDriver()
+    {
+        // The queue's thread calls executeCommand: it must be stopped before this object is destroyed.
+        getCommandQueue().stop();
+        
+        RD::Module* mod = module.load();
+        
+        if (mod) {
+            mod->removeListener((RD::ModuleListener*)this);
+        }
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const std::string NullDriver::name() const noexcept
+    {
+        return "NullDriver";
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const RD::Version NullDriver::version() const
+    {
+        return { 1, 0, 0, 0 };
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NullDriver::valid() const
+    {
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::Handle < RD::DriverResource > NullDriver::createResource(const std::string& name, std::size_t size, RD::MemoryKind kind)
+    {
+        RD::HashedString id(name.data());
+        RD::Handle < RD::DriverResource > existing = findResource(id);
+        
+        if (existing.valid())
+            return dynamic_cast < NullResource* >(existing.ptr()) ? existing : RD::Handle < RD::DriverResource >();
+        
+        count(NullCall::CreateResource);
+        Simulate(configuration.resourceCreationLatency);
+        
+        RD::Handle < RD::DriverResource > resource = RD::CreateHandle < NullResource >(this, size, kind);
+        
+        // Another thread may have created a resource with the same name meanwhile.
+        if (!addResource(id, resource))
+            return findResource(id);
+        
+        return resource;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::Handle < RD::DriverResource > NullDriver::createReplayResource(const std::string& name, std::size_t memorySize, RD::MemoryKind kind)
+    {
+        return createResource(name, memorySize, kind);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NullDriver::destroyResource(const RD::Handle < RD::DriverResource >& resource)
+    {
+        if (!resource.valid() || !removeResource(resource.ptr()))
+            return false;
+        
+        count(NullCall::DestroyResource);
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NullDriver::callsCount(NullCall call) const
+    {
+        return counters[static_cast < std::size_t >(call)].load(std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NullDriver::commandBytesCount() const
+    {
+        return commandBytes.load(std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NullDriver::drawItemsCount() const
+    {
+        return drawItems.load(std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t NullDriver::stateChangesCount() const
+    {
+        return stateChanges.load(std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::resetCounters()
+    {
+        for (auto& counter : counters)
+            counter.store(0, std::memory_order_relaxed);
+        
+        commandBytes.store(0, std::memory_order_relaxed);
+        drawItems.store(0, std::memory_order_relaxed);
+        stateChanges.store(0, std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::count(NullCall call) const
+    {
+        counters[static_cast < std::size_t >(call)].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::Simulate(std::chrono::nanoseconds latency)
+    {
+        if (latency.count() <= 0)
+            return;
+        
+        // Sleeping is not precise enough for short latencies: the thread may wake up milliseconds later.
+        if (latency >= std::chrono::microseconds(50))
+        {
+            std::this_thread::sleep_for(latency);
+            return;
+        }
+        
+        auto deadline = std::chrono::steady_clock::now() + latency;
+        
+        while (std::chrono::steady_clock::now() < deadline)
+            ;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::onModuleDidUpdate(RD::Module* mod)
+    {
+        count(NullCall::ModuleUpdate);
+        Simulate(configuration.updateLatency);
+        
+        RD::Driver::onModuleDidUpdate(mod);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::onModuleWillTerminate(RD::Module *mod)
+    {
+        RD::Driver::onModuleWillTerminate(mod);
+        count(NullCall::ModuleTerminate);
+        
+        if (mod != module.load()) {
+            throw NullInvalidModuleException();
+        }
+        
+        // NOTE [Concurrency]
+        // RD::Emitter does not lock its listener list while emitting, so we can unregister
+        // from the module while it emits 'onModuleWillTerminate'.
+        mod->removeListener((RD::ModuleListener*)this);
+        
+        module.store(nullptr);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::executeCommand(const RD::CommandHeader& header, const void* payload)
+    {
+        count(NullCall::ExecuteCommand);
+        commandBytes.fetch_add(header.size, std::memory_order_relaxed);
+        
+        Simulate(configuration.commandLatency);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullDriver::executeDrawItems(const RD::DrawItem* items, std::size_t count)
+    {
+        this->count(NullCall::ExecuteDrawItems);
+        
+        std::uint64_t changes = 0;
+        std::uint32_t state = 0;
+        
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Pipeline and material, as one value: a change of either is a state change.
+            std::uint32_t itemState = std::uint32_t(items[i].key >> 16);
+            
+            if (i == 0 || itemState != state)
+                changes++;
+            
+            state = itemState;
+            Simulate(configuration.commandLatency);
+        }
+        
+        drawItems.fetch_add(count, std::memory_order_relaxed);
+        stateChanges.fetch_add(changes, std::memory_order_relaxed);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::Handle < RD::Surface > NullDriver::_createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const
+    {
+        count(NullCall::CreateSurface);
+        Simulate(configuration.surfaceCreationLatency);
+        
+        return RD::CreateHandle < NullSurface >(const_cast < NullDriver* >(this), width, height, title, objectName, style, extension);
+    }
+}
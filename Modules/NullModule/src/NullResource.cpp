@@ -0,0 +1,37 @@
+//
+//  NullResource.cpp
+//  NullModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "NullResource.h"
+#include "NullDriver.h"
+
+namespace Null
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    NullResource::NullResource(NullDriver* driver, std::size_t size, RD::MemoryKind memoryKind) : RD::DriverResource(driver),
+    nullDriver(driver), bytes(size), kind(memoryKind)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t NullResource::memorySize() const
+    {
+        return bytes;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::MemoryKind NullResource::memoryKind() const
+    {
+        return kind;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullResource::onDriverClear()
+    {
+        nullDriver->count(NullCall::ClearResource);
+    }
+}
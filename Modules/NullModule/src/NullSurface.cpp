@@ -0,0 +1,124 @@
+//
+//  NullSurface.cpp
+//  NullModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "NullSurface.h"
+#include "NullDriver.h"
+
+namespace Null
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    NullSurface::NullSurface(NullDriver* driver, uint32_t width, uint32_t height, const std::string& title, const std::string& objectName,
+                             uint32_t st, const void* extension) : RD::Surface(driver, width, height, title, objectName, st, extension),
+    nullDriver(driver), style(st), packedSize((std::uint64_t(width) << 32) | height)
+    {
+        
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NullSurface::isWindow() const
+    {
+        return !(style & RD::SurfaceStyle::Borderless);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NullSurface::isView() const
+    {
+        return !isWindow();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::show()
+    {
+        nullDriver->count(NullCall::SurfaceShow);
+        hidden.store(false);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::move(uint32_t x, uint32_t y)
+    {
+        nullDriver->count(NullCall::SurfaceMove);
+        packedPosition.store((std::uint64_t(x) << 32) | y);
+        
+        RD::ScreenPosition newPosition;
+        newPosition.x = x;
+        newPosition.y = y;
+        emitDidMove(newPosition);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::resize(uint32_t width, uint32_t height)
+    {
+        nullDriver->count(NullCall::SurfaceResize);
+        packedSize.store((std::uint64_t(width) << 32) | height);
+        
+        RD::RectSize newSize;
+        newSize.width = width;
+        newSize.height = height;
+        emitDidResize(newSize);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::ScreenPosition NullSurface::position() const
+    {
+        std::uint64_t packed = packedPosition.load();
+        
+        RD::ScreenPosition result;
+        result.x = uint32_t(packed >> 32);
+        result.y = uint32_t(packed);
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::RectSize NullSurface::size() const
+    {
+        std::uint64_t packed = packedSize.load();
+        
+        RD::RectSize result;
+        result.width = uint32_t(packed >> 32);
+        result.height = uint32_t(packed);
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::lockFocus()
+    {
+        nullDriver->count(NullCall::SurfaceLockFocus);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceLockFocus, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::close()
+    {
+        if (isClosed.exchange(true))
+            return;
+        
+        nullDriver->count(NullCall::SurfaceClose);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceWillClose, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::hide()
+    {
+        nullDriver->count(NullCall::SurfaceHide);
+        hidden.store(true);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceWillHide, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void NullSurface::unhide()
+    {
+        nullDriver->count(NullCall::SurfaceUnhide);
+        hidden.store(false);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceUnhide, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool NullSurface::closed() const
+    {
+        return isClosed.load();
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  SoftCommands.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef SoftCommands_h
+#define SoftCommands_h
+
+#include "SoftRasterizer.h"
+#include <RD/CommandBuffer.h>
+
+namespace Soft
+{
+    class SoftSurface;
+    
+    /** @defgroup SoftCommands
+     * @{
+     */
+    
+    //! @brief Fills a surface with a color and a depth. Payload is a SoftClearCommand.
+    static constexpr uint32_t kSoftClearCommand = 0x536F0001;
+    
+    //! @brief Draws triangles into a surface. Payload is a SoftDrawCommand followed by its vertices.
+    static constexpr uint32_t kSoftDrawCommand = 0x536F0002;
+    
+    /** @} */
+    
+    /*! @brief Payload of kSoftClearCommand. */
+    struct SoftClearCommand
+    {
+        //! @brief Surface cleared, locked until the command is executed.
+        const SoftSurface* surface;
+        
+        //! @brief Color as RGBA8.
+        uint32_t color;
+        
+        //! @brief Depth.
+        float depth;
+    };
+    
+    /*! @brief Payload of kSoftDrawCommand, followed by count SoftVertex. */
+    struct SoftDrawCommand
+    {
+        //! @brief Surface drawn into, locked until the command is executed.
+        const SoftSurface* surface;
+        
+        //! @brief Number of vertices following.
+        uint32_t count;
+        
+        //! @brief SoftDrawFlags.
+        uint32_t flags;
+    };
+    
+    /*! @brief Records a kSoftClearCommand.
+     *
+     * The surface is locked (see RD::DriverResource::lock) until the command is executed, so it is not
+     * destroyed meanwhile. A buffer must not be dropped without being executed, or its surfaces would stay
+     * locked.
+     */
+    void RecordClear(RD::CommandBuffer& buffer, const SoftSurface* surface, uint32_t color, float depth = 1.0f);
+    
+    /*! @brief Records a kSoftDrawCommand, copying the vertices into the buffer. Surface is locked like
+     * \ref RecordClear. */
+    void RecordDraw(RD::CommandBuffer& buffer, const SoftSurface* surface, const SoftVertex* vertices, uint32_t count,
+                    uint32_t flags = SoftDrawFlags::Default);
+}
+
+#endif /* SoftCommands_h */
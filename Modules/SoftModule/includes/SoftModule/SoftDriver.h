@@ -0,0 +1,109 @@
+//
+//  SoftDriver.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef SoftDriver_h
+#define SoftDriver_h
+
+#include "SoftRasterizer.h"
+#include "SoftCommands.h"
+
+#include <RD/Driver.h>
+#include <RD/Module.h>
+
+namespace Soft
+{
+    /**
+     * @brief Configuration of the SoftDriver object.
+     *
+     * You can give a pointer to an instance of this structure to member RD::DriverConfiguration::extension.
+     */
+    struct SoftDriverConfiguration
+    {
+        //! @brief Number of threads shading tiles, including the command queue's thread. If zero, one per
+        //! hardware thread.
+        uint32_t threads = 0;
+        
+        //! @brief Instruction set used to shade pixels. Falls back to the best supported one.
+        SoftSimd simd = SoftBestSimd();
+        
+        //! @brief Size of the tiles, in pixels.
+        uint32_t tileSize = 64;
+    };
+    
+    /** @brief Thrown when given Module does not correspond to the driver's module. */
+    RDDefineException(SoftInvalidModuleException, 1 << 1);
+    
+    /**
+     * @brief Software implementation of RD::Driver, rendering with the CPU.
+     *
+     * A SoftDriver creates SoftSurfaces, rendered into framebuffers in memory. Commands are recorded with
+     * \ref RecordClear and \ref RecordDraw into buffers of the driver's command queue, and executed by the
+     * queue's thread with a SoftRasterizer, whose tiles are shaded by a WorkerPool owned by the driver.
+     * Images only depend on the commands: not on the number of threads, nor on the instruction set.
+     */
+    class SoftDriver : public RD::Driver
+    {
+        //! @brief Module that created this driver.
+        std::atomic < RD::Module* > module;
+        
+        //! @brief Workers shading tiles with the queue's thread, or null if it shades alone.
+        std::unique_ptr < RD::WorkerPool > pool;
+        
+        //! @brief Rasterizer, used by the queue's thread only.
+        SoftRasterizer rasterizer;
+        
+    public:
+        
+        /*! @brief Default constructor.
+         *
+         * @param[in] mod Module that created this driver.
+         * @param[in] config Configuration, whose extension may point to a SoftDriverConfiguration. May
+         *      be null.
+         */
+        SoftDriver(RD::Module* mod, RD::DriverConfiguration* config);
+        
+        /*! @brief Default destructor. Stops the command queue. */
+        ~SoftDriver();
+        
+        /*! @brief Returns 'SoftDriver'. */
+        const std::string name() const noexcept;
+        
+        /*! @brief Returns 1.0. */
+        const RD::Version version() const;
+        
+        /*! @brief Returns true. */
+        bool valid() const;
+        
+        /*! @brief Returns the instruction set used to shade pixels. */
+        SoftSimd instructionSet() const;
+        
+        /*! @brief Returns the number of threads shading tiles, including the queue's thread. */
+        std::size_t threadsCount() const;
+        
+        /*! @brief Called when module is terminating. Clears every resource and unregisters from the module.
+         *
+         * @param[in] mod Module that created this driver. If mod does not correspond to module,
+         *      exception SoftInvalidModuleException is thrown.
+         */
+        void onModuleWillTerminate(RD::Module* mod);
+        
+    protected:
+        
+        /*! @brief Executes kSoftClearCommand and kSoftDrawCommand. Other commands are ignored. */
+        void executeCommand(const RD::CommandHeader& header, const void* payload);
+        
+        /*! @brief Replaces the surface of a captured kSoftClearCommand or kSoftDrawCommand with the surface
+         * replaying it, and locks it like recording the command does. Skips the command if the surface was
+         * not replayed. Other commands are kept. */
+        bool relocateCommand(const RD::CommandHeader& header, void* payload, const RD::CaptureRelocator& relocator);
+        
+        /*! @brief Creates a SoftSurface. */
+        RD::Handle < RD::Surface > _createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const;
+    };
+}
+
+#endif /* SoftDriver_h */
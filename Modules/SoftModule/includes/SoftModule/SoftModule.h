@@ -0,0 +1,60 @@
+//
+//  SoftModule.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef SoftModule_h
+#define SoftModule_h
+
+#include <RD/Module.h>
+
+namespace Soft
+{
+    /**
+     * @brief SoftModule module class.
+     *
+     * Installs a software renderer into the current RD::Application object. SoftModule creates a
+     * SoftDriver, which renders into framebuffers in memory with the CPU. It needs no GPU nor window
+     * system: surfaces are offscreen and their pixels are read back with SoftSurface::readPixels.
+     */
+    class Module : public RD::Module
+    {
+    public:
+        
+        /*! @brief Default constructor. */
+        Module() noexcept = default;
+        
+        /*! @brief Default destructor. */
+        ~Module() noexcept = default;
+        
+        /*! @brief Starts the module. Always succeeds. */
+        bool start(RD::Application& application, const RD::Clock::time_point& ticks);
+        
+        /*! @brief Updates the module. There is no event loop to poll: listeners are notified only. */
+        bool update(RD::Application& application, const RD::Clock::time_point& ticks);
+        
+        /*! @brief Stops the module. Listeners (like SoftDriver) receive onModuleWillTerminate, then are
+         * cleared. */
+        bool terminate(RD::Application& application, const RD::Clock::time_point& ticks);
+        
+        /*! @brief Returns this module name ('SoftModule'). */
+        const std::string name() const;
+        
+        /*! @brief Returns a new instance of a given class hash, if supported.
+         *
+         * Currently, supported hashes are:
+         *   - RD::Driver: Will create an instance of SoftDriver.
+         *
+         * @param hash Hash of the class we want to instanciate.
+         * @param user A RD::DriverConfiguration*, whose extension may point to a SoftDriverConfiguration.
+         *
+         * @return A pointer to an handle to the referred class, or nullptr if this hash is
+         *  not supported by the module.
+         */
+        void* loadHash(size_t hash, void* user);
+    };
+}
+
+#endif /* SoftModule_h */
@@ -0,0 +1,193 @@
+//
+//  SoftRasterizer.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef SoftRasterizer_h
+#define SoftRasterizer_h
+
+#include <RD/WorkerPool.h>
+
+namespace Soft
+{
+    /**
+     * @brief A vertex, already transformed to the pixels of the framebuffer.
+     *
+     * Origin is the top-left corner of the framebuffer and y goes down. Pixel centers are at half
+     * coordinates. Depth is interpolated linearly and tested against the depth buffer, where smaller
+     * is closer.
+     */
+    struct SoftVertex
+    {
+        //! @brief Position along the X axis, in pixels.
+        float x;
+        
+        //! @brief Position along the Y axis, in pixels.
+        float y;
+        
+        //! @brief Depth, usually between 0 and 1.
+        float z;
+        
+        //! @brief Color as RGBA8: red in the lowest byte, alpha in the highest one.
+        uint32_t color;
+    };
+    
+    /** @brief Flags of a draw. */
+    namespace SoftDrawFlags
+    {
+        //! @brief Pixels are drawn only if closer than the depth buffer, which is updated.
+        static constexpr uint32_t DepthTest = 1 << 0;
+        
+        //! @brief Triangles whose vertices are clockwise on screen are not drawn.
+        static constexpr uint32_t CullClockwise = 1 << 1;
+        
+        //! @brief Default flags.
+        static constexpr uint32_t Default = DepthTest;
+    }
+    
+    /** @brief Instruction set used to shade pixels. */
+    enum class SoftSimd : uint32_t
+    {
+        //! @brief One pixel at a time, on every CPU.
+        Scalar,
+        
+        //! @brief Four pixels at a time, on x86-64 CPUs.
+        SSE2,
+        
+        //! @brief Eight pixels at a time, on x86-64 CPUs supporting AVX2.
+        AVX2
+    };
+    
+    /*! @brief Returns the best instruction set supported by the running CPU. */
+    SoftSimd SoftBestSimd() noexcept;
+    
+    /*! @brief Returns true if the running CPU supports simd. */
+    bool SoftSupportsSimd(SoftSimd simd) noexcept;
+    
+    /*! @brief Returns the name of an instruction set, like 'AVX2'. */
+    const char* SoftSimdName(SoftSimd simd) noexcept;
+    
+    /**
+     * @brief Color and depth buffers in memory, row by row from the top.
+     */
+    struct SoftFramebuffer
+    {
+        //! @brief Width in pixels.
+        uint32_t width = 0;
+        
+        //! @brief Height in pixels.
+        uint32_t height = 0;
+        
+        //! @brief Colors as RGBA8, width * height.
+        std::vector < uint32_t > color;
+        
+        //! @brief Depths, width * height.
+        std::vector < float > depth;
+        
+        /*! @brief Resizes the buffers, which are cleared to transparent black and depth 1. */
+        void resize(uint32_t newWidth, uint32_t newHeight);
+    };
+    
+    /**
+     * @brief Tiled triangle rasterizer.
+     *
+     * A draw sets up its triangles, bins them into square tiles of the framebuffer, then shades the tiles
+     * in parallel: the calling thread and the workers of a WorkerPool take tiles one by one until every
+     * tile is done. A tile is shaded by one thread, with its triangles in drawing order, and every
+     * instruction set evaluates the same floating-point operations in the same order: the image does not
+     * depend on the number of threads nor on the instruction set.
+     *
+     * Pixels are covered following a top-left rule, so triangles sharing an edge do not both cover it.
+     * Depth and color are interpolated linearly in screen space.
+     *
+     * @note
+     * A rasterizer draws one framebuffer at a time, and is not thread-safe.
+     */
+    class SoftRasterizer
+    {
+    public:
+        
+        /*! @brief A triangle after setup. */
+        struct Triangle
+        {
+            //! @brief Edge functions E(x, y) = a * x + b * y + c, positive inside.
+            float a[3], b[3], c[3];
+            
+            //! @brief True if pixels exactly on the edge are covered.
+            bool topLeft[3];
+            
+            //! @brief Inverse of the doubled area.
+            float invArea;
+            
+            //! @brief Depth at the first vertex, and its differences to the other two.
+            float z0, dz1, dz2;
+            
+            //! @brief Color components (0-255) at the first vertex, and their differences to the other two.
+            float c0[4], dc1[4], dc2[4];
+            
+            //! @brief Bounding box, in pixels, clipped to the framebuffer.
+            int32_t minX, minY, maxX, maxY;
+        };
+        
+    private:
+        
+        //! @brief Pool shading tiles with the calling thread, or null if the calling thread is alone.
+        RD::WorkerPool* pool;
+        
+        //! @brief Instruction set used.
+        SoftSimd simd;
+        
+        //! @brief Size of the tiles, in pixels.
+        uint32_t tileSize;
+        
+        //! @brief Triangles of the current draw.
+        std::vector < Triangle > triangles;
+        
+        //! @brief Triangles of each tile, by index.
+        std::vector < std::vector < uint32_t > > bins;
+        
+        //! @brief Tiles having at least one triangle.
+        std::vector < uint32_t > activeTiles;
+        
+    public:
+        
+        /*! @brief Constructs a rasterizer.
+         *
+         * @param[in] pool Pool used to shade tiles with the calling thread. May be null.
+         * @param[in] simd Instruction set used. Falls back to the best one supported if not supported.
+         * @param[in] tileSize Size of the tiles, rounded up to a multiple of 8 pixels.
+         */
+        SoftRasterizer(RD::WorkerPool* pool, SoftSimd simd = SoftBestSimd(), uint32_t tileSize = 64);
+        
+        /*! @brief Returns the instruction set used. */
+        SoftSimd instructionSet() const noexcept { return simd; }
+        
+        /*! @brief Fills the framebuffer with a color and a depth. */
+        void clear(SoftFramebuffer& framebuffer, uint32_t color, float depth);
+        
+        /*! @brief Draws a list of triangles, three vertices each. Remaining vertices are ignored.
+         *
+         * @param[in] framebuffer Framebuffer to draw into.
+         * @param[in] vertices Vertices of the triangles.
+         * @param[in] count Number of vertices.
+         * @param[in] flags SoftDrawFlags.
+         */
+        void draw(SoftFramebuffer& framebuffer, const SoftVertex* vertices, std::size_t count, uint32_t flags = SoftDrawFlags::Default);
+        
+    private:
+        
+        /*! @brief Sets up a triangle. Returns false if it covers no pixel. */
+        static bool Setup(const SoftFramebuffer& framebuffer, const SoftVertex& v0, const SoftVertex& v1, const SoftVertex& v2, uint32_t flags, Triangle& triangle);
+        
+        /*! @brief Calls shade(i) for every i below count, from this thread and the pool's workers. */
+        template < typename Shade >
+        void parallelFor(std::size_t count, const Shade& shade);
+        
+        /*! @brief Shades the triangles of a tile. */
+        void shadeTile(SoftFramebuffer& framebuffer, uint32_t tile, uint32_t flags) const;
+    };
+}
+
+#endif /* SoftRasterizer_h */
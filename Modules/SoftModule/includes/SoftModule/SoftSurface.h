@@ -0,0 +1,117 @@
+//
+//  SoftSurface.h
+//  RD
+//
+//  Created by agent on 19/10/2026.
+//
+
+#ifndef SoftSurface_h
+#define SoftSurface_h
+
+#include "SoftRasterizer.h"
+#include <RD/Surface.h>
+
+namespace Soft
+{
+    class SoftDriver;
+    
+    /**
+     * @brief Offscreen surface of a SoftDriver, rendered into a SoftFramebuffer in memory.
+     *
+     * A SoftSurface is neither a window nor a view: it is never displayed, and its pixels are read back
+     * with \ref readPixels. Commands drawing into it are executed by the driver's command queue, so a
+     * read back sees every frame executed, which can be waited for with RD::CommandQueue::wait.
+     */
+    class SoftSurface : public RD::Surface
+    {
+        friend class SoftDriver;
+        
+        //! @brief Color and depth buffers.
+        SoftFramebuffer framebuffer;
+        
+        //! @brief Mutex protecting framebuffer, between the driver's queue and readers.
+        mutable std::mutex mutex;
+        
+        //! @brief Position, as x in the high 32 bits and y in the low ones.
+        std::atomic < std::uint64_t > packedPosition { 0 };
+        
+        //! @brief True if the surface is hidden.
+        std::atomic < bool > hidden { true };
+        
+        //! @brief True once the surface is closed.
+        std::atomic < bool > isClosed { false };
+        
+    public:
+        
+        /*! @brief Default constructor.
+         *
+         * @param[in] driver Driver which constructed this object.
+         * @param[in] width Width of the surface in pixels.
+         * @param[in] height Height of the surface in pixels.
+         * @param[in] title Title for this Surface, ignored.
+         * @param[in] objectName Name for this surface.
+         * @param[in] style Ignored.
+         * @param[in] extension Ignored.
+         */
+        SoftSurface(SoftDriver* driver, uint32_t width, uint32_t height, const std::string& title, const std::string& objectName,
+                    uint32_t style = RD::SurfaceStyle::Default,
+                    const void* extension = nullptr);
+        
+        /*! @brief Default destructor. */
+        ~SoftSurface() = default;
+        
+        /*! @brief Returns false. */
+        bool isWindow() const;
+        
+        /*! @brief Returns false. */
+        bool isView() const;
+        
+        /*! @brief Marks the surface as visible. */
+        void show();
+        
+        /*! @brief Changes the position and notifies observers. */
+        void move(uint32_t x, uint32_t y);
+        
+        /*! @brief Reallocates the framebuffer, cleared, and notifies observers. */
+        void resize(uint32_t width, uint32_t height);
+        
+        /*! @brief Returns the last position set. */
+        RD::ScreenPosition position() const;
+        
+        /*! @brief Returns the size of the framebuffer. */
+        RD::RectSize size() const;
+        
+        /*! @brief Notifies observers the surface has focus. */
+        void lockFocus();
+        
+        /*! @brief Closes the surface and notifies observers, once. */
+        void close();
+        
+        /*! @brief Marks the surface as hidden and notifies observers. */
+        void hide();
+        
+        /*! @brief Marks the surface as visible and notifies observers. */
+        void unhide();
+        
+        /*! @brief Returns true if surface is closed. */
+        bool closed() const;
+        
+        /*! @brief Copies the colors of the framebuffer, as RGBA8 row by row from the top.
+         * @return The size of the framebuffer.
+         */
+        RD::RectSize readPixels(std::vector < uint32_t >& pixels) const;
+        
+        /*! @brief Copies the depths of the framebuffer, row by row from the top.
+         * @return The size of the framebuffer.
+         */
+        RD::RectSize readDepths(std::vector < float >& depths) const;
+        
+        /*! @brief Returns the memory held by the framebuffer. */
+        std::size_t memorySize() const;
+        
+        /*! @brief Returns RD::MemoryKind::HostVisible: the framebuffer is in the host's memory. */
+        RD::MemoryKind memoryKind() const;
+    };
+}
+
+#endif /* SoftSurface_h */
@@ -0,0 +1,192 @@
+//
+//  SoftDriver.cpp
+//  SoftModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "SoftDriver.h"
+#include "SoftSurface.h"
+
+#include <cstddef>
+
+namespace Soft
+{
+    RDImplementException(SoftInvalidModuleException, "Soft: Invalid module (differs from created).")
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void RecordClear(RD::CommandBuffer& buffer, const SoftSurface* surface, uint32_t color, float depth)
+    {
+        surface->lock();
+        buffer.record(kSoftClearCommand, SoftClearCommand { surface, color, depth });
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void RecordDraw(RD::CommandBuffer& buffer, const SoftSurface* surface, const SoftVertex* vertices, uint32_t count, uint32_t flags)
+    {
+        surface->lock();
+        
+        SoftDrawCommand command { surface, count, flags };
+        unsigned char* payload = static_cast < unsigned char* >(buffer.allocate(kSoftDrawCommand, uint32_t(sizeof(command) + count * sizeof(SoftVertex))));
+        
+        std::memcpy(payload, &command, sizeof(command));
+        std::memcpy(payload + sizeof(command), vertices, count * sizeof(SoftVertex));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    static std::unique_ptr < RD::WorkerPool > CreatePool(const SoftDriverConfiguration& config)
+    {
+        std::size_t threads = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+        
+        // The queue's thread shades tiles too.
+        if (threads <= 1)
+            return nullptr;
+        
+        return std::make_unique < RD::WorkerPool >(threads - 1);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    static SoftDriverConfiguration ConfigurationOf(const RD::DriverConfiguration* config)
+    {
+        if (config && config->extension)
+            return *static_cast < const SoftDriverConfiguration* >(config->extension);
+        
+        return SoftDriverConfiguration();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    SoftDriver::SoftDriver(RD::Module* mod, RD::DriverConfiguration* config) : module(mod),
+    pool(CreatePool(ConfigurationOf(config))),
+    rasterizer(pool.get(), ConfigurationOf(config).simd, ConfigurationOf(config).tileSize)
+    {
+        if (!mod) {
+            throw SoftInvalidModuleException();
+        }
+        
+        mod->addListener((RD::ModuleListener*)this);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    SoftDriver::~SoftDriver()
+    {
+        // The queue's thread uses the rasterizer and the pool: it must be stopped before they are destroyed.
+        getCommandQueue().stop();
+        
+        RD::Module* mod = module.load();
+        
+        if (mod) {
+            mod->removeListener((RD::ModuleListener*)this);
+        }
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const std::string SoftDriver::name() const noexcept
+    {
+        return "SoftDriver";
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const RD::Version SoftDriver::version() const
+    {
+        return { 1, 0, 0, 0 };
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftDriver::valid() const
+    {
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    SoftSimd SoftDriver::instructionSet() const
+    {
+        return rasterizer.instructionSet();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t SoftDriver::threadsCount() const
+    {
+        return pool ? pool->size() + 1 : 1;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftDriver::onModuleWillTerminate(RD::Module *mod)
+    {
+        RD::Driver::onModuleWillTerminate(mod);
+        
+        if (mod != module.load()) {
+            throw SoftInvalidModuleException();
+        }
+        
+        // NOTE [Concurrency]
+        // RD::Emitter does not lock its listener list while emitting, so we can unregister
+        // from the module while it emits 'onModuleWillTerminate'.
+        mod->removeListener((RD::ModuleListener*)this);
+        
+        module.store(nullptr);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftDriver::executeCommand(const RD::CommandHeader& header, const void* payload)
+    {
+        if (header.type == kSoftClearCommand)
+        {
+            SoftClearCommand command;
+            std::memcpy(&command, payload, sizeof(command));
+            
+            SoftSurface* surface = const_cast < SoftSurface* >(command.surface);
+            
+            {
+                std::lock_guard < std::mutex > lock(surface->mutex);
+                rasterizer.clear(surface->framebuffer, command.color, command.depth);
+            }
+            
+            surface->unlock();
+        }
+        
+        else if (header.type == kSoftDrawCommand)
+        {
+            SoftDrawCommand command;
+            std::memcpy(&command, payload, sizeof(command));
+            
+            SoftSurface* surface = const_cast < SoftSurface* >(command.surface);
+            const SoftVertex* vertices = reinterpret_cast < const SoftVertex* >(static_cast < const unsigned char* >(payload) + sizeof(command));
+            
+            {
+                std::lock_guard < std::mutex > lock(surface->mutex);
+                rasterizer.draw(surface->framebuffer, vertices, command.count, command.flags);
+            }
+            
+            surface->unlock();
+        }
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftDriver::relocateCommand(const RD::CommandHeader& header, void* payload, const RD::CaptureRelocator& relocator)
+    {
+        // Both commands start with their surface.
+        static_assert(offsetof(SoftClearCommand, surface) == 0 && offsetof(SoftDrawCommand, surface) == 0,
+                      "Soft commands start with their surface.");
+        
+        if (header.type != kSoftClearCommand && header.type != kSoftDrawCommand)
+            return true;
+        
+        const SoftSurface* surface;
+        std::memcpy(&surface, payload, sizeof(surface));
+        
+        surface = relocator.relocate(surface);
+        
+        if (!surface)
+            return false;
+        
+        surface->lock();
+        std::memcpy(payload, &surface, sizeof(surface));
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::Handle < RD::Surface > SoftDriver::_createSurface(uint32_t width, uint32_t height, const std::string& title, const std::string& objectName, uint32_t style, const void* extension) const
+    {
+        return RD::CreateHandle < SoftSurface >(const_cast < SoftDriver* >(this), width, height, title, objectName, style, extension);
+    }
+}
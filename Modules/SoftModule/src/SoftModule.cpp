@@ -0,0 +1,62 @@
+//
+//  SoftModule.cpp
+//  SoftModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "SoftModule.h"
+#include "SoftDriver.h"
+
+namespace Soft
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Module::start(RD::Application &application, const RD::Clock::time_point &ticks)
+    {
+        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleDidStart, this);
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Module::update(RD::Application& application, const RD::Clock::time_point& ticks)
+    {
+        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleWillUpdate, this);
+        
+        // Listeners only need to know the module updated: the event is dispatched once, when the
+        // Application flushes its event queue.
+        emitCoalesced < RD::ModuleListener >(&RD::ModuleListener::onModuleDidUpdate, this);
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool Module::terminate(RD::Application &application, const RD::Clock::time_point &ticks)
+    {
+        emit < RD::ModuleListener >(&RD::ModuleListener::onModuleWillTerminate, this);
+        
+        // Listeners unregister themselves when receiving 'onModuleWillTerminate' (see SoftDriver).
+        // Remaining listeners are cleared, as the module will not emit anything anymore.
+        clearListeners();
+        
+        return true;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    const std::string Module::name() const
+    {
+        return "SoftModule";
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void* Module::loadHash(size_t hash, void* user)
+    {
+        if (hash == typeid(RD::Driver).hash_code())
+            return (void*) RD::CreateHandlePtr < RD::Driver, SoftDriver >(this, (RD::DriverConfiguration*)user);
+        return nullptr;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+extern "C" RD::Handle < RD::Module > CreateModule( void )
+{
+    return RD::CreateHandle < Soft::Module >();
+}
@@ -0,0 +1,519 @@
+//
+//  SoftRasterizer.cpp
+//  SoftModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "SoftRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+
+#if defined(SoftHaveX86)
+#   include <immintrin.h>
+
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#       define SoftTargetAVX2
+#   else
+#       define SoftTargetAVX2 __attribute__((target("avx2")))
+#   endif
+
+#endif
+
+namespace Soft
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    SoftSimd SoftBestSimd() noexcept
+    {
+        if (SoftSupportsSimd(SoftSimd::AVX2))
+            return SoftSimd::AVX2;
+        if (SoftSupportsSimd(SoftSimd::SSE2))
+            return SoftSimd::SSE2;
+        return SoftSimd::Scalar;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftSupportsSimd(SoftSimd simd) noexcept
+    {
+        switch (simd)
+        {
+            case SoftSimd::Scalar:
+                return true;
+
+#           if defined(SoftHaveX86)
+            // SSE2 is part of x86-64.
+            case SoftSimd::SSE2:
+                return true;
+
+            case SoftSimd::AVX2:
+#               if defined(_MSC_VER)
+            {
+                int info[4];
+                __cpuidex(info, 7, 0);
+                return (info[1] & (1 << 5)) && (_xgetbv(0) & 0x6) == 0x6;
+            }
+#               else
+                return __builtin_cpu_supports("avx2");
+#               endif
+
+#           endif
+
+            default:
+                return false;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    const char* SoftSimdName(SoftSimd simd) noexcept
+    {
+        switch (simd)
+        {
+            case SoftSimd::Scalar: return "Scalar";
+            case SoftSimd::SSE2: return "SSE2";
+            case SoftSimd::AVX2: return "AVX2";
+            default: return "Unknown";
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftFramebuffer::resize(uint32_t newWidth, uint32_t newHeight)
+    {
+        width = newWidth;
+        height = newHeight;
+
+        color.assign(std::size_t(width) * height, 0);
+        depth.assign(std::size_t(width) * height, 1.0f);
+    }
+
+    // NOTE [Determinism]
+    // Every shading path below evaluates, for each pixel, exactly the same float operations in the same
+    // order: E = a * x + (b * y + c), then attribute = (v0 + l1 * d1) + l2 * d2 with l = E * invArea.
+    // Multiplies and adds are never fused (SoftModule is built with -ffp-contract=off), so the scalar,
+    // SSE2 and AVX2 paths produce the same image, bit for bit.
+
+    namespace
+    {
+        typedef SoftRasterizer::Triangle Triangle;
+
+        /*! @brief Row terms b * y + c of the three edge functions. */
+        struct RowTerms
+        {
+            float r[3];
+        };
+
+        /*! @brief Shades one pixel at x of a row. */
+        inline void ShadePixel(const Triangle& t, const RowTerms& row, int32_t x, uint32_t* color, float* depth, bool depthTest)
+        {
+            float fx = float(x) + 0.5f;
+
+            float w0 = t.a[0] * fx + row.r[0];
+            float w1 = t.a[1] * fx + row.r[1];
+            float w2 = t.a[2] * fx + row.r[2];
+
+            bool covered = (t.topLeft[0] ? w0 >= 0.0f : w0 > 0.0f)
+                        && (t.topLeft[1] ? w1 >= 0.0f : w1 > 0.0f)
+                        && (t.topLeft[2] ? w2 >= 0.0f : w2 > 0.0f);
+
+            if (!covered)
+                return;
+
+            float l1 = w1 * t.invArea;
+            float l2 = w2 * t.invArea;
+            float z = (t.z0 + l1 * t.dz1) + l2 * t.dz2;
+
+            if (depthTest)
+            {
+                if (!(z < depth[x]))
+                    return;
+
+                depth[x] = z;
+            }
+
+            uint32_t packed = 0;
+
+            for (int k = 0; k < 4; ++k)
+            {
+                float v = (t.c0[k] + l1 * t.dc1[k]) + l2 * t.dc2[k];
+                v = std::min(std::max(v, 0.0f), 255.0f);
+                packed |= uint32_t(v + 0.5f) << (8 * k);
+            }
+
+            color[x] = packed;
+        }
+
+        /*! @brief Shades pixels [x0, x1] of a row, one at a time. */
+        void ShadeSpanScalar(const Triangle& t, const RowTerms& row, int32_t x0, int32_t x1, uint32_t* color, float* depth, bool depthTest)
+        {
+            for (int32_t x = x0; x <= x1; ++x)
+                ShadePixel(t, row, x, color, depth, depthTest);
+        }
+
+#       if defined(SoftHaveX86)
+
+        /*! @brief Shades pixels [x0, x1] of a row, four at a time. */
+        void ShadeSpanSSE2(const Triangle& t, const RowTerms& row, int32_t x0, int32_t x1, uint32_t* color, float* depth, bool depthTest)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 max = _mm_set1_ps(255.0f);
+            const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+            const __m128 invArea = _mm_set1_ps(t.invArea);
+
+            int32_t x = x0;
+
+            for (; x + 3 <= x1; x += 4)
+            {
+                __m128 fx = _mm_add_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(x), lanes)), half);
+                __m128 w[3];
+                __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    w[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.a[i]), fx), _mm_set1_ps(row.r[i]));
+                    mask = _mm_and_ps(mask, t.topLeft[i] ? _mm_cmpge_ps(w[i], zero) : _mm_cmpgt_ps(w[i], zero));
+                }
+
+                if (!_mm_movemask_ps(mask))
+                    continue;
+
+                __m128 l1 = _mm_mul_ps(w[1], invArea);
+                __m128 l2 = _mm_mul_ps(w[2], invArea);
+                __m128 z = _mm_add_ps(_mm_add_ps(_mm_set1_ps(t.z0), _mm_mul_ps(l1, _mm_set1_ps(t.dz1))), _mm_mul_ps(l2, _mm_set1_ps(t.dz2)));
+
+                if (depthTest)
+                {
+                    __m128 stored = _mm_loadu_ps(depth + x);
+                    mask = _mm_and_ps(mask, _mm_cmplt_ps(z, stored));
+
+                    if (!_mm_movemask_ps(mask))
+                        continue;
+
+                    _mm_storeu_ps(depth + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, stored)));
+                }
+
+                __m128i packed = _mm_setzero_si128();
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    __m128 v = _mm_add_ps(_mm_add_ps(_mm_set1_ps(t.c0[k]), _mm_mul_ps(l1, _mm_set1_ps(t.dc1[k]))), _mm_mul_ps(l2, _mm_set1_ps(t.dc2[k])));
+                    v = _mm_min_ps(_mm_max_ps(v, zero), max);
+
+                    __m128i byte = _mm_cvttps_epi32(_mm_add_ps(v, half));
+                    packed = _mm_or_si128(packed, _mm_sll_epi32(byte, _mm_cvtsi32_si128(8 * k)));
+                }
+
+                __m128i stored = _mm_loadu_si128(reinterpret_cast < const __m128i* >(color + x));
+                __m128i select = _mm_castps_si128(mask);
+
+                _mm_storeu_si128(reinterpret_cast < __m128i* >(color + x),
+                                 _mm_or_si128(_mm_and_si128(select, packed), _mm_andnot_si128(select, stored)));
+            }
+
+            ShadeSpanScalar(t, row, x, x1, color, depth, depthTest);
+        }
+
+        /*! @brief Shades pixels [x0, x1] of a row, eight at a time. */
+        SoftTargetAVX2
+        void ShadeSpanAVX2(const Triangle& t, const RowTerms& row, int32_t x0, int32_t x1, uint32_t* color, float* depth, bool depthTest)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 half = _mm256_set1_ps(0.5f);
+            const __m256 max = _mm256_set1_ps(255.0f);
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256 invArea = _mm256_set1_ps(t.invArea);
+
+            int32_t x = x0;
+
+            for (; x + 7 <= x1; x += 8)
+            {
+                __m256 fx = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(x), lanes)), half);
+                __m256 w[3];
+                __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    w[i] = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(t.a[i]), fx), _mm256_set1_ps(row.r[i]));
+                    mask = _mm256_and_ps(mask, t.topLeft[i] ? _mm256_cmp_ps(w[i], zero, _CMP_GE_OQ) : _mm256_cmp_ps(w[i], zero, _CMP_GT_OQ));
+                }
+
+                if (!_mm256_movemask_ps(mask))
+                    continue;
+
+                __m256 l1 = _mm256_mul_ps(w[1], invArea);
+                __m256 l2 = _mm256_mul_ps(w[2], invArea);
+                __m256 z = _mm256_add_ps(_mm256_add_ps(_mm256_set1_ps(t.z0), _mm256_mul_ps(l1, _mm256_set1_ps(t.dz1))), _mm256_mul_ps(l2, _mm256_set1_ps(t.dz2)));
+
+                if (depthTest)
+                {
+                    __m256 stored = _mm256_loadu_ps(depth + x);
+                    mask = _mm256_and_ps(mask, _mm256_cmp_ps(z, stored, _CMP_LT_OQ));
+
+                    if (!_mm256_movemask_ps(mask))
+                        continue;
+
+                    _mm256_storeu_ps(depth + x, _mm256_blendv_ps(stored, z, mask));
+                }
+
+                __m256i packed = _mm256_setzero_si256();
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    __m256 v = _mm256_add_ps(_mm256_add_ps(_mm256_set1_ps(t.c0[k]), _mm256_mul_ps(l1, _mm256_set1_ps(t.dc1[k]))), _mm256_mul_ps(l2, _mm256_set1_ps(t.dc2[k])));
+                    v = _mm256_min_ps(_mm256_max_ps(v, zero), max);
+
+                    __m256i byte = _mm256_cvttps_epi32(_mm256_add_ps(v, half));
+                    packed = _mm256_or_si256(packed, _mm256_sllv_epi32(byte, _mm256_set1_epi32(8 * k)));
+                }
+
+                __m256i stored = _mm256_loadu_si256(reinterpret_cast < const __m256i* >(color + x));
+
+                _mm256_storeu_si256(reinterpret_cast < __m256i* >(color + x),
+                                    _mm256_blendv_epi8(stored, packed, _mm256_castps_si256(mask)));
+            }
+
+            ShadeSpanScalar(t, row, x, x1, color, depth, depthTest);
+        }
+
+#       endif
+
+        /*! @brief Signature of the span functions. */
+        typedef void (*ShadeSpanFcn)(const Triangle&, const RowTerms&, int32_t, int32_t, uint32_t*, float*, bool);
+
+        /*! @brief Returns the span function of an instruction set. */
+        ShadeSpanFcn ShadeSpanOf(SoftSimd simd)
+        {
+#           if defined(SoftHaveX86)
+            if (simd == SoftSimd::AVX2)
+                return &ShadeSpanAVX2;
+            if (simd == SoftSimd::SSE2)
+                return &ShadeSpanSSE2;
+#           endif
+
+            return &ShadeSpanScalar;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    SoftRasterizer::SoftRasterizer(RD::WorkerPool* p, SoftSimd s, uint32_t size)
+    : pool(p), simd(SoftSupportsSimd(s) ? s : SoftBestSimd()), tileSize(std::max(8u, (size + 7) & ~7u))
+    {
+
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    template < typename Shade >
+    void SoftRasterizer::parallelFor(std::size_t count, const Shade& shade)
+    {
+        struct State
+        {
+            std::atomic < std::size_t > next { 0 };
+            std::size_t running = 0;
+            std::mutex mutex;
+            std::condition_variable condition;
+        };
+
+        State state;
+        std::size_t helpers = pool && count > 1 ? std::min(pool->size(), count - 1) : 0;
+        state.running = helpers;
+
+        auto work = [&state, &shade, count](){
+            for (std::size_t i = state.next.fetch_add(1); i < count; i = state.next.fetch_add(1))
+                shade(i);
+        };
+
+        for (std::size_t i = 0; i < helpers; ++i)
+        {
+            pool->push([&state, work](){
+                work();
+
+                std::lock_guard < std::mutex > lock(state.mutex);
+
+                if (--state.running == 0)
+                    state.condition.notify_one();
+            });
+        }
+
+        work();
+
+        std::unique_lock < std::mutex > lock(state.mutex);
+        state.condition.wait(lock, [&state](){ return state.running == 0; });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftRasterizer::clear(SoftFramebuffer& framebuffer, uint32_t color, float depth)
+    {
+        std::size_t bands = (framebuffer.height + tileSize - 1) / tileSize;
+
+        parallelFor(bands, [&framebuffer, color, depth, this](std::size_t band){
+            std::size_t first = band * tileSize * framebuffer.width;
+            std::size_t last = std::min < std::size_t >((band + 1) * tileSize, framebuffer.height) * framebuffer.width;
+
+            std::fill(framebuffer.color.begin() + first, framebuffer.color.begin() + last, color);
+            std::fill(framebuffer.depth.begin() + first, framebuffer.depth.begin() + last, depth);
+        });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftRasterizer::draw(SoftFramebuffer& framebuffer, const SoftVertex* vertices, std::size_t count, uint32_t flags)
+    {
+        if (!framebuffer.width || !framebuffer.height)
+            return;
+
+        triangles.clear();
+
+        for (std::size_t i = 0; i + 2 < count; i += 3)
+        {
+            Triangle triangle;
+
+            if (Setup(framebuffer, vertices[i], vertices[i + 1], vertices[i + 2], flags, triangle))
+                triangles.push_back(triangle);
+        }
+
+        if (triangles.empty())
+            return;
+
+        // Bins are kept between draws, so their memory is reused.
+        uint32_t tilesX = (framebuffer.width + tileSize - 1) / tileSize;
+        uint32_t tilesY = (framebuffer.height + tileSize - 1) / tileSize;
+
+        if (bins.size() < std::size_t(tilesX) * tilesY)
+            bins.resize(std::size_t(tilesX) * tilesY);
+
+        activeTiles.clear();
+
+        for (uint32_t index = 0; index < triangles.size(); ++index)
+        {
+            const Triangle& triangle = triangles[index];
+
+            for (uint32_t ty = uint32_t(triangle.minY) / tileSize; ty <= uint32_t(triangle.maxY) / tileSize; ++ty)
+            {
+                for (uint32_t tx = uint32_t(triangle.minX) / tileSize; tx <= uint32_t(triangle.maxX) / tileSize; ++tx)
+                {
+                    std::vector < uint32_t >& bin = bins[ty * tilesX + tx];
+
+                    if (bin.empty())
+                        activeTiles.push_back(ty * tilesX + tx);
+
+                    bin.push_back(index);
+                }
+            }
+        }
+
+        parallelFor(activeTiles.size(), [this, &framebuffer, flags](std::size_t i){
+            shadeTile(framebuffer, activeTiles[i], flags);
+        });
+
+        for (uint32_t tile : activeTiles)
+            bins[tile].clear();
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftRasterizer::Setup(const SoftFramebuffer& framebuffer, const SoftVertex& v0, const SoftVertex& first, const SoftVertex& second, uint32_t flags, Triangle& t)
+    {
+        float area = (first.x - v0.x) * (second.y - v0.y) - (first.y - v0.y) * (second.x - v0.x);
+
+        // Positive areas are clockwise on screen, as y goes down.
+        if (!(area != 0.0f) || !std::isfinite(area))
+            return false;
+        if (area > 0.0f && (flags & SoftDrawFlags::CullClockwise))
+            return false;
+
+        const SoftVertex& v1 = area > 0.0f ? first : second;
+        const SoftVertex& v2 = area > 0.0f ? second : first;
+        area = std::fabs(area);
+
+        // Edge i is opposite to vertex i: E(p) = cross(d, p - origin), which is the weight of vertex i
+        // times the doubled area.
+        const SoftVertex* origins[3] = { &v1, &v2, &v0 };
+        const SoftVertex* ends[3] = { &v2, &v0, &v1 };
+
+        for (int i = 0; i < 3; ++i)
+        {
+            // A shared edge is set up from the same vertex in both triangles, and negated in one of them:
+            // its function is then exactly opposite, and the top-left rule gives its pixels to one triangle.
+            const SoftVertex* origin = origins[i];
+            const SoftVertex* end = ends[i];
+            bool swapped = origin->y > end->y || (origin->y == end->y && origin->x > end->x);
+
+            if (swapped)
+                std::swap(origin, end);
+
+            float dx = end->x - origin->x;
+            float dy = end->y - origin->y;
+            float sign = swapped ? -1.0f : 1.0f;
+
+            t.a[i] = sign * -dy;
+            t.b[i] = sign * dx;
+            t.c[i] = sign * (dy * origin->x - dx * origin->y);
+            t.topLeft[i] = swapped ? (dy > 0.0f || (dy == 0.0f && dx < 0.0f)) : (dy < 0.0f || (dy == 0.0f && dx > 0.0f));
+        }
+
+        t.invArea = 1.0f / area;
+        t.z0 = v0.z;
+        t.dz1 = v1.z - v0.z;
+        t.dz2 = v2.z - v0.z;
+
+        for (int k = 0; k < 4; ++k)
+        {
+            float c0 = float((v0.color >> (8 * k)) & 0xFF);
+            t.c0[k] = c0;
+            t.dc1[k] = float((v1.color >> (8 * k)) & 0xFF) - c0;
+            t.dc2[k] = float((v2.color >> (8 * k)) & 0xFF) - c0;
+        }
+
+        // Coordinates are clamped before conversion, so huge or infinite ones do not overflow.
+        float width = float(framebuffer.width);
+        float height = float(framebuffer.height);
+
+        float minX = std::floor(std::max(std::min(std::min(v0.x, v1.x), v2.x), -1.0f));
+        float maxX = std::ceil(std::min(std::max(std::max(v0.x, v1.x), v2.x), width));
+        float minY = std::floor(std::max(std::min(std::min(v0.y, v1.y), v2.y), -1.0f));
+        float maxY = std::ceil(std::min(std::max(std::max(v0.y, v1.y), v2.y), height));
+
+        t.minX = std::max(int32_t(minX), 0);
+        t.maxX = std::min(int32_t(maxX), int32_t(framebuffer.width) - 1);
+        t.minY = std::max(int32_t(minY), 0);
+        t.maxY = std::min(int32_t(maxY), int32_t(framebuffer.height) - 1);
+
+        return t.minX <= t.maxX && t.minY <= t.maxY;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftRasterizer::shadeTile(SoftFramebuffer& framebuffer, uint32_t tile, uint32_t flags) const
+    {
+        uint32_t tilesX = (framebuffer.width + tileSize - 1) / tileSize;
+        int32_t tileX0 = int32_t((tile % tilesX) * tileSize);
+        int32_t tileY0 = int32_t((tile / tilesX) * tileSize);
+        int32_t tileX1 = std::min(tileX0 + int32_t(tileSize), int32_t(framebuffer.width)) - 1;
+        int32_t tileY1 = std::min(tileY0 + int32_t(tileSize), int32_t(framebuffer.height)) - 1;
+
+        ShadeSpanFcn shadeSpan = ShadeSpanOf(simd);
+        bool depthTest = flags & SoftDrawFlags::DepthTest;
+
+        for (uint32_t index : bins[tile])
+        {
+            const Triangle& t = triangles[index];
+
+            int32_t x0 = std::max(t.minX, tileX0);
+            int32_t x1 = std::min(t.maxX, tileX1);
+            int32_t y0 = std::max(t.minY, tileY0);
+            int32_t y1 = std::min(t.maxY, tileY1);
+
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                float fy = float(y) + 0.5f;
+
+                RowTerms row;
+                row.r[0] = t.b[0] * fy + t.c[0];
+                row.r[1] = t.b[1] * fy + t.c[1];
+                row.r[2] = t.b[2] * fy + t.c[2];
+
+                std::size_t offset = std::size_t(y) * framebuffer.width;
+                shadeSpan(t, row, x0, x1, framebuffer.color.data() + offset, framebuffer.depth.data() + offset, depthTest);
+            }
+        }
+    }
+}
@@ -0,0 +1,156 @@
+//
+//  SoftSurface.cpp
+//  SoftModule
+//
+//  Created by agent on 19/10/2026.
+//
+
+#include "SoftSurface.h"
+#include "SoftDriver.h"
+
+namespace Soft
+{
+    /////////////////////////////////////////////////////////////////////////////////
+    SoftSurface::SoftSurface(SoftDriver* driver, uint32_t width, uint32_t height, const std::string& title, const std::string& objectName,
+                             uint32_t style, const void* extension) : RD::Surface(driver, width, height, title, objectName, style, extension)
+    {
+        framebuffer.resize(width, height);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftSurface::isWindow() const
+    {
+        return false;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftSurface::isView() const
+    {
+        return false;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::show()
+    {
+        hidden.store(false);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::move(uint32_t x, uint32_t y)
+    {
+        packedPosition.store((std::uint64_t(x) << 32) | y);
+        
+        RD::ScreenPosition newPosition;
+        newPosition.x = x;
+        newPosition.y = y;
+        emitDidMove(newPosition);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::resize(uint32_t width, uint32_t height)
+    {
+        {
+            std::lock_guard < std::mutex > lock(mutex);
+            framebuffer.resize(width, height);
+        }
+        
+        RD::RectSize newSize;
+        newSize.width = width;
+        newSize.height = height;
+        emitDidResize(newSize);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::ScreenPosition SoftSurface::position() const
+    {
+        std::uint64_t packed = packedPosition.load();
+        
+        RD::ScreenPosition result;
+        result.x = uint32_t(packed >> 32);
+        result.y = uint32_t(packed);
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::RectSize SoftSurface::size() const
+    {
+        std::lock_guard < std::mutex > lock(mutex);
+        
+        RD::RectSize result;
+        result.width = framebuffer.width;
+        result.height = framebuffer.height;
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::lockFocus()
+    {
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceLockFocus, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::close()
+    {
+        if (isClosed.exchange(true))
+            return;
+        
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceWillClose, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::hide()
+    {
+        hidden.store(true);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceWillHide, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    void SoftSurface::unhide()
+    {
+        hidden.store(false);
+        emit < RD::SurfaceObserver >(&RD::SurfaceObserver::onSurfaceUnhide, static_cast < const RD::Surface* >(this));
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    bool SoftSurface::closed() const
+    {
+        return isClosed.load();
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::RectSize SoftSurface::readPixels(std::vector < uint32_t >& pixels) const
+    {
+        std::lock_guard < std::mutex > lock(mutex);
+        pixels = framebuffer.color;
+        
+        RD::RectSize result;
+        result.width = framebuffer.width;
+        result.height = framebuffer.height;
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::RectSize SoftSurface::readDepths(std::vector < float >& depths) const
+    {
+        std::lock_guard < std::mutex > lock(mutex);
+        depths = framebuffer.depth;
+        
+        RD::RectSize result;
+        result.width = framebuffer.width;
+        result.height = framebuffer.height;
+        return result;
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    std::size_t SoftSurface::memorySize() const
+    {
+        std::lock_guard < std::mutex > lock(mutex);
+        return framebuffer.color.size() * sizeof(uint32_t) + framebuffer.depth.size() * sizeof(float);
+    }
+    
+    /////////////////////////////////////////////////////////////////////////////////
+    RD::MemoryKind SoftSurface::memoryKind() const
+    {
+        return RD::MemoryKind::HostVisible;
+    }
+}
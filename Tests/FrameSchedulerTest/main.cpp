@@ -0,0 +1,76 @@
+//
+//  main.cpp
+//  FrameSchedulerTest
+//
+//  Created by agent on 19/10/2026.
+//
+//  Checks that a paced FrameScheduler keeps its schedule when a wait ends early, on a timer deadline
+//  or on wake(): the following frame must still begin one period after the previous one.
+//
+
+#include <RD/FrameScheduler.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    //! @brief Period of the paced scheduler.
+    constexpr RD::Clock::duration kPeriod = std::chrono::milliseconds(20);
+
+    //! @brief Accepted distance between a frame and its expected time point.
+    constexpr RD::Clock::duration kTolerance = std::chrono::milliseconds(8);
+
+    /*! @brief Returns a duration in milliseconds, for messages. */
+    double Milliseconds(RD::Clock::duration duration)
+    {
+        return std::chrono::duration < double, std::milli >(duration).count();
+    }
+
+    /*! @brief Waits once for a full frame, then once until an early end, then for the next frame, and
+     * checks the next frame begins one period after the first one. */
+    bool CheckEarlyWait(const char* name, bool useWake)
+    {
+        RD::FrameScheduler scheduler;
+        scheduler.setTargetRate(1.0 / std::chrono::duration < double >(kPeriod).count());
+
+        // The first wait starts the schedule.
+        scheduler.beginFrame(RD::Clock::now());
+        scheduler.wait(RD::Clock::time_point::max());
+
+        const RD::Clock::time_point frame = RD::Clock::now();
+        scheduler.beginFrame(frame);
+
+        // Ends before the next frame, like a short timer or a wake from another thread.
+        if (useWake)
+        {
+            scheduler.wake();
+            scheduler.wait(RD::Clock::time_point::max());
+        }
+
+        else
+        {
+            scheduler.wait(frame + std::chrono::milliseconds(2));
+        }
+
+        scheduler.wait(RD::Clock::time_point::max());
+
+        const RD::Clock::duration elapsed = RD::Clock::now() - frame;
+        const bool passed = elapsed > kPeriod - kTolerance && elapsed < kPeriod + kTolerance;
+
+        std::printf("%-8s | next frame after %6.2f ms, expected %6.2f ms | %s\n",
+                    name, Milliseconds(elapsed), Milliseconds(kPeriod), passed ? "passed" : "FAILED");
+
+        return passed;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool passed = true;
+
+    passed = CheckEarlyWait("deadline", false) && passed;
+    passed = CheckEarlyWait("wake", true) && passed;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
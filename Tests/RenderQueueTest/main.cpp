@@ -0,0 +1,104 @@
+//
+//  main.cpp
+//  RenderQueueTest
+//
+//  Created by agent on 19/10/2026.
+//
+//  Checks that RenderQueue::Sort orders items like std::stable_sort by key, below and above
+//  kRadixThreshold, with distinct keys and with many duplicate keys whose order must be kept.
+//
+
+#include <RD/RenderQueue.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+    //! @brief Function returning a random key.
+    using KeyGenerator = std::uint64_t (*)(std::mt19937_64& random);
+
+    /*! @brief Prints the result of a check, and returns it. */
+    bool Check(const char* name, std::size_t count, bool passed)
+    {
+        std::printf("%-24s | %6zu items | %s\n", name, count, passed ? "passed" : "FAILED");
+        return passed;
+    }
+
+    /*! @brief Sorts count random items with RenderQueue::Sort and with std::stable_sort, and compares
+     * them. Each item's data is its index, so equal keys out of their submission order are detected. */
+    bool CheckSort(const char* name, std::size_t count, KeyGenerator generator, std::vector < RD::DrawItem >& scratch)
+    {
+        std::mt19937_64 random(count);
+        std::vector < RD::DrawItem > items(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            items[i] = RD::DrawItem { generator(random), i };
+
+        std::vector < RD::DrawItem > expected = items;
+        std::stable_sort(expected.begin(), expected.end(), [](const RD::DrawItem& lhs, const RD::DrawItem& rhs){
+            return lhs.key < rhs.key;
+        });
+
+        RD::RenderQueue::Sort(items, scratch);
+
+        const bool passed = std::equal(items.begin(), items.end(), expected.begin(), expected.end(),
+                                       [](const RD::DrawItem& lhs, const RD::DrawItem& rhs){
+            return lhs.key == rhs.key && lhs.data == rhs.data;
+        });
+
+        return Check(name, count, passed);
+    }
+
+    /*! @brief Keys over the 64 bits, nearly all distinct. */
+    std::uint64_t DistinctKey(std::mt19937_64& random)
+    {
+        return random();
+    }
+
+    /*! @brief Sixteen keys, differing in their high byte only, like draws sharing a few pipelines. */
+    std::uint64_t DuplicateKey(std::mt19937_64& random)
+    {
+        return (random() % 16) << 56;
+    }
+
+    /*! @brief Keys differing in a few bytes, spread over the key, with duplicates. */
+    std::uint64_t SparseKey(std::mt19937_64& random)
+    {
+        const std::uint64_t value = random();
+        return (value & 0x0300000000000000ull) | (value & 0x0000070000000000ull) | (value & 0x3);
+    }
+
+    /*! @brief The same key, every pass is skipped. */
+    std::uint64_t ConstantKey(std::mt19937_64&)
+    {
+        return 0x0123456789ABCDEFull;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t sizes[] = {
+        0, 1, 2, 100,
+        RD::RenderQueue::kRadixThreshold - 1,
+        RD::RenderQueue::kRadixThreshold,
+        RD::RenderQueue::kRadixThreshold + 1,
+        10000, 100000
+    };
+
+    // Shared by every sort, as RenderQueue::flush reuses it.
+    std::vector < RD::DrawItem > scratch;
+    bool passed = true;
+
+    for (std::size_t count : sizes)
+    {
+        passed = CheckSort("distinct keys", count, DistinctKey, scratch) && passed;
+        passed = CheckSort("duplicate keys", count, DuplicateKey, scratch) && passed;
+        passed = CheckSort("sparse duplicate keys", count, SparseKey, scratch) && passed;
+        passed = CheckSort("constant key", count, ConstantKey, scratch) && passed;
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+//
+//  main.cpp
+//  ResourceRegistryTest
+//
+//  Created by agent on 19/10/2026.
+//
+//  Checks ResourceRegistry: insertion and duplicate names, removal by pointer, surface counts, visitors
+//  removing entries, release of removed entries by collect(), and insertions and removals from several
+//  threads.
+//
+
+#include <RD/ResourceRegistry.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace
+{
+    //! @brief Number of TestResource and TestSurface alive.
+    std::atomic < int > alive { 0 };
+
+    /*! @brief A resource counting its instances. */
+    class TestResource : public RD::DriverResource
+    {
+    public:
+
+        TestResource() : RD::DriverResource(nullptr) { alive++; }
+        ~TestResource() { alive--; }
+
+    protected:
+
+        void onDriverClear() { }
+    };
+
+    /*! @brief A surface counting its instances. */
+    class TestSurface : public RD::Surface
+    {
+    public:
+
+        TestSurface() : RD::Surface(nullptr, 1, 1, "", "") { alive++; }
+        ~TestSurface() { alive--; }
+
+        bool isWindow() const { return false; }
+        bool isView() const { return false; }
+        void show() { }
+        void move(uint32_t, uint32_t) { }
+        void resize(uint32_t, uint32_t) { }
+        RD::ScreenPosition position() const { return RD::ScreenPosition(); }
+        RD::RectSize size() const { return RD::RectSize(); }
+        void lockFocus() { }
+        void close() { }
+        void hide() { }
+        void unhide() { }
+        bool closed() const { return false; }
+    };
+
+    /*! @brief Prints the result of a check, and returns it. */
+    bool Check(const char* name, bool passed)
+    {
+        std::printf("%-40s | %s\n", name, passed ? "passed" : "FAILED");
+        return passed;
+    }
+
+    /*! @brief Inserts resources and surfaces, rejects a duplicate name, finds and removes by pointer. */
+    bool CheckInsertRemove()
+    {
+        RD::ResourceRegistry registry;
+        auto resource = RD::CreateHandle < TestResource >();
+        auto surface = RD::CreateHandle < TestSurface >();
+
+        bool passed = true;
+
+        passed = Check("insert", registry.insert("resource", RD::Handle < RD::DriverResource >(resource))
+                                 && registry.insert("surface", RD::Handle < RD::Surface >(surface))) && passed;
+
+        passed = Check("insert rejects a duplicate name",
+                       !registry.insert("resource", RD::Handle < RD::DriverResource >(RD::CreateHandle < TestResource >()))
+                       && registry.size() == 2) && passed;
+
+        passed = Check("find and findSurface", registry.find("resource").ptr() == resource.ptr()
+                                               && registry.findSurface("surface").ptr() == surface.ptr()
+                                               && !registry.findSurface("resource").valid()
+                                               && !registry.find("missing").valid()) && passed;
+
+        passed = Check("surfaces counted", registry.size() == 2 && registry.surfacesSize() == 1) && passed;
+
+        passed = Check("remove by pointer", registry.remove(surface.ptr()).ptr() == surface.ptr()
+                                            && !registry.remove(surface.ptr()).valid()
+                                            && registry.size() == 1 && registry.surfacesSize() == 0
+                                            && !registry.findSurface("surface").valid()) && passed;
+
+        registry.clear();
+        passed = Check("clear", registry.size() == 0 && !registry.find("resource").valid()) && passed;
+
+        return passed;
+    }
+
+    /*! @brief Removes every entry from a visitor, and checks the visit still sees each of them once, and
+     * that removed entries are released by collect(). */
+    bool CheckVisitorRemoves()
+    {
+        RD::ResourceRegistry registry;
+        std::vector < std::string > names;
+
+        for (int i = 0; i < 100; ++i)
+            names.push_back("resource" + std::to_string(i));
+
+        for (const std::string& name : names)
+            registry.insert(RD::HashedString(name.c_str()), RD::Handle < RD::DriverResource >(RD::CreateHandle < TestResource >()));
+
+        const int created = alive.load();
+        std::size_t visited = 0;
+
+        registry.forEachResource([&registry, &visited](const RD::HashedString&, const RD::Handle < RD::DriverResource >& resource){
+            visited++;
+            registry.remove(resource.ptr());
+        });
+
+        bool passed = Check("visitor removes every entry", visited == names.size() && registry.size() == 0);
+
+        // Retired snapshots still hold the resources until they are collected.
+        registry.collect();
+        passed = Check("collect releases removed entries", alive.load() == created - int(names.size())) && passed;
+
+        return passed;
+    }
+
+    /*! @brief Inserts and removes resources from several threads while another one visits them. */
+    bool CheckConcurrent()
+    {
+        constexpr int kThreads = 4;
+        constexpr int kResources = 2000;
+
+        RD::ResourceRegistry registry;
+        std::vector < std::string > names;
+
+        for (int i = 0; i < kThreads * kResources; ++i)
+            names.push_back("concurrent" + std::to_string(i));
+
+        std::atomic < int > missed { 0 };
+        std::atomic < bool > done { false };
+        std::vector < std::thread > threads;
+
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&, t](){
+                for (int i = 0; i < kResources; ++i)
+                {
+                    RD::Handle < RD::DriverResource > resource(RD::CreateHandle < TestResource >());
+
+                    if (!registry.insert(RD::HashedString(names[t * kResources + i].c_str()), resource)
+                        || registry.remove(resource.ptr()).ptr() != resource.ptr())
+                        missed++;
+                }
+            });
+        }
+
+        std::thread visitor([&](){
+            while (!done.load())
+                registry.forEachResource([](const RD::HashedString&, const RD::Handle < RD::DriverResource >&){ });
+        });
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        done.store(true);
+        visitor.join();
+
+        return Check("concurrent insert and remove", missed.load() == 0 && registry.size() == 0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool passed = true;
+
+    passed = CheckInsertRemove() && passed;
+    passed = CheckVisitorRemoves() && passed;
+    passed = CheckConcurrent() && passed;
+
+    RD::Epoch::Collect();
+    passed = Check("every resource destroyed", alive.load() == 0) && passed;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,68 @@
+//
+//  main.cpp
+//  rdflightdump
+//
+//  Created by agent on 19/10/2026.
+//
+//  Prints a dump written by RD::FlightRecorder, one line per event, oldest first. Times are relative to
+//  the dump.
+//
+//  Usage: rdflightdump [-t thread] <dump>
+//
+
+#include <RD/FlightRecorder.h>
+#include <RD/Exception.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    unsigned long thread = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-t") && i + 1 < argc)
+            thread = std::strtoul(argv[++i], nullptr, 10);
+        else
+            path = argv[i];
+    }
+
+    if (!path)
+    {
+        std::fprintf(stderr, "usage: %s [-t thread] <dump>\n", argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        RD::FlightRecorder::Dump dump = RD::FlightRecorder::Read(path);
+
+        std::printf("reason: %s\n", dump.reason.c_str());
+        std::printf("events: %zu\n", dump.events.size());
+
+        for (const RD::FlightRecorder::Event& event : dump.events)
+        {
+            if (thread && event.thread != thread)
+                continue;
+
+            double seconds = (static_cast < double >(event.time) - static_cast < double >(dump.time)) * 1e-9;
+
+            std::printf("%12.6f [%u] %-18s object=0x%llx value=0x%llx %s\n",
+                        seconds, event.thread, RD::FlightRecorder::TypeName(event.type),
+                        static_cast < unsigned long long >(event.object),
+                        static_cast < unsigned long long >(event.value),
+                        event.text);
+        }
+    }
+
+    catch (const RD::Exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+//
+//  main.cpp
+//  rdlogdump
+//
+//  Created by agent on 19/10/2026.
+//
+//  Prints a binary notifications log written by RD::NotificationLogger, one line per notification, with
+//  the same layout as the logger's text encoding.
+//
+//  Usage: rdlogdump [-n name] <log>
+//
+
+#include <RD/NotificationLogger.h>
+#include <RD/Exception.h>
+
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    const char* filter = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-n") && i + 1 < argc)
+            filter = argv[++i];
+        else
+            path = argv[i];
+    }
+
+    if (!path)
+    {
+        std::fprintf(stderr, "usage: %s [-n name] <log>\n", argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        RD::NotificationLogReader reader(path);
+        RD::NotificationLogReader::Entry entry;
+        std::string line;
+
+        while (reader.next(entry))
+        {
+            if (entry.dropped)
+            {
+                std::printf("-- %llu notifications dropped --\n", static_cast < unsigned long long >(entry.dropped));
+                continue;
+            }
+
+            if (filter && entry.name != filter)
+                continue;
+
+            RD::NotificationLogger::FormatLine(line, static_cast < double >(entry.time) * 1e-9, entry.thread,
+                                               entry.module, entry.function, entry.name, entry.message);
+            std::puts(line.c_str());
+        }
+    }
+
+    catch (const RD::Exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+//
+//  main.cpp
+//  rdreplay
+//
+//  Created by agent on 19/10/2026.
+//
+//  Replays a capture written by RD::Driver::startCapture against the driver of a module, in a loop, and
+//  prints the time per frame: from the records of the frame replayed to the end of its execution by the
+//  driver's command queue.
+//
+//  Usage: rdreplay [-n loops] <module library> <capture>
+//
+
+#include <RD/Application.h>
+#include <RD/Driver.h>
+#include <RD/DriverCapture.h>
+#include <RD/Exception.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    const char* modulePath = nullptr;
+    const char* capturePath = nullptr;
+    unsigned long loops = 10;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-n") && i + 1 < argc)
+            loops = std::strtoul(argv[++i], nullptr, 10);
+        else if (!modulePath)
+            modulePath = argv[i];
+        else
+            capturePath = argv[i];
+    }
+
+    if (!modulePath || !capturePath || !loops)
+    {
+        std::fprintf(stderr, "usage: %s [-n loops] <module library> <capture>\n", argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        RD::Capture capture = RD::Capture::Read(capturePath);
+
+        std::printf("capture: %s, %zu records, %zu frames, driver %s\n", capturePath, capture.records.size(),
+                    capture.frames, capture.driver.c_str());
+
+        {
+            auto module = RD::Application::Get().loadModule(modulePath, true);
+
+            RD::DriverConfiguration config;
+            auto driver = module->loadClass < RD::Driver >(&config);
+
+            if (!driver.valid() || !driver->valid())
+            {
+                std::fprintf(stderr, "%s: no driver could be created.\n", modulePath);
+                return 1;
+            }
+
+            RD::Version version = driver->version();
+            std::printf("replaying with: %s %d.%d\n", driver->name().c_str(), version.major, version.minor);
+
+            std::vector < double > frames;
+            frames.reserve(capture.frames * loops);
+
+            {
+                RD::CaptureReplayer replayer(*driver, capture);
+
+                for (unsigned long loop = 0; loop < loops; ++loop)
+                {
+                    replayer.reset();
+
+                    while (true)
+                    {
+                        auto begin = RD::Clock::now();
+
+                        if (!replayer.step())
+                            break;
+
+                        driver->getCommandQueue().wait();
+                        frames.push_back(std::chrono::duration < double, std::milli >(RD::Clock::now() - begin).count());
+
+                        // Releases what the frame retired, as the application's update would.
+                        driver->onModuleDidUpdate(module.ptr());
+                    }
+                }
+
+                std::printf("skipped: %zu commands, %zu resources\n", replayer.skippedCommandsCount(),
+                            replayer.skippedResourcesCount());
+            }
+
+            if (!frames.empty())
+            {
+                std::sort(frames.begin(), frames.end());
+
+                double total = 0.0;
+
+                for (double frame : frames)
+                    total += frame;
+
+                std::printf("%zu frames: %.3f ms/frame, min %.3f, median %.3f, p99 %.3f, max %.3f\n", frames.size(),
+                            total / frames.size(), frames.front(), frames[frames.size() / 2],
+                            frames[std::min(frames.size() - 1, frames.size() * 99 / 100)], frames.back());
+            }
+
+            driver->onModuleWillTerminate(module.ptr());
+        }
+
+        RD::Application::Destroy();
+    }
+
+    catch (const RD::Exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}